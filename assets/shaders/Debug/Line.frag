@@ -0,0 +1,20 @@
+/// @file    Line.frag
+/// @author  Matthew Green
+/// @date    2024-01-28 14:12:08
+///
+/// @section LICENSE
+///
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#version 450 // GLSL v4.5
+
+layout(location = 0) in vec4 inColor;
+
+layout(location = 0) out vec4 outFragColor;
+
+void main()
+{
+    outFragColor = inColor;
+}
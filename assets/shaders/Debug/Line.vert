@@ -0,0 +1,30 @@
+/// @file    Line.vert
+/// @author  Matthew Green
+/// @date    2024-01-28 14:10:33
+///
+/// @section LICENSE
+///
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#version 450 // GLSL v4.5
+
+// Lines collected from DebugDraw, drawn as one line list, see DebugVertex.h
+
+layout(location = 0) in vec3 vPosition;
+layout(location = 1) in vec4 vColor;
+
+layout(location = 0) out vec4 outColor;
+
+// Camera of the frame, see FrameUniforms.h and DynamicRingBuffer.h
+layout(std140, set = 2, binding = 0) uniform FrameUniforms
+{
+    mat4 viewProjection;
+} frameUniforms;
+
+void main()
+{
+    gl_Position = frameUniforms.viewProjection * vec4(vPosition, 1.0);
+    outColor = vColor;
+}
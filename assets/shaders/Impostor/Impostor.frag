@@ -0,0 +1,75 @@
+/// @file    Impostor.frag
+/// @author  Matthew Green
+/// @date    2024-01-27 11:15:49
+///
+/// @section LICENSE
+///
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#version 450 // GLSL v4.5
+
+// Bindless table, see BindlessTable.h
+layout(set = 0, binding = 0) uniform texture2D textures[1024];
+layout(set = 0, binding = 1) uniform sampler textureSampler;
+
+// ImpostorPushConstants
+layout(push_constant) uniform constants
+{
+    vec4 cameraPosition;
+    uint colorTexture;
+    uint normalDepthTexture;
+    uint columns;
+    uint rows;
+} PushConstants;
+
+layout(location = 0) flat in vec4 inColor;
+layout(location = 1) in vec2 inUVA;
+layout(location = 2) in vec2 inUVB;
+layout(location = 3) flat in float inFrameBlend;
+layout(location = 4) flat in float inFade;
+layout(location = 5) in vec4 inClip;
+layout(location = 6) in vec4 inClipDepth;
+
+layout(location = 0) out vec4 outFragColor;
+
+// 4x4 ordered dither, the same pattern SimpleMesh.frag fades with
+float Dither(vec2 fragCoord)
+{
+    const float bayer[16] = float[16](0.0, 8.0, 2.0, 10.0, 12.0, 4.0, 14.0, 6.0, 3.0, 11.0, 1.0, 9.0, 15.0, 7.0, 13.0, 5.0);
+    ivec2 cell = ivec2(fragCoord) & 3;
+    return (bayer[cell.y * 4 + cell.x] + 0.5) / 16.0;
+}
+
+void main()
+{
+    // The mesh drops the pixels below the fade, the impostor draws exactly those
+    if (Dither(gl_FragCoord.xy) >= inFade)
+    {
+        discard;
+    }
+
+    vec4 albedo = mix
+    (
+        texture(sampler2D(textures[PushConstants.colorTexture], textureSampler), inUVA),
+        texture(sampler2D(textures[PushConstants.colorTexture], textureSampler), inUVB),
+        inFrameBlend
+    );
+    if (albedo.a < 0.5)
+    {
+        discard;
+    }
+
+    // Baked depth is 0 at the front of the bounding sphere and 1 at its back
+    float depth = mix
+    (
+        texture(sampler2D(textures[PushConstants.normalDepthTexture], textureSampler), inUVA).a,
+        texture(sampler2D(textures[PushConstants.normalDepthTexture], textureSampler), inUVB).a,
+        inFrameBlend
+    );
+    vec4 clip = inClip + (1.0 - 2.0 * depth) * inClipDepth;
+    gl_FragDepth = clip.z / clip.w;
+
+    outFragColor = vec4(albedo.rgb * inColor.rgb, inColor.a);
+}
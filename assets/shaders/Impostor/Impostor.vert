@@ -0,0 +1,96 @@
+/// @file    Impostor.vert
+/// @author  Matthew Green
+/// @date    2024-01-27 11:02:27
+///
+/// @section LICENSE
+///
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#version 450 // GLSL v4.5
+
+// One impostor billboard, drawn instanced per atlas, see ImpostorBaker.h
+
+struct ImpostorInstance
+{
+    vec4 center;
+    vec4 color;
+    uint frameA;
+    uint frameB;
+    float frameBlend;
+    float fade;
+    uint _padding0;
+    uint _padding1;
+    uint _padding2;
+    uint _padding3;
+};
+
+layout(location = 0) out vec4 outColor;
+layout(location = 1) out vec2 outUVA;
+layout(location = 2) out vec2 outUVB;
+layout(location = 3) out float outFrameBlend;
+layout(location = 4) out float outFade;
+layout(location = 5) out vec4 outClip;
+layout(location = 6) out vec4 outClipDepth;
+
+// ImpostorPushConstants
+layout(push_constant) uniform constants
+{
+    vec4 cameraPosition;
+    uint colorTexture;
+    uint normalDepthTexture;
+    uint columns;
+    uint rows;
+} PushConstants;
+
+// Camera and instances of the frame, see FrameUniforms.h and DynamicRingBuffer.h
+layout(std140, set = 2, binding = 0) uniform FrameUniforms
+{
+    mat4 viewProjection;
+} frameUniforms;
+
+layout(std430, set = 2, binding = 1) readonly buffer Impostors
+{
+    ImpostorInstance impostors[];
+} impostorBuffer;
+
+const vec2 corners[6] = vec2[](
+    vec2(-1.0, -1.0), vec2(1.0, -1.0), vec2(1.0, 1.0),
+    vec2(-1.0, -1.0), vec2(1.0, 1.0), vec2(-1.0, 1.0)
+);
+
+vec2 FrameUV(uint frame, vec2 uv)
+{
+    vec2 cell = vec2(frame % PushConstants.columns, frame / PushConstants.columns);
+    return (cell + uv) / vec2(PushConstants.columns, PushConstants.rows);
+}
+
+void main()
+{
+    ImpostorInstance impostor = impostorBuffer.impostors[gl_InstanceIndex];
+    vec3 center = impostor.center.xyz;
+    float radius = impostor.center.w;
+
+    // Turns around Y only, like the frames were baked
+    vec2 toCamera = PushConstants.cameraPosition.xz - center.xz;
+    vec3 facing = dot(toCamera, toCamera) > 1e-8 ? normalize(vec3(toCamera.x, 0.0, toCamera.y)) : vec3(0.0, 0.0, 1.0);
+    vec3 right = vec3(facing.z, 0.0, -facing.x);
+
+    vec2 corner = corners[gl_VertexIndex];
+    vec3 position = center + (right * corner.x + vec3(0.0, corner.y, 0.0)) * radius;
+
+    gl_Position = frameUniforms.viewProjection * vec4(position, 1.0);
+    outClip = gl_Position;
+    // Moving the quad towards the camera by the baked depth is linear in clip space
+    outClipDepth = frameUniforms.viewProjection * vec4(facing * radius, 0.0);
+
+    // Frame rows go down while the quad goes up
+    vec2 uv = vec2(corner.x * 0.5 + 0.5, 0.5 - corner.y * 0.5);
+    outUVA = FrameUV(impostor.frameA, uv);
+    outUVB = FrameUV(impostor.frameB, uv);
+
+    outColor = impostor.color;
+    outFrameBlend = impostor.frameBlend;
+    outFade = impostor.fade;
+}
@@ -9,12 +9,29 @@ layout (location = 0) out vec4 outColor;
 //push constants block
 layout( push_constant ) uniform constants
 {
-    vec4 data;
-    mat4 renderMatrix;
+    vec4 positionOffset;
+    vec4 positionScale;
+    uint materialIndex;
+    uint transformIndex;
+    float fade;
 } PushConstants;
 
+// World matrices, see TransformBuffer.h
+layout(std430, set = 1, binding = 0) readonly buffer TransformBuffer
+{
+    mat4 transforms[];
+} transformBuffer;
+
+// Camera of the frame, see FrameUniforms.h and DynamicRingBuffer.h
+layout(std140, set = 2, binding = 0) uniform FrameUniforms
+{
+    mat4 viewProjection;
+} frameUniforms;
+
 void main()
 {
-    gl_Position = PushConstants.renderMatrix * vec4(vPosition, 1.0f);
+    vec3 position = PushConstants.positionOffset.xyz + vPosition * PushConstants.positionScale.xyz;
+    mat4 renderMatrix = frameUniforms.viewProjection * transformBuffer.transforms[PushConstants.transformIndex];
+    gl_Position = renderMatrix * vec4(position, 1.0f);
     outColor = vColor;
-}
\ No newline at end of file
+}
\ No newline at end of file
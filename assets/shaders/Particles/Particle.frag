@@ -0,0 +1,23 @@
+/// @file    Particle.frag
+/// @author  Matthew Green
+/// @date    2024-01-20 13:09:27
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#version 450 // GLSL v4.5
+
+layout(location = 0) in vec4 inColor;
+layout(location = 1) in vec2 inCorner;
+
+layout(location = 0) out vec4 outFragColor;
+
+void main()
+{
+    // round, soft edged sprite without a texture
+    float falloff = 1.0 - smoothstep(0.25, 0.5, length(inCorner));
+    outFragColor = vec4(inColor.rgb, inColor.a * falloff);
+}
@@ -0,0 +1,65 @@
+/// @file    Particle.vert
+/// @author  Matthew Green
+/// @date    2024-01-20 13:05:10
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#version 450 // GLSL v4.5
+
+// Camera facing billboard of one particle, drawn instanced with ParticleSystem's draw command
+
+struct Particle
+{
+    vec4 positionAge;
+    vec4 velocityLifetime;
+    vec4 accelerationDrag;
+    uint startColor;
+    uint endColor;
+    float startSize;
+    float endSize;
+};
+
+layout(location = 0) out vec4 outColor;
+layout(location = 1) out vec2 outCorner;
+
+// ParticlePushConstants
+layout(push_constant) uniform constants
+{
+    vec4 cameraRight;
+    vec4 cameraUp;
+} PushConstants;
+
+// Particles written by the last simulation step, see ParticleSystem.h
+layout(std430, set = 1, binding = 0) readonly buffer Particles
+{
+    Particle particles[];
+} particleBuffer;
+
+// Camera of the frame, see FrameUniforms.h and DynamicRingBuffer.h
+layout(std140, set = 2, binding = 0) uniform FrameUniforms
+{
+    mat4 viewProjection;
+} frameUniforms;
+
+const vec2 corners[6] = vec2[](
+    vec2(-0.5, -0.5), vec2(0.5, -0.5), vec2(0.5, 0.5),
+    vec2(-0.5, -0.5), vec2(0.5, 0.5), vec2(-0.5, 0.5)
+);
+
+void main()
+{
+    Particle particle = particleBuffer.particles[gl_InstanceIndex];
+    float t = clamp(particle.positionAge.w / max(particle.velocityLifetime.w, 0.0001), 0.0, 1.0);
+
+    vec2 corner = corners[gl_VertexIndex];
+    float size = mix(particle.startSize, particle.endSize, t);
+    vec3 position = particle.positionAge.xyz + (PushConstants.cameraRight.xyz * corner.x + PushConstants.cameraUp.xyz * corner.y) * size;
+
+    gl_Position = frameUniforms.viewProjection * vec4(position, 1.0);
+    outColor = mix(unpackUnorm4x8(particle.startColor), unpackUnorm4x8(particle.endColor), t);
+    outCorner = corner;
+}
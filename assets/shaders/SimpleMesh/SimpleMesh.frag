@@ -0,0 +1,94 @@
+/// @file    SimpleMesh.frag
+/// @author  Matthew Green
+/// @date    2024-01-24 10:34:40
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#version 450 // GLSL v4.5
+
+// Variant of the pipeline, see ShaderVariantCache.h and SimpleMeshFeatures.h
+layout(constant_id = 1) const bool MATERIAL_COLOR = false;
+layout(constant_id = 2) const bool VERTEX_COLOR = false;
+layout(constant_id = 3) const bool DITHER_FADE = false;
+layout(constant_id = 4) const bool TEXTURED = false;
+
+struct MaterialParams
+{
+    vec4 color;
+    uint textureIndex;
+    uint _padding0;
+    uint _padding1;
+    uint _padding2;
+};
+
+// Bindless table, see BindlessTable.h
+layout(set = 0, binding = 0) uniform texture2D textures[1024];
+layout(set = 0, binding = 1) uniform sampler textureSampler;
+layout(std430, set = 0, binding = 2) readonly buffer MaterialBuffer
+{
+    MaterialParams materials[];
+} materialBuffer;
+
+layout( push_constant ) uniform constants
+{
+    vec4 positionOffset;
+    vec4 positionScale;
+    uint materialIndex;
+    uint transformIndex;
+    float fade;
+} PushConstants;
+
+layout(location = 0) in vec4 inColor; // Input color
+layout(location = 1) in vec3 inObjectPosition;
+layout(location = 0) out vec4 outFragColor; // Output color
+
+// 4x4 ordered dither, the same pattern Impostor.frag fades with
+float Dither(vec2 fragCoord)
+{
+    const float bayer[16] = float[16](0.0, 8.0, 2.0, 10.0, 12.0, 4.0, 14.0, 6.0, 3.0, 11.0, 1.0, 9.0, 15.0, 7.0, 13.0, 5.0);
+    ivec2 cell = ivec2(fragCoord) & 3;
+    return (bayer[cell.y * 4 + cell.x] + 0.5) / 16.0;
+}
+
+// SimpleMesh has no UVs, so the texture is projected along the three object axes, one repeat
+// per unit, and blended by how squarely the surface faces each axis
+vec4 SampleTriplanar(uint textureIndex)
+{
+    vec3 weights = abs(cross(dFdx(inObjectPosition), dFdy(inObjectPosition))) + vec3(1e-6f);
+    weights /= weights.x + weights.y + weights.z;
+
+    return texture(sampler2D(textures[textureIndex], textureSampler), inObjectPosition.zy) * weights.x
+        + texture(sampler2D(textures[textureIndex], textureSampler), inObjectPosition.xz) * weights.y
+        + texture(sampler2D(textures[textureIndex], textureSampler), inObjectPosition.xy) * weights.z;
+}
+
+void main()
+{
+    // Fading into an impostor, which draws exactly the pixels dropped here
+    if (DITHER_FADE && Dither(gl_FragCoord.xy) < PushConstants.fade)
+    {
+        discard;
+    }
+
+    // Variants without any color feature draw white
+    vec4 color = vec4(1.0f);
+    if (MATERIAL_COLOR)
+    {
+        color *= materialBuffer.materials[PushConstants.materialIndex].color;
+    }
+    if (VERTEX_COLOR)
+    {
+        color *= inColor;
+    }
+    if (TEXTURED)
+    {
+        // One material per draw, so the index is the same for the whole draw and needs no nonuniformEXT
+        color *= SampleTriplanar(materialBuffer.materials[PushConstants.materialIndex].textureIndex);
+    }
+
+    outFragColor = color;
+}
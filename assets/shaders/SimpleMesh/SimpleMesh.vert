@@ -0,0 +1,86 @@
+/// @file    SimpleMesh.vert
+/// @author  Matthew Green
+/// @date    2024-01-24 10:32:17
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#version 450 // GLSL v4.5
+
+#define PI 3.1415926535897932384626433832795
+
+// Variant of the pipeline, see ShaderVariantCache.h and SimpleMeshFeatures.h
+layout(constant_id = 0) const uint VERTEX_FORMAT = 0; // 0 = Float32, 1 = Quantized16
+layout(constant_id = 1) const bool MATERIAL_COLOR = false;
+layout(constant_id = 2) const bool VERTEX_COLOR = false;
+layout(constant_id = 4) const bool TEXTURED = false;
+
+layout (location = 0) in vec3 vPosition;
+
+layout (location = 0) out vec4 outColor;
+layout (location = 1) out vec3 outObjectPosition;
+
+//push constants block
+layout( push_constant ) uniform constants
+{
+    vec4 positionOffset;
+    vec4 positionScale;
+    uint materialIndex;
+    uint transformIndex;
+    float fade;
+} PushConstants;
+
+// World matrices, see TransformBuffer.h
+layout(std430, set = 1, binding = 0) readonly buffer TransformBuffer
+{
+    mat4 transforms[];
+} transformBuffer;
+
+// Camera of the frame, see FrameUniforms.h and DynamicRingBuffer.h
+layout(std140, set = 2, binding = 0) uniform FrameUniforms
+{
+    mat4 viewProjection;
+} frameUniforms;
+
+void main()
+{
+    // Quantized positions arrive in [0, 1] and are expanded back to the mesh bounds
+    vec3 position = vPosition;
+    if (VERTEX_FORMAT == 1)
+    {
+        position = PushConstants.positionOffset.xyz + vPosition * PushConstants.positionScale.xyz;
+    }
+
+    mat4 renderMatrix = frameUniforms.viewProjection * transformBuffer.transforms[PushConstants.transformIndex];
+    vec4 pos = renderMatrix * vec4(position, 1.0f);
+    vec4 ndcPos = pos / pos.w;
+
+    gl_Position = ndcPos;
+
+    // Decoded first, so a quantized mesh maps its texture like its full precision source
+    if (TEXTURED)
+    {
+        outObjectPosition = position;
+    }
+
+    outColor = vec4(1.0f);
+    if (VERTEX_COLOR)
+    {
+        // Red, green and blue channels rotated per corner of each triangle
+        const float xR = cos(0.0f);
+        const float xG = cos(2.0f * PI / 3.0f);
+        const float xB = cos(4.0f * PI / 3.0f);
+
+        const vec4 colors[3] = vec4[3]
+        (
+            vec4(clamp(xR, 0.0f, 1.0f), clamp(xG, 0.0f, 1.0f), clamp(xB, 0.0f, 1.0f), 1.0f),
+            vec4(clamp(xB, 0.0f, 1.0f), clamp(xR, 0.0f, 1.0f), clamp(xG, 0.0f, 1.0f), 1.0f),
+            vec4(clamp(xG, 0.0f, 1.0f), clamp(xB, 0.0f, 1.0f), clamp(xR, 0.0f, 1.0f), 1.0f)
+        );
+
+        outColor = colors[gl_VertexIndex % 3];
+    }
+}
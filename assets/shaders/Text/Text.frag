@@ -0,0 +1,43 @@
+/// @file    Text.frag
+/// @author  Matthew Green
+/// @date    2024-01-22 14:31:05
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#version 450 // GLSL v4.5
+
+// Bindless table, see BindlessTable.h
+layout(set = 0, binding = 0) uniform texture2D textures[1024];
+layout(set = 0, binding = 1) uniform sampler textureSampler;
+
+// TextPushConstants
+layout(push_constant) uniform constants
+{
+    mat4 viewProjection;
+    vec4 cameraRight;
+    vec4 cameraUp;
+    uint textureIndex;
+} PushConstants;
+
+layout(location = 0) in vec4 inColor;
+layout(location = 1) in vec2 inUV;
+
+layout(location = 0) out vec4 outFragColor;
+
+void main()
+{
+    // The atlas stores distance to the outline, 0.5 on it, so edges stay sharp at any size.
+    // One batch per font, so the texture index is the same for the whole draw
+    float distance = texture(sampler2D(textures[PushConstants.textureIndex], textureSampler), inUV).r;
+    float smoothing = max(fwidth(distance) * 0.75, 0.0001);
+    float coverage = smoothstep(0.5 - smoothing, 0.5 + smoothing, distance);
+    if (coverage <= 0.0)
+    {
+        discard;
+    }
+    outFragColor = vec4(inColor.rgb, inColor.a * coverage);
+}
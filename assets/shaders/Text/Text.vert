@@ -0,0 +1,87 @@
+/// @file    Text.vert
+/// @author  Matthew Green
+/// @date    2024-01-22 14:22:40
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#version 450 // GLSL v4.5
+
+// One glyph quad of a text label, drawn instanced with TextRenderer's batches
+
+struct TextLabelParams
+{
+    mat4 transform;
+    vec2 offset;
+    float size;
+    uint color;
+    uint billboard;
+    uint _padding0;
+    uint _padding1;
+    uint _padding2;
+};
+
+struct GlyphInstance
+{
+    vec4 rect;
+    vec4 uvRect;
+    uint labelIndex;
+    uint _padding0;
+    uint _padding1;
+    uint _padding2;
+};
+
+layout(location = 0) out vec4 outColor;
+layout(location = 1) out vec2 outUV;
+
+// TextPushConstants
+layout(push_constant) uniform constants
+{
+    mat4 viewProjection;
+    vec4 cameraRight;
+    vec4 cameraUp;
+    uint textureIndex;
+} PushConstants;
+
+// Labels and glyphs of the frame, see TextRenderer.h
+layout(std430, set = 1, binding = 0) readonly buffer Labels
+{
+    TextLabelParams labels[];
+} labelBuffer;
+
+layout(std430, set = 1, binding = 1) readonly buffer Glyphs
+{
+    GlyphInstance glyphs[];
+} glyphBuffer;
+
+const vec2 corners[6] = vec2[](
+    vec2(0.0, 0.0), vec2(1.0, 0.0), vec2(1.0, 1.0),
+    vec2(0.0, 0.0), vec2(1.0, 1.0), vec2(0.0, 1.0)
+);
+
+void main()
+{
+    GlyphInstance glyph = glyphBuffer.glyphs[gl_InstanceIndex];
+    TextLabelParams label = labelBuffer.labels[glyph.labelIndex];
+
+    vec2 corner = corners[gl_VertexIndex];
+    vec2 local = (mix(glyph.rect.xy, glyph.rect.zw, corner) + label.offset) * label.size;
+
+    vec3 position;
+    if (label.billboard != 0)
+    {
+        position = label.transform[3].xyz + PushConstants.cameraRight.xyz * local.x + PushConstants.cameraUp.xyz * local.y;
+    }
+    else
+    {
+        position = (label.transform * vec4(local, 0.0, 1.0)).xyz;
+    }
+
+    gl_Position = PushConstants.viewProjection * vec4(position, 1.0);
+    outColor = unpackUnorm4x8(label.color);
+    // the atlas rows go down while the quad goes up
+    outUV = vec2(mix(glyph.uvRect.x, glyph.uvRect.z, corner.x), mix(glyph.uvRect.w, glyph.uvRect.y, corner.y));
+}
@@ -0,0 +1,53 @@
+/// @file    Tile.frag
+/// @author  Matthew Green
+/// @date    2024-01-21 12:06:18
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#version 450 // GLSL v4.5
+
+struct MaterialParams
+{
+    vec4 color;
+    uint textureIndex;
+    uint _padding0;
+    uint _padding1;
+    uint _padding2;
+};
+
+// Bindless table, see BindlessTable.h
+layout(set = 0, binding = 0) uniform texture2D textures[1024];
+layout(set = 0, binding = 1) uniform sampler textureSampler;
+layout(std430, set = 0, binding = 2) readonly buffer MaterialBuffer
+{
+    MaterialParams materials[];
+} materialBuffer;
+
+layout( push_constant ) uniform constants
+{
+    vec4 positionOffset;
+    vec4 positionScale;
+    uint materialIndex;
+    uint transformIndex;
+    float fade;
+} PushConstants;
+
+layout (location = 0) in vec2 inUV;
+
+layout (location = 0) out vec4 outFragColor; // Output color
+
+void main()
+{
+    // One material per tilemap, so the texture index is the same for the whole draw
+    MaterialParams material = materialBuffer.materials[PushConstants.materialIndex];
+    vec4 texel = texture(sampler2D(textures[material.textureIndex], textureSampler), inUV);
+    if (texel.a < 0.5f)
+    {
+        discard; // Cut out, so tiles never need sorting
+    }
+    outFragColor = texel * material.color;
+}
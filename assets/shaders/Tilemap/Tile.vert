@@ -0,0 +1,47 @@
+/// @file    Tile.vert
+/// @author  Matthew Green
+/// @date    2024-01-21 12:05:41
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#version 450 // GLSL v4.5
+
+// Corner of the tile in whole tiles from the chunk origin, see TileVertex.h
+layout (location = 0) in uvec2 vCorner;
+layout (location = 1) in vec2 vUV;
+
+layout (location = 0) out vec2 outUV;
+
+//push constants block, the chunk origin and the tile size arrive as the position offset and scale
+layout( push_constant ) uniform constants
+{
+    vec4 positionOffset;
+    vec4 positionScale;
+    uint materialIndex;
+    uint transformIndex;
+    float fade;
+} PushConstants;
+
+// World matrices, see TransformBuffer.h
+layout(std430, set = 1, binding = 0) readonly buffer TransformBuffer
+{
+    mat4 transforms[];
+} transformBuffer;
+
+// Camera of the frame, see FrameUniforms.h and DynamicRingBuffer.h
+layout(std140, set = 2, binding = 0) uniform FrameUniforms
+{
+    mat4 viewProjection;
+} frameUniforms;
+
+void main()
+{
+    vec3 position = PushConstants.positionOffset.xyz + vec3(vec2(vCorner), 0.0f) * PushConstants.positionScale.xyz;
+    mat4 renderMatrix = frameUniforms.viewProjection * transformBuffer.transforms[PushConstants.transformIndex];
+    gl_Position = renderMatrix * vec4(position, 1.0f);
+    outUV = vUV;
+}
@@ -79,7 +79,7 @@ function(process_single_file_to_relative_destination SOURCE_FILE ASSETS_DIR DEST
 
     debug_message("FILE_EXT: ${FILE_EXT}")
 
-    if (${FILE_EXT} MATCHES ".vert" OR ${FILE_EXT} MATCHES  ".frag")
+    if (${FILE_EXT} MATCHES ".vert" OR ${FILE_EXT} MATCHES  ".frag" OR ${FILE_EXT} MATCHES ".comp")
         set(OUTPUT_FILE "${OUTPUT_FILE}.spv")
         debug_message("Preparing to compile: ${SOURCE_FILE} to ${OUTPUT_FILE}")
 
@@ -166,4 +166,4 @@ function(process_assets ASSETS_DIR DEST_DIR PATHS_TO_IGNORE COPIED_FILES_LIST)
     # After processing all paths, copy the files to the destination
     process_files_to_relative_destination("${ALL_ASSET_FILES}" "${ASSETS_DIR}" "${DEST_DIR}" LOCAL_COPIED_FILES)
     set(${COPIED_FILES_LIST} ${LOCAL_COPIED_FILES} PARENT_SCOPE)
-endfunction()
\ No newline at end of file
+endfunction()
\ No newline at end of file
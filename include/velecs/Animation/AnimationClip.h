@@ -0,0 +1,80 @@
+/// @file    AnimationClip.h
+/// @author  Matthew Green
+/// @date    2024-01-23 11:20:16
+///
+/// @section LICENSE
+///
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/Animation/Skeleton.h"
+
+#include <glm/vec3.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace velecs {
+
+/// @struct AnimationClip
+/// @brief Keyframed local poses of some joints of a Skeleton.
+///
+/// Each channel drives one joint with separate position, rotation and scale tracks,
+/// as they are imported. Times and values are kept in separate arrays so a lookup
+/// only walks the times. Joints without a channel keep their bind pose.
+struct AnimationClip {
+public:
+    // Enums
+
+    // Public Fields
+
+    /// @struct Channel
+    /// @brief Keys of one joint, times in seconds and in increasing order.
+    struct Channel {
+        uint32_t joint{0}; /// @brief Index of the joint in the skeleton.
+        std::vector<float> positionTimes;
+        std::vector<glm::vec3> positions;
+        std::vector<float> rotationTimes;
+        std::vector<glm::quat> rotations;
+        std::vector<float> scaleTimes;
+        std::vector<glm::vec3> scales;
+    };
+
+    std::string name; /// @brief Name of the animation in the source file.
+    float duration{0.0f}; /// @brief Length of the clip in seconds.
+    std::vector<Channel> channels; /// @brief One channel per animated joint.
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    AnimationClip() = default;
+
+    /// @brief Default deconstructor.
+    ~AnimationClip() = default;
+
+    // Public Methods
+
+    /// @brief Overwrites the poses of the animated joints with their value at @p time.
+    /// @param[in] time Seconds since the start of the clip, clamped to [0, duration].
+    /// @param[in,out] pose One local transform per joint, usually the bind pose.
+    ///
+    /// Positions and scales are interpolated linearly and rotations spherically.
+    void Sample(const float time, JointPose* pose) const;
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    // Private Methods
+};
+
+} // namespace velecs
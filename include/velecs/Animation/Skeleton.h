@@ -0,0 +1,100 @@
+/// @file    Skeleton.h
+/// @author  Matthew Green
+/// @date    2024-01-23 10:31:07
+///
+/// @section LICENSE
+///
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace velecs {
+
+/// @struct JointPose
+/// @brief Local transform of one joint, relative to its parent.
+struct JointPose {
+    glm::vec3 position{0.0f}; /// @brief Translation from the parent joint.
+    glm::quat rotation{1.0f, 0.0f, 0.0f, 0.0f}; /// @brief Rotation relative to the parent joint.
+    glm::vec3 scale{1.0f}; /// @brief Scale relative to the parent joint.
+};
+
+/// @struct Skeleton
+/// @brief Joint hierarchy of a SkinnedMesh and the bones its vertices are weighted to.
+///
+/// Joints are stored parents first, so a single forward pass turns local poses into
+/// global ones. Every bone is a joint, but not every joint is a bone: joints that only
+/// carry children, like the root, move the bones below them without skinning anything.
+struct Skeleton {
+public:
+    // Enums
+
+    // Public Fields
+
+    static constexpr int32_t NO_PARENT = -1; /// @brief Parent of the root joint.
+
+    /// @struct Joint
+    /// @brief One node of the hierarchy.
+    struct Joint {
+        std::string name; /// @brief Name of the node in the source file, animation channels refer to it.
+        int32_t parent{NO_PARENT}; /// @brief Index of the parent joint, always lower than this joint's index.
+        JointPose bindPose; /// @brief Local transform when no clip animates the joint.
+    };
+
+    std::vector<Joint> joints; /// @brief Every joint, parents before children.
+    std::vector<uint32_t> boneJoints; /// @brief Joint each bone follows, indexed by the bone indices of the vertices.
+    std::vector<glm::mat4> inverseBindMatrices; /// @brief Mesh space to bone space at bind time, one per bone.
+    glm::mat4 rootInverse{1.0f}; /// @brief Inverse of the root joint's bind transform, brings global poses back to mesh space.
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    Skeleton() = default;
+
+    /// @brief Default deconstructor.
+    ~Skeleton() = default;
+
+    // Public Methods
+
+    /// @brief Finds a joint by name.
+    /// @param[in] name The name of the node in the source file.
+    /// @return The joint index, or NO_PARENT if there is no such joint.
+    int32_t FindJoint(const std::string& name) const;
+
+    /// @brief Gets the number of bones.
+    /// @return The number of skin matrices ComputeSkinMatrices writes.
+    uint32_t GetBoneCount() const;
+
+    /// @brief Fills @p pose with the bind pose of every joint.
+    /// @param[out] pose Receives one local transform per joint.
+    void GetBindPose(std::vector<JointPose>& pose) const;
+
+    /// @brief Turns local joint poses into the matrices the skinning pass multiplies vertices by.
+    /// @param[in] pose One local transform per joint.
+    /// @param[out] skinMatrices Room for GetBoneCount() matrices, mesh space to posed mesh space.
+    ///
+    /// The matrix products run four lanes wide when VELECS_SIMD_SSE2 is defined. Safe to call
+    /// from several threads at once, each keeps its own scratch space.
+    void ComputeSkinMatrices(const JointPose* pose, glm::mat4* skinMatrices) const;
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    // Private Methods
+};
+
+} // namespace velecs
@@ -0,0 +1,96 @@
+/// @file    ThreadPool.h
+/// @author  Matthew Green
+/// @date    2024-01-07 11:03:18
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace velecs {
+
+/// @class ThreadPool
+/// @brief Fixed set of worker threads for data-parallel loops.
+///
+/// Work is handed out one index at a time, so which thread runs an index is not fixed.
+/// Jobs stay deterministic as long as each index only writes to data owned by that index.
+class ThreadPool {
+public:
+    // Enums
+
+    // Public Fields
+
+    // Constructors and Destructors
+
+    /// @brief Constructor.
+    /// @param[in] workerCount Number of threads to start in addition to the calling thread.
+    explicit ThreadPool(const size_t workerCount = DefaultWorkerCount());
+
+    /// @brief Deconstructor, joins every worker thread.
+    ~ThreadPool();
+
+    // Delete the copy constructor and assignment operator to prevent copies
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Public Methods
+
+    /// @brief Runs @p job once for every index in [0, @p count) and waits for all of them.
+    /// @param[in] count Number of indices.
+    /// @param[in] job Function called with each index, possibly from several threads at once.
+    /// @note The calling thread takes part in the work. Only one thread may call ParallelFor at a time.
+    void ParallelFor(const size_t count, const std::function<void(size_t index)>& job);
+
+    /// @brief Gets the number of threads that run jobs, including the calling thread.
+    /// @return The worker count plus one.
+    size_t GetThreadCount() const;
+
+    /// @brief Gets a worker count that leaves one hardware thread for the caller.
+    /// @return The number of hardware threads minus one, or zero if unknown.
+    static size_t DefaultWorkerCount();
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    std::vector<std::thread> workers;
+
+    std::mutex mutex; /// @brief Guards every field below except nextIndex.
+    std::condition_variable wakeCondition; /// @brief Signalled when a new job is posted or the pool stops.
+    std::condition_variable doneCondition; /// @brief Signalled when a worker finishes its share of a job.
+
+    const std::function<void(size_t)>* currentJob{nullptr};
+    size_t jobCount{0};
+    uint64_t jobGeneration{0}; /// @brief Incremented for every posted job so workers never run one twice.
+    size_t activeWorkers{0};
+    bool stopping{false};
+
+    std::atomic<size_t> nextIndex{0}; /// @brief Next index of the current job to hand out.
+
+    // Private Methods
+
+    /// @brief Loop run by every worker thread until the pool is destroyed.
+    void WorkerLoop();
+
+    /// @brief Claims and runs indices of a job until none are left.
+    /// @param[in] job The job to run.
+    /// @param[in] count Number of indices in the job.
+    void RunIndices(const std::function<void(size_t)>& job, const size_t count);
+};
+
+} // namespace velecs
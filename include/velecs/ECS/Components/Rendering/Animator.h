@@ -0,0 +1,74 @@
+/// @file    Animator.h
+/// @author  Matthew Green
+/// @date    2024-01-23 13:48:25
+///
+/// @section LICENSE
+///
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include <cstdint>
+
+namespace velecs {
+
+/// @struct Animator
+/// @brief Playback state of the clip posing an entity's SkinnedMesh.
+///
+/// The renderer advances time every Update and samples the clip for every visible
+/// animated entity on its worker threads, so instances sharing a mesh still play
+/// their clips independently.
+struct Animator {
+public:
+    // Enums
+
+    // Public Fields
+
+    static constexpr uint32_t BIND_POSE = UINT32_MAX; /// @brief Clip index that holds the mesh in its bind pose.
+
+    uint32_t clip{0}; /// @brief Index of the clip in SkinnedMesh::_clips, BIND_POSE or out of range shows the bind pose.
+    float time{0.0f}; /// @brief Seconds since the start of the clip.
+    float speed{1.0f}; /// @brief Playback rate, negative plays backwards.
+    bool loop{true}; /// @brief Wraps around at either end instead of holding the last pose.
+    bool playing{true}; /// @brief Whether Advance moves time.
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    Animator() = default;
+
+    /// @brief Constructor.
+    /// @param[in] clip Index of the clip to play.
+    /// @param[in] speed Playback rate.
+    /// @param[in] loop Whether the clip wraps around.
+    Animator(const uint32_t clip, const float speed = 1.0f, const bool loop = true);
+
+    /// @brief Default deconstructor.
+    ~Animator() = default;
+
+    // Public Methods
+
+    /// @brief Switches to another clip.
+    /// @param[in] clip Index of the clip to play.
+    /// @param[in] restart Whether to start from the beginning, otherwise the time carries over.
+    void Play(const uint32_t clip, const bool restart = true);
+
+    /// @brief Moves time forward.
+    /// @param[in] deltaTime Seconds since the last call.
+    /// @param[in] duration Length of the current clip in seconds.
+    void Advance(const float deltaTime, const float duration);
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    // Private Methods
+};
+
+} // namespace velecs
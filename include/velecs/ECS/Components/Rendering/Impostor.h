@@ -0,0 +1,37 @@
+/// @file    Impostor.h
+/// @author  Matthew Green
+/// @date    2024-01-27 10:44:18
+///
+/// @section LICENSE
+///
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include <cstdint>
+
+namespace velecs {
+
+/// @struct Impostor
+/// @brief Swaps an entity's SimpleMesh for a camera facing billboard of it when far away.
+///
+/// The atlas is baked once per mesh with RenderingECSModule::BakeImpostor and can be shared
+/// by every entity using that mesh. Across fadeRange the mesh and the billboard are drawn
+/// with complementary dither patterns, so the switch never pops and needs no blending.
+/// Billboards turn around the world Y axis, which suits trees, props and buildings.
+struct Impostor {
+    static constexpr uint32_t NO_ATLAS = UINT32_MAX; /// @brief Marks an entity drawn without an impostor.
+
+    uint32_t atlas{NO_ATLAS}; /// @brief Index returned by BakeImpostor or RegisterImpostor.
+    float distance{50.0f}; /// @brief Distance from the main camera at which the fade to the billboard starts.
+    float fadeRange{5.0f}; /// @brief Distance over which the mesh fades into the billboard.
+
+    Impostor() = default;
+
+    Impostor(const uint32_t atlas, const float distance = 50.0f, const float fadeRange = 5.0f)
+        : atlas(atlas), distance(distance), fadeRange(fadeRange) {}
+};
+
+} // namespace velecs
@@ -13,6 +13,7 @@
 #include "velecs/Graphics/Color32.h"
 #include "velecs/ECS/Entity.h"
 #include "velecs/Core/GameExceptions.h"
+#include "velecs/Rendering/BindlessTable.h"
 
 #include <vulkan/vulkan_core.h>
 
@@ -34,15 +35,53 @@ struct Material {
     Color32 color{Color32::MAGENTA}; /// @brief The color of the material.
     VkPipeline* pipeline{nullptr}; /// @brief The Vulkan pipeline associated with this material.
     VkPipelineLayout* pipelineLayout{nullptr}; /// @brief The Vulkan pipeline layout associated with this material.
+    uint32_t textureIndex{BindlessTable::DEFAULT_TEXTURE_INDEX}; /// @brief Slot of the base color texture in the bindless texture array.
+    uint32_t materialIndex{BindlessTable::INVALID_INDEX}; /// @brief Bindless material record, shared with every material of the same values and assigned by the renderer.
 
     // Constructors and Destructors
 
     /// @brief Default constructor.
     Material() = default;
 
+    /// @brief Constructor.
+    /// @param[in] color The color of the material.
+    /// @param[in] pipeline The Vulkan pipeline for the material.
+    /// @param[in] pipelineLayout The Vulkan pipeline layout for the material.
+    /// @param[in] textureIndex Slot of the base color texture in the bindless texture array.
+    Material
+    (
+        const Color32 color,
+        VkPipeline* const pipeline,
+        VkPipelineLayout* const pipelineLayout,
+        const uint32_t textureIndex = BindlessTable::DEFAULT_TEXTURE_INDEX
+    );
+
+    /// @brief Copy constructor.
+    /// @details Starts without a bindless record, the renderer takes a reference of its own for the copy.
+    /// @param[in] other The material to copy.
+    Material(const Material& other);
+
+    /// @brief Move constructor.
+    /// @details Keeps the bindless record, flecs moves components when entities change tables.
+    /// @param[in] other The material to move from.
+    Material(Material&& other) noexcept;
+
     /// @brief Default deconstructor.
     ~Material() = default;
 
+    // Operators
+
+    /// @brief Copy assignment operator.
+    /// @details Keeps this material's own reference, the renderer swaps it when the values changed.
+    /// @param[in] other The material to copy.
+    /// @return Reference to this material.
+    Material& operator=(const Material& other);
+
+    /// @brief Move assignment operator.
+    /// @param[in] other The material to move from.
+    /// @return Reference to this material.
+    Material& operator=(Material&& other) noexcept;
+
     // Public Methods
 
     /// @brief Creates a new Material entity in the ECS world.
@@ -51,6 +90,7 @@ struct Material {
     /// @param[in] pipeline The Vulkan pipeline for the material.
     /// @param[in] pipelineLayout The Vulkan pipeline layout for the material.
     /// @param[in] color The color of the material.
+    /// @param[in] textureIndex Slot of the base color texture in the bindless texture array.
     /// @return const Material* const A pointer to the newly created Material component.
     static const Material* const Create
     (
@@ -58,7 +98,8 @@ struct Material {
         const std::string& path,
         VkPipeline* const pipeline,
         VkPipelineLayout* const pipelineLayout,
-        const Color32 color = Color32::MAGENTA
+        const Color32 color = Color32::MAGENTA,
+        const uint32_t textureIndex = BindlessTable::DEFAULT_TEXTURE_INDEX
     );
 
     /// @brief Finds a Material component based on the search path.
@@ -0,0 +1,23 @@
+/// @file    Occluder.h
+/// @author  Matthew Green
+/// @date    2024-01-07 15:02:09
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+namespace velecs {
+
+/// @struct Occluder
+/// @brief Tag for entities whose SimpleMesh hides the objects behind it.
+///
+/// Occluder meshes are drawn into the software occlusion buffer every frame before
+/// any draw is recorded. Large, simple, closed meshes such as buildings and terrain
+/// make the best occluders; occluders themselves are never culled by the buffer.
+struct Occluder {};
+
+} // namespace velecs
@@ -36,7 +36,10 @@ struct OrthoCamera {
     OrthoCamera(const Rect extent,
                 const float nearPlaneOffset = 0.1f,
                 const float farPlaneOffset = 200.0f)
-        : extent(extent), nearPlaneOffset(nearPlaneOffset), farPlaneOffset(farPlaneOffset) {}
+        : extent(extent), nearPlaneOffset(nearPlaneOffset), farPlaneOffset(farPlaneOffset)
+    {
+        RecalculateProjectionMatrix();
+    }
 
     /// @brief Default deconstructor.
     ~OrthoCamera() = default;
@@ -45,17 +48,19 @@ struct OrthoCamera {
 
     void RecalculateProjectionMatrix()
     {
-        throw std::exception("Method is not implemented yet.");
-
-        projectionMatrix = glm::ortho
-        (
-            extent.min.x,
-            extent.min.y,
-            extent.max.x,
-            extent.max.y,
-            nearPlaneOffset,
-            farPlaneOffset
-        );
+        const float width = extent.max.x - extent.min.x;
+        const float height = extent.max.y - extent.min.y;
+        const float depth = farPlaneOffset - nearPlaneOffset;
+
+        // Same conventions as PerspectiveCamera: the camera looks down -Z with Y up, while
+        // Vulkan's NDC has Y down and depth from 0 at the near plane to 1 at the far plane.
+        projectionMatrix = glm::mat4(1.0f);
+        projectionMatrix[0][0] = 2.0f / width;
+        projectionMatrix[1][1] = -2.0f / height;
+        projectionMatrix[2][2] = -1.0f / depth;
+        projectionMatrix[3][0] = -(extent.max.x + extent.min.x) / width;
+        projectionMatrix[3][1] = (extent.max.y + extent.min.y) / height;
+        projectionMatrix[3][2] = -nearPlaneOffset / depth;
     }
 
     const glm::mat4& GetProjectionMatrix() const
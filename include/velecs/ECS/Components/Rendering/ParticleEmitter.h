@@ -0,0 +1,39 @@
+/// @file    ParticleEmitter.h
+/// @author  Matthew Green
+/// @date    2024-01-20 10:24:05
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/Math/Vec3.h"
+#include "velecs/Graphics/Color32.h"
+
+namespace velecs {
+
+/// @struct ParticleEmitter
+/// @brief Spawns GPU simulated particles at the entity's Transform.
+///
+/// Every frame the renderer turns each emitter into a ParticleEmitterParams record. The
+/// particles themselves live only in ParticleSystem's buffers, so removing the component
+/// stops the spawning while the particles already alive finish their lifetime.
+struct ParticleEmitter {
+    float rate{100.0f}; /// @brief Particles spawned per second.
+    float lifetime{2.0f}; /// @brief Seconds a particle lives for at most.
+    Vec3 velocity{Vec3::UP}; /// @brief Base velocity of spawned particles.
+    float spread{1.0f}; /// @brief Length of the random velocity added to each particle.
+    Vec3 acceleration{0.0f, -9.81f, 0.0f}; /// @brief Constant acceleration, gravity or wind.
+    float drag{0.0f}; /// @brief Fraction of its velocity a particle loses per second.
+    Color32 startColor{Color32::WHITE}; /// @brief Color of a particle when it spawns.
+    Color32 endColor{Color32::FromUInt8(255, 255, 255, 0)}; /// @brief Color of a particle when it dies, fade the alpha to make it disappear.
+    float startSize{0.1f}; /// @brief Billboard width of a particle when it spawns, in world units.
+    float endSize{0.0f}; /// @brief Billboard width of a particle when it dies.
+    bool emitting{true}; /// @brief Stops spawning without removing the emitter when false.
+    float spawnAccumulator{0.0f}; /// @brief Fraction of a particle carried over to the next frame, maintained by the renderer.
+};
+
+} // namespace velecs
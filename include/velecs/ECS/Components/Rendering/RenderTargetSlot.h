@@ -0,0 +1,35 @@
+/// @file    RenderTargetSlot.h
+/// @author  Matthew Green
+/// @date    2024-01-26 11:20:03
+///
+/// @section LICENSE
+///
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/Rendering/BindlessTable.h"
+#include "velecs/Rendering/RenderTargetPool.h"
+
+#include <cstdint>
+
+namespace velecs {
+
+/// @struct RenderTargetSlot
+/// @brief Texture a RenderView with a texture size draws into.
+///
+/// Added by the renderer, which replaces the target when the view's size changes.
+/// Store textureIndex in the Material::textureIndex of a SimpleMeshFeatures::TEXTURED
+/// material, or sample it from a custom pipeline. The texture holds
+/// the previous frame's image until the view is drawn again. Removing the
+/// component hands the target back to the pool.
+struct RenderTargetSlot {
+    uint32_t index{RenderTargetPool::INVALID_INDEX}; /// @brief Index of the target in the render target pool.
+    uint32_t textureIndex{BindlessTable::INVALID_INDEX}; /// @brief Slot of the target's color image in the bindless texture array.
+    uint32_t width{0}; /// @brief Width the target was created with.
+    uint32_t height{0}; /// @brief Height the target was created with.
+};
+
+} // namespace velecs
@@ -0,0 +1,53 @@
+/// @file    RenderView.h
+/// @author  Matthew Green
+/// @date    2024-01-26 11:12:40
+///
+/// @section LICENSE
+///
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/Graphics/Rect.h"
+
+#include <flecs.h>
+
+#include <cstdint>
+
+namespace velecs {
+
+/// @struct RenderView
+/// @brief An additional camera the scene is drawn from, into part of the window or into a texture.
+///
+/// Split-screen players and minimaps draw into a rectangle of the window. Security cameras
+/// and mirrors set a texture size instead, the renderer then adds a RenderTargetSlot with
+/// the texture's slot in the bindless array, which a SimpleMeshFeatures::TEXTURED material
+/// or a custom pipeline shows.
+/// Every view is culled in the same pass as the main
+/// camera, so an additional view costs its draws, not another walk over the scene.
+struct RenderView {
+    flecs::entity camera; /// @brief Entity with a Transform and a PerspectiveCamera or OrthoCamera.
+    Rect viewport{Vec2::ZERO, Vec2::ONE}; /// @brief Area drawn to as fractions of the target, min is the top-left corner.
+    uint32_t textureWidth{0}; /// @brief Width of the texture drawn to, 0 draws to the window.
+    uint32_t textureHeight{0}; /// @brief Height of the texture drawn to, 0 draws to the window.
+    int32_t order{0}; /// @brief Window views are drawn from the lowest order up, later views cover earlier ones.
+
+    RenderView() = default;
+
+    RenderView(flecs::entity camera, const Rect viewport, const int32_t order = 0)
+        : camera(camera), viewport(viewport), order(order) {}
+
+    RenderView(flecs::entity camera, const uint32_t textureWidth, const uint32_t textureHeight)
+        : camera(camera), textureWidth(textureWidth), textureHeight(textureHeight) {}
+
+    /// @brief Checks whether the view draws into a texture instead of the window.
+    /// @return true if both texture dimensions are set.
+    inline bool IsOffscreen() const
+    {
+        return textureWidth != 0 && textureHeight != 0;
+    }
+};
+
+} // namespace velecs
@@ -12,6 +12,9 @@
 
 #include "velecs/Rendering/SimpleVertex.h"
 #include "velecs/Memory/AllocatedBuffer.h"
+#include "velecs/Math/AABB.h"
+#include "velecs/Rendering/VertexFormat.h"
+#include "velecs/Rendering/Meshlet.h"
 
 #include <vector>
 
@@ -28,11 +31,20 @@ public:
     // Enums
 
     // Public Fields
+
+    static constexpr uint32_t CLUSTERED_TRIANGLE_THRESHOLD = 2048; /// @brief Load splits meshes with at least this many triangles into meshlets.
         
     std::vector<SimpleVertex> _vertices; /// @brief Vertex data of the mesh.
     std::vector<uint32_t> _indices; /// @brief Indices for drawing the mesh.
     AllocatedBuffer _vertexBuffer; /// @brief Allocated buffer for vertex data.
     AllocatedBuffer _indexBuffer; /// @brief Allocated buffer for index data.
+    AABB _bounds; /// @brief Local space bounds of _vertices.
+    VertexFormat _vertexFormat{VertexFormat::Float32}; /// @brief Layout _vertices are uploaded in, chosen by Load.
+    VkIndexType _indexType{VK_INDEX_TYPE_UINT32}; /// @brief Width of _indexBuffer, set when the mesh is uploaded.
+    uint64_t _uploadValue{0}; /// @brief TransferQueue value signaled once the buffers hold the data, set when the mesh is uploaded.
+    std::vector<Meshlet> _meshlets; /// @brief Clusters of _indices culled one by one, empty for meshes drawn whole.
+    AllocatedBuffer _meshletBuffer; /// @brief Allocated buffer for _meshlets, read by the GPU cluster culling pass.
+    bool _coneCulling{false}; /// @brief Also drops meshlets facing away from the camera, only for meshes that are closed or seen from the front.
 
     // Constructors and Destructors
 
@@ -68,6 +80,16 @@ public:
     /// @return True if loading succeeds, false otherwise.
     static bool TryLoad(const std::string& filePath, SimpleMesh*& mesh);
 
+    /// @brief Recomputes _bounds from _vertices.
+    /// @details Must be called after editing _vertices by hand, Load already does it.
+    void RecalculateBounds();
+
+    /// @brief Splits _indices into _meshlets, which the renderer then culls one by one.
+    /// @details Must be called after editing _vertices or _indices of a clustered mesh by hand.
+    /// Clusters are only frustum culled unless _coneCulling is set, SimpleMesh pipelines do not
+    /// cull faces, so dropping back-facing clusters would open holes in open meshes.
+    void BuildMeshlets();
+
 protected:
     // Protected Fields
 
@@ -0,0 +1,29 @@
+/// @file    SkinSlot.h
+/// @author  Matthew Green
+/// @date    2024-01-23 14:10:37
+///
+/// @section LICENSE
+///
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/Rendering/SkinningSystem.h"
+
+#include <cstdint>
+
+namespace velecs {
+
+/// @struct SkinSlot
+/// @brief Slot of an animated entity's posed vertices in the skinning system.
+///
+/// Added by the renderer to every entity with a SkinnedMesh, Animator and Material.
+/// The slot owns the vertex buffer the skinning pass writes the entity's pose into
+/// and the draw reads from. Removing the component frees the slot.
+struct SkinSlot {
+    uint32_t index{SkinningSystem::INVALID_INDEX}; /// @brief Index of the instance in the skinning system.
+};
+
+} // namespace velecs
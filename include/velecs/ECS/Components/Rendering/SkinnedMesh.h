@@ -0,0 +1,98 @@
+/// @file    SkinnedMesh.h
+/// @author  Matthew Green
+/// @date    2024-01-23 12:05:19
+///
+/// @section LICENSE
+///
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/Rendering/SkinnedVertex.h"
+#include "velecs/Animation/Skeleton.h"
+#include "velecs/Animation/AnimationClip.h"
+#include "velecs/Memory/AllocatedBuffer.h"
+#include "velecs/Math/AABB.h"
+
+#include <vulkan/vulkan_core.h>
+
+#include <glm/mat4x4.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace velecs {
+
+/// @struct SkinnedMesh
+/// @brief A mesh whose vertices follow the joints of a skeleton, with the clips that animate it.
+///
+/// The bind pose is uploaded once and only read by the skinning compute pass, which writes
+/// a posed copy for every instance. Put the mesh on a prefab and instantiate it with is_a,
+/// so a crowd shares one bind pose and its clips, and give each instance its own Animator.
+struct SkinnedMesh {
+public:
+    // Enums
+
+    // Public Fields
+
+    static constexpr uint32_t MAX_BONES = 256; /// @brief Bones a mesh may have, SkinnedVertex stores 8-bit bone indices.
+    static constexpr uint32_t BOUNDS_SAMPLES_PER_CLIP = 16; /// @brief Poses of each clip _bounds is computed from.
+
+    std::vector<SkinnedVertex> _vertices; /// @brief Bind pose vertices.
+    std::vector<uint32_t> _indices; /// @brief Indices for drawing the mesh.
+    Skeleton _skeleton; /// @brief Joints and bones the vertices are weighted to.
+    std::vector<AnimationClip> _clips; /// @brief Every animation of the source file, Animator::clip indexes them.
+    AllocatedBuffer _vertexBuffer; /// @brief Storage buffer of the bind pose vertices.
+    AllocatedBuffer _indexBuffer; /// @brief Allocated buffer for index data, shared by every instance.
+    AABB _bounds; /// @brief Local space bounds of the bind pose and of every clip, used for culling.
+    VkIndexType _indexType{VK_INDEX_TYPE_UINT32}; /// @brief Width of _indexBuffer, set when the mesh is uploaded.
+    uint64_t _uploadValue{0}; /// @brief TransferQueue value signaled once the buffers hold the data, set when the mesh is uploaded.
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    SkinnedMesh() = default;
+
+    /// @brief Default deconstructor.
+    ~SkinnedMesh() = default;
+
+    // Public Methods
+
+    /// @brief Loads a rigged mesh and its animations from a file.
+    /// @param filePath Path to the mesh file, relative to the meshes directory.
+    /// @return Loaded SkinnedMesh object.
+    /// @throw std::runtime_error if loading fails, or the mesh has no bones or too many.
+    static SkinnedMesh Load(std::string filePath);
+
+    /// @brief Finds a clip by name.
+    /// @param[in] name Name of the animation in the source file.
+    /// @return The clip index, or UINT32_MAX if there is no such clip.
+    uint32_t FindClip(const std::string& name) const;
+
+    /// @brief Computes the skin matrices of one pose.
+    /// @param[in] clip Index of the clip to sample, the bind pose is used when it is out of range.
+    /// @param[in] time Seconds since the start of the clip.
+    /// @param[out] skinMatrices Room for _skeleton.GetBoneCount() matrices.
+    ///
+    /// Safe to call from several threads at once.
+    void Evaluate(const uint32_t clip, const float time, glm::mat4* skinMatrices) const;
+
+    /// @brief Recomputes _bounds from the bind pose and sampled poses of every clip.
+    /// @details Must be called after editing the vertices, skeleton or clips by hand, Load already does it.
+    void RecalculateBounds();
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    // Private Methods
+};
+
+} // namespace velecs
@@ -50,6 +50,10 @@ public:
     const int height() const;
     const int numChannels() const;
 
+    /// @brief Gets the decoded pixels, always RGBA8 regardless of numChannels().
+    /// @return Pointer to width() * height() * 4 bytes, or nullptr if the sprite is not valid.
+    const unsigned char* data() const;
+
 protected:
     // Protected Fields
 
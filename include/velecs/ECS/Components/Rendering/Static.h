@@ -0,0 +1,24 @@
+/// @file    Static.h
+/// @author  Matthew Green
+/// @date    2024-01-13 10:12:48
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+namespace velecs {
+
+/// @struct Static
+/// @brief Tag for renderable entities that never move after they are spawned.
+///
+/// The renderer merges the geometry of Static entities that share a material into a few
+/// large meshes, one per spatial chunk, the first frame after they appear. From then on
+/// the entity is tagged StaticBatched and its Transform and SimpleMesh are no longer read
+/// for drawing, so moving it has no visible effect.
+struct Static {};
+
+} // namespace velecs
@@ -0,0 +1,22 @@
+/// @file    StaticBatched.h
+/// @author  Matthew Green
+/// @date    2024-01-13 10:14:05
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+namespace velecs {
+
+/// @struct StaticBatched
+/// @brief Tag added by the renderer to Static entities whose geometry lives in a batch.
+///
+/// Batched entities are skipped by the draw and transform systems. Removing the tag
+/// does not remove the geometry from its batch.
+struct StaticBatched {};
+
+} // namespace velecs
@@ -0,0 +1,99 @@
+/// @file    TextLabel.h
+/// @author  Matthew Green
+/// @date    2024-01-22 11:48:03
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/Math/Vec2.h"
+#include "velecs/Graphics/Color32.h"
+#include "velecs/Rendering/GlyphInstance.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace velecs {
+
+/// @struct TextLabel
+/// @brief Text drawn at the entity's Transform with a signed distance field font.
+///
+/// The text is laid out once into glyph quads that the label keeps, and laid out again
+/// only when the text or font changes, or when the font's atlas had to be emptied. Every
+/// visible label of a font is drawn in the same instanced batch, so thousands of labels
+/// cost one draw per font. Fonts are loaded with RenderingECSModule::LoadFont.
+struct TextLabel {
+public:
+    // Enums
+
+    // Public Fields
+
+    static constexpr uint32_t DEFAULT_FONT = 0; /// @brief The first font loaded.
+    static constexpr uint32_t NO_REVISION = UINT32_MAX; /// @brief Marks a layout that was never built.
+
+    /// @struct Layout
+    /// @brief Glyph quads of the text, maintained by the renderer.
+    struct Layout {
+        std::vector<GlyphInstance> glyphs; /// @brief One quad per visible glyph, labelIndex is set when drawn.
+        float width{0.0f}; /// @brief Width of the longest line in ems.
+        float height{0.0f}; /// @brief Height of every line in ems.
+        uint32_t revision{NO_REVISION}; /// @brief Text revision the quads were built from.
+        uint32_t font{DEFAULT_FONT}; /// @brief Font the quads were built with.
+        uint32_t generation{0}; /// @brief Atlas generation the quads were built at.
+    };
+
+    Color32 color{Color32::WHITE}; /// @brief Color of the glyphs, multiplied with their coverage.
+    float size{1.0f}; /// @brief World units per em, about the height of a line.
+    Vec2 pivot{0.5f, 0.5f}; /// @brief Point of the text block placed at the origin, (0, 0) is its bottom left and (1, 1) its top right.
+    uint32_t font{DEFAULT_FONT}; /// @brief Index returned by RenderingECSModule::LoadFont.
+    bool billboard{true}; /// @brief Faces the camera when true, otherwise lies in the XY plane of the Transform.
+    Layout layout; /// @brief Cached layout, maintained by the renderer.
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor, creates an empty label.
+    TextLabel() = default;
+
+    /// @brief Constructor.
+    /// @param[in] text UTF-8 text, '\n' starts a new line.
+    /// @param[in] size World units per em.
+    /// @param[in] color Color of the glyphs.
+    TextLabel(const std::string& text, const float size = 1.0f, const Color32 color = Color32::WHITE);
+
+    /// @brief Default deconstructor.
+    ~TextLabel() = default;
+
+    // Public Methods
+
+    /// @brief Changes the text, the layout is only rebuilt if it differs.
+    /// @param[in] text UTF-8 text, '\n' starts a new line.
+    void SetText(const std::string& text);
+
+    /// @brief Gets the text.
+    /// @return The UTF-8 text.
+    const std::string& GetText() const;
+
+    /// @brief Gets the revision of the text.
+    /// @return A counter incremented every time SetText changes the text.
+    uint32_t GetRevision() const;
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    std::string text; /// @brief UTF-8 text.
+    uint32_t revision{0}; /// @brief Incremented every time the text changes.
+
+    // Private Methods
+};
+
+} // namespace velecs
@@ -0,0 +1,131 @@
+/// @file    Tilemap.h
+/// @author  Matthew Green
+/// @date    2024-01-21 10:22:08
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace velecs {
+
+/// @struct Tilemap
+/// @brief Grid of tile IDs laid out in the XY plane of the entity's Transform.
+///
+/// Tiles are stored in dense CHUNK_SIZE x CHUNK_SIZE chunks. Each chunk counts its edits in
+/// a revision, so the renderer only rebuilds the mesh of a chunk that changed since it was
+/// last built, and draws each visible chunk with a single call. The entity also needs a
+/// Material, typically "Tilemap/Atlas", whose texture is the atlas the tile IDs index into.
+struct Tilemap {
+public:
+    // Enums
+
+    // Public Fields
+
+    static constexpr uint32_t CHUNK_SIZE = 32; /// @brief Tiles along each side of a chunk.
+    static constexpr uint16_t EMPTY_TILE = 0; /// @brief Tile ID that draws nothing, ID n draws atlas cell n - 1.
+
+    /// @struct Chunk
+    /// @brief Tile IDs of one CHUNK_SIZE x CHUNK_SIZE block of the map.
+    struct Chunk {
+        std::array<uint16_t, CHUNK_SIZE * CHUNK_SIZE> tiles{}; /// @brief Tile IDs, row by row from the chunk origin.
+        uint32_t revision{0}; /// @brief Incremented every time a tile of the chunk changes.
+        uint32_t tileCount{0}; /// @brief Number of tiles that are not EMPTY_TILE.
+    };
+
+    float tileSize{1.0f}; /// @brief Side of a tile in local units.
+    uint32_t atlasColumns{1}; /// @brief Cells across the atlas texture of the material.
+    uint32_t atlasRows{1}; /// @brief Cells down the atlas texture of the material.
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor, creates an empty 0x0 map.
+    Tilemap() = default;
+
+    /// @brief Constructor, every tile starts as EMPTY_TILE.
+    /// @param[in] width Map width in tiles.
+    /// @param[in] height Map height in tiles.
+    /// @param[in] tileSize Side of a tile in local units.
+    /// @param[in] atlasColumns Cells across the atlas texture.
+    /// @param[in] atlasRows Cells down the atlas texture.
+    Tilemap
+    (
+        const uint32_t width,
+        const uint32_t height,
+        const float tileSize = 1.0f,
+        const uint32_t atlasColumns = 1,
+        const uint32_t atlasRows = 1
+    );
+
+    /// @brief Default deconstructor.
+    ~Tilemap() = default;
+
+    // Public Methods
+
+    /// @brief Changes one tile, marking its chunk for a rebuild if the ID differs.
+    /// @param[in] x Column of the tile.
+    /// @param[in] y Row of the tile.
+    /// @param[in] tile The new tile ID.
+    /// @throws std::out_of_range if the tile is outside the map.
+    void SetTile(const uint32_t x, const uint32_t y, const uint16_t tile);
+
+    /// @brief Gets one tile.
+    /// @param[in] x Column of the tile.
+    /// @param[in] y Row of the tile.
+    /// @return The tile ID.
+    /// @throws std::out_of_range if the tile is outside the map.
+    uint16_t GetTile(const uint32_t x, const uint32_t y) const;
+
+    /// @brief Sets every tile of the map to the same ID.
+    /// @param[in] tile The new tile ID.
+    void Fill(const uint16_t tile);
+
+    /// @brief Gets the map width in tiles.
+    uint32_t GetWidth() const;
+
+    /// @brief Gets the map height in tiles.
+    uint32_t GetHeight() const;
+
+    /// @brief Gets the number of chunks across the map.
+    uint32_t GetChunkColumns() const;
+
+    /// @brief Gets the number of chunks down the map.
+    uint32_t GetChunkRows() const;
+
+    /// @brief Gets a chunk by its coordinates.
+    /// @param[in] chunkX Column of the chunk.
+    /// @param[in] chunkY Row of the chunk.
+    /// @return The chunk, tiles past the map edge are always EMPTY_TILE.
+    const Chunk& GetChunk(const uint32_t chunkX, const uint32_t chunkY) const;
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    uint32_t width{0}; /// @brief Map width in tiles.
+    uint32_t height{0}; /// @brief Map height in tiles.
+    uint32_t chunkColumns{0}; /// @brief Chunks across the map.
+    uint32_t chunkRows{0}; /// @brief Chunks down the map.
+    std::vector<Chunk> chunks; /// @brief Chunks row by row.
+
+    // Private Methods
+
+    /// @brief Throws if a tile is outside the map.
+    /// @param[in] x Column of the tile.
+    /// @param[in] y Row of the tile.
+    /// @throws std::out_of_range if the tile is outside the map.
+    void CheckBounds(const uint32_t x, const uint32_t y) const;
+};
+
+} // namespace velecs
@@ -0,0 +1,29 @@
+/// @file    TransformSlot.h
+/// @author  Matthew Green
+/// @date    2024-01-12 09:41:26
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/Rendering/TransformBuffer.h"
+
+#include <cstdint>
+
+namespace velecs {
+
+/// @struct TransformSlot
+/// @brief Slot of a renderable entity in the persistent GPU transform buffer.
+///
+/// Added by the renderer to every entity with a Transform, SimpleMesh and Material.
+/// The slot keeps the entity's world matrix on the GPU between frames and is only
+/// rewritten when the matrix changes. Removing the component frees the slot.
+struct TransformSlot {
+    uint32_t index{TransformBuffer::INVALID_INDEX}; /// @brief Index of the world matrix in the transform buffer.
+};
+
+} // namespace velecs
@@ -16,8 +16,40 @@
 #include "velecs/Memory/UploadContext.h"
 #include "velecs/Memory/AllocatedImage.h"
 
+#include "velecs/Rendering/DeviceCapabilities.h"
+#include "velecs/Rendering/BindlessTable.h"
+#include "velecs/Rendering/OcclusionBuffer.h"
+#include "velecs/Rendering/DynamicResolution.h"
+#include "velecs/Rendering/DrawPacket.h"
+#include "velecs/Rendering/RenderSnapshot.h"
+#include "velecs/Rendering/RenderStats.h"
+#include "velecs/Rendering/RenderStatsLog.h"
+#include "velecs/Rendering/RenderThread.h"
+#include "velecs/Rendering/TransformBuffer.h"
+#include "velecs/Rendering/StaticBatcher.h"
+#include "velecs/Rendering/TransferQueue.h"
+#include "velecs/Rendering/FrameCapture.h"
+#include "velecs/Rendering/DescriptorAllocator.h"
+#include "velecs/Rendering/DescriptorLayoutCache.h"
+#include "velecs/Rendering/DynamicRingBuffer.h"
+#include "velecs/Rendering/TextureData.h"
+#include "velecs/Rendering/ParticleSystem.h"
+#include "velecs/Rendering/TilemapRenderer.h"
+#include "velecs/Rendering/TextRenderer.h"
+#include "velecs/Rendering/SkinningSystem.h"
+#include "velecs/Rendering/MeshletCuller.h"
+#include "velecs/Rendering/DynamicBatcher.h"
+#include "velecs/Rendering/ShaderVariantCache.h"
+#include "velecs/Rendering/SimpleMeshFeatures.h"
+#include "velecs/Rendering/RenderTargetPool.h"
+#include "velecs/Rendering/ImpostorBaker.h"
+#include "velecs/Rendering/ImpostorInstance.h"
+
+#include "velecs/Core/ThreadPool.h"
+
 #include "velecs/Math/Vec2.h"
 #include "velecs/Math/Vec3.h"
+#include "velecs/Math/Frustum.h"
 
 #include "velecs/ECS/Components/Rendering/Transform.h"
 #include "velecs/ECS/Components/Rendering/Mesh.h"
@@ -26,6 +58,19 @@
 #include "velecs/ECS/Components/Rendering/PerspectiveCamera.h"
 #include "velecs/ECS/Components/Rendering/OrthoCamera.h"
 #include "velecs/ECS/Components/Rendering/MainCamera.h"
+#include "velecs/ECS/Components/Rendering/Occluder.h"
+#include "velecs/ECS/Components/Rendering/TransformSlot.h"
+#include "velecs/ECS/Components/Rendering/Static.h"
+#include "velecs/ECS/Components/Rendering/StaticBatched.h"
+#include "velecs/ECS/Components/Rendering/ParticleEmitter.h"
+#include "velecs/ECS/Components/Rendering/Tilemap.h"
+#include "velecs/ECS/Components/Rendering/TextLabel.h"
+#include "velecs/ECS/Components/Rendering/SkinnedMesh.h"
+#include "velecs/ECS/Components/Rendering/Animator.h"
+#include "velecs/ECS/Components/Rendering/SkinSlot.h"
+#include "velecs/ECS/Components/Rendering/RenderView.h"
+#include "velecs/ECS/Components/Rendering/RenderTargetSlot.h"
+#include "velecs/ECS/Components/Rendering/Impostor.h"
 
 #include <vulkan/vulkan.h>
 
@@ -34,6 +79,9 @@
 #include <VkBootstrap.h>
 
 #include <vector>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 
 #include <imgui.h>
 
@@ -88,6 +136,78 @@ public:
 
     static flecs::entity GetMainCameraEntity(flecs::world& ecs);
 
+    /// @brief Loads a texture from disk and registers it in the bindless texture array.
+    /// @param[in] filePath A baked `.vtex` file, or any image stb_image can decode.
+    /// @return The slot to store in Material::textureIndex.
+    /// @throws std::runtime_error if the file cannot be read or uploaded.
+    ///
+    /// Baked files are uploaded with the mips and format they were baked with. Other
+    /// images are decoded to RGBA8 and get their mip chain generated on the GPU.
+    uint32_t LoadTexture(const std::string& filePath);
+
+    /// @brief Uploads a texture through a staging buffer and registers it in the bindless texture array.
+    /// @param[in] texture The texture to upload, its levels are copied as they are.
+    /// @return The slot to store in Material::textureIndex.
+    /// @throws std::runtime_error if the device cannot sample the texture's format.
+    ///
+    /// A texture with only its base level gets a full mip chain, blitted on the GPU when the
+    /// format supports linear blits and box filtered on the CPU otherwise.
+    uint32_t UploadTexture(const TextureData& texture);
+
+    /// @brief Creates a Material drawn by the SimpleMesh shader variant with the given features.
+    /// @param[in] path The unique path for the new material entity.
+    /// @param[in] features SimpleMeshFeatures bits the variant enables.
+    /// @param[in] color The color of the material, read with SimpleMeshFeatures::MATERIAL_COLOR.
+    /// @param[in] textureIndex Slot returned by LoadTexture or UploadTexture, read with SimpleMeshFeatures::TEXTURED.
+    /// @return const Material* const A pointer to the newly created Material component.
+    /// @throws std::runtime_error if the variant cannot be built.
+    ///
+    /// Materials with the same features share one pipeline, built the first time it is requested.
+    /// Features left out are compiled out, so a material only pays for what it uses.
+    const Material* const CreateSimpleMeshMaterial
+    (
+        const std::string& path,
+        const uint32_t features,
+        const Color32 color = Color32::MAGENTA,
+        const uint32_t textureIndex = BindlessTable::DEFAULT_TEXTURE_INDEX
+    );
+
+    /// @brief Loads a font whose glyphs TextLabels draw as signed distance fields.
+    /// @param[in] filePath A .ttf or .otf file.
+    /// @return The index to store in TextLabel::font, the first font loaded is TextLabel::DEFAULT_FONT.
+    /// @throws std::runtime_error if the file cannot be read or is not a font.
+    ///
+    /// Only the empty atlas is created here, glyphs are rasterized the first time a label uses them.
+    uint32_t LoadFont(const std::string& filePath);
+
+    /// @brief Bakes the impostor atlases of a mesh and registers them.
+    /// @param[in] mesh The mesh, in the local space its entities are drawn from.
+    /// @param[in] frameCount Number of angles to bake around the mesh's Y axis.
+    /// @param[in] frameSize Side of one frame in texels.
+    /// @return The index to store in Impostor::atlas.
+    /// @throws std::runtime_error if the mesh has no triangles.
+    ///
+    /// Baking runs on the calling thread, see ImpostorBaker. Call it once per mesh and
+    /// share the index between every entity drawing that mesh.
+    uint32_t BakeImpostor
+    (
+        const SimpleMesh& mesh,
+        const uint32_t frameCount = ImpostorBaker::DEFAULT_FRAME_COUNT,
+        const uint32_t frameSize = ImpostorBaker::DEFAULT_FRAME_SIZE
+    );
+
+    /// @brief Uploads atlases baked earlier, at build time for example, and registers them.
+    /// @param[in] baked The atlases and their layout.
+    /// @return The index to store in Impostor::atlas.
+    uint32_t RegisterImpostor(const ImpostorBaker::Result& baked);
+
+    /// @brief Sets the largest SimpleMesh merged into a dynamic batch instead of drawn on its own.
+    /// @param[in] vertexThreshold Vertex count of the largest batched mesh, 0 turns dynamic batching off.
+    ///
+    /// Batched meshes are transformed to world space on the CPU every frame, which only pays
+    /// off for small meshes, see DynamicBatcher.
+    void SetDynamicBatchThreshold(const uint32_t vertexThreshold);
+
     const Rect RenderingECSModule::GetWindowExtent() const;
 
 protected:
@@ -105,12 +225,18 @@ private:
     SDL_Window* _window{nullptr}; /// @brief Pointer to the SDL window structure.
 
     VkExtent2D windowExtent{1700, 900}; /// @brief Desired dimensions of the rendering window.
+    VkExtent2D renderExtent{1700, 900}; /// @brief Area of the scene target drawn to this frame, windowExtent unless dynamic resolution is enabled.
 
     VkInstance _instance{VK_NULL_HANDLE}; /// @brief Handle to the Vulkan library.
     VkDebugUtilsMessengerEXT _debug_messenger{VK_NULL_HANDLE}; /// @brief Handle for Vulkan debug messaging.
     VkPhysicalDevice _chosenGPU{VK_NULL_HANDLE}; /// @brief The chosen GPU for rendering operations.
     VkDevice _device{VK_NULL_HANDLE}; /// @brief Handle to the Vulkan device.
     VkSurfaceKHR _surface{VK_NULL_HANDLE}; /// @brief Handle to the Vulkan window surface.
+    DeviceCapabilities capabilities; /// @brief Optional features enabled on _device.
+    PFN_vkCmdBeginRenderingKHR cmdBeginRendering{nullptr}; /// @brief Loaded when capabilities.dynamicRendering is set.
+    PFN_vkCmdEndRenderingKHR cmdEndRendering{nullptr};
+    PFN_vkCmdPipelineBarrier2KHR cmdPipelineBarrier2{nullptr};
+    PFN_vkQueueSubmit2KHR queueSubmit2{nullptr};
 
     VkSwapchainKHR _swapchain{VK_NULL_HANDLE}; /// @brief Handle to the Vulkan swapchain.
     VkFormat _swapchainImageFormat{VK_FORMAT_UNDEFINED}; /// @brief The format used for swapchain images.
@@ -119,12 +245,33 @@ private:
     uint32_t swapchainImageIndex{0};
 
     VkQueue _graphicsQueue{VK_NULL_HANDLE}; /// @brief Queue used for submitting graphics commands.
+    std::mutex queueMutex; /// @brief Guards submissions to _graphicsQueue, which come from both the simulation and the render thread.
     uint32_t _graphicsQueueFamily{0}; /// @brief Index of the queue family for graphics operations.
+    VkQueue transferQueue{VK_NULL_HANDLE}; /// @brief Dedicated transfer queue, or _graphicsQueue when the device has none.
+    uint32_t transferQueueFamily{0}; /// @brief Index of the queue family of transferQueue.
+    TransferQueue uploadQueue; /// @brief Streams mesh data without blocking the simulation or the frame submission.
     VkCommandPool _commandPool{VK_NULL_HANDLE}; /// @brief Pool for allocating command buffers.
     VkCommandBuffer _mainCommandBuffer{VK_NULL_HANDLE}; /// @brief Main command buffer for recording rendering commands.
 
-    VkRenderPass _renderPass{VK_NULL_HANDLE}; /// @brief Handle to the Vulkan render pass.
-    std::vector<VkFramebuffer> _framebuffers; /// @brief List of framebuffers for rendering.
+    VkRenderPass _renderPass{VK_NULL_HANDLE}; /// @brief Handle to the Vulkan render pass, null under dynamic rendering.
+    std::vector<VkFramebuffer> _framebuffers; /// @brief List of framebuffers for rendering, empty under dynamic rendering.
+
+    VkRenderPass sceneRenderPass{VK_NULL_HANDLE}; /// @brief Renders the scene into sceneColorImage and leaves it ready to blit.
+    VkRenderPass compositeRenderPass{VK_NULL_HANDLE}; /// @brief Draws ImGui over the upscaled scene already copied into the swapchain image.
+    AllocatedImage sceneColorImage; /// @brief Window sized offscreen color target, only the renderExtent corner is used.
+    VkImageView sceneColorImageView{VK_NULL_HANDLE};
+    VkFramebuffer sceneFramebuffer{VK_NULL_HANDLE};
+    bool renderingToSceneTarget{false}; /// @brief Whether the frame being recorded draws the scene into sceneColorImage.
+    VkRenderPass offscreenRenderPass{VK_NULL_HANDLE}; /// @brief Draws a RenderView into its texture and leaves it ready to sample.
+
+    bool dynamicResolutionEnabled{false}; /// @brief Toggled by the simulation, applied to dynamicResolution by the render thread.
+    DynamicResolution dynamicResolution; /// @brief Chooses renderExtent from the measured GPU frame time.
+    VkQueryPool timestampQueryPool{VK_NULL_HANDLE}; /// @brief Start and end timestamps of the frame in flight.
+    bool timestampsWritten{false}; /// @brief Whether the last submitted frame wrote both timestamps.
+    VkQueryPool pipelineStatisticsQueryPool{VK_NULL_HANDLE}; /// @brief Vertex, clipping and fragment invocations of the main and offscreen views in flight.
+    bool pipelineStatisticsWritten{false}; /// @brief Whether the last submitted frame ended its pipeline statistics queries.
+
+    FrameCapture frameCapture; /// @brief Screenshots and recordings, read back without stalling the render thread.
 
     VkSemaphore _presentSemaphore{VK_NULL_HANDLE}, _renderSemaphore{VK_NULL_HANDLE}; /// @brief Semaphore for synchronizing image presentation.
     VkFence _renderFence{VK_NULL_HANDLE}; /// @brief Fence for synchronizing rendering operations.
@@ -136,13 +283,43 @@ private:
 
     VkPipelineLayout _trianglePipelineLayout{VK_NULL_HANDLE}; /// @brief Handle to the pipeline layout.
     VkPipeline _triangleWireFramePipeline{VK_NULL_HANDLE}; /// @brief Handle to the pipeline.
-    VkPipeline _rainbowSimpleMeshPipeline{VK_NULL_HANDLE}; /// @brief Handle to the pipeline.
 
     VkPipelineLayout _meshPipelineLayout{VK_NULL_HANDLE};
     VkPipeline _meshPipeline{VK_NULL_HANDLE};
 
     VkPipelineLayout simpleMeshPipelineLayout{VK_NULL_HANDLE};
-    VkPipeline simpleMeshPipeline{VK_NULL_HANDLE};
+    ShaderVariantCache simpleMeshVariants; /// @brief SimpleMesh.vert and SimpleMesh.frag specialized per SimpleMeshFeatures and VertexFormat.
+
+    VkPipelineLayout particlePipelineLayout{VK_NULL_HANDLE};
+    VkPipeline particlePipeline{VK_NULL_HANDLE}; /// @brief Alpha blended billboards read from particleSystem, no vertex input.
+
+    VkPipelineLayout tilemapPipelineLayout{VK_NULL_HANDLE};
+    VkPipeline tilemapPipeline{VK_NULL_HANDLE}; /// @brief Atlas textured TileVertex chunks, behind the "Tilemap/Atlas" material.
+
+    VkPipelineLayout textPipelineLayout{VK_NULL_HANDLE};
+    VkPipeline textPipeline{VK_NULL_HANDLE}; /// @brief Alpha blended SDF glyph quads read from textRenderer, no vertex input.
+
+    VkPipelineLayout impostorPipelineLayout{VK_NULL_HANDLE};
+    VkPipeline impostorPipeline{VK_NULL_HANDLE}; /// @brief Alpha tested billboards read from the frame ring, no vertex input.
+    bool warnedImpostorsDropped{false}; /// @brief Whether running out of frame ring space for impostors was already reported, render thread only.
+
+    VkPipelineLayout debugLinePipelineLayout{VK_NULL_HANDLE};
+    VkPipeline debugLinePipeline{VK_NULL_HANDLE}; /// @brief Alpha blended DebugVertex line list, depth tested without writing depth.
+
+    /// @brief Maps each SimpleVertex pipeline to its twin reading QuantizedSimpleVertex.
+    /// @details Filled by GetSimpleMeshVariant.
+    std::unordered_map<VkPipeline, VkPipeline> quantizedPipelineVariants;
+
+    /// @brief Maps every SimpleMesh pipeline to its twin with SimpleMeshFeatures::DITHER_FADE.
+    /// @details Filled by GetSimpleMeshVariant, for both vertex formats.
+    std::unordered_map<VkPipeline, VkPipeline> fadePipelineVariants;
+
+    /// @brief Maps every SimpleMesh pipeline to its SimpleMeshFeatures bits.
+    /// @details Filled by GetSimpleMeshVariant, for both vertex formats.
+    std::unordered_map<VkPipeline, uint32_t> simpleMeshPipelineFeatures;
+
+    std::vector<ImpostorAtlas> impostorAtlases; /// @brief Registered atlases, indexed by Impostor::atlas.
+    std::vector<std::vector<ImpostorInstance>> pendingImpostors; /// @brief This tick's visible impostors per atlas, flattened into the snapshot in PostDraw.
 
     UploadContext _uploadContext;
 
@@ -156,6 +333,56 @@ private:
 
     VkDescriptorPool imguiPool{VK_NULL_HANDLE};
 
+    DescriptorLayoutCache descriptorLayoutCache; /// @brief Descriptor set layouts shared by every subsystem, one per distinct binding list.
+    DescriptorAllocator descriptorAllocator; /// @brief Sets that live as long as the renderer, allocated on the simulation thread.
+    DescriptorAllocator frameDescriptorAllocator; /// @brief Sets used by a single frame, reset by the render thread once that frame's fence signals.
+    DynamicRingBuffer frameRing; /// @brief Per-frame shader data read through dynamic offsets, rewound once the frame's fence signals.
+    uint32_t frameUniformsOffset{0}; /// @brief Offset of the FrameUniforms of the view being recorded in frameRing.
+    std::vector<uint32_t> viewUniformOffsets; /// @brief Offset of the FrameUniforms of every view of the frame being recorded.
+    VkRect2D viewArea{}; /// @brief Viewport and scissor of the view being recorded.
+    VkClearValue viewClearValues[2]{}; /// @brief Color and depth every view of the frame being recorded is cleared to.
+
+    std::shared_ptr<BindlessTable> bindlessTable; /// @brief Texture array and material buffer shared by every pipeline.
+    std::shared_ptr<TransformBuffer> transformBuffer; /// @brief Persistent world matrices of every renderable, read by the vertex shaders.
+    ParticleSystem particleSystem; /// @brief Particles of every ParticleEmitter, simulated and drawn without reading them back.
+    flecs::query<const Transform, ParticleEmitter> emitterQuery; /// @brief Matches every entity with a ParticleEmitter.
+    TilemapRenderer tilemapRenderer; /// @brief Chunk meshes of every Tilemap, rebuilt when their tiles change.
+    flecs::query<const Tilemap, Material, const TransformSlot> tilemapQuery; /// @brief Matches every Tilemap ready to draw.
+    TextRenderer textRenderer; /// @brief Glyph atlases of every loaded font and the batches of every TextLabel.
+    flecs::query<const Transform, TextLabel> textQuery; /// @brief Matches every TextLabel.
+    std::shared_ptr<SkinningSystem> skinningSystem; /// @brief Posed vertex buffers of every animated entity, written by a compute pass.
+    flecs::query<SkinnedMesh, const Animator, Material, const TransformSlot, const SkinSlot> skinnedQuery; /// @brief Matches every animated entity ready to draw.
+    MeshletCuller meshletCuller; /// @brief Culls the meshlets of clustered meshes, on the CPU or in a compute pass.
+    DynamicBatcher dynamicBatcher; /// @brief Merges small visible meshes sharing a material into one draw per frame.
+    uint32_t batchTransformIndex{TransformBuffer::INVALID_INDEX}; /// @brief Identity slot in transformBuffer, the batches are already in world space.
+    AllocatedBuffer debugLineBuffer; /// @brief Lines collected from DebugDraw, rewritten by the render thread every frame.
+    void* mappedDebugLines{nullptr};
+    VkDeviceSize debugLineCapacity{0};
+    std::vector<AllocatedBuffer> retiredBuffers; /// @brief Buffers the last rendered frame was the last to read, freed once its fence signals.
+    AllocatedImage defaultTexture; /// @brief 1x1 white texture in the BindlessTable::DEFAULT_TEXTURE_INDEX slot.
+    VkImageView defaultTextureView{VK_NULL_HANDLE};
+
+    ThreadPool threadPool; /// @brief Worker threads for CPU side rendering work.
+    OcclusionBuffer occlusionBuffer; /// @brief Software depth buffer filled with Occluder meshes each frame.
+    flecs::query<const Transform, const SimpleMesh> occluderQuery; /// @brief Matches every entity tagged Occluder.
+    flecs::query<const Transform, const SimpleMesh, const Material> staticQuery; /// @brief Matches every Static entity not merged into a batch yet.
+    bool occlusionCullingEnabled{true}; /// @brief Skips drawing objects hidden behind occluders when true.
+    uint32_t occludedCount{0}; /// @brief Objects culled by the occlusion buffer this frame.
+    bool gpuClusterCullingEnabled{false}; /// @brief Culls meshlets in a compute pass and draws them indirectly when true, on the CPU otherwise.
+    uint32_t culledClusterCount{0}; /// @brief Meshlets culled on the CPU this frame, the GPU path does not read its result back.
+
+    static constexpr size_t MAX_VIEWS = 32; /// @brief Views a frame draws, one bit each in a visibility mask.
+    std::shared_ptr<RenderTargetPool> renderTargets; /// @brief Textures RenderViews draw into, pooled by size.
+    flecs::query<const RenderView> viewQuery; /// @brief Matches every RenderView.
+    std::vector<Frustum> viewFrusta; /// @brief Frustum of every view in this tick's snapshot, in the same order.
+    bool mainViewPerspective{false}; /// @brief Whether the main view of this tick is drawn by a PerspectiveCamera, the only kind occlusion culls.
+
+    RenderThread renderThread; /// @brief Records and submits the snapshot of the previous tick while the next one simulates.
+    mutable std::mutex renderStatsMutex; /// @brief Guards renderStats.
+    RenderStats renderStats; /// @brief Written by the render thread after every frame, shown by DisplayFPSCounter.
+    RenderStats recordedStats; /// @brief Counted by the render thread while it records a frame, copied into renderStats at the end.
+    RenderStatsLog renderStatsLog; /// @brief Writes renderStats to CSV every frame while toggled on.
+
     // Private Methods
 
     void InitWindow();
@@ -180,32 +407,109 @@ private:
     /// It is called by the Init method during engine initialization.
     void InitCommands();
 
+    /// @brief Initializes uploadQueue on transferQueue.
+    void InitUploadQueue();
+
     /// @brief Initializes the default render pass used for rendering.
     ///
     /// This method sets up the render pass which defines how rendering operations are handled.
     /// It is called by the Init method during engine initialization.
+    /// Does nothing under dynamic rendering, where attachments are given when recording.
     void InitDefaultRenderPass();
 
     /// @brief Initializes framebuffers used for rendering.
     ///
     /// This method sets up the framebuffers which hold references to the images used in rendering.
     /// It is called by the Init method during engine initialization.
+    /// Does nothing under dynamic rendering, so a resize only rebuilds the swapchain and images.
     void InitFrameBuffers();
 
     void CleanupFrameBuffers();
 
+    /// @brief Creates the offscreen color image and framebuffer the scene is drawn to under dynamic resolution.
+    ///
+    /// The target always matches the window, each frame only renders into its top-left renderExtent,
+    /// so changing the scale never reallocates. It shares the depth image with the swapchain framebuffers.
+    void InitSceneTarget();
+
+    void CleanupSceneTarget();
+
     /// @brief Initializes synchronization structures used for rendering.
     ///
     /// This method sets up semaphores and fences used to synchronize rendering operations.
     /// It is called by the Init method during engine initialization.
     void InitSyncStructures();
 
+    /// @brief Initializes the descriptor layout cache, the descriptor allocators and frameRing.
+    ///
+    /// It must run before any subsystem that allocates descriptor sets or asks for a shared layout.
+    void InitDescriptors();
+
+    /// @brief Initializes the bindless texture and material table.
+    ///
+    /// This method creates the BindlessTable and uploads the default white texture into its first slot.
+    /// It must run after InitSyncStructures, since the upload goes through ImmediateSubmit, and before
+    /// InitPipelines, since every pipeline layout includes the table's descriptor set layout.
+    void InitBindlessTable();
+
+    /// @brief Initializes the persistent transform buffer.
+    ///
+    /// It must run before InitPipelines, since every pipeline layout includes the buffer's descriptor set layout.
+    void InitTransformBuffer();
+
+    /// @brief Initializes the particle buffers and the simulation pipeline.
+    ///
+    /// It must run after InitDescriptors and before InitPipelines, since the billboard pipeline layout
+    /// includes the particle set layout. Defining VELECS_CPU_PARTICLES simulates on the CPU instead.
+    void InitParticles();
+
+    /// @brief Initializes the tilemap renderer and starts uploading its shared index buffer.
+    ///
+    /// It must run after InitUploadQueue, since every chunk mesh is streamed through uploadQueue.
+    void InitTilemaps();
+
+    /// @brief Initializes the text renderer.
+    ///
+    /// It must run after InitDescriptors and before InitPipelines, since the text pipeline layout
+    /// includes the text renderer's set layout.
+    void InitText();
+
+    /// @brief Initializes the skinning system and its compute pipeline.
+    ///
+    /// It must run after InitDescriptors, since the skinning set layout is created through descriptorLayoutCache.
+    void InitSkinning();
+
+    /// @brief Initializes the meshlet culler and its compute pipeline.
+    ///
+    /// It must run after InitDescriptors, since the culling set layout is created through descriptorLayoutCache.
+    void InitMeshlets();
+
+    /// @brief Initializes the dynamic batcher and its identity transform.
+    ///
+    /// It must run after InitTransformBuffer, since the batches draw with a slot of transformBuffer.
+    void InitDynamicBatching();
+
+    /// @brief Frees the debug line buffer on shutdown, it is created by the first frame with lines.
+    void InitDebugDraw();
+
+    /// @brief Initializes the pool of textures RenderViews draw into.
+    ///
+    /// It must run after InitDefaultRenderPass and InitBindlessTable, targets are created for offscreenRenderPass
+    /// and registered in the bindless texture array.
+    void InitRenderTargets();
+
     /// @brief Initializes the rendering pipelines by loading shader modules.
     ///
     /// This method loads the shader modules necessary for rendering, including a vertex shader and a fragment shader for rendering triangles.
     /// It leverages the load_shader_module method to load SPIR-V compiled shaders from file, and reports any errors encountered during the loading process.
     void InitPipelines();
 
+    /// @brief Gets the SimpleVertex pipeline of a SimpleMesh variant and registers its QuantizedSimpleVertex twin.
+    /// @param[in] features SimpleMeshFeatures bits the variant enables.
+    /// @return Pointer to the pipeline, valid until simpleMeshVariants is cleaned up.
+    /// @throws std::runtime_error if the variant cannot be built.
+    VkPipeline* GetSimpleMeshVariant(const uint32_t features);
+
     /// @brief Initializes the ImGUI user interface.
     ///
     /// This method sets up ImGUI which is used for rendering the user interface.
@@ -214,23 +518,218 @@ private:
 
     void CleanupImGui();
 
+    /// @brief Starts the ImGui frame on the simulation thread.
     void PreDrawStep(float deltaTime);
 
+    /// @brief Finishes the ImGui frame and publishes the extracted snapshot to the render thread.
     void PostDrawStep(float deltaTime);
 
-    void BindPipeline(const Material& material);
+    /// @brief Records and submits one frame, runs on the render thread.
+    /// @param[in] snapshot The render state extracted by the simulation.
+    void RenderFrame(RenderSnapshot& snapshot);
+
+    /// @brief Waits for the previous frame, acquires a swapchain image, draws the texture views and begins the scene render pass or rendering scope.
+    /// @param[in] snapshot The render state extracted by the simulation.
+    void BeginFrame(const RenderSnapshot& snapshot);
+
+    /// @brief Composites ImGui, submits the command buffer and presents.
+    /// @param[in] snapshot The render state extracted by the simulation.
+    void EndFrame(RenderSnapshot& snapshot);
+
+    /// @brief Ends the scene, blits it when scaled and draws ImGui, all without render pass objects.
+    /// @param[in] snapshot The render state extracted by the simulation.
+    ///
+    /// Leaves the swapchain image in VK_IMAGE_LAYOUT_PRESENT_SRC_KHR, like compositeRenderPass and _renderPass do.
+    void CompositeWithDynamicRendering(RenderSnapshot& snapshot);
+
+    /// @brief Begins dynamic rendering into one color attachment and, optionally, the depth image.
+    /// @param[in] colorView The color attachment, in VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL.
+    /// @param[in] colorClear Clear value of the color attachment, nullptr loads its contents instead.
+    /// @param[in] depthView The depth attachment, cleared and not stored, VK_NULL_HANDLE for none.
+    /// @param[in] extent The render area.
+    void BeginRendering(VkImageView colorView, const VkClearValue* colorClear, VkImageView depthView, const VkExtent2D extent);
+
+    /// @brief Records synchronization2 image barriers into _mainCommandBuffer.
+    /// @param[in] barriers The barriers to record.
+    /// @param[in] count Number of barriers in @p barriers.
+    void RecordImageBarriers(const VkImageMemoryBarrier2KHR* barriers, const uint32_t count);
+
+    /// @brief Pushes the FrameUniforms of every view of the snapshot into frameRing.
+    /// @param[in] snapshot The render state extracted by the simulation.
+    void PushViewUniforms(const RenderSnapshot& snapshot);
+
+    /// @brief Draws every view that renders into a texture, before the scene pass begins.
+    /// @param[in] snapshot The render state extracted by the simulation.
+    ///
+    /// Leaves every target in VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL for the scene to sample.
+    void DrawOffscreenViews(const RenderSnapshot& snapshot);
+
+    /// @brief Draws the window views of the snapshot into the scene pass, from the lowest order up.
+    /// @param[in] snapshot The render state extracted by the simulation.
+    ///
+    /// Each view after the first clears its own rectangle, so it covers what was drawn below it.
+    void DrawWindowViews(const RenderSnapshot& snapshot);
+
+    /// @brief Draws the packets of one view with its FrameUniforms into viewArea.
+    /// @param[in] snapshot The render state extracted by the simulation.
+    /// @param[in] viewIndex Index of the view in RenderSnapshot::views.
+    void DrawView(const RenderSnapshot& snapshot, const uint32_t viewIndex);
+
+    /// @brief Sets viewArea to a view's rectangle of a target.
+    /// @param[in] view The view.
+    /// @param[in] extent Size of the target the view draws into.
+    /// @return false if the rectangle is empty, nothing may be drawn then.
+    bool SetViewArea(const ViewPacket& view, const VkExtent2D extent);
+
+    /// @brief Appends the main camera and every RenderView to this tick's snapshot and computes their frusta.
+    /// @param[in] ecs The ECS world holding the cameras and views.
+    /// @throws std::runtime_error if the main camera has no PerspectiveCamera or OrthoCamera.
+    void ExtractViews(flecs::world& ecs);
+
+    /// @brief Computes the view-projection matrix of a camera entity.
+    /// @param[in] camera Entity with a Transform and a PerspectiveCamera or OrthoCamera.
+    /// @param[out] viewProjection Receives the matrix.
+    /// @param[out] position Receives the world space position of the camera.
+    /// @param[out] perspective Receives whether the camera is a PerspectiveCamera.
+    /// @return false if the entity is not a camera.
+    static bool GetViewProjection(const flecs::entity camera, glm::mat4& viewProjection, glm::vec3& position, bool& perspective);
+
+    /// @brief Rebuilds the occlusion buffer from every Occluder seen by the main camera.
+    /// @param[in] ecs The ECS world holding the occluders and the main camera.
+    void RasterizeOccluders(flecs::world& ecs);
+
+    /// @brief Merges every Static entity matched by staticQuery into per material, per chunk batch entities.
+    /// @param[in] ecs The ECS world holding the static entities.
+    ///
+    /// Sources are tagged StaticBatched. Batches are plain renderables without the Static tag,
+    /// so they get a transform slot and are drawn and culled like any other entity.
+    void BakeStaticBatches(flecs::world& ecs);
 
-    void Draw
+    /// @brief Turns every ParticleEmitter into the ParticleEmitterParams of this frame's snapshot.
+    /// @param[in] ecs The ECS world holding the emitters and the main camera.
+    /// @param[in] deltaTime Seconds since the last frame.
+    void ExtractParticleEmitters(flecs::world& ecs, const float deltaTime);
+
+    /// @brief Draws the particles written by this frame's simulation step.
+    /// @param[in] snapshot The render state extracted by the simulation.
+    void DrawParticles(const RenderSnapshot& snapshot);
+
+    /// @brief Appends one draw packet per visible chunk of every Tilemap, rebuilding the chunks that changed.
+    /// @param[in] ecs The ECS world holding the tilemaps and the main camera.
+    void ExtractTilemaps(flecs::world& ecs);
+
+    /// @brief Appends every visible TextLabel to this frame's text batches, laying out the ones whose text changed.
+    /// @param[in] ecs The ECS world holding the labels and the main camera.
+    void ExtractText(flecs::world& ecs);
+
+    /// @brief Samples the clip of every visible animated entity and appends its skinning dispatch and draw packet.
+    /// @param[in] ecs The ECS world holding the animated entities and the main camera.
+    ///
+    /// Clips are sampled on threadPool, each instance writes its own range of skin matrices.
+    void ExtractSkinnedMeshes(flecs::world& ecs);
+
+    /// @brief Draws the text batches of the frame.
+    /// @param[in] snapshot The render state extracted by the simulation.
+    void DrawTextLabels(const RenderSnapshot& snapshot);
+
+    /// @brief Copies the frame's debug lines into debugLineBuffer, growing it when they do not fit.
+    /// @param[in] vertices The lines collected from DebugDraw, two vertices each.
+    ///
+    /// The buffer is reused every frame, the frame that last read it has retired by the time BeginFrame runs.
+    void UploadDebugLines(const std::vector<DebugVertex>& vertices);
+
+    /// @brief Draws the debug lines of the frame over the main view with one line list draw.
+    /// @param[in] snapshot The render state extracted by the simulation.
+    void DrawDebugLines(const RenderSnapshot& snapshot);
+
+    /// @brief Appends an impostor of a SimpleMesh entity to this tick's batches.
+    /// @param[in] atlasIndex Index of the entity's atlas in impostorAtlases.
+    /// @param[in] world World matrix of the entity.
+    /// @param[in] cameraPosition World space position of the main camera.
+    /// @param[in] color Tint of the albedo, white unless the mesh draws with its material color.
+    /// @param[in] fade Share of the dithered pixels the impostor covers.
+    void AddImpostor(const uint32_t atlasIndex, const glm::mat4& world, const glm::vec3& cameraPosition, const glm::vec4& color, const float fade);
+
+    /// @brief Draws the impostor batches of the frame through the main view.
+    /// @param[in] snapshot The render state extracted by the simulation.
+    void DrawImpostors(const RenderSnapshot& snapshot);
+
+    /// @brief Destroys every buffer in @p buffers and empties it.
+    /// @param[in,out] buffers Buffers no frame reads anymore.
+    void DestroyBuffers(std::vector<AllocatedBuffer>& buffers);
+
+    /// @brief Reads the GPU time of the previous frame and updates dynamicResolution with it.
+    void UpdateRenderScale();
+
+    /// @brief Reads the invocation counts of the previous frame into recordedStats.
+    void ReadPipelineStatistics();
+
+    void BindPipeline(const VkPipeline pipeline, const VkPipelineLayout pipelineLayout);
+
+    /// @brief Sets the viewport and scissor to viewArea.
+    void SetRenderArea();
+
+    /// @brief Takes the bindless material record matching a material's current values.
+    /// @param[in] material The material, its record is released when its values changed.
+    /// @return The record to store in Material::materialIndex.
+    uint32_t AcquireMaterialIndex(const Material& material);
+
+    /// @brief Copies the world space axes of the main camera into the snapshot.
+    /// @param[in] view View matrix of the main camera.
+    /// @param[out] snapshot Receives cameraRight and cameraUp.
+    static void ExtractCameraAxes(const glm::mat4& view, RenderSnapshot& snapshot);
+
+    /// @brief Copies what the render thread needs to draw an entity into a packet.
+    /// @param[in] transformIndex The slot of the entity in transformBuffer.
+    /// @param[in] mesh The uploaded mesh of the entity.
+    /// @param[in] material The material of the entity, with its bindless record allocated.
+    /// @param[in] pipeline The pipeline to draw with, already resolved for the mesh's vertex format.
+    /// @return The draw packet.
+    DrawPacket ExtractDrawPacket
     (
-        const float deltaTime,
-        const glm::mat4 renderMatrix,
+        const uint32_t transformIndex,
         const SimpleMesh& mesh,
-        const Material& material
-    );
+        const Material& material,
+        const VkPipeline pipeline
+    ) const;
+
+    void Draw(const DrawPacket& packet);
 
     template<typename TMesh>
     void UploadMesh(TMesh& mesh);
 
+    /// @brief Starts streaming the bind pose and indices of a skinned mesh.
+    /// @param[in,out] mesh The mesh, its buffers, index type and upload value are set.
+    ///
+    /// The bind pose becomes a storage buffer, only the skinning pass reads it.
+    void UploadMesh(SkinnedMesh& mesh);
+
+    /// @brief Creates a device storage buffer and streams @p bytes into it through uploadQueue.
+    /// @param[in] bytes The contents of the buffer.
+    /// @param[out] bufferOut Receives the buffer.
+    /// @return The uploadQueue value signaled once the buffer holds the data.
+    uint64_t UploadStorageBuffer(const std::vector<uint8_t>& bytes, AllocatedBuffer& bufferOut);
+
+    /// @brief Creates a mesh's device buffers and streams them through uploadQueue.
+    /// @param[in] vertexBytes The encoded vertices.
+    /// @param[in] vertexUsage How the vertex buffer is read, transfer usage is added.
+    /// @param[in] indices The indices, narrowed to 16 bits when @p vertexCount allows it.
+    /// @param[in] vertexCount Number of vertices @p indices address.
+    /// @param[out] vertexBuffer Receives the vertex buffer.
+    /// @param[out] indexBuffer Receives the index buffer.
+    /// @param[out] indexType Receives the width of @p indexBuffer.
+    /// @return The uploadQueue value signaled once both buffers hold the data.
+    uint64_t UploadMeshBuffers
+    (
+        const std::vector<uint8_t>& vertexBytes,
+        const VkBufferUsageFlags vertexUsage,
+        const std::vector<uint32_t>& indices,
+        const size_t vertexCount,
+        AllocatedBuffer& vertexBuffer,
+        AllocatedBuffer& indexBuffer,
+        VkIndexType& indexType
+    );
+
     void ImmediateSubmit(std::function<void(VkCommandBuffer cmd)>&& function);
 
     void DisplayFPSCounter() const;
@@ -38,5 +38,10 @@ namespace vkinit
     VkCommandBufferBeginInfo command_buffer_begin_info(VkCommandBufferUsageFlags flags = 0);
 
     VkSubmitInfo submit_info(VkCommandBuffer* cmd);
+
+    VkImageMemoryBarrier2KHR image_memory_barrier2(VkImage image, VkImageAspectFlags aspectMask, VkImageLayout oldLayout, VkImageLayout newLayout,
+        VkPipelineStageFlags2KHR srcStageMask, VkAccessFlags2KHR srcAccessMask, VkPipelineStageFlags2KHR dstStageMask, VkAccessFlags2KHR dstAccessMask);
+
+    VkRenderingAttachmentInfoKHR rendering_attachment_info(VkImageView imageView, VkImageLayout layout, const VkClearValue* clear);
 }
 
@@ -0,0 +1,91 @@
+/// @file    AABB.h
+/// @author  Matthew Green
+/// @date    2024-01-07 10:20:31
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/Math/Consts.h"
+
+#include <glm/vec3.hpp>
+#include <glm/mat4x4.hpp>
+
+#include <array>
+
+namespace velecs {
+
+/// @struct AABB
+/// @brief Axis-aligned bounding box.
+///
+/// A default constructed box is empty (min is +infinity, max is -infinity) so that
+/// the first call to Encapsulate sets both corners to the point.
+struct AABB {
+public:
+    // Enums
+
+    // Public Fields
+
+    glm::vec3 min{FLOAT_POS_INFINITY}; /// @brief Smallest corner of the box.
+    glm::vec3 max{FLOAT_NEG_INFINITY}; /// @brief Largest corner of the box.
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor, creates an empty box.
+    AABB() = default;
+
+    /// @brief Constructor.
+    /// @param[in] min Smallest corner of the box.
+    /// @param[in] max Largest corner of the box.
+    AABB(const glm::vec3 min, const glm::vec3 max);
+
+    /// @brief Default deconstructor.
+    ~AABB() = default;
+
+    // Public Methods
+
+    /// @brief Grows the box to contain a point.
+    /// @param[in] point The point to include.
+    void Encapsulate(const glm::vec3 point);
+
+    /// @brief Grows the box to contain another box.
+    /// @param[in] other The box to include.
+    void Encapsulate(const AABB& other);
+
+    /// @brief Checks whether the box contains at least one point.
+    /// @return true if min is less than or equal to max on every axis.
+    bool IsValid() const;
+
+    /// @brief Gets the center of the box.
+    /// @return The midpoint between min and max.
+    glm::vec3 GetCenter() const;
+
+    /// @brief Gets the half size of the box.
+    /// @return Half of the distance between min and max on each axis.
+    glm::vec3 GetExtents() const;
+
+    /// @brief Gets the eight corners of the box.
+    /// @return The corners, bit 0 of the index selects max.x, bit 1 max.y and bit 2 max.z.
+    std::array<glm::vec3, 8> GetCorners() const;
+
+    /// @brief Gets the box that contains this box after a transformation.
+    /// @param[in] matrix Affine transformation, e.g. a world matrix.
+    /// @return The axis-aligned box around the transformed box.
+    AABB Transformed(const glm::mat4& matrix) const;
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    // Private Methods
+};
+
+} // namespace velecs
@@ -0,0 +1,67 @@
+/// @file    Frustum.h
+/// @author  Matthew Green
+/// @date    2024-01-26 09:12:40
+///
+/// @section LICENSE
+///
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/Math/AABB.h"
+
+#include <glm/vec4.hpp>
+#include <glm/mat4x4.hpp>
+
+#include <array>
+
+namespace velecs {
+
+/// @struct Frustum
+/// @brief The six planes bounding what a camera sees, in world space.
+///
+/// Testing a world space box against the planes costs six dot products, so once an
+/// object's world bounds are known, every additional camera only pays for this test.
+struct Frustum {
+public:
+    // Enums
+
+    // Public Fields
+
+    /// @brief Left, right, bottom, top, near and far planes. xyz is the normal pointing inside, w the offset.
+    std::array<glm::vec4, 6> planes;
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor, creates a frustum that contains everything.
+    Frustum();
+
+    /// @brief Default deconstructor.
+    ~Frustum() = default;
+
+    // Public Methods
+
+    /// @brief Extracts the planes of a view-projection matrix.
+    /// @param[in] viewProjection Projection times view, with Vulkan's depth range of 0 to 1.
+    /// @return The frustum the matrix maps into clip space.
+    static Frustum FromViewProjection(const glm::mat4& viewProjection);
+
+    /// @brief Checks whether a box is at least partly inside the frustum.
+    /// @param[in] bounds The box, in world space.
+    /// @return false only if the box is entirely outside one of the planes.
+    bool Intersects(const AABB& bounds) const;
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    // Private Methods
+};
+
+} // namespace velecs
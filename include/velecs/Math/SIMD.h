@@ -0,0 +1,18 @@
+/// @file    SIMD.h
+/// @author  Matthew Green
+/// @date    2024-01-07 10:12:44
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+// Every x64 target has SSE2, MSVC only reports it for 32-bit builds through _M_IX86_FP.
+// Define VELECS_NO_SIMD to force the scalar paths, e.g. when comparing results.
+#if !defined(VELECS_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+    #define VELECS_SIMD_SSE2 1
+    #include <emmintrin.h>
+#endif
@@ -0,0 +1,183 @@
+/// @file    BindlessTable.h
+/// @author  Matthew Green
+/// @date    2024-01-06 14:48:17
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/Memory/AllocatedBuffer.h"
+#include "velecs/Rendering/MaterialParams.h"
+#include "velecs/Rendering/DeviceCapabilities.h"
+
+#include <vulkan/vulkan_core.h>
+
+#include <vma/vk_mem_alloc.h>
+
+#include <cstdint>
+#include <vector>
+#include <unordered_map>
+
+namespace velecs {
+
+/// @class BindlessTable
+/// @brief One descriptor set holding every texture and material the renderer knows about.
+///
+/// The set has a large sampled-image array, a single immutable sampler and a storage
+/// buffer of MaterialParams. Shaders index both arrays with values taken from per-object
+/// data, so switching between materials that share a pipeline never rebinds descriptors.
+/// When descriptor indexing is available the texture array is partially bound and
+/// update-after-bind; otherwise every slot is kept pointing at the fallback texture.
+/// Material records are shared by every material with the same pipeline, color and
+/// texture, and freed once the last of them is removed.
+class BindlessTable {
+public:
+    // Enums
+
+    // Public Fields
+
+    static constexpr uint32_t MAX_TEXTURES = 1024; /// @brief Size of the sampled-image array, must match the shaders.
+    static constexpr uint32_t MAX_MATERIALS = 4096; /// @brief Number of MaterialParams records in the material buffer.
+    static constexpr uint32_t INVALID_INDEX = UINT32_MAX; /// @brief Marks a texture or material that has no slot yet.
+    static constexpr uint32_t DEFAULT_TEXTURE_INDEX = 0; /// @brief Slot reserved for the 1x1 white texture.
+    static constexpr uint32_t DEFAULT_MATERIAL_INDEX = 0; /// @brief White record with the default texture, used by materials that do not fit in the buffer.
+
+    static constexpr uint32_t TEXTURES_BINDING = 0; /// @brief Binding of the sampled-image array.
+    static constexpr uint32_t SAMPLER_BINDING = 1; /// @brief Binding of the immutable sampler.
+    static constexpr uint32_t MATERIALS_BINDING = 2; /// @brief Binding of the material storage buffer.
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    BindlessTable() = default;
+
+    /// @brief Default deconstructor.
+    ~BindlessTable() = default;
+
+    // Delete the copy constructor and assignment operator to prevent copies
+    BindlessTable(const BindlessTable&) = delete;
+    BindlessTable& operator=(const BindlessTable&) = delete;
+
+    // Public Methods
+
+    /// @brief Creates the descriptor set layout, pool, set, sampler and material buffer.
+    /// @param[in] device The Vulkan device.
+    /// @param[in] allocator The VMA allocator used for the material buffer.
+    /// @param[in] capabilities Optional features enabled on the device.
+    void Init(VkDevice device, VmaAllocator allocator, const DeviceCapabilities& capabilities);
+
+    /// @brief Destroys every Vulkan object owned by the table.
+    void Cleanup();
+
+    /// @brief Sets the image view written into every unused texture slot.
+    /// @param[in] imageView A valid view in VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL.
+    void SetFallbackTexture(VkImageView imageView);
+
+    /// @brief Places a texture in the first free slot of the texture array.
+    /// @param[in] imageView A valid view in VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL.
+    /// @return The slot index shaders use to sample the texture.
+    /// @throws std::runtime_error if the texture array is full.
+    uint32_t RegisterTexture(VkImageView imageView);
+
+    /// @brief Frees a texture slot and points it back at the fallback texture.
+    /// @param[in] index The slot returned by RegisterTexture.
+    void ReleaseTexture(const uint32_t index);
+
+    /// @brief Gets the record shared by every material with these values, taking a reference to it.
+    /// @param[in] current The record the caller holds or INVALID_INDEX, released if it no longer matches.
+    /// @param[in] pipeline The pipeline of the material.
+    /// @param[in] params The values of the material.
+    /// @return The material index shaders use to read the record, or DEFAULT_MATERIAL_INDEX if the buffer is full.
+    ///
+    /// Returns @p current unchanged while the material keeps its values, so it is cheap to call every frame.
+    /// The record is not written here, SetMaterial does that on the render thread.
+    uint32_t AcquireMaterial(const uint32_t current, VkPipeline pipeline, const MaterialParams& params);
+
+    /// @brief Drops a reference to a record, freeing it with the last one.
+    /// @param[in] index The index returned by AcquireMaterial.
+    void ReleaseMaterial(const uint32_t index);
+
+    /// @brief Writes a record of the persistently mapped material buffer.
+    /// @param[in] index The index returned by AcquireMaterial, DEFAULT_MATERIAL_INDEX is left untouched.
+    /// @param[in] params The values to write.
+    ///
+    /// The buffer is host visible and coherent, so this is a plain memcpy. It must only
+    /// be called once the frame that last read the record has retired.
+    void SetMaterial(const uint32_t index, const MaterialParams& params);
+
+    /// @brief Binds the table's descriptor set.
+    /// @param[in] cmd The command buffer being recorded.
+    /// @param[in] pipelineLayout A pipeline layout created with GetLayout() at set @p setIndex.
+    /// @param[in] bindPoint The pipeline bind point.
+    /// @param[in] setIndex The set number the layout expects the table at.
+    void Bind
+    (
+        VkCommandBuffer cmd,
+        VkPipelineLayout pipelineLayout,
+        const VkPipelineBindPoint bindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS,
+        const uint32_t setIndex = 0
+    ) const;
+
+    /// @brief Gets the descriptor set layout to include in pipeline layouts.
+    /// @return The descriptor set layout of the table.
+    VkDescriptorSetLayout GetLayout() const;
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    /// @struct MaterialKey
+    /// @brief Identity of a shared material record.
+    struct MaterialKey {
+        VkPipeline pipeline{VK_NULL_HANDLE};
+        glm::vec4 color{1.0f};
+        uint32_t textureIndex{DEFAULT_TEXTURE_INDEX};
+
+        bool operator==(const MaterialKey& other) const;
+    };
+
+    /// @struct MaterialKeyHash
+    /// @brief FNV-1a over the fields compared by MaterialKey::operator==.
+    struct MaterialKeyHash {
+        size_t operator()(const MaterialKey& key) const;
+    };
+
+    // Private Fields
+
+    VkDevice device{VK_NULL_HANDLE}; /// @brief Handle to the Vulkan device.
+    VmaAllocator allocator{nullptr}; /// @brief Allocator that owns the material buffer.
+    bool updateAfterBind{false}; /// @brief Whether texture slots can be written while the set is bound.
+
+    VkDescriptorSetLayout layout{VK_NULL_HANDLE};
+    VkDescriptorPool pool{VK_NULL_HANDLE};
+    VkDescriptorSet set{VK_NULL_HANDLE};
+    VkSampler sampler{VK_NULL_HANDLE};
+
+    AllocatedBuffer materialBuffer; /// @brief Storage buffer of MAX_MATERIALS MaterialParams records.
+    MaterialParams* mappedMaterials{nullptr}; /// @brief Persistent mapping of materialBuffer.
+
+    VkImageView fallbackTexture{VK_NULL_HANDLE};
+
+    std::vector<bool> usedTextureSlots; /// @brief Occupancy of each texture slot.
+    std::vector<uint32_t> freeMaterialSlots; /// @brief Released material records available for reuse.
+    uint32_t nextMaterialSlot{DEFAULT_MATERIAL_INDEX + 1}; /// @brief First material record that has never been handed out.
+    std::unordered_map<MaterialKey, uint32_t, MaterialKeyHash> materialSlots; /// @brief Record of every material in use.
+    std::vector<MaterialKey> materialKeys; /// @brief Identity of each record, to find it in materialSlots on release.
+    std::vector<uint32_t> materialReferences; /// @brief Materials holding each record.
+    bool warnedMaterialsFull{false}; /// @brief Whether running out of records was already reported.
+
+    // Private Methods
+
+    /// @brief Writes an image view into one element of the texture array.
+    /// @param[in] index The slot to write.
+    /// @param[in] imageView The view to write.
+    void WriteTexture(const uint32_t index, VkImageView imageView);
+};
+
+} // namespace velecs
@@ -0,0 +1,95 @@
+/// @file    BlockCompression.h
+/// @author  Matthew Green
+/// @date    2024-01-19 09:22:41
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include <vulkan/vulkan_core.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace velecs {
+
+/// @struct BlockCompression
+/// @brief CPU encoders for the BC1, BC3 and BC7 texture formats.
+///
+/// Every format stores 4x4 pixel blocks: BC1 in 8 bytes (opaque color, 8:1 against RGBA8),
+/// BC3 and BC7 in 16 bytes (color and alpha, 4:1). BC1 and BC3 go through stb_dxt. BC7 is
+/// encoded in mode 6 only, a single RGBA endpoint pair with 4-bit weights, which trades a
+/// little quality on multi-colored blocks for a fast and simple encoder. Meant for asset
+/// baking, not for per-frame use.
+struct BlockCompression {
+public:
+    // Enums
+
+    // Public Fields
+
+    static constexpr uint32_t BLOCK_DIM = 4; /// @brief Width and height of a block in pixels.
+
+    // Constructors and Destructors
+
+    BlockCompression() = delete;
+
+    // Public Methods
+
+    /// @brief Whether a format is one of the block formats produced here.
+    /// @param[in] format The format to check.
+    /// @return true for BC1, BC3 and BC7.
+    static bool IsBlockCompressed(const VkFormat format);
+
+    /// @brief Gets the bytes of one encoded block.
+    /// @param[in] format A block compressed format.
+    /// @return 8 for BC1, 16 for BC3 and BC7, 0 for any other format.
+    static size_t GetBlockSize(const VkFormat format);
+
+    /// @brief Gets the bytes of an encoded image.
+    /// @param[in] format A block compressed format.
+    /// @param[in] width Width of the image in pixels.
+    /// @param[in] height Height of the image in pixels.
+    /// @return Bytes of the image, partial blocks on the edges count as whole ones.
+    static size_t GetImageSize(const VkFormat format, const uint32_t width, const uint32_t height);
+
+    /// @brief Picks BC1 for opaque images and BC7 for images with any transparency.
+    /// @param[in] rgba Tightly packed RGBA8 pixels.
+    /// @param[in] width Width of the image in pixels.
+    /// @param[in] height Height of the image in pixels.
+    /// @return VK_FORMAT_BC1_RGB_UNORM_BLOCK or VK_FORMAT_BC7_UNORM_BLOCK.
+    static VkFormat ChooseFormat(const uint8_t* rgba, const uint32_t width, const uint32_t height);
+
+    /// @brief Encodes an RGBA8 image.
+    /// @param[in] rgba Tightly packed RGBA8 pixels.
+    /// @param[in] width Width of the image in pixels.
+    /// @param[in] height Height of the image in pixels.
+    /// @param[in] format VK_FORMAT_BC1_RGB_UNORM_BLOCK, VK_FORMAT_BC3_UNORM_BLOCK or VK_FORMAT_BC7_UNORM_BLOCK.
+    /// @return The encoded blocks in row order. Edge blocks repeat the last row and column.
+    /// @throws std::invalid_argument if @p format is not supported.
+    static std::vector<uint8_t> Compress(const uint8_t* rgba, const uint32_t width, const uint32_t height, const VkFormat format);
+
+    /// @brief Encodes one block in BC7 mode 6.
+    ///
+    /// The endpoints are the two corners of the block's RGBA bounding box on whichever of its
+    /// 8 diagonals decodes with the least error.
+    /// @param[in] pixels 16 RGBA8 pixels in row order.
+    /// @param[out] block The 16 encoded bytes.
+    static void EncodeBC7Block(const uint8_t* pixels, uint8_t* block);
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    // Private Methods
+};
+
+} // namespace velecs
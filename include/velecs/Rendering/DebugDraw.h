@@ -0,0 +1,96 @@
+/// @file    DebugDraw.h
+/// @author  Matthew Green
+/// @date    2024-01-28 13:24:51
+///
+/// @section LICENSE
+///
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/Graphics/Color32.h"
+#include "velecs/Math/AABB.h"
+#include "velecs/Rendering/DebugVertex.h"
+
+#include <glm/vec3.hpp>
+#include <glm/mat4x4.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace velecs {
+
+/// @class DebugDraw
+/// @brief Immediate mode lines, boxes, spheres and arrows, callable from any thread.
+///
+/// Every shape is broken into lines right away and appended to a buffer owned by the
+/// calling thread, so systems running on the worker threads never wait on each other.
+/// RenderingECSModule collects every thread's lines once per frame and draws them over
+/// the main view with one line list draw. Shapes last a single frame, call again to keep
+/// them on screen.
+class DebugDraw {
+public:
+    // Enums
+
+    // Public Fields
+
+    static constexpr uint32_t DEFAULT_SPHERE_SEGMENTS = 24; /// @brief Lines per circle of a sphere.
+    static constexpr float DEFAULT_ARROW_HEAD = 0.2f; /// @brief Length of an arrow's head as a fraction of the arrow.
+
+    // Constructors and Destructors
+
+    DebugDraw() = delete;
+
+    // Public Methods
+
+    /// @brief Draws a line.
+    /// @param[in] from Start of the line in world space.
+    /// @param[in] to End of the line in world space.
+    /// @param[in] color Color of the line.
+    static void Line(const glm::vec3& from, const glm::vec3& to, const Color32 color = Color32::WHITE);
+
+    /// @brief Draws the edges of an axis aligned box.
+    /// @param[in] bounds The box in world space, invalid boxes are skipped.
+    /// @param[in] color Color of the edges.
+    static void Box(const AABB& bounds, const Color32 color = Color32::WHITE);
+
+    /// @brief Draws the edges of a transformed box, such as an entity's local bounds.
+    /// @param[in] world Matrix taking the box to world space.
+    /// @param[in] bounds The box before @p world is applied, invalid boxes are skipped.
+    /// @param[in] color Color of the edges.
+    static void Box(const glm::mat4& world, const AABB& bounds, const Color32 color = Color32::WHITE);
+
+    /// @brief Draws a sphere as three circles around its axes.
+    /// @param[in] center Center of the sphere in world space.
+    /// @param[in] radius Radius of the sphere.
+    /// @param[in] color Color of the circles.
+    /// @param[in] segments Lines per circle, at least 3.
+    static void Sphere(const glm::vec3& center, const float radius, const Color32 color = Color32::WHITE, const uint32_t segments = DEFAULT_SPHERE_SEGMENTS);
+
+    /// @brief Draws an arrow with a four sided head at its tip.
+    /// @param[in] from Tail of the arrow in world space.
+    /// @param[in] to Tip of the arrow in world space.
+    /// @param[in] color Color of the arrow.
+    /// @param[in] headSize Length of the head as a fraction of the arrow.
+    static void Arrow(const glm::vec3& from, const glm::vec3& to, const Color32 color = Color32::WHITE, const float headSize = DEFAULT_ARROW_HEAD);
+
+    /// @brief Moves the lines of every thread into one list and empties the thread buffers.
+    /// @param[out] vertices Receives two vertices per line.
+    ///
+    /// Lines added while collecting land either in this frame or the next, never in both.
+    static void Collect(std::vector<DebugVertex>& vertices);
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    // Private Methods
+};
+
+} // namespace velecs
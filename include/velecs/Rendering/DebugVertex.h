@@ -0,0 +1,65 @@
+/// @file    DebugVertex.h
+/// @author  Matthew Green
+/// @date    2024-01-28 13:02:19
+///
+/// @section LICENSE
+///
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/Graphics/Color32.h"
+#include "velecs/Rendering/VertexInputAttributeDescriptor.h"
+
+#include <glm/vec3.hpp>
+
+#include <cstdint>
+
+namespace velecs {
+
+/// @struct DebugVertex
+/// @brief 16-byte end of one debug line, in world space.
+///
+/// The color is read as VK_FORMAT_R8G8B8A8_UNORM, so lines may be translucent.
+struct DebugVertex {
+public:
+    // Enums
+
+    // Public Fields
+
+    glm::vec3 position{0.0f}; /// @brief World space position of the line end.
+    uint8_t color[4]{255, 255, 255, 255}; /// @brief RGBA color of the line end.
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    DebugVertex() = default;
+
+    /// @brief Constructor.
+    /// @param[in] position World space position of the line end.
+    /// @param[in] color Color of the line end.
+    DebugVertex(const glm::vec3& position, const Color32 color);
+
+    /// @brief Default deconstructor.
+    ~DebugVertex() = default;
+
+    // Public Methods
+
+    static VertexInputAttributeDescriptor GetVertexDescription();
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    // Private Methods
+};
+
+static_assert(sizeof(DebugVertex) == 16, "DebugVertex must match the vertex input description.");
+
+} // namespace velecs
@@ -0,0 +1,122 @@
+/// @file    DescriptorAllocator.h
+/// @author  Matthew Green
+/// @date    2024-01-17 11:12:40
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include <vulkan/vulkan_core.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace velecs {
+
+/// @class DescriptorAllocator
+/// @brief Hands out descriptor sets from a growing list of pools.
+///
+/// Sets are allocated from the current pool until it runs out, then a new pool is taken,
+/// each one holding twice the sets of the last up to MAX_SETS_PER_POOL. Sets are never freed
+/// one by one: Reset returns every pool at once, which is how per-frame allocators are
+/// recycled after the frame that used them has retired. Pools are kept and reused.
+///
+/// An allocator is not thread safe, each thread recording descriptors should own one.
+class DescriptorAllocator {
+public:
+    // Enums
+
+    // Public Fields
+
+    /// @struct PoolSizeRatio
+    /// @brief Descriptors of one type reserved per set in each pool.
+    struct PoolSizeRatio {
+        VkDescriptorType type; /// @brief The descriptor type.
+        float ratio; /// @brief Descriptors of @p type per set.
+    };
+
+    static constexpr uint32_t DEFAULT_SETS_PER_POOL = 64; /// @brief Sets in the first pool.
+    static constexpr uint32_t MAX_SETS_PER_POOL = 4096; /// @brief Growth stops at this many sets per pool.
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    DescriptorAllocator() = default;
+
+    /// @brief Default deconstructor.
+    ~DescriptorAllocator() = default;
+
+    // Delete the copy constructor and assignment operator to prevent copies
+    DescriptorAllocator(const DescriptorAllocator&) = delete;
+    DescriptorAllocator& operator=(const DescriptorAllocator&) = delete;
+
+    // Public Methods
+
+    /// @brief Stores the device and the pool sizing, the first pool is created on the first allocation.
+    /// @param[in] device The Vulkan device.
+    /// @param[in] poolRatios Descriptors of each type reserved per set, the defaults cover the common types.
+    /// @param[in] setsPerPool Sets in the first pool.
+    void Init
+    (
+        VkDevice device,
+        const std::vector<PoolSizeRatio>& poolRatios = GetDefaultPoolRatios(),
+        const uint32_t setsPerPool = DEFAULT_SETS_PER_POOL
+    );
+
+    /// @brief Destroys every pool, which frees every set allocated from them.
+    void Cleanup();
+
+    /// @brief Allocates one set, taking a new pool when the current one is exhausted.
+    /// @param[in] layout The layout of the set.
+    /// @param[in] pNext Optional structure chained to the allocate info, e.g. variable descriptor counts.
+    /// @return The allocated set, valid until the next Reset or Cleanup.
+    /// @throws std::runtime_error if a set cannot be allocated even from a fresh pool.
+    VkDescriptorSet Allocate(VkDescriptorSetLayout layout, const void* pNext = nullptr);
+
+    /// @brief Resets every pool, invalidating all sets allocated so far.
+    ///
+    /// Only call this once the GPU has finished with every set, e.g. after the frame fence.
+    void Reset();
+
+    /// @brief Gets the number of pools created so far.
+    /// @return The number of pools, in use or free.
+    uint32_t GetPoolCount() const;
+
+    /// @brief Gets the pool sizing used when none is given to Init.
+    /// @return Ratios for samplers, images, uniform and storage buffers.
+    static const std::vector<PoolSizeRatio>& GetDefaultPoolRatios();
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    VkDevice device{VK_NULL_HANDLE}; /// @brief Handle to the Vulkan device.
+    std::vector<PoolSizeRatio> ratios; /// @brief Descriptors of each type reserved per set.
+    uint32_t nextSetsPerPool{DEFAULT_SETS_PER_POOL}; /// @brief Sets in the next pool created.
+
+    VkDescriptorPool currentPool{VK_NULL_HANDLE}; /// @brief Pool allocations are taken from.
+    std::vector<VkDescriptorPool> fullPools; /// @brief Exhausted pools waiting for Reset.
+    std::vector<VkDescriptorPool> freePools; /// @brief Reset pools ready to be reused.
+
+    // Private Methods
+
+    /// @brief Takes a free pool, or creates one when none is left.
+    /// @return An empty pool.
+    /// @throws std::runtime_error if the pool cannot be created.
+    VkDescriptorPool GrabPool();
+
+    /// @brief Creates a pool of nextSetsPerPool sets and grows the size of the next one.
+    /// @return The new pool.
+    /// @throws std::runtime_error if the pool cannot be created.
+    VkDescriptorPool CreatePool();
+};
+
+} // namespace velecs
@@ -0,0 +1,112 @@
+/// @file    DescriptorLayoutCache.h
+/// @author  Matthew Green
+/// @date    2024-01-17 10:04:27
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include <vulkan/vulkan_core.h>
+
+#include <cstddef>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace velecs {
+
+/// @class DescriptorLayoutCache
+/// @brief Creates each distinct descriptor set layout once and hands the same handle back afterwards.
+///
+/// Layouts are keyed by their bindings, sorted by binding number, together with the create flags
+/// and the per-binding flags of a chained VkDescriptorSetLayoutBindingFlagsCreateInfoEXT. Two
+/// subsystems asking for the same layout therefore get pipeline layouts that are compatible.
+/// The cache owns every layout it returns and destroys them in Cleanup.
+class DescriptorLayoutCache {
+public:
+    // Enums
+
+    // Public Fields
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    DescriptorLayoutCache() = default;
+
+    /// @brief Default deconstructor.
+    ~DescriptorLayoutCache() = default;
+
+    // Delete the copy constructor and assignment operator to prevent copies
+    DescriptorLayoutCache(const DescriptorLayoutCache&) = delete;
+    DescriptorLayoutCache& operator=(const DescriptorLayoutCache&) = delete;
+
+    // Public Methods
+
+    /// @brief Stores the device the layouts are created on.
+    /// @param[in] device The Vulkan device.
+    void Init(VkDevice device);
+
+    /// @brief Destroys every cached layout.
+    void Cleanup();
+
+    /// @brief Returns the cached layout matching @p info, creating it on first use.
+    /// @param[in] info The layout description. Only VkDescriptorSetLayoutBindingFlagsCreateInfoEXT may be chained.
+    /// @return A layout owned by the cache.
+    /// @throws std::runtime_error if the layout cannot be created or @p info chains an unsupported structure.
+    VkDescriptorSetLayout CreateLayout(const VkDescriptorSetLayoutCreateInfo& info);
+
+    /// @brief Gets the number of distinct layouts created so far.
+    /// @return The number of cached layouts.
+    size_t GetLayoutCount() const;
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    /// @struct BindingKey
+    /// @brief Everything about one binding that makes two layouts incompatible.
+    struct BindingKey {
+        VkDescriptorSetLayoutBinding binding{}; /// @brief The binding, its pImmutableSamplers is not compared.
+        VkDescriptorBindingFlagsEXT flags{0}; /// @brief Flags from the chained binding flags structure.
+        std::vector<VkSampler> immutableSamplers; /// @brief Copy of the samplers pImmutableSamplers pointed at.
+
+        bool operator==(const BindingKey& other) const;
+    };
+
+    /// @struct LayoutKey
+    /// @brief Cache key of one layout, bindings are sorted by binding number.
+    struct LayoutKey {
+        VkDescriptorSetLayoutCreateFlags flags{0};
+        std::vector<BindingKey> bindings;
+
+        bool operator==(const LayoutKey& other) const;
+    };
+
+    /// @struct LayoutKeyHash
+    /// @brief FNV-1a over the fields compared by LayoutKey::operator==.
+    struct LayoutKeyHash {
+        size_t operator()(const LayoutKey& key) const;
+    };
+
+    // Private Fields
+
+    VkDevice device{VK_NULL_HANDLE}; /// @brief Handle to the Vulkan device.
+    mutable std::mutex cacheMutex; /// @brief Guards layouts, subsystems may create layouts from worker threads.
+    std::unordered_map<LayoutKey, VkDescriptorSetLayout, LayoutKeyHash> layouts; /// @brief Every layout created so far.
+
+    // Private Methods
+
+    /// @brief Builds the cache key of a layout description.
+    /// @param[in] info The layout description.
+    /// @return The key.
+    /// @throws std::runtime_error if @p info chains an unsupported structure.
+    static LayoutKey MakeKey(const VkDescriptorSetLayoutCreateInfo& info);
+};
+
+} // namespace velecs
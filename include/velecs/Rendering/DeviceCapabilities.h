@@ -0,0 +1,56 @@
+/// @file    DeviceCapabilities.h
+/// @author  Matthew Green
+/// @date    2024-01-06 14:12:40
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+namespace velecs {
+
+/// @struct DeviceCapabilities
+/// @brief Optional Vulkan features that were found and enabled on the chosen device.
+///
+/// Filled in once by RenderingECSModule::InitVulkan. Renderer subsystems check these
+/// flags to pick between their fast path and the baseline Vulkan 1.1 path.
+struct DeviceCapabilities {
+public:
+    // Enums
+
+    // Public Fields
+
+    bool descriptorIndexing{false}; /// @brief VK_EXT_descriptor_indexing with non-uniform sampled image indexing, partially bound and update-after-bind arrays.
+    float timestampPeriod{0.0f}; /// @brief Nanoseconds per timestamp tick on graphics queues, 0 when timestamps are unsupported.
+    bool timelineSemaphore{false}; /// @brief VK_KHR_timeline_semaphore, used to track uploads on the transfer queue.
+    bool dedicatedTransferQueue{false}; /// @brief Uploads run on a queue family without graphics or compute.
+    bool dynamicRendering{false}; /// @brief VK_KHR_dynamic_rendering and VK_KHR_synchronization2, frames are recorded without render pass or framebuffer objects.
+    bool textureCompressionBC{false}; /// @brief BC1-BC7 formats can be sampled, baked textures may stay block compressed on the GPU.
+    bool pipelineStatisticsQuery{false}; /// @brief Vertex, clipping and fragment invocations of the scene can be counted on the GPU.
+    bool multiDrawIndirect{false}; /// @brief One indirect call can draw many commands, clustered meshes may be culled on the GPU.
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    DeviceCapabilities() = default;
+
+    /// @brief Default deconstructor.
+    ~DeviceCapabilities() = default;
+
+    // Public Methods
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    // Private Methods
+};
+
+} // namespace velecs
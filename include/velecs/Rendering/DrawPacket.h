@@ -0,0 +1,75 @@
+/// @file    DrawPacket.h
+/// @author  Matthew Green
+/// @date    2024-01-11 10:04:52
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/Rendering/MaterialParams.h"
+#include "velecs/Rendering/BindlessTable.h"
+
+#include <vulkan/vulkan_core.h>
+
+#include <glm/vec4.hpp>
+
+#include <cstdint>
+
+namespace velecs {
+
+/// @struct DrawPacket
+/// @brief Everything the render thread needs to draw one object, copied out of the ECS.
+///
+/// Packets only hold plain values and Vulkan handles, so they stay valid while the
+/// simulation moves or edits the components they were extracted from.
+struct DrawPacket {
+public:
+    // Enums
+
+    // Public Fields
+
+    uint32_t transformIndex{0}; /// @brief Slot of the world matrix in the transform buffer.
+    glm::vec4 positionOffset{0.0f}; /// @brief Minimum corner of the mesh bounds for quantized meshes, zero otherwise.
+    glm::vec4 positionScale{1.0f}; /// @brief Size of the mesh bounds for quantized meshes, one otherwise.
+    VkBuffer vertexBuffer{VK_NULL_HANDLE}; /// @brief Uploaded vertex buffer of the mesh.
+    VkBuffer indexBuffer{VK_NULL_HANDLE}; /// @brief Uploaded index buffer of the mesh.
+    VkIndexType indexType{VK_INDEX_TYPE_UINT32}; /// @brief Width of the indices in indexBuffer.
+    uint32_t firstIndex{0}; /// @brief First index to draw, non-zero for the visible ranges of a clustered mesh.
+    uint32_t indexCount{0}; /// @brief Number of indices to draw.
+    uint32_t meshletCount{0}; /// @brief Indirect draws culled on the GPU, 0 draws firstIndex and indexCount directly.
+    uint32_t firstCommand{0}; /// @brief First of the meshletCount commands in the MeshletCuller's command buffer.
+    int32_t vertexOffset{0}; /// @brief Added to every index before the vertex is read.
+    bool dynamicBatch{false}; /// @brief Reads the DynamicBatcher's buffers of the frame instead of vertexBuffer and indexBuffer.
+    VkPipeline pipeline{VK_NULL_HANDLE}; /// @brief Pipeline to draw with, already resolved to the quantized variant if needed.
+    VkPipelineLayout pipelineLayout{VK_NULL_HANDLE}; /// @brief Layout of pipeline.
+    uint32_t materialIndex{BindlessTable::INVALID_INDEX}; /// @brief Record of the material in the bindless material buffer.
+    MaterialParams material; /// @brief Color and texture written to the material record before drawing.
+    uint32_t viewIndex{0}; /// @brief Index of the view in RenderSnapshot::views the packet is drawn in.
+    float fade{0.0f}; /// @brief Share of pixels a DITHER_FADE pipeline drops while fading into an impostor.
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    DrawPacket() = default;
+
+    /// @brief Default deconstructor.
+    ~DrawPacket() = default;
+
+    // Public Methods
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    // Private Methods
+};
+
+} // namespace velecs
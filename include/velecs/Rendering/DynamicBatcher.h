@@ -0,0 +1,171 @@
+/// @file    DynamicBatcher.h
+/// @author  Matthew Green
+/// @date    2024-01-28 10:06:41
+///
+/// @section LICENSE
+///
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/ECS/Components/Rendering/SimpleMesh.h"
+#include "velecs/Memory/AllocatedBuffer.h"
+#include "velecs/Rendering/DrawPacket.h"
+#include "velecs/Core/ThreadPool.h"
+
+#include <vulkan/vulkan_core.h>
+
+#include <vma/vk_mem_alloc.h>
+
+#include <glm/mat4x4.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace velecs {
+
+/// @class DynamicBatcher
+/// @brief Merges small visible meshes that share a material into one draw every frame.
+///
+/// Instancing needs identical meshes, so props made of a few dozen distinct vertices
+/// would otherwise cost a draw each. Every frame their vertices are transformed to world
+/// space on the worker threads, four lanes wide when VELECS_SIMD_SSE2 is defined, and
+/// appended to the geometry of their batch. Each batch is drawn once per view any of its
+/// sources is visible in, so the GPU may clip a few sources another view kept.
+///
+/// Flatten swaps the geometry into the snapshot rather than copying it, and Upload copies
+/// it once, straight into the frame buffers. Meshes that are batched never need their own
+/// GPU buffers.
+///
+/// Find, Append and Flatten belong to the simulation, Upload to the render thread. Unlike
+/// StaticBatcher the sources may move freely, the work is simply redone every frame.
+class DynamicBatcher {
+public:
+    // Enums
+
+    // Public Fields
+
+    static constexpr uint32_t DEFAULT_VERTEX_THRESHOLD = 256; /// @brief Meshes with more vertices are drawn on their own.
+
+    /// @struct Source
+    /// @brief One visible mesh to merge into a batch this frame.
+    struct Source {
+        const SimpleMesh* mesh{nullptr}; /// @brief The mesh, alive until Append returns.
+        glm::mat4 world{1.0f}; /// @brief Matrix taking the mesh to world space.
+        uint32_t batch{0}; /// @brief Index returned by Find.
+        uint32_t viewMask{0}; /// @brief Bit v is set when the mesh is visible in view v.
+    };
+
+    /// @struct Geometry
+    /// @brief World space vertices and indices of one batch.
+    struct Geometry {
+        std::vector<SimpleVertex> vertices;
+        std::vector<uint32_t> indices; /// @brief Relative to the first vertex of the batch.
+    };
+
+    // Constructors and Destructors
+
+    /// @brief Constructor.
+    /// @param[in] vertexThreshold Meshes with more vertices are never batched, 0 batches nothing.
+    explicit DynamicBatcher(const uint32_t vertexThreshold = DEFAULT_VERTEX_THRESHOLD);
+
+    /// @brief Default deconstructor.
+    ~DynamicBatcher() = default;
+
+    // Delete the copy constructor and assignment operator to prevent copies
+    DynamicBatcher(const DynamicBatcher&) = delete;
+    DynamicBatcher& operator=(const DynamicBatcher&) = delete;
+
+    // Public Methods
+
+    /// @brief Sets the largest mesh that is batched.
+    /// @param[in] vertexThreshold Meshes with more vertices are never batched, 0 batches nothing.
+    void SetVertexThreshold(const uint32_t vertexThreshold);
+
+    /// @brief Checks whether a mesh is small enough to be batched.
+    /// @param[in] mesh The mesh.
+    /// @return true if the mesh has triangles and at most the threshold's vertices.
+    bool IsBatchable(const SimpleMesh& mesh) const;
+
+    /// @brief Gets the batch of a material, creating it on first use this frame.
+    /// @param[in] packet Pipeline, layout and material the batch is drawn with, every other field is ignored.
+    /// @return The index to store in Source::batch.
+    uint32_t Find(const DrawPacket& packet);
+
+    /// @brief Transforms sources to world space and appends them to their batches.
+    /// @param[in] threadPool Pool the sources are spread over.
+    /// @param[in] sources The meshes to merge.
+    void Append(ThreadPool& threadPool, const std::vector<Source>& sources);
+
+    /// @brief Moves every batch of the frame into the snapshot and starts the next frame.
+    /// @param[in,out] geometry Receives batch after batch, its slots must be empty. The vectors
+    /// swapped out of it are reused by the next frame, so their capacity is kept.
+    /// @param[out] drawPackets Receives one packet per batch and view.
+    /// @return Number of sources merged this frame.
+    uint32_t Flatten(std::vector<Geometry>& geometry, std::vector<DrawPacket>& drawPackets);
+
+    /// @brief Sets the allocator the frame buffers are created with.
+    /// @param[in] allocator The VMA allocator.
+    void Init(VmaAllocator allocator);
+
+    /// @brief Destroys the frame buffers.
+    void Cleanup();
+
+    /// @brief Copies the batched geometry of a frame into the frame buffers.
+    /// @param[in] geometry The batches Flatten wrote.
+    ///
+    /// The buffers are reused every frame, so the previous frame must have retired.
+    /// @throws std::runtime_error if a buffer cannot be grown.
+    void Upload(const std::vector<Geometry>& geometry);
+
+    /// @brief Gets the buffer batched packets read their vertices from.
+    /// @return The vertex buffer written by the last Upload.
+    VkBuffer GetVertexBuffer() const;
+
+    /// @brief Gets the buffer batched packets read their indices from.
+    /// @return The 32-bit index buffer written by the last Upload.
+    VkBuffer GetIndexBuffer() const;
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    /// @struct Batch
+    /// @brief World space geometry of every source sharing a material this frame.
+    struct Batch {
+        DrawPacket packet; /// @brief Pipeline, layout and material of the batch.
+        uint32_t viewMask{0}; /// @brief Views any source is visible in.
+        Geometry geometry;
+        uint32_t sourceCount{0};
+    };
+
+    uint32_t vertexThreshold; /// @brief Largest mesh that is batched.
+    std::vector<Batch> batches; /// @brief Batches of the frame being simulated, simulation only.
+
+    VmaAllocator allocator{nullptr}; /// @brief Allocator that owns the frame buffers.
+    AllocatedBuffer vertexBuffer; /// @brief Vertices of the frame being recorded, render thread only.
+    void* mappedVertices{nullptr};
+    VkDeviceSize vertexCapacity{0};
+    AllocatedBuffer indexBuffer; /// @brief Indices of the frame being recorded, render thread only.
+    void* mappedIndices{nullptr};
+    VkDeviceSize indexCapacity{0};
+
+    // Private Methods
+
+    /// @brief Makes sure a host visible frame buffer holds @p bytes.
+    /// @param[in,out] buffer The buffer, recreated when too small.
+    /// @param[in,out] mapped Pointer to its mapped memory.
+    /// @param[in,out] capacity Its size in bytes.
+    /// @param[in] bytes Size needed.
+    /// @param[in] usage How the buffer is read.
+    /// @throws std::runtime_error if the buffer cannot be created.
+    void Reserve(AllocatedBuffer& buffer, void*& mapped, VkDeviceSize& capacity, const VkDeviceSize bytes, const VkBufferUsageFlags usage);
+};
+
+} // namespace velecs
@@ -0,0 +1,82 @@
+/// @file    DynamicResolution.h
+/// @author  Matthew Green
+/// @date    2024-01-10 09:18:33
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include <vulkan/vulkan_core.h>
+
+namespace velecs {
+
+/// @class DynamicResolution
+/// @brief Picks the scene render scale that keeps the GPU frame time near a target.
+///
+/// Fragment cost grows with the rendered area, so each update moves the scale by the square
+/// root of the target to measured time ratio. The measurement is smoothed and changes inside
+/// a small dead band are ignored so the resolution does not flicker between adjacent values.
+class DynamicResolution {
+public:
+    // Enums
+
+    // Public Fields
+
+    bool enabled{false}; /// @brief Renders the scene offscreen at GetScale() and upscales it when true.
+    float targetFrameTimeMs{16.6f}; /// @brief GPU time per frame to aim for, in milliseconds.
+    float minScale{0.5f}; /// @brief Smallest scale applied to each axis.
+    float maxScale{1.0f}; /// @brief Largest scale applied to each axis.
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    DynamicResolution() = default;
+
+    /// @brief Default deconstructor.
+    ~DynamicResolution() = default;
+
+    // Public Methods
+
+    /// @brief Feeds the GPU time of the last frame and updates the scale.
+    /// @param[in] gpuFrameTimeMs Time the GPU spent on the scene, in milliseconds.
+    void Update(const float gpuFrameTimeMs);
+
+    /// @brief Restores the maximum scale and forgets past measurements.
+    void Reset();
+
+    /// @brief Gets the current scale.
+    /// @return The scale applied to each axis, between minScale and maxScale.
+    float GetScale() const;
+
+    /// @brief Gets the smoothed GPU frame time.
+    /// @return The smoothed time in milliseconds, 0 before the first update.
+    float GetSmoothedFrameTimeMs() const;
+
+    /// @brief Scales a full resolution extent, or returns it unchanged when disabled.
+    /// @param[in] fullExtent The output resolution.
+    /// @return The resolution to render the scene at, at least 1x1.
+    VkExtent2D GetRenderExtent(const VkExtent2D fullExtent) const;
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    static constexpr float SMOOTHING = 0.1f; /// @brief Weight of the newest sample in the moving average.
+    static constexpr float DEAD_BAND = 0.05f; /// @brief Relative distance from the target that is left alone.
+    static constexpr float MAX_STEP = 0.05f; /// @brief Largest scale change per update.
+
+    float scale{1.0f};
+    float smoothedFrameTimeMs{0.0f};
+
+    // Private Methods
+};
+
+} // namespace velecs
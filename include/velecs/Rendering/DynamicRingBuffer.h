@@ -0,0 +1,175 @@
+/// @file    DynamicRingBuffer.h
+/// @author  Matthew Green
+/// @date    2024-01-18 09:41:15
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/Memory/AllocatedBuffer.h"
+#include "velecs/Rendering/DescriptorAllocator.h"
+#include "velecs/Rendering/DescriptorLayoutCache.h"
+
+#include <vulkan/vulkan_core.h>
+
+#include <vma/vk_mem_alloc.h>
+
+#include <cstdint>
+#include <cstring>
+
+namespace velecs {
+
+/// @class DynamicRingBuffer
+/// @brief Persistently mapped buffer that hands out aligned sub-ranges for one frame's shader data.
+///
+/// Allocations bump a head through the buffer and are written in place, then read by shaders
+/// through one descriptor set whose two bindings are a dynamic uniform buffer and a dynamic
+/// storage buffer over the whole buffer. Selecting a range is a dynamic offset at bind time,
+/// so per-draw data never allocates memory or writes descriptors.
+///
+/// Reset rewinds the head once the fence of the frame that read the data has signalled.
+/// Every method except Init and Cleanup belongs to the render thread.
+class DynamicRingBuffer {
+public:
+    // Enums
+
+    /// @enum Usage
+    /// @brief Binding an allocation is read through, which decides its alignment.
+    enum class Usage {
+        Uniform, /// @brief Read through UNIFORM_BINDING, at most UNIFORM_RANGE bytes.
+        Storage /// @brief Read through STORAGE_BINDING, at most STORAGE_RANGE bytes.
+    };
+
+    // Public Fields
+
+    static constexpr VkDeviceSize DEFAULT_CAPACITY = 4 * 1024 * 1024; /// @brief Bytes available to one frame.
+    static constexpr VkDeviceSize UNIFORM_RANGE = 256; /// @brief Bytes visible through the uniform binding at each offset.
+    static constexpr VkDeviceSize STORAGE_RANGE = 64 * 1024; /// @brief Bytes visible through the storage binding at each offset.
+    static constexpr uint32_t UNIFORM_BINDING = 0; /// @brief Binding of the dynamic uniform buffer.
+    static constexpr uint32_t STORAGE_BINDING = 1; /// @brief Binding of the dynamic storage buffer.
+
+    /// @struct Allocation
+    /// @brief One sub-range of the buffer.
+    struct Allocation {
+        void* data{nullptr}; /// @brief Mapped address of the range.
+        uint32_t offset{0}; /// @brief Dynamic offset that selects the range when binding.
+    };
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    DynamicRingBuffer() = default;
+
+    /// @brief Default deconstructor.
+    ~DynamicRingBuffer() = default;
+
+    // Delete the copy constructor and assignment operator to prevent copies
+    DynamicRingBuffer(const DynamicRingBuffer&) = delete;
+    DynamicRingBuffer& operator=(const DynamicRingBuffer&) = delete;
+
+    // Public Methods
+
+    /// @brief Creates the buffer and the descriptor set that reads it.
+    /// @param[in] device The Vulkan device.
+    /// @param[in] physicalDevice The GPU, its limits decide the offset alignments.
+    /// @param[in] allocator The VMA allocator used for the buffer.
+    /// @param[in] layoutCache Cache the set layout is taken from, it keeps ownership of the layout.
+    /// @param[in] descriptorAllocator Allocator the set is taken from, it keeps ownership of the set.
+    /// @param[in] capacity Bytes available to one frame.
+    void Init
+    (
+        VkDevice device,
+        VkPhysicalDevice physicalDevice,
+        VmaAllocator allocator,
+        DescriptorLayoutCache& layoutCache,
+        DescriptorAllocator& descriptorAllocator,
+        const VkDeviceSize capacity = DEFAULT_CAPACITY
+    );
+
+    /// @brief Destroys the buffer.
+    void Cleanup();
+
+    /// @brief Rewinds the head, every allocation handed out so far becomes invalid.
+    ///
+    /// Only call this once the GPU has finished reading the previous frame.
+    void Reset();
+
+    /// @brief Reserves an aligned range.
+    /// @param[in] size Bytes to reserve.
+    /// @param[in] usage Binding the range is read through.
+    /// @return The mapped address and dynamic offset of the range.
+    /// @throws std::runtime_error if the range does not fit the binding or the frame is out of space.
+    Allocation Allocate(const VkDeviceSize size, const Usage usage = Usage::Uniform);
+
+    /// @brief Checks whether one more range fits this frame.
+    /// @param[in] usage Binding the range would be read through.
+    /// @return true if Allocate would not run out of space for a range of that binding.
+    bool HasRoom(const Usage usage = Usage::Uniform) const;
+
+    /// @brief Reserves a range and copies a value into it.
+    /// @tparam T A trivially copyable type laid out like its shader block.
+    /// @param[in] value The value to copy.
+    /// @param[in] usage Binding the value is read through.
+    /// @return The dynamic offset of the value.
+    template<typename T>
+    uint32_t Push(const T& value, const Usage usage = Usage::Uniform)
+    {
+        const Allocation allocation = Allocate(sizeof(T), usage);
+        std::memcpy(allocation.data, &value, sizeof(T));
+        return allocation.offset;
+    }
+
+    /// @brief Binds the set with the given dynamic offsets.
+    /// @param[in] cmd The command buffer being recorded.
+    /// @param[in] pipelineLayout A pipeline layout created with GetLayout() at set @p setIndex.
+    /// @param[in] uniformOffset Offset of the range read through UNIFORM_BINDING.
+    /// @param[in] storageOffset Offset of the range read through STORAGE_BINDING.
+    /// @param[in] setIndex The set number the layout expects the buffer at.
+    /// @param[in] bindPoint The pipeline bind point, compute passes read the ring too.
+    void Bind
+    (
+        VkCommandBuffer cmd,
+        VkPipelineLayout pipelineLayout,
+        const uint32_t uniformOffset,
+        const uint32_t storageOffset = 0,
+        const uint32_t setIndex = 2,
+        const VkPipelineBindPoint bindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS
+    ) const;
+
+    /// @brief Gets the descriptor set layout to include in pipeline layouts.
+    /// @return The descriptor set layout of the buffer.
+    VkDescriptorSetLayout GetLayout() const;
+
+    /// @brief Gets the bytes handed out since the last Reset, padding included.
+    /// @return The position of the head.
+    VkDeviceSize GetUsedBytes() const;
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    VmaAllocator allocator{nullptr}; /// @brief Allocator that owns the buffer.
+
+    AllocatedBuffer buffer; /// @brief Host visible buffer of capacity bytes.
+    uint8_t* mapped{nullptr}; /// @brief Persistent mapping of buffer.
+    VkDeviceSize capacity{0}; /// @brief Size of buffer.
+    VkDeviceSize head{0}; /// @brief First free byte.
+
+    VkDeviceSize uniformAlignment{256}; /// @brief minUniformBufferOffsetAlignment of the GPU.
+    VkDeviceSize storageAlignment{256}; /// @brief minStorageBufferOffsetAlignment of the GPU.
+
+    VkDescriptorSetLayout layout{VK_NULL_HANDLE}; /// @brief Owned by the layout cache.
+    VkDescriptorSet set{VK_NULL_HANDLE}; /// @brief Owned by the descriptor allocator.
+
+    // Private Methods
+};
+
+} // namespace velecs
@@ -0,0 +1,203 @@
+/// @file    FrameCapture.h
+/// @author  Matthew Green
+/// @date    2024-01-15 09:52:14
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/Memory/AllocatedBuffer.h"
+
+#include <vulkan/vulkan_core.h>
+
+#include <vma/vk_mem_alloc.h>
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace velecs {
+
+/// @class FrameCapture
+/// @brief Copies rendered frames into host-visible buffers and writes them to disk on a worker thread.
+///
+/// The render thread records an image to buffer copy at the end of the frame into one of
+/// RING_SIZE readback buffers. Once the frame's fence has been waited on anyway, the buffer
+/// is handed to the worker, which converts it to RGBA and encodes PNG or raw files, so the
+/// render thread never waits on the GPU or on the disk. When every buffer is still being
+/// encoded, screenshots are retried next frame and recorded frames are dropped and counted.
+///
+/// Capture, StartRecording and StopRecording may be called from any thread; RecordCopy and
+/// OnFrameRetired belong to the render thread.
+class FrameCapture {
+public:
+    // Enums
+
+    /// @enum Format
+    /// @brief File encoding of a capture.
+    enum class Format {
+        PNG, /// @brief Lossless PNG, slower to encode.
+        Raw, /// @brief Tightly packed RGBA8 rows, top to bottom, no header.
+    };
+
+    /// @enum Source
+    /// @brief Image a capture is taken from.
+    enum class Source {
+        Swapchain, /// @brief The presented image, ImGui included.
+        Scene, /// @brief The offscreen scene at render resolution, without ImGui. Falls back to Swapchain when the scene is rendered directly into it.
+    };
+
+    // Public Fields
+
+    static constexpr uint32_t RING_SIZE = 3; /// @brief Number of readback buffers.
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    FrameCapture() = default;
+
+    /// @brief Default deconstructor.
+    ~FrameCapture() = default;
+
+    // Delete the copy constructor and assignment operator to prevent copies
+    FrameCapture(const FrameCapture&) = delete;
+    FrameCapture& operator=(const FrameCapture&) = delete;
+
+    // Public Methods
+
+    /// @brief Starts the encoding thread.
+    /// @param[in] allocator The VMA allocator used for the readback buffers.
+    void Init(VmaAllocator allocator);
+
+    /// @brief Encodes every copy already retired, stops the thread and frees the readback buffers.
+    /// @details The GPU must be idle.
+    void Cleanup();
+
+    /// @brief Requests a single capture of the next frame.
+    /// @param[in] path File to write, its directory is created if needed.
+    /// @param[in] format Encoding of the file.
+    /// @param[in] source Image to capture.
+    void Capture(const std::string& path, const Format format = Format::PNG, const Source source = Source::Swapchain);
+
+    /// @brief Captures every frame into numbered files until StopRecording.
+    /// @param[in] directory Directory receiving Frame_000000 and following.
+    /// @param[in] format Encoding of the files, Raw keeps up with far higher frame rates.
+    /// @param[in] source Image to capture.
+    void StartRecording(const std::string& directory, const Format format = Format::Raw, const Source source = Source::Swapchain);
+
+    /// @brief Stops the recording started by StartRecording.
+    void StopRecording();
+
+    /// @brief Checks whether a recording is running.
+    /// @return Whether StartRecording was called without a matching StopRecording.
+    bool IsRecording() const;
+
+    /// @brief Gets the number of recorded frames skipped because every readback buffer was busy.
+    /// @return The count since the last StartRecording.
+    uint32_t GetDroppedFrameCount() const;
+
+    /// @brief Records the copy of @p image if a capture from @p source is pending.
+    /// @param[in] cmd The frame's command buffer, outside of any render pass.
+    /// @param[in] source Which capture source @p image is.
+    /// @param[in] image The image to copy, left in @p layout.
+    /// @param[in] layout Layout of @p image before and after the copy.
+    /// @param[in] format Format of @p image, only 8-bit RGBA and BGRA formats are supported.
+    /// @param[in] extent Size of the region to copy, from the image origin.
+    /// @param[in] servesScene Whether @p image also stands in for Source::Scene this frame.
+    void RecordCopy
+    (
+        VkCommandBuffer cmd,
+        const Source source,
+        VkImage image,
+        const VkImageLayout layout,
+        const VkFormat format,
+        const VkExtent2D extent,
+        const bool servesScene = false
+    );
+
+    /// @brief Hands copies recorded before the last fence wait to the encoding thread.
+    /// @details Call right after waiting on the fence of the previous frame.
+    void OnFrameRetired();
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    /// @enum SlotState
+    /// @brief Lifetime of a readback buffer.
+    enum class SlotState {
+        Free,
+        Recorded, /// @brief Copy recorded into a frame that may still be running.
+        Encoding, /// @brief Owned by the encoding thread.
+    };
+
+    /// @struct Request
+    /// @brief A pending single capture.
+    struct Request {
+        std::string path;
+        Format format{Format::PNG};
+        Source source{Source::Swapchain};
+    };
+
+    /// @struct Slot
+    /// @brief One readback buffer and the capture it holds.
+    struct Slot {
+        AllocatedBuffer buffer;
+        void* mapped{nullptr};
+        VkDeviceSize size{0};
+        std::atomic<SlotState> state{SlotState::Free};
+        std::string path;
+        Format format{Format::PNG};
+        VkExtent2D extent{0, 0};
+        bool swizzle{false}; /// @brief Whether the copy is BGRA and needs red and blue swapped.
+        bool announce{false}; /// @brief Whether to log the file once written, off for recorded frames.
+    };
+
+    VmaAllocator allocator{nullptr};
+    std::array<Slot, RING_SIZE> slots;
+
+    mutable std::mutex requestMutex; /// @brief Guards the requests and recording fields.
+    std::deque<Request> requests;
+    bool recording{false};
+    std::string recordingDirectory;
+    Format recordingFormat{Format::Raw};
+    Source recordingSource{Source::Swapchain};
+    uint32_t recordingFrame{0}; /// @brief Number of the next recorded file.
+    std::atomic<uint32_t> droppedFrames{0};
+
+    std::thread worker;
+    std::mutex workMutex; /// @brief Guards encodeQueue and stopping.
+    std::condition_variable workCondition;
+    std::deque<uint32_t> encodeQueue; /// @brief Slots waiting for the encoding thread.
+    bool stopping{false};
+
+    // Private Methods
+
+    /// @brief Loop run by the encoding thread until Cleanup.
+    void WorkerLoop();
+
+    /// @brief Converts and writes the capture held by a slot, then frees the slot.
+    /// @param[in] slotIndex The slot to encode.
+    void Encode(const uint32_t slotIndex);
+
+    /// @brief Makes sure a slot's buffer holds at least @p size bytes.
+    /// @param[in] slot The slot, which must be Free.
+    /// @param[in] size The number of bytes needed.
+    void Reserve(Slot& slot, const VkDeviceSize size);
+};
+
+} // namespace velecs
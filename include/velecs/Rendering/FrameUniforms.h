@@ -0,0 +1,55 @@
+/// @file    FrameUniforms.h
+/// @author  Matthew Green
+/// @date    2024-01-18 09:12:50
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include <glm/mat4x4.hpp>
+
+namespace velecs {
+
+/// @struct FrameUniforms
+/// @brief Shader data shared by every draw of a frame, read from the dynamic ring buffer.
+///
+/// The layout mirrors the `FrameUniforms` block declared in the vertex shaders (std140).
+struct FrameUniforms {
+public:
+    // Enums
+
+    // Public Fields
+
+    glm::mat4 viewProjection{1.0f}; /// @brief View-projection matrix of the camera.
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    FrameUniforms() = default;
+
+    /// @brief Constructor.
+    /// @param[in] viewProjection View-projection matrix of the camera.
+    explicit FrameUniforms(const glm::mat4& viewProjection)
+        : viewProjection(viewProjection) {}
+
+    /// @brief Default deconstructor.
+    ~FrameUniforms() = default;
+
+    // Public Methods
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    // Private Methods
+};
+
+} // namespace velecs
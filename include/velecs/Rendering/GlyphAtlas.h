@@ -0,0 +1,169 @@
+/// @file    GlyphAtlas.h
+/// @author  Matthew Green
+/// @date    2024-01-22 10:14:37
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include <glm/vec4.hpp>
+
+#include <stb_truetype.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace velecs {
+
+/// @class GlyphAtlas
+/// @brief Signed distance field glyphs of one font, rasterized on first use into a single channel atlas.
+///
+/// Glyphs are rendered once at GLYPH_PIXELS_PER_EM with stb_truetype's SDF rasterizer and
+/// shelf packed into an R8 image, so one atlas draws the font sharply at any size. The atlas
+/// only lives on the CPU; the rows written since the last TakeDirtyRows are what the renderer
+/// copies to the GPU image. Metrics are in ems with y up, the scale every label multiplies by.
+///
+/// When a glyph no longer fits the atlas is emptied and its generation advances, which tells
+/// every cached layout to lay itself out again. Not thread safe, it belongs to the simulation.
+class GlyphAtlas {
+public:
+    // Enums
+
+    // Public Fields
+
+    static constexpr uint32_t DEFAULT_SIZE = 1024; /// @brief Width and height of the atlas in texels.
+    static constexpr float GLYPH_PIXELS_PER_EM = 48.0f; /// @brief Size glyphs are rasterized at.
+    static constexpr int SDF_PADDING = 6; /// @brief Texels of distance field around each glyph, the widest outline the shaders can draw.
+    static constexpr unsigned char ON_EDGE_VALUE = 128; /// @brief Atlas value on the glyph outline, 0.5 once normalized.
+    static constexpr uint32_t GUTTER = 1; /// @brief Empty texels between packed glyphs, so filtering never reads a neighbour.
+
+    /// @struct Glyph
+    /// @brief Placement of one codepoint.
+    struct Glyph {
+        glm::vec4 rect{0.0f}; /// @brief Quad relative to the pen position in ems: left, bottom, right, top.
+        glm::vec4 uvRect{0.0f}; /// @brief Atlas area of the quad: left, top, right, bottom.
+        float advance{0.0f}; /// @brief Pen movement after the glyph in ems.
+        bool visible{false}; /// @brief Whether the glyph has a quad, whitespace only advances.
+    };
+
+    // Constructors and Destructors
+
+    /// @brief Constructor.
+    /// @param[in] fontData Contents of a TrueType or OpenType file, kept for the lifetime of the atlas.
+    /// @param[in] size Width and height of the atlas in texels.
+    /// @throws std::runtime_error if @p fontData is not a font stb_truetype can read.
+    explicit GlyphAtlas(std::vector<unsigned char> fontData, const uint32_t size = DEFAULT_SIZE);
+
+    /// @brief Default deconstructor.
+    ~GlyphAtlas() = default;
+
+    // Delete the copy constructor and assignment operator to prevent copies, fontInfo points into fontData
+    GlyphAtlas(const GlyphAtlas&) = delete;
+    GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+
+    // Public Methods
+
+    /// @brief Reads a font file into a new atlas.
+    /// @param[in] filePath Path of a .ttf or .otf file.
+    /// @param[in] size Width and height of the atlas in texels.
+    /// @return The atlas, with no glyphs yet.
+    /// @throws std::runtime_error if the file cannot be read or is not a font.
+    static std::unique_ptr<GlyphAtlas> Load(const std::string& filePath, const uint32_t size = DEFAULT_SIZE);
+
+    /// @brief Gets a glyph, rasterizing it into the atlas the first time it is asked for.
+    /// @param[in] codepoint The Unicode codepoint.
+    /// @return The glyph, valid until the atlas is emptied.
+    ///
+    /// A full atlas is emptied before the glyph is inserted, see GetGeneration.
+    const Glyph& GetGlyph(const uint32_t codepoint);
+
+    /// @brief Gets the kerning adjustment between two codepoints.
+    /// @param[in] left The codepoint drawn first.
+    /// @param[in] right The codepoint drawn after it.
+    /// @return Extra pen movement in ems, usually zero or negative.
+    float GetKerning(const uint32_t left, const uint32_t right) const;
+
+    /// @brief Gets the distance from the baseline to the top of the tallest glyphs.
+    /// @return The ascent in ems.
+    float GetAscent() const;
+
+    /// @brief Gets the distance between the baselines of two lines.
+    /// @return The line height in ems.
+    float GetLineHeight() const;
+
+    /// @brief Gets the counter advanced every time the atlas is emptied.
+    /// @return The generation, a layout made at another generation points at stale texels.
+    uint32_t GetGeneration() const;
+
+    /// @brief Gets the width and height of the atlas.
+    /// @return The size in texels.
+    uint32_t GetSize() const;
+
+    /// @brief Gets the texels of the atlas, row by row.
+    /// @return GetSize() * GetSize() bytes.
+    const std::vector<unsigned char>& GetPixels() const;
+
+    /// @brief Gets the rows written since the last call and forgets them.
+    /// @param[out] firstRow First written row.
+    /// @param[out] rowCount Number of written rows, every row in between included.
+    /// @return false if nothing was written.
+    bool TakeDirtyRows(uint32_t& firstRow, uint32_t& rowCount);
+
+    /// @brief Gets the number of glyphs in the atlas.
+    /// @return The number of codepoints asked for since the atlas was last emptied.
+    size_t GetGlyphCount() const;
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    std::vector<unsigned char> fontData; /// @brief The font file, fontInfo reads it in place.
+    stbtt_fontinfo fontInfo; /// @brief Parsed tables of fontData.
+    float pixelScale{0.0f}; /// @brief Font units to atlas texels.
+    float emScale{0.0f}; /// @brief Font units to ems.
+    float ascent{0.0f}; /// @brief Ascent in ems.
+    float lineHeight{0.0f}; /// @brief Ascent, descent and line gap in ems.
+
+    uint32_t size{0}; /// @brief Width and height of the atlas.
+    std::vector<unsigned char> pixels; /// @brief size * size texels, ON_EDGE_VALUE on the outlines.
+    std::unordered_map<uint32_t, Glyph> glyphs; /// @brief Every codepoint asked for, keyed by codepoint.
+    uint32_t generation{0}; /// @brief Advanced by Clear.
+
+    uint32_t shelfX{0}; /// @brief First free column of the current shelf.
+    uint32_t shelfY{0}; /// @brief Top row of the current shelf.
+    uint32_t shelfHeight{0}; /// @brief Height of the tallest glyph on the current shelf.
+
+    uint32_t dirtyBegin{UINT32_MAX}; /// @brief First row written since the last TakeDirtyRows.
+    uint32_t dirtyEnd{0}; /// @brief One past the last row written since the last TakeDirtyRows.
+
+    // Private Methods
+
+    /// @brief Rasterizes a codepoint and packs it into the atlas.
+    /// @param[in] codepoint The Unicode codepoint.
+    /// @return The placement of the glyph.
+    Glyph Rasterize(const uint32_t codepoint);
+
+    /// @brief Finds room for a block of texels on the shelves.
+    /// @param[in] width Width of the block, the gutter excluded.
+    /// @param[in] height Height of the block, the gutter excluded.
+    /// @param[out] x Column of the block.
+    /// @param[out] y Row of the block.
+    /// @return false if the atlas has no room left.
+    bool Allocate(const uint32_t width, const uint32_t height, uint32_t& x, uint32_t& y);
+
+    /// @brief Forgets every glyph and zeroes the texels.
+    void Clear();
+};
+
+} // namespace velecs
@@ -0,0 +1,59 @@
+/// @file    GlyphInstance.h
+/// @author  Matthew Green
+/// @date    2024-01-22 11:20:45
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include <glm/vec4.hpp>
+
+#include <cstdint>
+
+namespace velecs {
+
+/// @struct GlyphInstance
+/// @brief One glyph quad of a text label, read by Text/Text.vert.
+///
+/// Labels cache their laid out glyphs as instances and only set labelIndex each frame, so
+/// a label whose text does not change is never laid out again. The layout mirrors the
+/// `GlyphInstance` struct declared in Text/Text.vert (std430).
+struct GlyphInstance {
+public:
+    // Enums
+
+    // Public Fields
+
+    glm::vec4 rect{0.0f}; /// @brief Quad in the label's layout space in ems: left, bottom, right, top.
+    glm::vec4 uvRect{0.0f}; /// @brief Atlas area of the quad: left, top, right, bottom.
+    uint32_t labelIndex{0}; /// @brief Record of the label in the frame's TextLabelParams.
+    uint32_t _padding[3]{0, 0, 0}; /// @brief Pads the struct to 48 bytes for std430.
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    GlyphInstance() = default;
+
+    /// @brief Default deconstructor.
+    ~GlyphInstance() = default;
+
+    // Public Methods
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    // Private Methods
+};
+
+static_assert(sizeof(GlyphInstance) % 16 == 0, "GlyphInstance must match the std430 layout used by the text shaders.");
+
+} // namespace velecs
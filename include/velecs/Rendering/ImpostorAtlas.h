@@ -0,0 +1,62 @@
+/// @file    ImpostorAtlas.h
+/// @author  Matthew Green
+/// @date    2024-01-27 09:12:40
+///
+/// @section LICENSE
+///
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/Rendering/BindlessTable.h"
+
+#include <glm/vec3.hpp>
+
+#include <cstdint>
+
+namespace velecs {
+
+/// @struct ImpostorAtlas
+/// @brief A mesh pre-rendered from evenly spaced angles around its vertical axis.
+///
+/// Frame k looks at the mesh from the yaw 2 * pi * k / frameCount, frames are laid out
+/// left to right then top to bottom. Every frame covers the square of side 2 * radius
+/// around center, in the mesh's local space.
+struct ImpostorAtlas {
+public:
+    // Enums
+
+    // Public Fields
+
+    uint32_t colorTexture{BindlessTable::INVALID_INDEX}; /// @brief Slot of the albedo and coverage atlas in the bindless texture array.
+    uint32_t normalDepthTexture{BindlessTable::INVALID_INDEX}; /// @brief Slot of the view space normal and depth atlas.
+    uint32_t frameCount{0}; /// @brief Number of angles baked.
+    uint32_t columns{0}; /// @brief Frames per atlas row.
+    uint32_t rows{0}; /// @brief Frames per atlas column.
+    glm::vec3 center{0.0f}; /// @brief Center of the mesh bounds in local space.
+    float radius{0.0f}; /// @brief Radius of the sphere around the mesh bounds in local space.
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    ImpostorAtlas() = default;
+
+    /// @brief Default deconstructor.
+    ~ImpostorAtlas() = default;
+
+    // Public Methods
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    // Private Methods
+};
+
+} // namespace velecs
@@ -0,0 +1,80 @@
+/// @file    ImpostorBaker.h
+/// @author  Matthew Green
+/// @date    2024-01-27 09:20:16
+///
+/// @section LICENSE
+///
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/Rendering/ImpostorAtlas.h"
+#include "velecs/Rendering/SimpleVertex.h"
+#include "velecs/Rendering/TextureData.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace velecs {
+
+/// @class ImpostorBaker
+/// @brief Renders a mesh from several angles into the atlases an impostor billboard samples.
+///
+/// Baking runs on the CPU with a small depth tested rasterizer, so it can run at load
+/// time on any thread, or offline with the atlases saved alongside the mesh. Frames are
+/// orthographic views looking at the mesh from evenly spaced yaws around its local Y
+/// axis. The color atlas holds white albedo with coverage in alpha, tinted by the
+/// material when drawn. The normal and depth atlas holds the view space normal in RGB and
+/// the depth across the bounding sphere in alpha, 0 at the front.
+class ImpostorBaker {
+public:
+    // Enums
+
+    // Public Fields
+
+    static constexpr uint32_t DEFAULT_FRAME_COUNT = 16; /// @brief Angles baked when not told otherwise.
+    static constexpr uint32_t DEFAULT_FRAME_SIZE = 128; /// @brief Side of one frame in texels.
+
+    /// @struct Result
+    /// @brief The baked atlases, ready for RenderingECSModule::RegisterImpostor.
+    struct Result {
+        TextureData color; /// @brief RGBA8 albedo and coverage.
+        TextureData normalDepth; /// @brief RGBA8 normal and depth.
+        ImpostorAtlas atlas; /// @brief Layout of the frames, the texture slots are left unset.
+    };
+
+    // Constructors and Destructors
+
+    ImpostorBaker() = delete;
+
+    // Public Methods
+
+    /// @brief Bakes the atlases of a mesh.
+    /// @param[in] vertices Vertices of the mesh in local space.
+    /// @param[in] indices Triangle list indexing @p vertices.
+    /// @param[in] frameCount Number of angles to bake.
+    /// @param[in] frameSize Side of one frame in texels.
+    /// @return The atlases and their layout.
+    /// @throws std::runtime_error if the mesh has no triangles or an index is out of range.
+    static Result Bake
+    (
+        const std::vector<SimpleVertex>& vertices,
+        const std::vector<uint32_t>& indices,
+        const uint32_t frameCount = DEFAULT_FRAME_COUNT,
+        const uint32_t frameSize = DEFAULT_FRAME_SIZE
+    );
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    // Private Methods
+};
+
+} // namespace velecs
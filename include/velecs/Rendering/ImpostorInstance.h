@@ -0,0 +1,73 @@
+/// @file    ImpostorInstance.h
+/// @author  Matthew Green
+/// @date    2024-01-27 10:21:35
+///
+/// @section LICENSE
+///
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include <glm/vec4.hpp>
+
+#include <cstdint>
+
+namespace velecs {
+
+/// @struct ImpostorInstance
+/// @brief One impostor billboard, read by Impostor/Impostor.vert.
+///
+/// The two frames nearest the camera's yaw around the object are chosen on the CPU and
+/// blended in the fragment shader. The layout mirrors the `ImpostorInstance` struct
+/// declared in Impostor/Impostor.vert (std430).
+struct ImpostorInstance {
+public:
+    // Enums
+
+    // Public Fields
+
+    glm::vec4 center{0.0f}; /// @brief World space center of the bounding sphere in xyz, its world radius in w.
+    glm::vec4 color{1.0f}; /// @brief Material color the baked albedo is multiplied with.
+    uint32_t frameA{0}; /// @brief Atlas frame at or before the camera's yaw.
+    uint32_t frameB{0}; /// @brief Atlas frame after the camera's yaw.
+    float frameBlend{0.0f}; /// @brief Weight of frameB, 0 shows frameA alone.
+    float fade{1.0f}; /// @brief Share of the dithered pixels the impostor covers, the mesh covers the rest.
+    uint32_t _padding[4]{0, 0, 0, 0}; /// @brief Pads the struct to 64 bytes for std430.
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    ImpostorInstance() = default;
+
+    /// @brief Default deconstructor.
+    ~ImpostorInstance() = default;
+
+    // Public Methods
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    // Private Methods
+};
+
+static_assert(sizeof(ImpostorInstance) % 16 == 0, "ImpostorInstance must match the std430 layout used by the impostor shaders.");
+
+/// @struct ImpostorBatch
+/// @brief Impostors of one atlas, drawn with one instanced draw.
+struct ImpostorBatch {
+    uint32_t colorTexture{0}; /// @brief Slot of the atlas's albedo texture in the bindless texture array.
+    uint32_t normalDepthTexture{0}; /// @brief Slot of the atlas's normal and depth texture.
+    uint32_t columns{1}; /// @brief Frames per atlas row.
+    uint32_t rows{1}; /// @brief Frames per atlas column.
+    uint32_t firstInstance{0}; /// @brief First instance of the batch in the frame's impostors.
+    uint32_t instanceCount{0}; /// @brief Number of instances in the batch.
+};
+
+} // namespace velecs
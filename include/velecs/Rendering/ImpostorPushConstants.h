@@ -0,0 +1,57 @@
+/// @file    ImpostorPushConstants.h
+/// @author  Matthew Green
+/// @date    2024-01-27 10:30:52
+///
+/// @section LICENSE
+///
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include <glm/vec4.hpp>
+
+#include <cstdint>
+
+namespace velecs {
+
+/// @class ImpostorPushConstants
+/// @brief Per-batch data pushed to the impostor pipeline.
+///
+/// The camera is read from FrameUniforms like every scene pipeline, only its position is
+/// pushed to turn the billboards. Each batch draws the impostors of one atlas.
+class ImpostorPushConstants {
+public:
+    // Enums
+
+    // Public Fields
+
+    glm::vec4 cameraPosition{0.0f}; /// @brief World space position of the main camera, xyz only.
+    uint32_t colorTexture{0}; /// @brief Slot of the batch's albedo atlas in the bindless texture array.
+    uint32_t normalDepthTexture{0}; /// @brief Slot of the batch's normal and depth atlas.
+    uint32_t columns{1}; /// @brief Frames per atlas row.
+    uint32_t rows{1}; /// @brief Frames per atlas column.
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    ImpostorPushConstants() = default;
+
+    /// @brief Default deconstructor.
+    ~ImpostorPushConstants() = default;
+
+    // Public Methods
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    // Private Methods
+};
+
+} // namespace velecs
@@ -0,0 +1,63 @@
+/// @file    MaterialParams.h
+/// @author  Matthew Green
+/// @date    2024-01-06 14:31:05
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include <glm/vec4.hpp>
+
+#include <cstdint>
+
+namespace velecs {
+
+/// @struct MaterialParams
+/// @brief GPU-side material record stored in the bindless material storage buffer.
+///
+/// The layout mirrors the `MaterialParams` struct declared in the shaders (std430),
+/// so the size must stay a multiple of 16 bytes.
+struct MaterialParams {
+public:
+    // Enums
+
+    // Public Fields
+
+    glm::vec4 color{1.0f}; /// @brief Base color of the material, normalized RGBA.
+    uint32_t textureIndex{0}; /// @brief Slot of the base color texture in the bindless texture array.
+    uint32_t _padding[3]{0, 0, 0}; /// @brief Pads the struct to 32 bytes for std430.
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    MaterialParams() = default;
+
+    /// @brief Constructor.
+    /// @param[in] color Base color of the material.
+    /// @param[in] textureIndex Slot of the base color texture in the bindless texture array.
+    MaterialParams(const glm::vec4 color, const uint32_t textureIndex)
+        : color(color), textureIndex(textureIndex) {}
+
+    /// @brief Default deconstructor.
+    ~MaterialParams() = default;
+
+    // Public Methods
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    // Private Methods
+};
+
+static_assert(sizeof(MaterialParams) % 16 == 0, "MaterialParams must match the std430 layout used by the shaders.");
+
+} // namespace velecs
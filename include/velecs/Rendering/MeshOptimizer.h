@@ -0,0 +1,137 @@
+/// @file    MeshOptimizer.h
+/// @author  Matthew Green
+/// @date    2024-01-09 10:06:51
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/Rendering/SimpleVertex.h"
+#include "velecs/Rendering/Meshlet.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace velecs {
+
+/// @struct MeshOptimizer
+/// @brief Import time passes that make indexed triangle lists cheaper to draw.
+///
+/// Optimize runs every pass in order: weld duplicate vertices, reorder triangles for the
+/// post-transform vertex cache (Forsyth's linear-speed algorithm), reorder triangle clusters
+/// to draw outer surfaces first, and finally reorder vertices by first use for fetch locality.
+/// All passes are deterministic and keep the set of triangles and their winding.
+struct MeshOptimizer {
+public:
+    // Enums
+
+    // Public Fields
+
+    /// @struct VertexCacheStatistics
+    /// @brief Result of running an index buffer through a simulated FIFO vertex cache.
+    struct VertexCacheStatistics {
+        uint32_t vertexTransforms{0}; /// @brief Number of cache misses.
+        float acmr{0.0f}; /// @brief Average cache miss ratio, transforms per triangle, 0.5 at best and 3 at worst.
+        float atvr{0.0f}; /// @brief Average transform to vertex ratio, 1 at best.
+    };
+
+    /// @struct Report
+    /// @brief Before and after numbers of Optimize.
+    struct Report {
+        size_t verticesBefore{0};
+        size_t verticesAfter{0};
+        size_t trianglesBefore{0};
+        size_t trianglesAfter{0}; /// @brief Lower than trianglesBefore when welding collapsed degenerate triangles.
+        VertexCacheStatistics before;
+        VertexCacheStatistics after;
+    };
+
+    static constexpr uint32_t DEFAULT_CACHE_SIZE = 16; /// @brief FIFO size used for statistics, typical of current GPUs.
+    static constexpr float DEFAULT_OVERDRAW_THRESHOLD = 1.05f; /// @brief ACMR increase accepted in exchange for less overdraw.
+    static constexpr uint32_t DEFAULT_MESHLET_VERTICES = 64; /// @brief Vertices per meshlet, the common mesh shader limit.
+    static constexpr uint32_t DEFAULT_MESHLET_TRIANGLES = 124; /// @brief Triangles per meshlet, keeps the index data of one under 384 bytes.
+
+    // Constructors and Destructors
+
+    MeshOptimizer() = delete;
+
+    // Public Methods
+
+    /// @brief Runs every pass on a mesh.
+    /// @param[in,out] vertices Vertices of the mesh.
+    /// @param[in,out] indices Triangle list indices of the mesh.
+    /// @return Vertex and triangle counts and cache statistics before and after.
+    static Report Optimize(std::vector<SimpleVertex>& vertices, std::vector<uint32_t>& indices);
+
+    /// @brief Merges vertices with identical attributes and drops triangles that collapse.
+    /// @param[in,out] vertices Vertices of the mesh, compacted in order of first occurrence.
+    /// @param[in,out] indices Triangle list indices of the mesh.
+    static void WeldVertices(std::vector<SimpleVertex>& vertices, std::vector<uint32_t>& indices);
+
+    /// @brief Reorders triangles so vertices are reused while still in the post-transform cache.
+    /// @param[in,out] indices Triangle list indices of the mesh.
+    /// @param[in] vertexCount Number of vertices the indices refer to.
+    static void OptimizeVertexCache(std::vector<uint32_t>& indices, const size_t vertexCount);
+
+    /// @brief Reorders clusters of triangles so outward facing, outer surfaces draw first.
+    /// @param[in,out] indices Triangle list indices, already optimized for the vertex cache.
+    /// @param[in] vertices Vertices of the mesh.
+    /// @param[in] threshold Largest ACMR ratio over the input order accepted for the new order.
+    static void OptimizeOverdraw
+    (
+        std::vector<uint32_t>& indices,
+        const std::vector<SimpleVertex>& vertices,
+        const float threshold = DEFAULT_OVERDRAW_THRESHOLD
+    );
+
+    /// @brief Reorders vertices by first use in the index buffer and drops unused ones.
+    /// @param[in,out] vertices Vertices of the mesh.
+    /// @param[in,out] indices Triangle list indices, remapped to the new vertex order.
+    static void OptimizeVertexFetch(std::vector<SimpleVertex>& vertices, std::vector<uint32_t>& indices);
+
+    /// @brief Splits a triangle list into meshlets with their bounding spheres and normal cones.
+    /// @param[in] vertices Vertices of the mesh.
+    /// @param[in] indices Triangle list indices, best already optimized for the vertex cache.
+    /// @param[in] maxVertices Most distinct vertices in one meshlet, at least 3.
+    /// @param[in] maxTriangles Most triangles in one meshlet.
+    /// @return Meshlets covering @p indices in order, each a contiguous range of it.
+    ///
+    /// Triangles are taken in index order and a meshlet is closed once the next triangle
+    /// would break a limit, so the index buffer is left as it is. After OptimizeVertexCache
+    /// neighbouring triangles share vertices, which keeps the meshlets compact.
+    static std::vector<Meshlet> BuildMeshlets
+    (
+        const std::vector<SimpleVertex>& vertices,
+        const std::vector<uint32_t>& indices,
+        const uint32_t maxVertices = DEFAULT_MESHLET_VERTICES,
+        const uint32_t maxTriangles = DEFAULT_MESHLET_TRIANGLES
+    );
+
+    /// @brief Simulates a FIFO post-transform vertex cache.
+    /// @param[in] indices Triangle list indices.
+    /// @param[in] vertexCount Number of vertices the indices refer to.
+    /// @param[in] cacheSize Number of entries in the simulated cache.
+    /// @return The miss count and ratios.
+    static VertexCacheStatistics AnalyzeVertexCache
+    (
+        const std::vector<uint32_t>& indices,
+        const size_t vertexCount,
+        const uint32_t cacheSize = DEFAULT_CACHE_SIZE
+    );
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    // Private Methods
+};
+
+} // namespace velecs
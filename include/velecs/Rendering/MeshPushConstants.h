@@ -11,22 +11,28 @@
 #pragma once
 
 #include <glm/vec4.hpp>
-#include <glm/mat4x4.hpp>
+
+#include <cstdint>
 
 namespace velecs {
 
 /// @class MeshPushConstants
-/// @brief Brief description.
+/// @brief Per-draw data pushed to the mesh pipelines.
 ///
-/// Rest of description.
+/// Material values live in the bindless material buffer, world matrices in the
+/// transform buffer and the camera in the frame's FrameUniforms, the draw only carries
+/// the index of each record. Per-draw data larger than this belongs in DynamicRingBuffer.
 class MeshPushConstants {
 public:
     // Enums
 
     // Public Fields
 
-    glm::vec4 color;
-    glm::mat4 renderMatrix;
+    glm::vec4 positionOffset{0.0f}; /// @brief Added to vertex positions after positionScale, xyz only.
+    glm::vec4 positionScale{1.0f}; /// @brief Multiplies vertex positions, expands quantized positions back to the mesh bounds.
+    uint32_t materialIndex{0}; /// @brief Record of the draw's material in the bindless material buffer.
+    uint32_t transformIndex{0}; /// @brief Slot of the draw's world matrix in the transform buffer.
+    float fade{0.0f}; /// @brief Share of pixels the SimpleMeshFeatures::DITHER_FADE variants drop.
 
     // Constructors and Destructors
     
@@ -0,0 +1,61 @@
+/// @file    Meshlet.h
+/// @author  Matthew Green
+/// @date    2024-01-27 14:05:32
+///
+/// @section LICENSE
+///
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include <glm/vec4.hpp>
+
+#include <cstdint>
+
+namespace velecs {
+
+/// @struct Meshlet
+/// @brief A small cluster of a mesh's triangles, culled on its own.
+///
+/// A meshlet is a contiguous range of the mesh's index buffer, so any run of neighbouring
+/// meshlets is drawn with one indexed draw. The layout mirrors the `Meshlet` struct
+/// declared in Meshlets/Cull.comp (std430).
+struct Meshlet {
+public:
+    // Enums
+
+    // Public Fields
+
+    glm::vec4 sphere{0.0f}; /// @brief Center of the bounding sphere in local space in xyz, its radius in w.
+    glm::vec4 cone{0.0f, 0.0f, 0.0f, 1.0f}; /// @brief Average triangle normal in xyz, sine of the cone's half angle in w, 1 never culls.
+    uint32_t firstIndex{0}; /// @brief First index of the meshlet in the mesh's index buffer.
+    uint32_t indexCount{0}; /// @brief Three per triangle.
+    uint32_t vertexCount{0}; /// @brief Distinct vertices the triangles use.
+    uint32_t _padding{0}; /// @brief Pads the struct to 48 bytes for std430.
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    Meshlet() = default;
+
+    /// @brief Default deconstructor.
+    ~Meshlet() = default;
+
+    // Public Methods
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    // Private Methods
+};
+
+static_assert(sizeof(Meshlet) % 16 == 0, "Meshlet must match the std430 layout used by the cluster culling shader.");
+
+} // namespace velecs
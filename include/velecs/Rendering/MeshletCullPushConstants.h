@@ -0,0 +1,60 @@
+/// @file    MeshletCullPushConstants.h
+/// @author  Matthew Green
+/// @date    2024-01-27 14:22:08
+///
+/// @section LICENSE
+///
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include <glm/vec4.hpp>
+
+#include <cstdint>
+
+namespace velecs {
+
+/// @struct MeshletCullPushConstants
+/// @brief Push constants of Meshlets/Cull.comp, one dispatch per clustered mesh and view.
+///
+/// Everything is in the mesh's local space, so the meshlet bounds are tested as they were
+/// imported, see MeshletCuller::MakeCullConstants.
+struct MeshletCullPushConstants {
+public:
+    // Enums
+
+    // Public Fields
+
+    glm::vec4 planes[6]; /// @brief Frustum planes in local space, scaled so they measure world space distances.
+    glm::vec4 camera{0.0f}; /// @brief Camera position in local space in xyz, largest axis scale of the world matrix in w.
+    uint32_t meshletCount{0}; /// @brief Meshlets of the mesh, threads past it return early.
+    uint32_t firstCommand{0}; /// @brief Draw command of meshlet 0 in the frame's command buffer.
+    uint32_t coneCulling{0}; /// @brief Non-zero to also drop back-facing meshlets.
+    uint32_t _padding{0};
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    MeshletCullPushConstants() = default;
+
+    /// @brief Default deconstructor.
+    ~MeshletCullPushConstants() = default;
+
+    // Public Methods
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    // Private Methods
+};
+
+static_assert(sizeof(MeshletCullPushConstants) <= 128, "Push constants are only guaranteed 128 bytes.");
+
+} // namespace velecs
@@ -0,0 +1,160 @@
+/// @file    MeshletCuller.h
+/// @author  Matthew Green
+/// @date    2024-01-27 14:31:50
+///
+/// @section LICENSE
+///
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/Memory/AllocatedBuffer.h"
+#include "velecs/Math/Frustum.h"
+#include "velecs/Rendering/DescriptorAllocator.h"
+#include "velecs/Rendering/DescriptorLayoutCache.h"
+#include "velecs/Rendering/Meshlet.h"
+#include "velecs/Rendering/MeshletCullPushConstants.h"
+
+#include <vulkan/vulkan_core.h>
+
+#include <vma/vk_mem_alloc.h>
+
+#include <glm/vec3.hpp>
+#include <glm/mat4x4.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace velecs {
+
+/// @class MeshletCuller
+/// @brief Drops the meshlets of a clustered mesh that are outside a view or, when the mesh opts in, facing away from it.
+///
+/// Culling runs on the CPU by default: Cull merges the surviving meshlets into index ranges,
+/// each drawn with one indexed draw. RecordCulling runs the same test in Meshlets/Cull.comp
+/// instead, writing one indirect draw command per meshlet whose instance count is 0 when
+/// culled, and each mesh is then drawn with a single multi-draw indirect call.
+///
+/// The static methods are free of state and safe on any thread. RecordCulling belongs to
+/// the render thread.
+class MeshletCuller {
+public:
+    // Enums
+
+    // Public Fields
+
+    static constexpr uint32_t WORKGROUP_SIZE = 64; /// @brief local_size_x of Meshlets/Cull.comp.
+
+    static constexpr uint32_t MESHLETS_BINDING = 0; /// @brief Binding of the mesh's Meshlet records.
+    static constexpr uint32_t COMMANDS_BINDING = 1; /// @brief Binding of the frame's draw commands.
+
+    /// @struct IndexRange
+    /// @brief Neighbouring visible meshlets, drawn with one indexed draw.
+    struct IndexRange {
+        uint32_t firstIndex{0};
+        uint32_t indexCount{0};
+    };
+
+    /// @struct Dispatch
+    /// @brief Culling of one clustered mesh in one view this frame.
+    struct Dispatch {
+        VkBuffer meshlets{VK_NULL_HANDLE}; /// @brief Uploaded meshlet buffer of the SimpleMesh.
+        MeshletCullPushConstants constants; /// @brief View, meshlet count and first command of the mesh.
+    };
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    MeshletCuller() = default;
+
+    /// @brief Default deconstructor.
+    ~MeshletCuller() = default;
+
+    // Delete the copy constructor and assignment operator to prevent copies
+    MeshletCuller(const MeshletCuller&) = delete;
+    MeshletCuller& operator=(const MeshletCuller&) = delete;
+
+    // Public Methods
+
+    /// @brief Moves a view into the local space of a mesh.
+    /// @param[in] world The world matrix of the mesh.
+    /// @param[in] frustum The view's frustum in world space.
+    /// @param[in] cameraPosition The view's camera in world space.
+    /// @param[in] perspective Whether the view is drawn by a PerspectiveCamera.
+    /// @param[in] coneCulling Whether the mesh allows dropping back-facing meshlets, see SimpleMesh::_coneCulling.
+    /// @return Constants with every field but meshletCount and firstCommand set.
+    ///
+    /// Back-facing meshlets are only dropped for meshes that opt in, in perspective views and when
+    /// uniformly scaled, the normal cones do not survive a non-uniform scale.
+    static MeshletCullPushConstants MakeCullConstants
+    (
+        const glm::mat4& world,
+        const Frustum& frustum,
+        const glm::vec3& cameraPosition,
+        const bool perspective,
+        const bool coneCulling
+    );
+
+    /// @brief Checks whether any part of a meshlet may be seen.
+    /// @param[in] meshlet The meshlet, in the mesh's local space.
+    /// @param[in] constants The view, from MakeCullConstants.
+    /// @return false if the meshlet is outside a plane or faces away from the camera.
+    static bool IsVisible(const Meshlet& meshlet, const MeshletCullPushConstants& constants);
+
+    /// @brief Culls the meshlets of a mesh on the CPU.
+    /// @param[in] meshlets The mesh's meshlets, in index buffer order.
+    /// @param[in] constants The view, from MakeCullConstants.
+    /// @param[out] ranges Receives the visible index ranges, neighbouring meshlets merged.
+    /// @return Number of meshlets culled.
+    static uint32_t Cull(const std::vector<Meshlet>& meshlets, const MeshletCullPushConstants& constants, std::vector<IndexRange>& ranges);
+
+    /// @brief Creates the descriptor set layout and the culling pipeline.
+    /// @param[in] device The Vulkan device.
+    /// @param[in] allocator The VMA allocator the command buffer is created with.
+    /// @param[in] layoutCache Cache the set layout is created through.
+    void Init(VkDevice device, VmaAllocator allocator, DescriptorLayoutCache& layoutCache);
+
+    /// @brief Destroys the command buffer and every Vulkan object owned by the culler.
+    void Cleanup();
+
+    /// @brief Records one dispatch per clustered mesh and view, outside of any render pass.
+    /// @param[in] cmd The command buffer being recorded.
+    /// @param[in] frameDescriptorAllocator Allocator of sets that live for one frame.
+    /// @param[in] dispatches The meshes to cull.
+    /// @param[in] commandCount Draw commands the dispatches write, one per meshlet.
+    ///
+    /// The command buffer is reused every frame, so the previous frame must have retired.
+    /// @throws std::runtime_error if the command buffer cannot be grown.
+    void RecordCulling
+    (
+        VkCommandBuffer cmd,
+        DescriptorAllocator& frameDescriptorAllocator,
+        const std::vector<Dispatch>& dispatches,
+        const uint32_t commandCount
+    );
+
+    /// @brief Gets the buffer the draws read their commands from.
+    /// @return The command buffer written by the last RecordCulling.
+    VkBuffer GetCommandBuffer() const;
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    VkDevice device{VK_NULL_HANDLE}; /// @brief Handle to the Vulkan device.
+    VmaAllocator allocator{nullptr}; /// @brief Allocator that owns commandBuffer.
+    VkDescriptorSetLayout layout{VK_NULL_HANDLE}; /// @brief Owned by the layout cache.
+    VkPipelineLayout pipelineLayout{VK_NULL_HANDLE};
+    VkPipeline pipeline{VK_NULL_HANDLE};
+
+    AllocatedBuffer commandBuffer; /// @brief VkDrawIndexedIndirectCommand of every meshlet of the frame, render thread only.
+    VkDeviceSize commandCapacity{0};
+};
+
+} // namespace velecs
@@ -0,0 +1,150 @@
+/// @file    OcclusionBuffer.h
+/// @author  Matthew Green
+/// @date    2024-01-07 13:37:52
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/Math/AABB.h"
+#include "velecs/Rendering/SimpleVertex.h"
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace velecs {
+
+class ThreadPool;
+
+/// @class OcclusionBuffer
+/// @brief Low resolution software depth buffer used to cull objects hidden behind occluders.
+///
+/// Occluder triangles are projected on the calling thread, binned into screen tiles and then
+/// rasterized one tile per job, so every pixel is only ever written by a single thread. Each
+/// triangle writes its farthest vertex depth, which keeps the buffer conservative: an object
+/// is only reported hidden if it is behind an occluder at every pixel its bounds cover.
+/// The buffer has no GPU dependencies and gives the same result for any thread count.
+class OcclusionBuffer {
+public:
+    // Enums
+
+    // Public Fields
+
+    static constexpr uint32_t TILE_WIDTH = 32; /// @brief Width of a tile in pixels, a multiple of 4 for the SIMD paths.
+    static constexpr uint32_t TILE_HEIGHT = 16; /// @brief Height of a tile in pixels.
+    static constexpr uint32_t DEFAULT_WIDTH = 256; /// @brief Default buffer width in pixels.
+    static constexpr uint32_t DEFAULT_HEIGHT = 128; /// @brief Default buffer height in pixels.
+
+    // Constructors and Destructors
+
+    /// @brief Constructor.
+    /// @param[in] width Buffer width in pixels, rounded up to a multiple of TILE_WIDTH.
+    /// @param[in] height Buffer height in pixels, rounded up to a multiple of TILE_HEIGHT.
+    OcclusionBuffer(const uint32_t width = DEFAULT_WIDTH, const uint32_t height = DEFAULT_HEIGHT);
+
+    /// @brief Default deconstructor.
+    ~OcclusionBuffer() = default;
+
+    // Public Methods
+
+    /// @brief Changes the buffer resolution and clears it.
+    /// @param[in] width Buffer width in pixels, rounded up to a multiple of TILE_WIDTH.
+    /// @param[in] height Buffer height in pixels, rounded up to a multiple of TILE_HEIGHT.
+    void Resize(const uint32_t width, const uint32_t height);
+
+    /// @brief Discards every occluder and resets the depth buffer to the far plane.
+    void Clear();
+
+    /// @brief Projects the triangles of an occluder mesh and queues them for rasterization.
+    /// @param[in] renderMatrix Matrix taking mesh positions to clip space.
+    /// @param[in] vertices Vertices of the mesh.
+    /// @param[in] indices Triangle list indices of the mesh.
+    /// @throws std::runtime_error if an index is out of range.
+    ///
+    /// Triangles crossing the near plane are dropped, which can only make the culling less aggressive.
+    void AddOccluder
+    (
+        const glm::mat4& renderMatrix,
+        const std::vector<SimpleVertex>& vertices,
+        const std::vector<uint32_t>& indices
+    );
+
+    /// @brief Rebuilds the depth buffer from the queued occluders.
+    /// @param[in] threadPool Pool whose threads rasterize the tiles.
+    void Rasterize(ThreadPool& threadPool);
+
+    /// @brief Tests a bounding box against the depth buffer.
+    /// @param[in] renderMatrix Matrix taking the box to clip space.
+    /// @param[in] bounds The box in the space @p renderMatrix expects.
+    /// @return false if the box is off screen or behind occluders everywhere it covers, true otherwise.
+    bool IsVisible(const glm::mat4& renderMatrix, const AABB& bounds) const;
+
+    /// @brief Gets the buffer width.
+    /// @return The width in pixels.
+    uint32_t GetWidth() const;
+
+    /// @brief Gets the buffer height.
+    /// @return The height in pixels.
+    uint32_t GetHeight() const;
+
+    /// @brief Reads one pixel of the depth buffer.
+    /// @param[in] x Column of the pixel.
+    /// @param[in] y Row of the pixel.
+    /// @return Depth in [0, 1], 1 where no occluder was drawn.
+    float GetDepth(const uint32_t x, const uint32_t y) const;
+
+    /// @brief Gets the number of occluder triangles queued since the last Clear.
+    /// @return The triangle count.
+    size_t GetTriangleCount() const;
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    /// @struct Triangle
+    /// @brief Screen space triangle ready for rasterization.
+    struct Triangle {
+        float edgeA[3]; /// @brief X coefficient of each edge function.
+        float edgeB[3]; /// @brief Y coefficient of each edge function.
+        float edgeC[3]; /// @brief Constant term of each edge function.
+        float depth; /// @brief Farthest vertex depth, written to every covered pixel.
+        int32_t minX, minY, maxX, maxY; /// @brief Inclusive pixel bounds, clamped to the buffer.
+    };
+
+    // Private Fields
+
+    static constexpr float MIN_CLIP_W = 1e-4f; /// @brief Smallest clip space w treated as in front of the camera.
+
+    uint32_t width{0};
+    uint32_t height{0};
+    uint32_t tilesX{0};
+    uint32_t tilesY{0};
+
+    std::vector<float> depthBuffer; /// @brief Row major depth values, width * height.
+    std::vector<Triangle> triangles; /// @brief Occluder triangles in submission order.
+    std::vector<std::vector<uint32_t>> tileBins; /// @brief Indices into triangles overlapping each tile.
+    std::vector<glm::vec3> projectedVertices; /// @brief Scratch space for AddOccluder.
+
+    // Private Methods
+
+    /// @brief Sets up the edge functions of a screen space triangle and queues it.
+    /// @param[in] a First vertex, x and y in pixels and z as depth.
+    /// @param[in] b Second vertex.
+    /// @param[in] c Third vertex.
+    void AddTriangle(const glm::vec3 a, const glm::vec3 b, const glm::vec3 c);
+
+    /// @brief Clears one tile and rasterizes every triangle binned to it.
+    /// @param[in] tileIndex Index of the tile, row major.
+    void RasterizeTile(const uint32_t tileIndex);
+};
+
+} // namespace velecs
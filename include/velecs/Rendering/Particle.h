@@ -0,0 +1,62 @@
+/// @file    Particle.h
+/// @author  Matthew Green
+/// @date    2024-01-20 09:41:12
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include <glm/vec4.hpp>
+
+#include <cstdint>
+
+namespace velecs {
+
+/// @struct Particle
+/// @brief One live particle in the particle storage buffers.
+///
+/// The layout mirrors the `Particle` struct declared in the particle shaders (std430) and is
+/// shared with ParticleSystem::Simulate, the CPU fallback. Everything the particle needs after
+/// it spawned is copied in from its emitter, so it never looks the emitter up again.
+struct Particle {
+public:
+    // Enums
+
+    // Public Fields
+
+    glm::vec4 positionAge{0.0f}; /// @brief World position in xyz, seconds since it spawned in w.
+    glm::vec4 velocityLifetime{0.0f}; /// @brief Velocity in xyz, seconds it lives for in w.
+    glm::vec4 accelerationDrag{0.0f}; /// @brief Constant acceleration in xyz, fraction of velocity lost per second in w.
+    uint32_t startColor{0xFFFFFFFF}; /// @brief RGBA8 color at spawn, red in the lowest byte like unpackUnorm4x8 expects.
+    uint32_t endColor{0x00FFFFFF}; /// @brief RGBA8 color when it dies.
+    float startSize{0.1f}; /// @brief Width of the billboard at spawn, in world units.
+    float endSize{0.0f}; /// @brief Width of the billboard when it dies.
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    Particle() = default;
+
+    /// @brief Default deconstructor.
+    ~Particle() = default;
+
+    // Public Methods
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    // Private Methods
+};
+
+static_assert(sizeof(Particle) == 64, "Particle must match the std430 layout used by the particle shaders.");
+
+} // namespace velecs
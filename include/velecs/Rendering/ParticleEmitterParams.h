@@ -0,0 +1,66 @@
+/// @file    ParticleEmitterParams.h
+/// @author  Matthew Green
+/// @date    2024-01-20 09:58:40
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include <glm/vec4.hpp>
+
+#include <cstdint>
+
+namespace velecs {
+
+/// @struct ParticleEmitterParams
+/// @brief What one emitter spawns this frame, read by the particle simulation.
+///
+/// Built from each ParticleEmitter component on the simulation thread and written into the
+/// frame's DynamicRingBuffer as a storage range. The layout mirrors the `ParticleEmitterParams`
+/// struct declared in Particles/Simulate.comp (std430).
+struct ParticleEmitterParams {
+public:
+    // Enums
+
+    // Public Fields
+
+    glm::vec4 position{0.0f}; /// @brief World position particles spawn at, xyz only.
+    glm::vec4 velocitySpread{0.0f}; /// @brief Base velocity in xyz, length of the random velocity added to it in w.
+    glm::vec4 accelerationDrag{0.0f}; /// @brief Copied into every particle, see Particle::accelerationDrag.
+    uint32_t startColor{0xFFFFFFFF}; /// @brief Copied into every particle, see Particle::startColor.
+    uint32_t endColor{0x00FFFFFF}; /// @brief Copied into every particle, see Particle::endColor.
+    float startSize{0.1f}; /// @brief Copied into every particle, see Particle::startSize.
+    float endSize{0.0f}; /// @brief Copied into every particle, see Particle::endSize.
+    uint32_t spawnOffset{0}; /// @brief Number of particles spawned by the emitters before this one this frame.
+    uint32_t spawnCount{0}; /// @brief Number of particles this emitter spawns this frame.
+    float lifetime{1.0f}; /// @brief Longest lifetime of a particle, each one loses up to a quarter of it at random.
+    uint32_t seed{0}; /// @brief Keeps emitters spawning at the same frame from drawing the same random numbers.
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    ParticleEmitterParams() = default;
+
+    /// @brief Default deconstructor.
+    ~ParticleEmitterParams() = default;
+
+    // Public Methods
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    // Private Methods
+};
+
+static_assert(sizeof(ParticleEmitterParams) % 16 == 0, "ParticleEmitterParams must match the std430 layout used by the particle shaders.");
+
+} // namespace velecs
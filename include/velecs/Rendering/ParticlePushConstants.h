@@ -0,0 +1,52 @@
+/// @file    ParticlePushConstants.h
+/// @author  Matthew Green
+/// @date    2024-01-20 10:11:52
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include <glm/vec4.hpp>
+
+namespace velecs {
+
+/// @class ParticlePushConstants
+/// @brief Per-draw data pushed to the particle billboard pipeline.
+///
+/// The camera's view-projection comes from the frame's FrameUniforms like every other
+/// pipeline; the billboards only need the camera axes to face it.
+class ParticlePushConstants {
+public:
+    // Enums
+
+    // Public Fields
+
+    glm::vec4 cameraRight{1.0f, 0.0f, 0.0f, 0.0f}; /// @brief World space right axis of the camera, xyz only.
+    glm::vec4 cameraUp{0.0f, 1.0f, 0.0f, 0.0f}; /// @brief World space up axis of the camera, xyz only.
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    ParticlePushConstants() = default;
+
+    /// @brief Default deconstructor.
+    ~ParticlePushConstants() = default;
+
+    // Public Methods
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    // Private Methods
+};
+
+} // namespace velecs
@@ -0,0 +1,55 @@
+/// @file    ParticleSimulationParams.h
+/// @author  Matthew Green
+/// @date    2024-01-20 10:06:18
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include <cstdint>
+
+namespace velecs {
+
+/// @struct ParticleSimulationParams
+/// @brief Per-frame values pushed to Particles/Simulate.comp.
+///
+/// The layout mirrors the push constant block of the shader. ParticleSystem::Simulate takes
+/// the same struct, so the CPU fallback runs on exactly what the GPU would have seen.
+struct ParticleSimulationParams {
+public:
+    // Enums
+
+    // Public Fields
+
+    float deltaTime{0.0f}; /// @brief Seconds simulated this frame.
+    uint32_t emitterCount{0}; /// @brief Number of ParticleEmitterParams records to spawn from.
+    uint32_t spawnCount{0}; /// @brief Particles spawned by every emitter together, never more than capacity.
+    uint32_t capacity{0}; /// @brief Size of each particle buffer, particles past it are dropped.
+    uint32_t frameSeed{0}; /// @brief Changes every frame so emitters do not repeat their random numbers.
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    ParticleSimulationParams() = default;
+
+    /// @brief Default deconstructor.
+    ~ParticleSimulationParams() = default;
+
+    // Public Methods
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    // Private Methods
+};
+
+} // namespace velecs
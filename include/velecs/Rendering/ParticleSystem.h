@@ -0,0 +1,191 @@
+/// @file    ParticleSystem.h
+/// @author  Matthew Green
+/// @date    2024-01-20 11:02:37
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/Memory/AllocatedBuffer.h"
+#include "velecs/Rendering/Particle.h"
+#include "velecs/Rendering/ParticleEmitterParams.h"
+#include "velecs/Rendering/ParticleSimulationParams.h"
+#include "velecs/Rendering/DescriptorAllocator.h"
+#include "velecs/Rendering/DescriptorLayoutCache.h"
+#include "velecs/Rendering/DynamicRingBuffer.h"
+
+#include <vulkan/vulkan_core.h>
+
+#include <vma/vk_mem_alloc.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace velecs {
+
+/// @class ParticleSystem
+/// @brief Particles that live in GPU storage buffers and are drawn with one indirect draw.
+///
+/// Two particle buffers take turns: each frame Particles/Simulate.comp reads the live
+/// particles of one, integrates them, drops the dead ones and appends the survivors and
+/// the newly spawned particles to the other. The append counter of each buffer doubles as
+/// the instance count of a VkDrawIndirectCommand, so the CPU never reads the particle count
+/// back and the billboards are drawn straight from the buffer the simulation just wrote.
+///
+/// With CPU simulation, Simulate runs the same step on the render thread over the same
+/// Particle layout and the result is copied into the buffer the draw reads, so the
+/// simulation can be tested, and the effects still work, without the compute path.
+///
+/// Every method except Init, Cleanup and Simulate belongs to the render thread.
+class ParticleSystem {
+public:
+    // Enums
+
+    // Public Fields
+
+    static constexpr uint32_t DEFAULT_CAPACITY = 65536; /// @brief Particles alive at once, 4 MiB per buffer.
+    static constexpr uint32_t MAX_EMITTERS = 256; /// @brief Emitters simulated per frame, extra emitters are skipped.
+    static constexpr uint32_t WORKGROUP_SIZE = 64; /// @brief local_size_x of Particles/Simulate.comp.
+    static constexpr uint32_t VERTICES_PER_PARTICLE = 6; /// @brief Each billboard is two triangles expanded in the vertex shader.
+
+    static constexpr uint32_t SOURCE_BINDING = 0; /// @brief Binding of the particles read by the simulation.
+    static constexpr uint32_t DESTINATION_BINDING = 1; /// @brief Binding of the particles written by the simulation.
+    static constexpr uint32_t SOURCE_COUNTER_BINDING = 2; /// @brief Binding of the draw command holding the source count.
+    static constexpr uint32_t DESTINATION_COUNTER_BINDING = 3; /// @brief Binding of the draw command the simulation appends to.
+    static constexpr uint32_t PARTICLES_BINDING = 0; /// @brief Binding of the particles in the render set.
+
+    static_assert(sizeof(ParticleEmitterParams) * MAX_EMITTERS <= DynamicRingBuffer::STORAGE_RANGE,
+        "Every emitter of a frame must be visible through one storage range of the frame ring.");
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    ParticleSystem() = default;
+
+    /// @brief Default deconstructor.
+    ~ParticleSystem() = default;
+
+    // Delete the copy constructor and assignment operator to prevent copies
+    ParticleSystem(const ParticleSystem&) = delete;
+    ParticleSystem& operator=(const ParticleSystem&) = delete;
+
+    // Public Methods
+
+    /// @brief Creates the particle and counter buffers, their descriptor sets and the simulation pipeline.
+    /// @param[in] device The Vulkan device.
+    /// @param[in] allocator The VMA allocator used for every buffer.
+    /// @param[in] layoutCache Cache the set layouts are created through.
+    /// @param[in] descriptorAllocator Allocator of sets that live as long as the renderer.
+    /// @param[in] frameLayout Layout of the frame ring, the emitters of a frame are read through it.
+    /// @param[in] useCpuSimulation Runs Simulate on the render thread instead of the compute shader.
+    /// @param[in] capacity Particles alive at once.
+    void Init
+    (
+        VkDevice device,
+        VmaAllocator allocator,
+        DescriptorLayoutCache& layoutCache,
+        DescriptorAllocator& descriptorAllocator,
+        VkDescriptorSetLayout frameLayout,
+        const bool useCpuSimulation,
+        const uint32_t capacity = DEFAULT_CAPACITY
+    );
+
+    /// @brief Destroys every Vulkan object owned by the system.
+    void Cleanup();
+
+    /// @brief Records one simulation step, outside of any render pass.
+    /// @param[in] cmd The command buffer being recorded.
+    /// @param[in] frameRing Ring of the frame, the emitters are written into it.
+    /// @param[in] emitters What each emitter spawns this frame, with spawnOffset already set.
+    /// @param[in] deltaTime Seconds to simulate.
+    ///
+    /// The buffers are reused every frame, so the previous frame must have retired.
+    void RecordSimulation
+    (
+        VkCommandBuffer cmd,
+        DynamicRingBuffer& frameRing,
+        const std::vector<ParticleEmitterParams>& emitters,
+        const float deltaTime
+    );
+
+    /// @brief Binds the particles written by the last simulation step and draws them.
+    /// @param[in] cmd The command buffer being recorded, inside the scene render pass.
+    /// @param[in] pipelineLayout A pipeline layout created with GetRenderLayout() at set @p setIndex.
+    /// @param[in] setIndex The set number the layout expects the particles at.
+    void RecordDraw(VkCommandBuffer cmd, VkPipelineLayout pipelineLayout, const uint32_t setIndex = 1) const;
+
+    /// @brief Runs one simulation step on the CPU, the same step Particles/Simulate.comp runs.
+    /// @param[in] source Live particles of the last step.
+    /// @param[in] sourceCount Number of particles in @p source.
+    /// @param[out] destination Receives the survivors and the spawned particles, room for params.capacity.
+    /// @param[in] emitters params.emitterCount records.
+    /// @param[in] params The values the compute shader would have been pushed.
+    /// @return Number of particles written to @p destination.
+    ///
+    /// The GPU appends in no particular order, so only the set of particles is comparable.
+    static uint32_t Simulate
+    (
+        const Particle* source,
+        const uint32_t sourceCount,
+        Particle* destination,
+        const ParticleEmitterParams* emitters,
+        const ParticleSimulationParams& params
+    );
+
+    /// @brief Gets the descriptor set layout to include in the billboard pipeline layout.
+    /// @return The descriptor set layout of the render sets.
+    VkDescriptorSetLayout GetRenderLayout() const;
+
+    /// @brief Gets the number of particles that can be alive at once.
+    /// @return The capacity given to Init.
+    uint32_t GetCapacity() const;
+
+    /// @brief Gets whether the simulation runs on the CPU.
+    /// @return The value given to Init.
+    bool IsCpuSimulated() const;
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    VkDevice device{VK_NULL_HANDLE}; /// @brief Handle to the Vulkan device.
+    VmaAllocator allocator{nullptr}; /// @brief Allocator that owns every buffer.
+    uint32_t capacity{0}; /// @brief Particles each buffer holds.
+    bool cpuSimulation{false}; /// @brief Whether Simulate replaces the compute shader.
+
+    AllocatedBuffer particleBuffers[2]; /// @brief Storage buffers of capacity particles, read and written in turn.
+    AllocatedBuffer counterBuffers[2]; /// @brief VkDrawIndirectCommand of each particle buffer, instanceCount is its particle count.
+    uint32_t current{0}; /// @brief Buffer holding the particles of the last step.
+    uint32_t frameSeed{0}; /// @brief Incremented every step.
+    bool sourceCounterCleared{false}; /// @brief Whether the first compute step has cleared the count it reads.
+
+    VkDescriptorSetLayout simulationLayout{VK_NULL_HANDLE}; /// @brief Owned by the layout cache.
+    VkDescriptorSetLayout renderLayout{VK_NULL_HANDLE}; /// @brief Owned by the layout cache.
+    VkDescriptorSet simulationSets[2]{VK_NULL_HANDLE, VK_NULL_HANDLE}; /// @brief Set i reads buffer i and writes the other one.
+    VkDescriptorSet renderSets[2]{VK_NULL_HANDLE, VK_NULL_HANDLE}; /// @brief Set i reads buffer i.
+    VkPipelineLayout simulationPipelineLayout{VK_NULL_HANDLE};
+    VkPipeline simulationPipeline{VK_NULL_HANDLE};
+
+    AllocatedBuffer stagingBuffer; /// @brief Source of the copies of CPU simulated particles, CPU simulation only.
+    Particle* mappedStaging{nullptr}; /// @brief Persistent mapping of stagingBuffer.
+    std::vector<Particle> cpuParticles[2]; /// @brief CPU copy of each particle buffer, CPU simulation only.
+    uint32_t cpuCounts[2]{0, 0}; /// @brief Particles alive in each CPU copy.
+
+    // Private Methods
+
+    /// @brief Records the dispatch of Particles/Simulate.comp.
+    void RecordGpuSimulation(VkCommandBuffer cmd, DynamicRingBuffer& frameRing, const std::vector<ParticleEmitterParams>& emitters, const ParticleSimulationParams& params);
+
+    /// @brief Runs Simulate and records the copy of its result.
+    void RecordCpuSimulation(VkCommandBuffer cmd, const std::vector<ParticleEmitterParams>& emitters, const ParticleSimulationParams& params);
+};
+
+} // namespace velecs
@@ -37,6 +37,7 @@ public:
     VkPipelineMultisampleStateCreateInfo _multisampling; /// @brief Multisampling state parameters.
     VkPipelineLayout _pipelineLayout{VK_NULL_HANDLE}; /// @brief The layout of the pipeline, describing shader stages and more.
     VkPipelineDepthStencilStateCreateInfo _depthStencil;
+    const VkPipelineRenderingCreateInfoKHR* _renderingInfo{nullptr}; /// @brief Attachment formats for dynamic rendering, the render pass is ignored when set.
 
     // Constructors and Destructors
     
@@ -45,7 +46,7 @@ public:
     /// @brief Builds and returns a Vulkan pipeline using the specified device and render pass.
     ///
     /// @param device The Vulkan device to use for pipeline creation.
-    /// @param pass The render pass with which this pipeline will be used.
+    /// @param pass The render pass with which this pipeline will be used, or VK_NULL_HANDLE when _renderingInfo is set.
     /// @return The created Vulkan pipeline.
     VkPipeline BuildPipeline(VkDevice device, VkRenderPass pass);
 
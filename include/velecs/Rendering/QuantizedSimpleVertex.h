@@ -0,0 +1,65 @@
+/// @file    QuantizedSimpleVertex.h
+/// @author  Matthew Green
+/// @date    2024-01-08 11:14:40
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/Math/AABB.h"
+#include "velecs/Rendering/VertexInputAttributeDescriptor.h"
+
+#include <glm/vec3.hpp>
+
+#include <cstdint>
+
+namespace velecs {
+
+/// @struct QuantizedSimpleVertex
+/// @brief 8-byte SimpleVertex with the position stored relative to the mesh bounds.
+///
+/// The position is read as VK_FORMAT_R16G16B16A16_UNORM, so it arrives in the shader in [0, 1]
+/// and the same shaders as SimpleVertex work once the push constants carry the bounds as the
+/// position offset and scale. The fourth component pads the attribute to a
+/// format every GPU supports for vertex input.
+struct QuantizedSimpleVertex {
+public:
+    // Enums
+
+    // Public Fields
+
+    uint16_t position[4]{0, 0, 0, 0};
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    QuantizedSimpleVertex() = default;
+
+    /// @brief Constructor.
+    /// @param[in] position The full precision position.
+    /// @param[in] bounds Bounds of the mesh the vertex belongs to.
+    QuantizedSimpleVertex(const glm::vec3 position, const AABB& bounds);
+
+    /// @brief Default deconstructor.
+    ~QuantizedSimpleVertex() = default;
+
+    // Public Methods
+
+    static VertexInputAttributeDescriptor GetVertexDescription();
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    // Private Methods
+};
+
+} // namespace velecs
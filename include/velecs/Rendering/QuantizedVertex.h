@@ -0,0 +1,67 @@
+/// @file    QuantizedVertex.h
+/// @author  Matthew Green
+/// @date    2024-01-08 11:32:17
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/Graphics/Color32.h"
+#include "velecs/Math/AABB.h"
+#include "velecs/Rendering/Vertex.h"
+#include "velecs/Rendering/VertexInputAttributeDescriptor.h"
+
+#include <cstdint>
+
+namespace velecs {
+
+/// @struct QuantizedVertex
+/// @brief 20-byte Vertex, compared to 36 bytes at full precision.
+///
+/// Locations match Vertex, but the position is R16G16B16A16_UNORM relative to the mesh
+/// bounds, the normal is an R16G16_SNORM octahedral encoding that the vertex shader has to
+/// unfold, and the texture coordinates are R16G16_SFLOAT.
+struct QuantizedVertex {
+public:
+    // Enums
+
+    // Public Fields
+
+    uint16_t position[4]{0, 0, 0, 0};
+    int16_t normal[2]{0, 0};
+    Color32 color{Color32::MAGENTA};
+    uint16_t uv[2]{0, 0};
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    QuantizedVertex() = default;
+
+    /// @brief Constructor.
+    /// @param[in] vertex The full precision vertex.
+    /// @param[in] bounds Bounds of the mesh the vertex belongs to.
+    QuantizedVertex(const Vertex& vertex, const AABB& bounds);
+
+    /// @brief Default deconstructor.
+    ~QuantizedVertex() = default;
+
+    // Public Methods
+
+    static VertexInputAttributeDescriptor GetVertexDescription();
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    // Private Methods
+};
+
+} // namespace velecs
@@ -0,0 +1,117 @@
+/// @file    RenderSnapshot.h
+/// @author  Matthew Green
+/// @date    2024-01-11 10:17:20
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/Memory/AllocatedBuffer.h"
+#include "velecs/Rendering/DrawPacket.h"
+#include "velecs/Rendering/ViewPacket.h"
+#include "velecs/Rendering/TransformBuffer.h"
+#include "velecs/Rendering/ParticleEmitterParams.h"
+#include "velecs/Rendering/TextRenderer.h"
+#include "velecs/Rendering/SkinningSystem.h"
+#include "velecs/Rendering/ImpostorInstance.h"
+#include "velecs/Rendering/SimpleVertex.h"
+#include "velecs/Rendering/MeshletCuller.h"
+#include "velecs/Rendering/DebugVertex.h"
+#include "velecs/Rendering/DynamicBatcher.h"
+
+#include <vulkan/vulkan_core.h>
+
+#include <imgui.h>
+
+#include <glm/mat4x4.hpp>
+
+#include <vector>
+
+namespace velecs {
+
+/// @class RenderSnapshot
+/// @brief One frame of render state extracted from the simulation.
+///
+/// The simulation fills a snapshot during its Draw phase and hands it to the render thread,
+/// which records the frame from it alone. ImGui draw lists are deep copied, because the
+/// simulation starts the next ImGui frame while the render thread is still using them.
+class RenderSnapshot {
+public:
+    // Enums
+
+    // Public Fields
+
+    std::vector<ViewPacket> views; /// @brief Cameras the frame is drawn from, the main camera is always first.
+    std::vector<DrawPacket> drawPackets; /// @brief Visible objects, in the order they are drawn.
+    std::vector<TransformBuffer::UploadRange> transformUploads; /// @brief Transform buffer slots that changed this tick.
+    std::vector<glm::mat4> transformUploadData; /// @brief Matrices of transformUploads, back to back.
+    std::vector<VkBufferMemoryBarrier> ownershipAcquires; /// @brief Buffers finished on the transfer queue that the graphics queue takes ownership of.
+    uint64_t transferWaitValue{0}; /// @brief Transfer timeline value the frame waits on, every upload it draws is at or below it.
+    bool dynamicResolution{false}; /// @brief Whether the frame renders the scene offscreen at a dynamic scale.
+    std::vector<ParticleEmitterParams> particleEmitters; /// @brief What each emitter spawns this frame, spawn offsets already set.
+    float particleDeltaTime{0.0f}; /// @brief Seconds the particles advance this frame.
+    glm::vec4 cameraRight{1.0f, 0.0f, 0.0f, 0.0f}; /// @brief World space right axis of the main camera, faces the particle billboards.
+    glm::vec4 cameraUp{0.0f, 1.0f, 0.0f, 0.0f}; /// @brief World space up axis of the main camera.
+    glm::mat4 textViewProjection{1.0f}; /// @brief View-projection matrix text is drawn with, set for orthographic cameras too.
+    std::vector<TextLabelParams> textLabels; /// @brief Visible text labels.
+    std::vector<GlyphInstance> glyphInstances; /// @brief Glyphs of textLabels, grouped by font.
+    std::vector<TextRenderer::Batch> textBatches; /// @brief One instanced draw per font with visible glyphs.
+    std::vector<TextRenderer::AtlasUpload> atlasUploads; /// @brief Glyph atlas rows rasterized this tick.
+    std::vector<unsigned char> atlasUploadPixels; /// @brief Texels of atlasUploads, back to back.
+    std::vector<SkinningSystem::Dispatch> skinDispatches; /// @brief Animated instances posed before the scene is drawn.
+    std::vector<glm::mat4> skinMatrices; /// @brief Skin matrices of skinDispatches, back to back.
+    std::vector<ImpostorInstance> impostorInstances; /// @brief Visible impostors, grouped by atlas.
+    std::vector<ImpostorBatch> impostorBatches; /// @brief One instanced draw per atlas with visible impostors.
+    std::vector<MeshletCuller::Dispatch> meshletDispatches; /// @brief Clustered meshes culled on the GPU before the scene is drawn, one per view they are drawn in.
+    uint32_t meshletCommandCount{0}; /// @brief Indirect draw commands meshletDispatches write.
+    std::vector<DynamicBatcher::Geometry> batchGeometry; /// @brief World space geometry of the dynamic batches, emptied but never shrunk by Clear.
+    uint32_t batchedCount{0}; /// @brief Meshes merged into the dynamic batches.
+    std::vector<DebugVertex> debugVertices; /// @brief Lines every thread added through DebugDraw this tick, two vertices each.
+    std::vector<AllocatedBuffer> retiredBuffers; /// @brief Buffers this frame is the last to read, freed once it retires.
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    RenderSnapshot() = default;
+
+    /// @brief Deconstructor, frees the copied ImGui draw lists.
+    ~RenderSnapshot();
+
+    // Delete the copy constructor and assignment operator to prevent copies
+    RenderSnapshot(const RenderSnapshot&) = delete;
+    RenderSnapshot& operator=(const RenderSnapshot&) = delete;
+
+    // Public Methods
+
+    /// @brief Empties the snapshot, keeping the capacity of drawPackets.
+    void Clear();
+
+    /// @brief Copies the output of ImGui::Render into the snapshot.
+    /// @param[in] drawData The draw data returned by ImGui::GetDrawData, may be null.
+    void CaptureUI(const ImDrawData* const drawData);
+
+    /// @brief Gets the copied ImGui draw data.
+    /// @return The draw data to pass to the ImGui renderer backend.
+    ImDrawData* GetUIDrawData();
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    ImDrawData uiDrawData; /// @brief Copy of the ImGui draw data, owns every list in CmdLists.
+
+    // Private Methods
+
+    /// @brief Frees the copied ImGui draw lists.
+    void ClearUI();
+};
+
+} // namespace velecs
@@ -0,0 +1,67 @@
+/// @file    RenderStats.h
+/// @author  Matthew Green
+/// @date    2024-01-11 10:11:37
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include <vulkan/vulkan_core.h>
+
+#include <cstdint>
+
+namespace velecs {
+
+/// @struct RenderStats
+/// @brief Numbers the render thread reports back about the last frame it recorded.
+struct RenderStats {
+public:
+    // Enums
+
+    // Public Fields
+
+    float renderScale{1.0f}; /// @brief Dynamic resolution scale the frame was rendered at.
+    VkExtent2D renderExtent{0, 0}; /// @brief Resolution the scene was rendered at.
+    float gpuFrameTimeMs{0.0f}; /// @brief Smoothed GPU time of the scene, 0 when unmeasured.
+    uint32_t drawCount{0}; /// @brief Draw calls recorded in the frame, a multi-draw indirect counts each of its commands.
+    uint32_t instanceCount{0}; /// @brief Instances of the draw calls, without the ones only the GPU knows about.
+    uint32_t triangleCount{0}; /// @brief Triangles submitted by the draw calls, without the ones only the GPU knows about.
+    uint32_t pipelineBindCount{0}; /// @brief Graphics pipelines bound in the frame.
+    uint32_t bufferBindCount{0}; /// @brief Vertex buffer, index buffer and descriptor set binds of the graphics draws.
+    uint32_t pushConstantBytes{0}; /// @brief Bytes pushed as push constants by the graphics draws.
+    uint32_t transformUploadCount{0}; /// @brief World matrices copied to the transform buffer in the frame.
+    uint32_t glyphCount{0}; /// @brief Glyph quads drawn by the text batches of the frame.
+    uint32_t skinnedCount{0}; /// @brief Animated instances posed by the skinning pass of the frame.
+    uint32_t impostorCount{0}; /// @brief Impostor billboards drawn in place of, or fading from, their meshes.
+    uint32_t batchedCount{0}; /// @brief Small meshes drawn through the dynamic batches instead of on their own.
+    bool pipelineStatisticsValid{false}; /// @brief Whether the device could count the invocations below.
+    uint64_t vertexInvocations{0}; /// @brief Vertex shader invocations of every view, as of the last frame the GPU finished.
+    uint64_t clippingInvocations{0}; /// @brief Primitives that reached the clipper in every view, as of the last frame the GPU finished.
+    uint64_t fragmentInvocations{0}; /// @brief Fragment shader invocations of every view, as of the last frame the GPU finished.
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    RenderStats() = default;
+
+    /// @brief Default deconstructor.
+    ~RenderStats() = default;
+
+    // Public Methods
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    // Private Methods
+};
+
+} // namespace velecs
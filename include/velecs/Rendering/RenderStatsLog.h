@@ -0,0 +1,79 @@
+/// @file    RenderStatsLog.h
+/// @author  Matthew Green
+/// @date    2024-01-25 11:02:46
+///
+/// @section LICENSE
+///
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/Rendering/RenderStats.h"
+
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+
+namespace velecs {
+
+/// @class RenderStatsLog
+/// @brief Writes the RenderStats of every frame as one row of a CSV file.
+///
+/// Start and Stop may be called from any thread; Append belongs to the render thread.
+/// Rows go through the stream's buffer, so the render thread only touches the disk
+/// when it fills up.
+class RenderStatsLog {
+public:
+    // Enums
+
+    // Public Fields
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    RenderStatsLog() = default;
+
+    /// @brief Default deconstructor.
+    ~RenderStatsLog() = default;
+
+    // Delete the copy constructor and assignment operator to prevent copies
+    RenderStatsLog(const RenderStatsLog&) = delete;
+    RenderStatsLog& operator=(const RenderStatsLog&) = delete;
+
+    // Public Methods
+
+    /// @brief Opens a CSV file and writes its header row, closing any file already open.
+    /// @param[in] path File to write, its directory is created if needed.
+    /// @return Whether the file could be opened.
+    bool Start(const std::string& path);
+
+    /// @brief Flushes and closes the file opened by Start.
+    void Stop();
+
+    /// @brief Checks whether rows are being written.
+    /// @return Whether Start succeeded without a matching Stop.
+    bool IsLogging() const;
+
+    /// @brief Writes one row, does nothing when not logging.
+    /// @param[in] frameNumber Frame the stats were recorded in.
+    /// @param[in] stats The frame's stats, the pipeline statistics columns stay empty when they are invalid.
+    void Append(const int frameNumber, const RenderStats& stats);
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    mutable std::mutex mutex; /// @brief Guards file, Start and Stop run on the simulation thread.
+    std::ofstream file;
+
+    // Private Methods
+};
+
+} // namespace velecs
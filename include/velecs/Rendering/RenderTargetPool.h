@@ -0,0 +1,137 @@
+/// @file    RenderTargetPool.h
+/// @author  Matthew Green
+/// @date    2024-01-26 10:05:18
+///
+/// @section LICENSE
+///
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/Memory/AllocatedImage.h"
+
+#include <vulkan/vulkan_core.h>
+
+#include <vma/vk_mem_alloc.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace velecs {
+
+class BindlessTable;
+
+/// @struct RenderTarget
+/// @brief Handles of an offscreen color and depth target, copied into the snapshot of every frame that draws it.
+struct RenderTarget {
+    AllocatedImage colorImage; /// @brief Sampled by materials once the view is drawn.
+    VkImageView colorView{VK_NULL_HANDLE};
+    AllocatedImage depthImage; /// @brief Only used while the view is drawn.
+    VkImageView depthView{VK_NULL_HANDLE};
+    VkFramebuffer framebuffer{VK_NULL_HANDLE}; /// @brief Null under dynamic rendering.
+    VkExtent2D extent{0, 0};
+    uint32_t textureIndex{UINT32_MAX}; /// @brief Slot of colorView in the bindless texture array.
+};
+
+/// @class RenderTargetPool
+/// @brief Owns the offscreen targets render-to-texture views draw into.
+///
+/// A released target keeps its images and bindless slot and is handed to the next view
+/// that asks for the same size. A frame still drawing into it only races with the next
+/// view's first frame, which the command stream already orders, so nothing waits on the
+/// GPU and targets are only destroyed by Cleanup.
+///
+/// Acquire, Release and Get belong to the simulation; the render thread only reads the
+/// copies placed in the snapshot.
+class RenderTargetPool {
+public:
+    // Enums
+
+    // Public Fields
+
+    static constexpr uint32_t INVALID_INDEX = UINT32_MAX; /// @brief Marks a view without a target.
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    RenderTargetPool() = default;
+
+    /// @brief Default deconstructor.
+    ~RenderTargetPool() = default;
+
+    // Delete the copy constructor and assignment operator to prevent copies
+    RenderTargetPool(const RenderTargetPool&) = delete;
+    RenderTargetPool& operator=(const RenderTargetPool&) = delete;
+
+    // Public Methods
+
+    /// @brief Stores what targets are created with.
+    /// @param[in] device The Vulkan device.
+    /// @param[in] allocator The VMA allocator used for the images.
+    /// @param[in] bindlessTable Table the color images are registered in.
+    /// @param[in] colorFormat Format of the color images, the one the pipelines were built for.
+    /// @param[in] depthFormat Format of the depth images, the one the pipelines were built for.
+    /// @param[in] renderPass Pass the framebuffers are created for, VK_NULL_HANDLE under dynamic rendering.
+    void Init
+    (
+        VkDevice device,
+        VmaAllocator allocator,
+        BindlessTable* const bindlessTable,
+        const VkFormat colorFormat,
+        const VkFormat depthFormat,
+        VkRenderPass renderPass
+    );
+
+    /// @brief Destroys every target, the GPU must be idle.
+    void Cleanup();
+
+    /// @brief Gets a target of the given size, reusing a released one when possible.
+    /// @param[in] extent Size of the target.
+    /// @param[out] outCreated Set when the target is new, its color image is then still in VK_IMAGE_LAYOUT_UNDEFINED.
+    /// @return Index of the target.
+    /// @throws std::runtime_error if the images cannot be created.
+    uint32_t Acquire(const VkExtent2D extent, bool& outCreated);
+
+    /// @brief Hands a target back for reuse.
+    /// @param[in] index The index returned by Acquire.
+    void Release(const uint32_t index);
+
+    /// @brief Gets the handles of a target.
+    /// @param[in] index The index returned by Acquire.
+    /// @return The target.
+    const RenderTarget& Get(const uint32_t index) const;
+
+    /// @brief Records the transition of a new target's color image to VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL.
+    /// @param[in] cmd The command buffer being recorded.
+    /// @param[in] target The new target.
+    ///
+    /// Materials may sample a view's texture before the view was ever drawn.
+    static void RecordInitialLayout(VkCommandBuffer cmd, const RenderTarget& target);
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    VkDevice device{VK_NULL_HANDLE}; /// @brief Handle to the Vulkan device.
+    VmaAllocator allocator{nullptr}; /// @brief Allocator that owns the images.
+    BindlessTable* bindlessTable{nullptr};
+    VkFormat colorFormat{VK_FORMAT_UNDEFINED};
+    VkFormat depthFormat{VK_FORMAT_UNDEFINED};
+    VkRenderPass renderPass{VK_NULL_HANDLE};
+
+    std::vector<RenderTarget> targets;
+    std::vector<uint32_t> freeIndices; /// @brief Released targets, reused by size.
+
+    // Private Methods
+
+    /// @brief Creates the images, views and framebuffer of a target.
+    RenderTarget Create(const VkExtent2D extent) const;
+};
+
+} // namespace velecs
@@ -0,0 +1,109 @@
+/// @file    RenderThread.h
+/// @author  Matthew Green
+/// @date    2024-01-11 10:36:08
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/Rendering/RenderSnapshot.h"
+
+#include <array>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace velecs {
+
+/// @class RenderThread
+/// @brief Dedicated thread that records and submits frames from double-buffered snapshots.
+///
+/// The simulation fills the write snapshot, then Publish hands it over and returns the other
+/// one, so the next tick runs while the previous frame is being recorded. Publish only blocks
+/// when the simulation gets a full frame ahead of the render thread.
+class RenderThread {
+public:
+    // Enums
+
+    // Public Fields
+
+    /// @brief Function that records and submits one frame.
+    using RenderFunction = std::function<void(RenderSnapshot& snapshot)>;
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    RenderThread() = default;
+
+    /// @brief Deconstructor, renders any pending snapshot and joins the thread.
+    ~RenderThread();
+
+    // Delete the copy constructor and assignment operator to prevent copies
+    RenderThread(const RenderThread&) = delete;
+    RenderThread& operator=(const RenderThread&) = delete;
+
+    // Public Methods
+
+    /// @brief Starts rendering published snapshots.
+    /// @param[in] renderFunction Called once for every published snapshot.
+    /// @param[in] threaded Runs @p renderFunction on a dedicated thread when true, inside Publish otherwise.
+    void Start(RenderFunction renderFunction, const bool threaded = true);
+
+    /// @brief Renders any pending snapshot and joins the thread.
+    void Stop();
+
+    /// @brief Gets the snapshot the simulation is filling for the next frame.
+    /// @return The write snapshot, empty at the start of every tick.
+    RenderSnapshot& GetWriteSnapshot();
+
+    /// @brief Hands the write snapshot to the render thread and clears the other one for the next tick.
+    /// @throws Rethrows any exception thrown by the render function.
+    void Publish();
+
+    /// @brief Waits until every published snapshot has been rendered.
+    /// @details Must be called before the simulation changes anything the render function reads, such as the swapchain.
+    /// @throws Rethrows any exception thrown by the render function.
+    void WaitIdle();
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    RenderFunction renderFunction;
+    bool threaded{false};
+    std::thread thread;
+
+    std::array<RenderSnapshot, 2> snapshots;
+    size_t writeIndex{0}; /// @brief Snapshot owned by the simulation, only touched by the publishing thread.
+
+    std::mutex mutex; /// @brief Guards every field below.
+    std::condition_variable snapshotReady; /// @brief Signalled when a snapshot is published or the thread stops.
+    std::condition_variable renderDone; /// @brief Signalled when the render thread finishes a snapshot.
+
+    size_t readIndex{0}; /// @brief Snapshot owned by the render thread.
+    bool hasPendingSnapshot{false};
+    bool rendering{false};
+    bool stopping{false};
+    std::exception_ptr renderError; /// @brief First exception thrown by the render function, rethrown on the simulation thread.
+
+    // Private Methods
+
+    /// @brief Loop run by the render thread until Stop is called.
+    void RenderLoop();
+
+    /// @brief Waits with @p lock held until the render thread is idle, then rethrows any render error.
+    /// @param[in] lock A lock on mutex.
+    void WaitIdleLocked(std::unique_lock<std::mutex>& lock);
+};
+
+} // namespace velecs
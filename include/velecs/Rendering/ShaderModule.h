@@ -57,6 +57,13 @@ public:
     /// Throws runtime_error if the shader file can't be opened, the file is not a valid fragment shader, or shader module creation fails.
     static ShaderModule CreateFragShader(const VkDevice device, const std::string& relFilePath);
 
+    /// @brief Creates a compute shader from a file.
+    /// @param device The Vulkan device.
+    /// @param relFilePath Relative file path to the compute shader SPIR-V file, relative to Path::SHADERS_DIR.
+    /// @return A ShaderModule object with the compute shader loaded.
+    /// Throws runtime_error if the shader file can't be opened or shader module creation fails.
+    static ShaderModule CreateCompShader(const VkDevice device, const std::string& relFilePath);
+
 protected:
     // Protected Fields
 
@@ -0,0 +1,125 @@
+/// @file    ShaderVariantCache.h
+/// @author  Matthew Green
+/// @date    2024-01-24 09:41:12
+///
+/// @section LICENSE
+///
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/Rendering/PipelineBuilder.h"
+#include "velecs/Rendering/VertexFormat.h"
+#include "velecs/Rendering/VertexInputAttributeDescriptor.h"
+
+#include <vulkan/vulkan_core.h>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+namespace velecs {
+
+/// @class ShaderVariantCache
+/// @brief Builds the pipelines of one vertex and fragment shader pair on demand, one per variant.
+///
+/// A variant is a set of feature bits and a vertex format. Both reach the shaders as
+/// specialization constants: the vertex format at VERTEX_FORMAT_CONSTANT_ID and feature
+/// bit i as a bool at FIRST_FEATURE_CONSTANT_ID + i. The driver folds the branches on
+/// them when the pipeline is compiled, so a variant only pays for the features it has.
+///
+/// Pipelines are built the first time their variant is requested and kept until Cleanup.
+/// The pointers Get returns stay valid until then, so Materials can hold them.
+class ShaderVariantCache {
+public:
+    // Enums
+
+    // Public Fields
+
+    static constexpr uint32_t VERTEX_FORMAT_CONSTANT_ID = 0; /// @brief constant_id of the VertexFormat, as a uint.
+    static constexpr uint32_t FIRST_FEATURE_CONSTANT_ID = 1; /// @brief constant_id of feature bit 0, as a bool.
+    static constexpr uint32_t MAX_FEATURES = 16; /// @brief Feature bits a variant may set.
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    ShaderVariantCache() = default;
+
+    /// @brief Default deconstructor.
+    ~ShaderVariantCache() = default;
+
+    // Delete the copy constructor and assignment operator to prevent copies
+    ShaderVariantCache(const ShaderVariantCache&) = delete;
+    ShaderVariantCache& operator=(const ShaderVariantCache&) = delete;
+
+    // Public Methods
+
+    /// @brief Stores everything needed to build the variants later.
+    /// @param[in] device The Vulkan device.
+    /// @param[in] renderPass The render pass the pipelines are used in, ignored under dynamic rendering.
+    /// @param[in] builder Fixed function state and pipeline layout shared by every variant, copied.
+    /// @param[in] vertShaderPath Vertex shader SPIR-V file, relative to Path::SHADERS_DIR.
+    /// @param[in] fragShaderPath Fragment shader SPIR-V file, relative to Path::SHADERS_DIR.
+    ///
+    /// The attachment formats @p builder points to under dynamic rendering are copied too,
+    /// so the builder does not have to outlive the call.
+    void Init
+    (
+        VkDevice device,
+        VkRenderPass renderPass,
+        const PipelineBuilder& builder,
+        const std::string& vertShaderPath,
+        const std::string& fragShaderPath
+    );
+
+    /// @brief Sets how vertices of one format are read.
+    /// @param[in] format The vertex format.
+    /// @param[in] description The bindings and attributes of the format.
+    void SetVertexInput(const VertexFormat format, const VertexInputAttributeDescriptor& description);
+
+    /// @brief Gets the pipeline of a variant, building it on the first request.
+    /// @param[in] features Feature bits, below 1 << MAX_FEATURES.
+    /// @param[in] format Vertex format the pipeline reads.
+    /// @return Pointer to the pipeline, valid until Cleanup.
+    /// @throws std::runtime_error if @p format has no vertex input or the pipeline cannot be built.
+    VkPipeline* Get(const uint32_t features, const VertexFormat format = VertexFormat::Float32);
+
+    /// @brief Destroys every pipeline built so far.
+    /// @details Pipelines already destroyed by Material::Cleanup, which clears the handle, are skipped.
+    void Cleanup();
+
+    /// @brief Gets the number of variants built so far.
+    /// @return The number of cached pipelines.
+    uint32_t GetVariantCount() const;
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    VkDevice device{VK_NULL_HANDLE}; /// @brief Handle to the Vulkan device.
+    VkRenderPass renderPass{VK_NULL_HANDLE};
+    PipelineBuilder builder; /// @brief Shared state, shader stages and vertex input are filled per variant.
+    VkPipelineRenderingCreateInfoKHR renderingInfo{}; /// @brief Copy of the builder's attachment formats.
+    VkFormat colorFormat{VK_FORMAT_UNDEFINED}; /// @brief Storage renderingInfo points to.
+    std::string vertShaderPath;
+    std::string fragShaderPath;
+    std::unordered_map<uint8_t, VertexInputAttributeDescriptor> vertexInputs; /// @brief Keyed by VertexFormat.
+    std::unordered_map<uint64_t, VkPipeline> variants; /// @brief Keyed by MakeKey, node based so pointers to the values stay valid.
+
+    // Private Methods
+
+    /// @brief Packs a variant into one map key.
+    static uint64_t MakeKey(const uint32_t features, const VertexFormat format);
+
+    /// @brief Compiles one variant.
+    /// @throws std::runtime_error if the pipeline cannot be built.
+    VkPipeline Build(const uint32_t features, const VertexFormat format);
+};
+
+} // namespace velecs
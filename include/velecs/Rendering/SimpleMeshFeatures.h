@@ -0,0 +1,30 @@
+/// @file    SimpleMeshFeatures.h
+/// @author  Matthew Green
+/// @date    2024-01-24 10:21:03
+///
+/// @section LICENSE
+///
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include <cstdint>
+
+namespace velecs {
+
+/// @struct SimpleMeshFeatures
+/// @brief Feature bits of the SimpleMesh shader variants, see ShaderVariantCache.
+///
+/// Bit i is the bool specialization constant with constant_id 1 + i in
+/// SimpleMesh.vert and SimpleMesh.frag, so the two must be kept in sync.
+struct SimpleMeshFeatures {
+    static constexpr uint32_t NONE = 0; /// @brief Draws white.
+    static constexpr uint32_t MATERIAL_COLOR = 1u << 0; /// @brief Multiplies by the Material's color.
+    static constexpr uint32_t VERTEX_COLOR = 1u << 1; /// @brief Multiplies by a color rotated per triangle corner.
+    static constexpr uint32_t DITHER_FADE = 1u << 2; /// @brief Drops the share MeshPushConstants::fade of pixels in an ordered dither, set by the renderer.
+    static constexpr uint32_t TEXTURED = 1u << 3; /// @brief Multiplies by the Material's texture, projected along the object's axes since SimpleMesh has no UVs.
+};
+
+} // namespace velecs
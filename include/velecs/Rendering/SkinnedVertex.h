@@ -0,0 +1,71 @@
+/// @file    SkinnedVertex.h
+/// @author  Matthew Green
+/// @date    2024-01-23 10:14:52
+///
+/// @section LICENSE
+///
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+#include <cstdint>
+
+namespace velecs {
+
+/// @struct SkinnedVertex
+/// @brief Bind pose vertex of a SkinnedMesh with up to four bone influences.
+///
+/// Only Skinning/Skin.comp reads these, from a storage buffer (std430), so there is no
+/// vertex input description. The pass writes plain SimpleVertex positions for the draw.
+struct SkinnedVertex {
+public:
+    // Enums
+
+    // Public Fields
+
+    glm::vec3 position{0.0f}; /// @brief Position in mesh space.
+    uint32_t boneIndices{0}; /// @brief Four 8-bit bone indices, the first in the lowest byte.
+    glm::vec4 boneWeights{1.0f, 0.0f, 0.0f, 0.0f}; /// @brief Weight of each bone in boneIndices, they sum to one.
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    SkinnedVertex() = default;
+
+    /// @brief Constructor, the vertex follows bone 0 only.
+    /// @param[in] position Position in mesh space.
+    SkinnedVertex(const glm::vec3 position)
+        : position(position) {}
+
+    /// @brief Default deconstructor.
+    ~SkinnedVertex() = default;
+
+    // Public Methods
+
+    /// @brief Gets one of the four bone indices.
+    /// @param[in] influence Which influence, 0 to 3.
+    /// @return The bone index.
+    uint32_t GetBoneIndex(const uint32_t influence) const
+    {
+        return (boneIndices >> (influence * 8)) & 0xFF;
+    }
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    // Private Methods
+};
+
+static_assert(sizeof(SkinnedVertex) == 32, "SkinnedVertex must match the std430 layout used by Skinning/Skin.comp.");
+
+} // namespace velecs
@@ -0,0 +1,51 @@
+/// @file    SkinningPushConstants.h
+/// @author  Matthew Green
+/// @date    2024-01-23 14:18:44
+///
+/// @section LICENSE
+///
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include <cstdint>
+
+namespace velecs {
+
+/// @struct SkinningPushConstants
+/// @brief Push constants of Skinning/Skin.comp, one dispatch per instance.
+struct SkinningPushConstants {
+public:
+    // Enums
+
+    // Public Fields
+
+    uint32_t vertexCount{0}; /// @brief Vertices of the mesh, threads past it return early.
+    uint32_t firstBone{0}; /// @brief Skin matrix of the instance's bone 0 in the frame's bone buffer.
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    SkinningPushConstants() = default;
+
+    /// @brief Default deconstructor.
+    ~SkinningPushConstants() = default;
+
+    // Public Methods
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    // Private Methods
+};
+
+static_assert(sizeof(SkinningPushConstants) <= 128, "Push constants are only guaranteed 128 bytes.");
+
+} // namespace velecs
@@ -0,0 +1,149 @@
+/// @file    SkinningSystem.h
+/// @author  Matthew Green
+/// @date    2024-01-23 14:27:09
+///
+/// @section LICENSE
+///
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/Memory/AllocatedBuffer.h"
+#include "velecs/Rendering/DescriptorAllocator.h"
+#include "velecs/Rendering/DescriptorLayoutCache.h"
+
+#include <vulkan/vulkan_core.h>
+
+#include <vma/vk_mem_alloc.h>
+
+#include <glm/mat4x4.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace velecs {
+
+/// @class SkinningSystem
+/// @brief Poses the vertices of every animated instance in a compute pass.
+///
+/// Each instance owns a vertex buffer of plain positions. Every frame Skinning/Skin.comp
+/// reads the bind pose of the instance's mesh and the skin matrices sampled on the CPU,
+/// and writes the posed vertices into that buffer, which is then drawn like any other
+/// SimpleVertex mesh with the index buffer of the shared mesh. The CPU never touches a
+/// vertex after import, however many instances play.
+///
+/// Allocate, Release, Reserve and EndFrame belong to the simulation, RecordSkinning to the
+/// render thread. Released and replaced buffers are handed out instead of destroyed, the
+/// frame being recorded may still read them.
+class SkinningSystem {
+public:
+    // Enums
+
+    // Public Fields
+
+    static constexpr uint32_t INVALID_INDEX = UINT32_MAX; /// @brief Marks an entity that has no instance yet.
+    static constexpr uint32_t WORKGROUP_SIZE = 64; /// @brief local_size_x of Skinning/Skin.comp.
+
+    static constexpr uint32_t BIND_POSE_BINDING = 0; /// @brief Binding of the mesh's SkinnedVertex records.
+    static constexpr uint32_t BONES_BINDING = 1; /// @brief Binding of the frame's skin matrices.
+    static constexpr uint32_t OUTPUT_BINDING = 2; /// @brief Binding of the instance's posed positions.
+
+    /// @struct Dispatch
+    /// @brief Skinning of one instance this frame.
+    struct Dispatch {
+        VkBuffer bindPose{VK_NULL_HANDLE}; /// @brief Uploaded vertex buffer of the SkinnedMesh.
+        VkBuffer output{VK_NULL_HANDLE}; /// @brief Vertex buffer of the instance.
+        uint32_t vertexCount{0}; /// @brief Vertices to pose.
+        uint32_t firstBone{0}; /// @brief Skin matrix of the instance's bone 0 in the frame's bone matrices.
+    };
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    SkinningSystem() = default;
+
+    /// @brief Default deconstructor.
+    ~SkinningSystem() = default;
+
+    // Delete the copy constructor and assignment operator to prevent copies
+    SkinningSystem(const SkinningSystem&) = delete;
+    SkinningSystem& operator=(const SkinningSystem&) = delete;
+
+    // Public Methods
+
+    /// @brief Creates the descriptor set layout and the skinning pipeline.
+    /// @param[in] device The Vulkan device.
+    /// @param[in] allocator The VMA allocator used for every buffer.
+    /// @param[in] layoutCache Cache the set layout is created through.
+    void Init(VkDevice device, VmaAllocator allocator, DescriptorLayoutCache& layoutCache);
+
+    /// @brief Destroys every buffer and Vulkan object owned by the system.
+    void Cleanup();
+
+    /// @brief Creates an instance without a vertex buffer.
+    /// @return The index to store in SkinSlot::index.
+    uint32_t Allocate();
+
+    /// @brief Frees an instance, its vertex buffer is handed out by the next EndFrame.
+    /// @param[in] index The index returned by Allocate, INVALID_INDEX is ignored.
+    void Release(const uint32_t index);
+
+    /// @brief Makes sure an instance's vertex buffer holds @p vertexCount positions.
+    /// @param[in] index The index returned by Allocate.
+    /// @param[in] vertexCount Vertices of the instance's mesh.
+    /// @param[out] retiredBuffers Receives the old buffer when it is too small.
+    /// @return The vertex buffer to skin into and draw from.
+    /// @throws std::runtime_error if the buffer cannot be created.
+    VkBuffer Reserve(const uint32_t index, const uint32_t vertexCount, std::vector<AllocatedBuffer>& retiredBuffers);
+
+    /// @brief Hands out the buffers of the instances released since the last call.
+    /// @param[out] retiredBuffers Receives the buffers.
+    void EndFrame(std::vector<AllocatedBuffer>& retiredBuffers);
+
+    /// @brief Records one dispatch per instance, outside of any render pass.
+    /// @param[in] cmd The command buffer being recorded.
+    /// @param[in] frameDescriptorAllocator Allocator of sets that live for one frame.
+    /// @param[in] dispatches The instances to pose.
+    /// @param[in] boneMatrices Skin matrices of every instance, back to back.
+    ///
+    /// The bone buffer is reused every frame, so the previous frame must have retired.
+    void RecordSkinning
+    (
+        VkCommandBuffer cmd,
+        DescriptorAllocator& frameDescriptorAllocator,
+        const std::vector<Dispatch>& dispatches,
+        const std::vector<glm::mat4>& boneMatrices
+    );
+
+    /// @brief Gets the number of live instances.
+    /// @return Instances allocated and not released.
+    uint32_t GetInstanceCount() const;
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    VkDevice device{VK_NULL_HANDLE}; /// @brief Handle to the Vulkan device.
+    VmaAllocator allocator{nullptr}; /// @brief Allocator that owns every buffer.
+    VkDescriptorSetLayout layout{VK_NULL_HANDLE}; /// @brief Owned by the layout cache.
+    VkPipelineLayout pipelineLayout{VK_NULL_HANDLE};
+    VkPipeline pipeline{VK_NULL_HANDLE};
+
+    std::vector<AllocatedBuffer> outputBuffers; /// @brief Posed positions of each instance, simulation only.
+    std::vector<uint32_t> outputCapacities; /// @brief Vertices each of outputBuffers holds.
+    std::vector<uint32_t> freeIndices; /// @brief Released instances available for reuse.
+    std::vector<AllocatedBuffer> releasedBuffers; /// @brief Buffers of released instances, handed out by EndFrame.
+    uint32_t liveCount{0};
+
+    AllocatedBuffer boneBuffer; /// @brief Skin matrices of the frame being recorded, render thread only.
+    void* mappedBones{nullptr};
+    VkDeviceSize boneCapacity{0};
+};
+
+} // namespace velecs
@@ -0,0 +1,85 @@
+/// @file    StaticBatcher.h
+/// @author  Matthew Green
+/// @date    2024-01-13 10:31:52
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/ECS/Components/Rendering/SimpleMesh.h"
+
+#include <glm/mat4x4.hpp>
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <tuple>
+#include <vector>
+
+namespace velecs {
+
+/// @class StaticBatcher
+/// @brief Merges meshes that never move into world space meshes, one per group and chunk.
+///
+/// Each source is placed in the cubic chunk holding the center of its world bounds, so a
+/// batch stays compact enough to be culled as a whole. The group is chosen by the caller,
+/// typically one per distinct material, since a batch is drawn with a single material.
+class StaticBatcher {
+public:
+    // Enums
+
+    // Public Fields
+
+    static constexpr float DEFAULT_CHUNK_SIZE = 32.0f; /// @brief Side of a chunk in world units.
+
+    /// @struct Batch
+    /// @brief Merged geometry of every source in one group and chunk.
+    struct Batch {
+        uint32_t group{0}; /// @brief Group passed to Add for every source in the batch.
+        std::array<int32_t, 3> chunk{0, 0, 0}; /// @brief Chunk coordinates, world position divided by the chunk size.
+        SimpleMesh mesh; /// @brief World space geometry with bounds and vertex format already computed.
+        uint32_t sourceCount{0}; /// @brief Number of meshes merged into the batch.
+    };
+
+    // Constructors and Destructors
+
+    /// @brief Constructor.
+    /// @param[in] chunkSize Side of a chunk in world units.
+    explicit StaticBatcher(const float chunkSize = DEFAULT_CHUNK_SIZE);
+
+    /// @brief Default deconstructor.
+    ~StaticBatcher() = default;
+
+    // Public Methods
+
+    /// @brief Appends a mesh, transformed to world space, to the batch of its group and chunk.
+    /// @param[in] group Caller defined group, sources in different groups are never merged.
+    /// @param[in] worldMatrix Matrix taking the mesh to world space.
+    /// @param[in] mesh The source mesh, its _bounds must be up to date.
+    void Add(const uint32_t group, const glm::mat4& worldMatrix, const SimpleMesh& mesh);
+
+    /// @brief Finishes every batch and empties the batcher.
+    /// @return The batches, ordered by group then chunk.
+    std::vector<Batch> Build();
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    using BatchKey = std::tuple<uint32_t, int32_t, int32_t, int32_t>;
+
+    float chunkSize; /// @brief Side of a chunk in world units.
+    std::map<BatchKey, Batch> batches; /// @brief Batches being filled, ordered for deterministic output.
+
+    // Private Methods
+};
+
+} // namespace velecs
@@ -0,0 +1,62 @@
+/// @file    TextLabelParams.h
+/// @author  Matthew Green
+/// @date    2024-01-22 11:26:12
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include <glm/vec2.hpp>
+#include <glm/mat4x4.hpp>
+
+#include <cstdint>
+
+namespace velecs {
+
+/// @struct TextLabelParams
+/// @brief Placement of one visible text label this frame, read by Text/Text.vert.
+///
+/// Every GlyphInstance of the label points at this record, so moving a label rewrites one
+/// record instead of its glyphs. The layout mirrors the `TextLabelParams` struct declared
+/// in Text/Text.vert (std430).
+struct TextLabelParams {
+public:
+    // Enums
+
+    // Public Fields
+
+    glm::mat4 transform{1.0f}; /// @brief World matrix of the label, billboards only use its translation.
+    glm::vec2 offset{0.0f}; /// @brief Added to every glyph quad in ems, places the pivot at the origin.
+    float size{1.0f}; /// @brief World units per em.
+    uint32_t color{0xFFFFFFFF}; /// @brief Packed RGBA8, red in the lowest byte.
+    uint32_t billboard{1}; /// @brief Non-zero to face the camera instead of following the transform's rotation.
+    uint32_t _padding[3]{0, 0, 0}; /// @brief Pads the struct to 96 bytes for std430.
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    TextLabelParams() = default;
+
+    /// @brief Default deconstructor.
+    ~TextLabelParams() = default;
+
+    // Public Methods
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    // Private Methods
+};
+
+static_assert(sizeof(TextLabelParams) % 16 == 0, "TextLabelParams must match the std430 layout used by the text shaders.");
+
+} // namespace velecs
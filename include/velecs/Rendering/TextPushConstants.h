@@ -0,0 +1,60 @@
+/// @file    TextPushConstants.h
+/// @author  Matthew Green
+/// @date    2024-01-22 11:31:50
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include <glm/vec4.hpp>
+#include <glm/mat4x4.hpp>
+
+#include <cstdint>
+
+namespace velecs {
+
+/// @class TextPushConstants
+/// @brief Per-batch data pushed to the text pipeline.
+///
+/// Text is drawn through whichever camera is the main camera, perspective or orthographic,
+/// so its view-projection is pushed instead of read from FrameUniforms. Each batch draws the
+/// glyphs of one font, only textureIndex changes between them.
+class TextPushConstants {
+public:
+    // Enums
+
+    // Public Fields
+
+    glm::mat4 viewProjection{1.0f}; /// @brief View-projection matrix of the main camera.
+    glm::vec4 cameraRight{1.0f, 0.0f, 0.0f, 0.0f}; /// @brief World space right axis of the camera, xyz only.
+    glm::vec4 cameraUp{0.0f, 1.0f, 0.0f, 0.0f}; /// @brief World space up axis of the camera, xyz only.
+    uint32_t textureIndex{0}; /// @brief Slot of the batch's glyph atlas in the bindless texture array.
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    TextPushConstants() = default;
+
+    /// @brief Default deconstructor.
+    ~TextPushConstants() = default;
+
+    // Public Methods
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    // Private Methods
+};
+
+static_assert(sizeof(TextPushConstants) <= 128, "TextPushConstants must fit the guaranteed push constant range.");
+
+} // namespace velecs
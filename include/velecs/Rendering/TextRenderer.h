@@ -0,0 +1,229 @@
+/// @file    TextRenderer.h
+/// @author  Matthew Green
+/// @date    2024-01-22 12:34:18
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/Memory/AllocatedBuffer.h"
+#include "velecs/Memory/AllocatedImage.h"
+#include "velecs/Rendering/GlyphAtlas.h"
+#include "velecs/Rendering/GlyphInstance.h"
+#include "velecs/Rendering/TextLabelParams.h"
+#include "velecs/Rendering/TextPushConstants.h"
+#include "velecs/Rendering/DescriptorAllocator.h"
+#include "velecs/Rendering/DescriptorLayoutCache.h"
+#include "velecs/ECS/Components/Rendering/TextLabel.h"
+
+#include <vulkan/vulkan_core.h>
+
+#include <vma/vk_mem_alloc.h>
+
+#include <glm/mat4x4.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace velecs {
+
+/// @class TextRenderer
+/// @brief Draws every TextLabel with one instanced quad batch per font.
+///
+/// Each font is a GlyphAtlas on the CPU mirrored by an R8 image in the bindless texture array.
+/// Extract lays a label out only when its cached layout is stale, then appends its record and
+/// its cached glyphs for the frame; EndFrame groups the glyphs by font and collects the atlas
+/// rows rasterized during the tick. The render thread copies those rows into the atlas images,
+/// writes the records and glyphs into host visible storage buffers and draws each font's glyphs
+/// with a single vkCmdDraw, six vertices per instance and no vertex input.
+///
+/// AddFont, Extract and EndFrame belong to the simulation, RecordUploads and RecordDraw to the
+/// render thread.
+class TextRenderer {
+public:
+    // Enums
+
+    // Public Fields
+
+    static constexpr uint32_t LABELS_BINDING = 0; /// @brief Binding of the frame's TextLabelParams records.
+    static constexpr uint32_t GLYPHS_BINDING = 1; /// @brief Binding of the frame's GlyphInstance records.
+    static constexpr uint32_t VERTICES_PER_GLYPH = 6; /// @brief Each glyph is two triangles expanded in the vertex shader.
+
+    /// @struct Batch
+    /// @brief Glyphs of one font, drawn with one instanced draw.
+    struct Batch {
+        uint32_t textureIndex{0}; /// @brief Slot of the font's atlas in the bindless texture array.
+        uint32_t firstGlyph{0}; /// @brief First instance of the batch in the frame's glyphs.
+        uint32_t glyphCount{0}; /// @brief Number of instances in the batch.
+    };
+
+    /// @struct AtlasUpload
+    /// @brief Rows of an atlas rasterized during the tick.
+    struct AtlasUpload {
+        VkImage image{VK_NULL_HANDLE}; /// @brief The atlas image, in VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL.
+        uint32_t width{0}; /// @brief Texels per row.
+        uint32_t firstRow{0}; /// @brief First row to copy.
+        uint32_t rowCount{0}; /// @brief Number of rows to copy.
+        size_t pixelOffset{0}; /// @brief Offset of the rows in the frame's upload pixels.
+    };
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    TextRenderer() = default;
+
+    /// @brief Default deconstructor.
+    ~TextRenderer() = default;
+
+    // Delete the copy constructor and assignment operator to prevent copies
+    TextRenderer(const TextRenderer&) = delete;
+    TextRenderer& operator=(const TextRenderer&) = delete;
+
+    // Public Methods
+
+    /// @brief Creates the descriptor set layout of the label and glyph buffers.
+    /// @param[in] device The Vulkan device.
+    /// @param[in] allocator The VMA allocator used for every buffer.
+    /// @param[in] layoutCache Cache the set layout is created through.
+    void Init(VkDevice device, VmaAllocator allocator, DescriptorLayoutCache& layoutCache);
+
+    /// @brief Destroys every buffer, atlas image and view owned by the renderer.
+    void Cleanup();
+
+    /// @brief Takes ownership of a font and its atlas image.
+    /// @param[in] atlas The glyph atlas of the font.
+    /// @param[in] image An image of atlas->GetSize() texels per side, cleared and in VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL.
+    /// @param[in] imageView A view of @p image.
+    /// @param[in] textureIndex Slot of @p imageView in the bindless texture array.
+    /// @return The font index labels select the font with.
+    uint32_t AddFont(std::unique_ptr<GlyphAtlas> atlas, const AllocatedImage& image, VkImageView imageView, const uint32_t textureIndex);
+
+    /// @brief Gets the number of fonts added so far.
+    /// @return One past the last valid font index.
+    uint32_t GetFontCount() const;
+
+    /// @brief Adds a label to the frame if it is in view, laying it out first if its layout is stale.
+    /// @param[in,out] label The label, its layout is rebuilt in place when needed.
+    /// @param[in] worldMatrix World matrix of the label's Transform.
+    /// @param[in] viewProjection View-projection matrix of the main camera, used to cull the label.
+    /// @param[in,out] labels Receives the label's record.
+    /// @return false if the label was skipped, for an unknown font, empty text or being out of view.
+    bool Extract(TextLabel& label, const glm::mat4& worldMatrix, const glm::mat4& viewProjection, std::vector<TextLabelParams>& labels);
+
+    /// @brief Collects the glyphs extracted this tick into one batch per font and the atlas rows to upload.
+    /// @param[out] glyphs Receives the glyph instances, grouped by font.
+    /// @param[out] batches Receives one batch per font with visible glyphs.
+    /// @param[out] uploads Receives the atlas rows rasterized since the last call.
+    /// @param[out] uploadPixels Receives the texels of @p uploads, back to back.
+    void EndFrame
+    (
+        std::vector<GlyphInstance>& glyphs,
+        std::vector<Batch>& batches,
+        std::vector<AtlasUpload>& uploads,
+        std::vector<unsigned char>& uploadPixels
+    );
+
+    /// @brief Records the copies of the rasterized atlas rows, outside of any render pass.
+    /// @param[in] cmd The command buffer being recorded.
+    /// @param[in] uploads The rows to copy.
+    /// @param[in] uploadPixels The texels of @p uploads.
+    ///
+    /// The staging buffer is reused every frame, so the previous frame must have retired.
+    void RecordUploads(VkCommandBuffer cmd, const std::vector<AtlasUpload>& uploads, const std::vector<unsigned char>& uploadPixels);
+
+    /// @brief Writes the frame's labels and glyphs and draws every batch.
+    /// @param[in] cmd The command buffer being recorded, inside the scene render pass with the text pipeline bound.
+    /// @param[in] pipelineLayout A pipeline layout created with GetLayout() at set @p setIndex.
+    /// @param[in] frameDescriptorAllocator Allocator of sets that live for one frame.
+    /// @param[in] labels The frame's label records.
+    /// @param[in] glyphs The frame's glyph instances.
+    /// @param[in] batches The frame's batches.
+    /// @param[in] constants Camera of the frame, textureIndex is set for each batch.
+    /// @param[in] setIndex The set number the layout expects the buffers at.
+    ///
+    /// The buffers are reused every frame, so the previous frame must have retired.
+    void RecordDraw
+    (
+        VkCommandBuffer cmd,
+        VkPipelineLayout pipelineLayout,
+        DescriptorAllocator& frameDescriptorAllocator,
+        const std::vector<TextLabelParams>& labels,
+        const std::vector<GlyphInstance>& glyphs,
+        const std::vector<Batch>& batches,
+        TextPushConstants constants,
+        const uint32_t setIndex = 1
+    );
+
+    /// @brief Lays a label's text out into its cached glyph quads.
+    /// @param[in] atlas The atlas of the label's font, missing glyphs are rasterized into it.
+    /// @param[in,out] label The label, its layout is replaced.
+    ///
+    /// The first line's top is at y = 0 and lines go down from there. If the atlas has to be
+    /// emptied half way through, the text is laid out again so every quad is of one generation.
+    static void Layout(GlyphAtlas& atlas, TextLabel& label);
+
+    /// @brief Gets the descriptor set layout to include in the text pipeline layout.
+    /// @return The descriptor set layout of the label and glyph buffers.
+    VkDescriptorSetLayout GetLayout() const;
+
+    /// @brief Gets the number of layouts built since Init.
+    /// @return The number of times Layout ran on behalf of Extract.
+    uint64_t GetLayoutCount() const;
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    /// @struct Font
+    /// @brief A glyph atlas and the GPU image mirroring it.
+    struct Font {
+        std::unique_ptr<GlyphAtlas> atlas; /// @brief Glyphs rasterized so far.
+        AllocatedImage image; /// @brief R8 copy of the atlas texels.
+        VkImageView imageView{VK_NULL_HANDLE};
+        uint32_t textureIndex{0}; /// @brief Slot of imageView in the bindless texture array.
+        std::vector<GlyphInstance> glyphs; /// @brief Glyphs of this font extracted this tick.
+    };
+
+    VkDevice device{VK_NULL_HANDLE}; /// @brief Handle to the Vulkan device.
+    VmaAllocator allocator{nullptr}; /// @brief Allocator that owns every buffer and atlas image.
+    VkDescriptorSetLayout layout{VK_NULL_HANDLE}; /// @brief Owned by the layout cache.
+
+    std::vector<Font> fonts; /// @brief Indexed by TextLabel::font, simulation only.
+    uint64_t layoutCount{0}; /// @brief Layouts built by Extract, simulation only.
+
+    AllocatedBuffer stagingBuffer; /// @brief Source of the atlas row copies, render thread only.
+    void* mappedStaging{nullptr};
+    VkDeviceSize stagingCapacity{0};
+
+    AllocatedBuffer labelBuffer; /// @brief TextLabelParams of the frame being drawn, render thread only.
+    void* mappedLabels{nullptr};
+    VkDeviceSize labelCapacity{0};
+
+    AllocatedBuffer glyphBuffer; /// @brief GlyphInstance records of the frame being drawn, render thread only.
+    void* mappedGlyphs{nullptr};
+    VkDeviceSize glyphCapacity{0};
+
+    // Private Methods
+
+    /// @brief Grows a persistently mapped buffer to hold at least @p size bytes.
+    /// @param[in,out] buffer The buffer, replaced when too small.
+    /// @param[in,out] mapped Mapping of @p buffer.
+    /// @param[in,out] capacity Size of @p buffer.
+    /// @param[in] size Bytes needed.
+    /// @param[in] usage Usage of a replacement buffer.
+    ///
+    /// The old buffer is destroyed right away, so nothing in flight may read it.
+    void Reserve(AllocatedBuffer& buffer, void*& mapped, VkDeviceSize& capacity, const VkDeviceSize size, const VkBufferUsageFlags usage);
+};
+
+} // namespace velecs
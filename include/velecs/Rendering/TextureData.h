@@ -0,0 +1,130 @@
+/// @file    TextureData.h
+/// @author  Matthew Green
+/// @date    2024-01-19 11:14:09
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/ECS/Components/Rendering/Sprite.h"
+
+#include <vulkan/vulkan_core.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace velecs {
+
+/// @struct TextureData
+/// @brief CPU copy of a texture and its mip chain, ready to be uploaded.
+///
+/// Textures are either decoded RGBA8 with only the base level, in which case the renderer
+/// builds the mip chain on the GPU while uploading, or baked ahead of time: mips generated,
+/// optionally block compressed with BlockCompression, and saved to a `.vtex` file whose
+/// levels are copied into the image as they are.
+struct TextureData {
+public:
+    // Enums
+
+    // Public Fields
+
+    static constexpr uint32_t BAKED_MAGIC = 0x58455456; /// @brief "VTEX" read as a little-endian word.
+    static constexpr uint32_t BAKED_VERSION = 1; /// @brief Bumped whenever the file layout changes.
+    static constexpr const char* BAKED_EXTENSION = ".vtex"; /// @brief Extension of baked texture files.
+    static constexpr uint32_t MAX_BAKED_DIMENSION = 16384; /// @brief Largest width or height LoadBaked accepts, the usual maxImageDimension2D.
+
+    VkFormat format{VK_FORMAT_R8G8B8A8_UNORM}; /// @brief Format of every level.
+    uint32_t width{0}; /// @brief Width of the base level in pixels.
+    uint32_t height{0}; /// @brief Height of the base level in pixels.
+    std::vector<std::vector<uint8_t>> mips; /// @brief Tightly packed pixels or blocks of each level, base level first.
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    TextureData() = default;
+
+    /// @brief Default deconstructor.
+    ~TextureData() = default;
+
+    // Public Methods
+
+    /// @brief Copies RGBA8 pixels into a texture with only the base level.
+    /// @param[in] rgba Tightly packed RGBA8 pixels.
+    /// @param[in] width Width in pixels.
+    /// @param[in] height Height in pixels.
+    /// @return The texture.
+    static TextureData FromRGBA8(const uint8_t* rgba, const uint32_t width, const uint32_t height);
+
+    /// @brief Copies the pixels of a loaded sprite into a texture with only the base level.
+    /// @param[in] sprite A valid sprite, Sprite::Load always decodes to RGBA8.
+    /// @return The texture.
+    /// @throws std::runtime_error if @p sprite is not valid.
+    static TextureData FromSprite(const Sprite& sprite);
+
+    /// @brief Reads a texture written by Save.
+    /// @param[in] filePath Path to the `.vtex` file.
+    /// @return The texture with every baked level.
+    /// @throws std::runtime_error if the file is missing, truncated, from another version, or its header
+    /// or level sizes do not describe an RGBA8 or BC texture of at most MAX_BAKED_DIMENSION pixels a side.
+    static TextureData LoadBaked(const std::string& filePath);
+
+    /// @brief Asset build step: decodes an image, generates its mips, compresses them and saves the result.
+    /// @param[in] sourcePath Path to an image stb_image can decode.
+    /// @param[in] bakedPath Path of the `.vtex` file to write.
+    /// @param[in] compressedFormat BC1, BC3 or BC7, VK_FORMAT_UNDEFINED picks with BlockCompression::ChooseFormat,
+    /// VK_FORMAT_R8G8B8A8_UNORM keeps the levels uncompressed.
+    /// @throws std::runtime_error if the source cannot be decoded or the output cannot be written.
+    static void Bake(const std::string& sourcePath, const std::string& bakedPath, const VkFormat compressedFormat = VK_FORMAT_UNDEFINED);
+
+    /// @brief Writes the texture to a `.vtex` file.
+    /// @param[in] filePath Path of the file to write.
+    /// @throws std::runtime_error if the file cannot be written.
+    void Save(const std::string& filePath) const;
+
+    /// @brief Replaces every level after the base with a box filtered chain down to 1x1.
+    /// @throws std::runtime_error if the texture is not RGBA8.
+    void GenerateMips();
+
+    /// @brief Encodes every level into a block compressed format.
+    /// @param[in] compressedFormat BC1, BC3 or BC7.
+    /// @return The compressed copy.
+    /// @throws std::runtime_error if the texture is not RGBA8.
+    TextureData Compress(const VkFormat compressedFormat) const;
+
+    /// @brief Gets the number of levels in a full chain down to 1x1.
+    /// @param[in] width Width of the base level.
+    /// @param[in] height Height of the base level.
+    /// @return floor(log2(max(width, height))) + 1.
+    static uint32_t GetFullMipCount(const uint32_t width, const uint32_t height);
+
+    /// @brief Gets the width of a level.
+    /// @param[in] level The level, 0 being the base.
+    /// @return The width, at least 1.
+    uint32_t GetMipWidth(const uint32_t level) const;
+
+    /// @brief Gets the height of a level.
+    /// @param[in] level The level, 0 being the base.
+    /// @return The height, at least 1.
+    uint32_t GetMipHeight(const uint32_t level) const;
+
+    /// @brief Gets the bytes of every level together.
+    /// @return The size of the staging data.
+    size_t GetTotalSize() const;
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    // Private Methods
+};
+
+} // namespace velecs
@@ -0,0 +1,66 @@
+/// @file    TileVertex.h
+/// @author  Matthew Green
+/// @date    2024-01-21 10:14:52
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/Rendering/VertexInputAttributeDescriptor.h"
+
+#include <cstdint>
+
+namespace velecs {
+
+/// @struct TileVertex
+/// @brief 8-byte corner of one tile quad in a tilemap chunk mesh.
+///
+/// The corner is stored in tiles from the chunk origin, read as VK_FORMAT_R16G16_UINT, and the
+/// push constants carry the chunk origin as the position offset and the tile size as the scale.
+/// The atlas coordinates are read as VK_FORMAT_R16G16_UNORM.
+struct TileVertex {
+public:
+    // Enums
+
+    // Public Fields
+
+    uint16_t corner[2]{0, 0}; /// @brief Corner of the tile in tiles, relative to the chunk origin.
+    uint16_t uv[2]{0, 0}; /// @brief Atlas coordinates of the corner, normalized to 16 bits.
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    TileVertex() = default;
+
+    /// @brief Constructor.
+    /// @param[in] x Corner column in tiles, relative to the chunk origin.
+    /// @param[in] y Corner row in tiles, relative to the chunk origin.
+    /// @param[in] u Horizontal atlas coordinate in [0, 1].
+    /// @param[in] v Vertical atlas coordinate in [0, 1].
+    TileVertex(const uint16_t x, const uint16_t y, const float u, const float v);
+
+    /// @brief Default deconstructor.
+    ~TileVertex() = default;
+
+    // Public Methods
+
+    static VertexInputAttributeDescriptor GetVertexDescription();
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    // Private Methods
+};
+
+static_assert(sizeof(TileVertex) == 8, "TileVertex must match the vertex input description.");
+
+} // namespace velecs
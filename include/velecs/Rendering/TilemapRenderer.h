@@ -0,0 +1,167 @@
+/// @file    TilemapRenderer.h
+/// @author  Matthew Green
+/// @date    2024-01-21 11:02:19
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/Memory/AllocatedBuffer.h"
+#include "velecs/Math/AABB.h"
+#include "velecs/Rendering/DrawPacket.h"
+#include "velecs/Rendering/OcclusionBuffer.h"
+#include "velecs/Rendering/TileVertex.h"
+#include "velecs/Rendering/TransferQueue.h"
+#include "velecs/ECS/Components/Rendering/Tilemap.h"
+
+#include <vulkan/vulkan_core.h>
+
+#include <vma/vk_mem_alloc.h>
+
+#include <glm/mat4x4.hpp>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace velecs {
+
+/// @class TilemapRenderer
+/// @brief Keeps one GPU mesh per Tilemap chunk and turns the visible ones into draw packets.
+///
+/// A chunk is only meshed while it is visible and its revision differs from the one its
+/// mesh was built from, at most rebuildBudget chunks per frame, so painting a tile costs one
+/// small rebuild and chunks that are never looked at are never built. The new vertices are
+/// streamed through the TransferQueue while the previous mesh keeps drawing, and the old
+/// buffer is retired once the new one has landed. Every chunk shares one index buffer.
+///
+/// Belongs to the simulation thread. Retired buffers are handed out instead of destroyed,
+/// they must outlive every frame that may still read them.
+class TilemapRenderer {
+public:
+    // Enums
+
+    // Public Fields
+
+    static constexpr uint32_t MAX_QUADS_PER_CHUNK = Tilemap::CHUNK_SIZE * Tilemap::CHUNK_SIZE; /// @brief One quad per tile.
+    static constexpr uint32_t DEFAULT_REBUILD_BUDGET = 64; /// @brief Chunks meshed per frame at most, spreads a freshly seen map over a few frames.
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    TilemapRenderer() = default;
+
+    /// @brief Default deconstructor.
+    ~TilemapRenderer() = default;
+
+    // Delete the copy constructor and assignment operator to prevent copies
+    TilemapRenderer(const TilemapRenderer&) = delete;
+    TilemapRenderer& operator=(const TilemapRenderer&) = delete;
+
+    // Public Methods
+
+    /// @brief Creates the shared quad index buffer and starts its upload.
+    /// @param[in] allocator The VMA allocator used for every chunk buffer.
+    /// @param[in] uploadQueue Queue the index and vertex buffers are streamed through.
+    /// @param[in] rebuildBudget Chunks meshed per frame at most.
+    void Init(VmaAllocator allocator, TransferQueue& uploadQueue, const uint32_t rebuildBudget = DEFAULT_REBUILD_BUDGET);
+
+    /// @brief Destroys every buffer, the GPU and the transfer queue must be idle.
+    void Cleanup();
+
+    /// @brief Rebuilds the visible chunks that changed and appends one packet per visible, non-empty chunk.
+    /// @param[in] id Identifies the tilemap across frames, typically its entity id.
+    /// @param[in] tilemap The tiles.
+    /// @param[in] renderMatrix View-projection times the world matrix of the tilemap.
+    /// @param[in] packet Transform, pipeline and material of the tilemap, the mesh fields are filled per chunk.
+    /// @param[in] occlusionBuffer Also culls chunks hidden behind occluders when not nullptr.
+    /// @param[out] packets Receives the draw packets.
+    /// @param[out] retiredBuffers Receives the buffers of replaced meshes.
+    void Extract
+    (
+        const uint64_t id,
+        const Tilemap& tilemap,
+        const glm::mat4& renderMatrix,
+        const DrawPacket& packet,
+        const OcclusionBuffer* const occlusionBuffer,
+        std::vector<DrawPacket>& packets,
+        std::vector<AllocatedBuffer>& retiredBuffers
+    );
+
+    /// @brief Retires the meshes of every tilemap that was not extracted since the last call.
+    /// @param[out] retiredBuffers Receives the buffers.
+    ///
+    /// Called once per frame after every Extract, so removed or hidden tilemaps give their memory back.
+    void EndFrame(std::vector<AllocatedBuffer>& retiredBuffers);
+
+    /// @brief Meshes one chunk, one quad per tile that is not Tilemap::EMPTY_TILE.
+    /// @param[in] tilemap The tiles.
+    /// @param[in] chunkX Column of the chunk.
+    /// @param[in] chunkY Row of the chunk.
+    /// @param[out] vertices Receives four vertices per quad, in the order the shared index buffer expects.
+    static void BuildChunkVertices(const Tilemap& tilemap, const uint32_t chunkX, const uint32_t chunkY, std::vector<TileVertex>& vertices);
+
+    /// @brief Gets the number of chunk meshes rebuilt by the last frame.
+    /// @return The number of rebuilds, at most the rebuild budget.
+    uint32_t GetRebuildCount() const;
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    /// @struct ChunkMesh
+    /// @brief GPU side of one chunk.
+    struct ChunkMesh {
+        AllocatedBuffer vertexBuffer; /// @brief Mesh being drawn.
+        uint32_t quadCount{0}; /// @brief Quads in vertexBuffer.
+        AllocatedBuffer pendingBuffer; /// @brief Rebuilt mesh still streaming in.
+        uint32_t pendingQuadCount{0}; /// @brief Quads in pendingBuffer.
+        uint64_t pendingUploadValue{0}; /// @brief TransferQueue value of pendingBuffer, 0 when nothing is streaming.
+        uint32_t builtRevision{0}; /// @brief Chunk revision the latest mesh was built from.
+    };
+
+    /// @struct TilemapMeshes
+    /// @brief Chunk meshes of one tilemap.
+    struct TilemapMeshes {
+        uint32_t chunkColumns{0};
+        uint32_t chunkRows{0};
+        std::vector<ChunkMesh> chunks; /// @brief Chunk meshes row by row, like Tilemap's chunks.
+        uint64_t lastFrame{0}; /// @brief Frame of the last Extract.
+    };
+
+    VmaAllocator allocator{nullptr};
+    TransferQueue* uploadQueue{nullptr};
+    uint32_t rebuildBudget{DEFAULT_REBUILD_BUDGET};
+
+    AllocatedBuffer indexBuffer; /// @brief 16-bit indices of MAX_QUADS_PER_CHUNK quads, shared by every chunk.
+    uint64_t indexUploadValue{0}; /// @brief TransferQueue value of indexBuffer, nothing draws before it lands.
+
+    std::unordered_map<uint64_t, TilemapMeshes> tilemaps; /// @brief Meshes by tilemap id.
+    std::vector<TilemapMeshes> orphans; /// @brief Meshes of removed or resized tilemaps, retired once nothing streams into them.
+    std::vector<TileVertex> scratchVertices; /// @brief Reused by every rebuild.
+    uint64_t frame{1}; /// @brief Incremented by EndFrame.
+    uint32_t rebuildCount{0}; /// @brief Rebuilds done this frame.
+    uint32_t lastRebuildCount{0}; /// @brief Rebuilds done by the last frame.
+
+    // Private Methods
+
+    /// @brief Starts streaming a rebuilt mesh into pendingBuffer.
+    /// @param[in] mesh The chunk mesh to rebuild.
+    /// @param[in] vertices The new vertices, not empty.
+    void Upload(ChunkMesh& mesh, const std::vector<TileVertex>& vertices);
+
+    /// @brief Moves every buffer of a chunk mesh to @p retiredBuffers.
+    /// @param[in] mesh The chunk mesh, nothing may still be streaming into it.
+    /// @param[out] retiredBuffers Receives the buffers.
+    static void Retire(ChunkMesh& mesh, std::vector<AllocatedBuffer>& retiredBuffers);
+};
+
+} // namespace velecs
@@ -0,0 +1,154 @@
+/// @file    TransferQueue.h
+/// @author  Matthew Green
+/// @date    2024-01-14 11:06:37
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include <vulkan/vulkan_core.h>
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace velecs {
+
+/// @class TransferQueue
+/// @brief Asynchronous copy submissions on the dedicated transfer queue, when the device has one.
+///
+/// Every submission gets a monotonically increasing value. With timeline semaphores the queue
+/// signals that value on a single semaphore, otherwise each submission carries its own fence.
+/// Submit never waits on the GPU: Collect polls once per frame, recycles finished command
+/// buffers, runs their completion callbacks and queues the acquire half of any queue family
+/// ownership transfer for the graphics queue to record.
+///
+/// Everything except GetTimelineSemaphore and RecordAcquires belongs to the simulation thread.
+class TransferQueue {
+public:
+    // Enums
+
+    // Public Fields
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    TransferQueue() = default;
+
+    /// @brief Default deconstructor.
+    ~TransferQueue() = default;
+
+    // Delete the copy constructor and assignment operator to prevent copies
+    TransferQueue(const TransferQueue&) = delete;
+    TransferQueue& operator=(const TransferQueue&) = delete;
+
+    // Public Methods
+
+    /// @brief Creates the command pool and the timeline semaphore.
+    /// @param[in] device The Vulkan device.
+    /// @param[in] queue The queue copies are submitted to.
+    /// @param[in] queueFamily Family of @p queue.
+    /// @param[in] graphicsQueueFamily Family that reads the uploaded buffers.
+    /// @param[in] useTimeline Whether VK_KHR_timeline_semaphore is enabled on the device.
+    /// @param[in] sharedQueueMutex Mutex guarding @p queue when it is also the graphics queue, otherwise nullptr.
+    void Init
+    (
+        VkDevice device,
+        VkQueue queue,
+        const uint32_t queueFamily,
+        const uint32_t graphicsQueueFamily,
+        const bool useTimeline,
+        std::mutex* const sharedQueueMutex = nullptr
+    );
+
+    /// @brief Waits for every submission, runs their callbacks and destroys the Vulkan objects.
+    void Cleanup();
+
+    /// @brief Records and submits copy commands without waiting for them.
+    /// @param[in] record Records the copies into a command buffer of the transfer family.
+    /// @param[in] buffers Destination buffers the graphics queue will read, released to its family if it differs.
+    /// @param[in] onComplete Called from Collect once the copies have finished, typically to free staging buffers.
+    /// @return The value IsComplete reports once the copies have finished.
+    uint64_t Submit
+    (
+        std::function<void(VkCommandBuffer cmd)>&& record,
+        const std::vector<VkBuffer>& buffers,
+        std::function<void()>&& onComplete
+    );
+
+    /// @brief Retires finished submissions.
+    void Collect();
+
+    /// @brief Checks a value returned by Submit against the last Collect.
+    /// @param[in] value The value returned by Submit, 0 is always complete.
+    /// @return Whether the submission had finished at the last Collect.
+    bool IsComplete(const uint64_t value) const;
+
+    /// @brief Gets the highest value known to be complete.
+    /// @return The value of the last submission retired by Collect.
+    uint64_t GetCompletedValue() const;
+
+    /// @brief Moves the acquire barriers of retired submissions out of the queue.
+    /// @param[out] barriers Receives the barriers, in submission order.
+    void TakeAcquires(std::vector<VkBufferMemoryBarrier>& barriers);
+
+    /// @brief Gets the semaphore graphics submissions wait on before reading uploads.
+    /// @return The timeline semaphore, VK_NULL_HANDLE without timeline support.
+    VkSemaphore GetTimelineSemaphore() const;
+
+    /// @brief Records the acquire half of ownership transfers on the graphics queue.
+    /// @param[in] cmd A graphics command buffer, outside of any render pass.
+    /// @param[in] barriers Barriers returned by TakeAcquires.
+    static void RecordAcquires(VkCommandBuffer cmd, const std::vector<VkBufferMemoryBarrier>& barriers);
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    /// @struct Submission
+    /// @brief Copies in flight on the transfer queue.
+    struct Submission {
+        uint64_t value{0}; /// @brief Value signaled when the copies finish.
+        VkCommandBuffer cmd{VK_NULL_HANDLE};
+        VkFence fence{VK_NULL_HANDLE}; /// @brief Completion fence, only without timeline semaphores.
+        std::vector<VkBuffer> releasedBuffers; /// @brief Buffers to acquire on the graphics queue.
+        std::function<void()> onComplete;
+    };
+
+    VkDevice device{VK_NULL_HANDLE}; /// @brief Handle to the Vulkan device.
+    VkQueue queue{VK_NULL_HANDLE};
+    uint32_t queueFamily{0};
+    uint32_t graphicsQueueFamily{0};
+    std::mutex* sharedQueueMutex{nullptr}; /// @brief Guards queue when it is the graphics queue.
+
+    VkCommandPool commandPool{VK_NULL_HANDLE};
+    VkSemaphore timelineSemaphore{VK_NULL_HANDLE};
+    PFN_vkGetSemaphoreCounterValueKHR getSemaphoreCounterValue{nullptr};
+
+    std::deque<Submission> inFlight; /// @brief Submissions not retired yet, oldest first.
+    std::vector<VkCommandBuffer> freeCommandBuffers;
+    std::vector<VkFence> freeFences;
+    std::vector<VkBufferMemoryBarrier> pendingAcquires; /// @brief Acquire barriers of retired submissions.
+
+    uint64_t nextValue{1}; /// @brief Value of the next submission.
+    uint64_t completedValue{0}; /// @brief Value of the last retired submission.
+
+    // Private Methods
+
+    /// @brief Submits a recorded command buffer under the shared queue mutex if there is one.
+    /// @param[in] submit The submission.
+    /// @param[in] fence Fence to signal, may be VK_NULL_HANDLE.
+    void SubmitToQueue(const VkSubmitInfo& submit, VkFence fence);
+};
+
+} // namespace velecs
@@ -0,0 +1,146 @@
+/// @file    TransformBuffer.h
+/// @author  Matthew Green
+/// @date    2024-01-12 09:18:02
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/Memory/AllocatedBuffer.h"
+
+#include <vulkan/vulkan_core.h>
+
+#include <vma/vk_mem_alloc.h>
+
+#include <glm/mat4x4.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace velecs {
+
+/// @class TransformBuffer
+/// @brief Device-local storage buffer of world matrices that persists between frames.
+///
+/// Every renderable owns a slot. The simulation writes matrices into a CPU copy, and only
+/// slots whose matrix actually changed are gathered into coalesced ranges for the render
+/// thread to copy, so the upload cost of a frame follows the number of moving objects.
+///
+/// Allocate, Release, Write and ExtractUploads belong to the simulation thread; RecordUploads
+/// and Bind belong to the render thread. The two halves share no mutable state.
+class TransformBuffer {
+public:
+    // Enums
+
+    // Public Fields
+
+    static constexpr uint32_t MAX_TRANSFORMS = 65536; /// @brief Number of slots, 4 MiB of matrices.
+    static constexpr uint32_t INVALID_INDEX = UINT32_MAX; /// @brief Marks an entity that has no slot yet.
+    static constexpr uint32_t MERGE_GAP = 4; /// @brief Dirty ranges separated by at most this many clean slots are copied as one.
+    static constexpr uint32_t TRANSFORMS_BINDING = 0; /// @brief Binding of the storage buffer in the set.
+
+    /// @struct UploadRange
+    /// @brief Consecutive slots to copy in one region.
+    struct UploadRange {
+        uint32_t firstIndex{0}; /// @brief First slot written.
+        uint32_t count{0}; /// @brief Number of slots written.
+        uint32_t dataOffset{0}; /// @brief Matrix offset of the range in the packed upload data.
+    };
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    TransformBuffer() = default;
+
+    /// @brief Default deconstructor.
+    ~TransformBuffer() = default;
+
+    // Delete the copy constructor and assignment operator to prevent copies
+    TransformBuffer(const TransformBuffer&) = delete;
+    TransformBuffer& operator=(const TransformBuffer&) = delete;
+
+    // Public Methods
+
+    /// @brief Creates the device-local buffer, the staging buffer and the descriptor set.
+    /// @param[in] device The Vulkan device.
+    /// @param[in] allocator The VMA allocator used for both buffers.
+    void Init(VkDevice device, VmaAllocator allocator);
+
+    /// @brief Destroys every Vulkan object owned by the buffer.
+    void Cleanup();
+
+    /// @brief Reserves a slot, initialized to the identity matrix.
+    /// @return The slot index shaders use to read the matrix.
+    /// @throws std::runtime_error if every slot is in use.
+    uint32_t Allocate();
+
+    /// @brief Frees a slot.
+    /// @param[in] index The index returned by Allocate.
+    void Release(const uint32_t index);
+
+    /// @brief Sets the matrix of a slot, marking it for upload only if it changed.
+    /// @param[in] index The index returned by Allocate.
+    /// @param[in] matrix The world matrix.
+    void Write(const uint32_t index, const glm::mat4& matrix);
+
+    /// @brief Gets the last matrix written to a slot.
+    /// @param[in] index The index returned by Allocate.
+    /// @return The world matrix.
+    const glm::mat4& GetMatrix(const uint32_t index) const;
+
+    /// @brief Moves the pending changes into coalesced ranges and packed matrices.
+    /// @param[out] ranges Receives the ranges to copy, sorted by slot.
+    /// @param[out] data Receives the matrices of every range, back to back.
+    void ExtractUploads(std::vector<UploadRange>& ranges, std::vector<glm::mat4>& data);
+
+    /// @brief Copies extracted matrices to the GPU and makes them visible to vertex shaders.
+    /// @param[in] cmd The command buffer being recorded, outside of any render pass.
+    /// @param[in] ranges Ranges returned by ExtractUploads.
+    /// @param[in] data Matrices returned by ExtractUploads.
+    ///
+    /// The staging buffer is reused every frame, so the previous frame must have retired.
+    void RecordUploads(VkCommandBuffer cmd, const std::vector<UploadRange>& ranges, const std::vector<glm::mat4>& data);
+
+    /// @brief Binds the buffer's descriptor set.
+    /// @param[in] cmd The command buffer being recorded.
+    /// @param[in] pipelineLayout A pipeline layout created with GetLayout() at set @p setIndex.
+    /// @param[in] setIndex The set number the layout expects the buffer at.
+    void Bind(VkCommandBuffer cmd, VkPipelineLayout pipelineLayout, const uint32_t setIndex = 1) const;
+
+    /// @brief Gets the descriptor set layout to include in pipeline layouts.
+    /// @return The descriptor set layout of the buffer.
+    VkDescriptorSetLayout GetLayout() const;
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    VkDevice device{VK_NULL_HANDLE}; /// @brief Handle to the Vulkan device.
+    VmaAllocator allocator{nullptr}; /// @brief Allocator that owns both buffers.
+
+    VkDescriptorSetLayout layout{VK_NULL_HANDLE};
+    VkDescriptorPool pool{VK_NULL_HANDLE};
+    VkDescriptorSet set{VK_NULL_HANDLE};
+
+    AllocatedBuffer gpuBuffer; /// @brief Device-local storage buffer read by the vertex shaders.
+    AllocatedBuffer stagingBuffer; /// @brief Host-visible source of the per-frame copies.
+    glm::mat4* mappedStaging{nullptr}; /// @brief Persistent mapping of stagingBuffer.
+
+    std::vector<glm::mat4> matrices; /// @brief CPU copy of every slot, used to skip unchanged writes.
+    std::vector<uint32_t> dirtyIndices; /// @brief Slots written since the last ExtractUploads.
+    std::vector<bool> dirtyFlags; /// @brief Whether a slot is already in dirtyIndices.
+    std::vector<uint32_t> freeSlots; /// @brief Released slots available for reuse.
+    uint32_t nextSlot{0}; /// @brief First slot that has never been handed out.
+
+    // Private Methods
+};
+
+} // namespace velecs
@@ -16,6 +16,7 @@
 #include <glm/mat4x4.hpp>
 #include <glm/vec4.hpp>
 #include <glm/vec3.hpp>
+#include <glm/vec2.hpp>
 
 namespace velecs {
 
@@ -32,6 +33,7 @@ public:
     glm::vec3 position;
     glm::vec3 normal;
     Color32 color{Color32::MAGENTA};
+    glm::vec2 uv{0.0f};
 
     // Constructors and Destructors
     
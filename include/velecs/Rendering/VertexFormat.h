@@ -0,0 +1,24 @@
+/// @file    VertexFormat.h
+/// @author  Matthew Green
+/// @date    2024-01-08 09:41:26
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include <cstdint>
+
+namespace velecs {
+
+/// @enum VertexFormat
+/// @brief Layout a mesh's vertices are stored in on the GPU.
+enum class VertexFormat : uint8_t {
+    Float32,    /// @brief Full precision floats, e.g. SimpleVertex and Vertex.
+    Quantized16 /// @brief 16-bit positions relative to the mesh bounds, e.g. QuantizedSimpleVertex and QuantizedVertex.
+};
+
+} // namespace velecs
@@ -0,0 +1,94 @@
+/// @file    VertexQuantization.h
+/// @author  Matthew Green
+/// @date    2024-01-08 09:55:03
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/Math/AABB.h"
+#include "velecs/Rendering/VertexFormat.h"
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include <array>
+#include <cstdint>
+
+namespace velecs {
+
+/// @struct VertexQuantization
+/// @brief Encoders and decoders for compressed vertex attributes.
+///
+/// Positions are stored as 16-bit unsigned normalized values relative to the mesh bounds,
+/// normals as two 16-bit signed normalized octahedral coordinates and texture coordinates
+/// as half floats. The GPU decodes the normalized formats in the vertex fetch, so only the
+/// bounds need undoing, either with GetDequantizeMatrix or as a per-draw offset and scale.
+struct VertexQuantization {
+public:
+    // Enums
+
+    // Public Fields
+
+    /// @brief Largest position error, in mesh units, accepted when choosing Quantized16.
+    static constexpr float MAX_POSITION_ERROR = 0.001f;
+
+    // Constructors and Destructors
+
+    VertexQuantization() = delete;
+
+    // Public Methods
+
+    /// @brief Picks the most compact vertex format that keeps positions within MAX_POSITION_ERROR.
+    /// @param[in] bounds Bounds of the mesh positions.
+    /// @return Quantized16 when the largest side of @p bounds fits in 65535 steps of MAX_POSITION_ERROR.
+    static VertexFormat ChooseFormat(const AABB& bounds);
+
+    /// @brief Encodes a position relative to a box as three 16-bit unsigned normalized values.
+    /// @param[in] position The position, expected inside @p bounds.
+    /// @param[in] bounds The box mapped to [0, 65535] on each axis.
+    /// @return The encoded x, y and z.
+    static std::array<uint16_t, 3> QuantizePosition(const glm::vec3 position, const AABB& bounds);
+
+    /// @brief Gets the matrix that maps unsigned normalized positions back into the space of @p bounds.
+    /// @param[in] bounds The box the positions were quantized against.
+    /// @return Translation to bounds.min times a scale by the bounds size.
+    static glm::mat4 GetDequantizeMatrix(const AABB& bounds);
+
+    /// @brief Encodes a unit vector with the octahedral mapping.
+    /// @param[in] normal The vector to encode, does not need to be normalized.
+    /// @return Two signed normalized 16-bit coordinates.
+    static std::array<int16_t, 2> EncodeOctahedral(const glm::vec3 normal);
+
+    /// @brief Decodes a vector encoded with EncodeOctahedral.
+    /// @param[in] encoded The two signed normalized 16-bit coordinates.
+    /// @return The normalized vector.
+    static glm::vec3 DecodeOctahedral(const std::array<int16_t, 2> encoded);
+
+    /// @brief Converts a float to IEEE 754 half precision, rounding to nearest even.
+    /// @param[in] value The value to convert.
+    /// @return The half float bits.
+    static uint16_t FloatToHalf(const float value);
+
+    /// @brief Converts IEEE 754 half precision bits to a float.
+    /// @param[in] half The half float bits.
+    /// @return The value as a float.
+    static float HalfToFloat(const uint16_t half);
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    // Private Methods
+};
+
+} // namespace velecs
@@ -0,0 +1,62 @@
+/// @file    ViewPacket.h
+/// @author  Matthew Green
+/// @date    2024-01-26 11:34:27
+///
+/// @section LICENSE
+///
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/Rendering/RenderTargetPool.h"
+
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <glm/mat4x4.hpp>
+
+#include <cstdint>
+
+namespace velecs {
+
+/// @struct ViewPacket
+/// @brief One camera the frame is drawn from, copied out of the ECS.
+///
+/// Draw packets name the view they belong to through DrawPacket::viewIndex.
+struct ViewPacket {
+public:
+    // Enums
+
+    // Public Fields
+
+    glm::mat4 viewProjection{1.0f}; /// @brief View-projection matrix of the view's camera.
+    glm::vec3 position{0.0f}; /// @brief World space position of the view's camera.
+    bool perspective{false}; /// @brief Whether the view's camera is a PerspectiveCamera, back-facing meshlets are only culled then.
+    glm::vec4 viewport{0.0f, 0.0f, 1.0f, 1.0f}; /// @brief x, y, width and height of the area drawn to, as fractions of the target.
+    bool offscreen{false}; /// @brief Whether the view draws into target instead of the window.
+    RenderTarget target; /// @brief Handles of the texture drawn to, only set when offscreen.
+    int32_t order{0}; /// @brief Window views are drawn from the lowest order up.
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    ViewPacket() = default;
+
+    /// @brief Default deconstructor.
+    ~ViewPacket() = default;
+
+    // Public Methods
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    // Private Methods
+};
+
+} // namespace velecs
@@ -0,0 +1,105 @@
+/// @file    AnimationClip.cpp
+/// @author  Matthew Green
+/// @date    2024-01-23 11:42:33
+///
+/// @section LICENSE
+///
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Animation/AnimationClip.h"
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+
+namespace velecs {
+
+namespace {
+
+/// @brief Finds the keys around @p time.
+/// @param[out] first Key at or before @p time.
+/// @param[out] factor How far @p time is from @p first towards the next key, in [0, 1].
+/// @return false if the track is empty.
+bool FindKeys(const std::vector<float>& times, const float time, size_t& first, float& factor)
+{
+    if (times.empty())
+    {
+        return false;
+    }
+
+    const auto next = std::upper_bound(times.begin(), times.end(), time);
+    if (next == times.begin())
+    {
+        first = 0;
+        factor = 0.0f;
+        return true;
+    }
+    if (next == times.end())
+    {
+        first = times.size() - 1;
+        factor = 0.0f;
+        return true;
+    }
+
+    first = static_cast<size_t>(next - times.begin()) - 1;
+    const float span = *next - times[first];
+    factor = span > 0.0f ? (time - times[first]) / span : 0.0f;
+    return true;
+}
+
+/// @brief Interpolates a vector track, keeps @p value if the track is empty.
+void SampleTrack(const std::vector<float>& times, const std::vector<glm::vec3>& values, const float time, glm::vec3& value)
+{
+    size_t first = 0;
+    float factor = 0.0f;
+    if (!FindKeys(times, time, first, factor))
+    {
+        return;
+    }
+    value = factor > 0.0f ? glm::mix(values[first], values[first + 1], factor) : values[first];
+}
+
+/// @brief Interpolates a rotation track, keeps @p value if the track is empty.
+void SampleTrack(const std::vector<float>& times, const std::vector<glm::quat>& values, const float time, glm::quat& value)
+{
+    size_t first = 0;
+    float factor = 0.0f;
+    if (!FindKeys(times, time, first, factor))
+    {
+        return;
+    }
+    value = factor > 0.0f ? glm::normalize(glm::slerp(values[first], values[first + 1], factor)) : values[first];
+}
+
+} // namespace
+
+// Public Fields
+
+// Constructors and Destructors
+
+// Public Methods
+
+void AnimationClip::Sample(const float time, JointPose* pose) const
+{
+    const float clampedTime = std::min(std::max(time, 0.0f), duration);
+
+    for (const Channel& channel : channels)
+    {
+        JointPose& jointPose = pose[channel.joint];
+        SampleTrack(channel.positionTimes, channel.positions, clampedTime, jointPose.position);
+        SampleTrack(channel.rotationTimes, channel.rotations, clampedTime, jointPose.rotation);
+        SampleTrack(channel.scaleTimes, channel.scales, clampedTime, jointPose.scale);
+    }
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+} // namespace velecs
@@ -0,0 +1,117 @@
+/// @file    Skeleton.cpp
+/// @author  Matthew Green
+/// @date    2024-01-23 10:58:41
+///
+/// @section LICENSE
+///
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Animation/Skeleton.h"
+
+#include "velecs/Math/SIMD.h"
+
+namespace velecs {
+
+namespace {
+
+/// @brief Builds the matrix of a local pose, scale first, then rotation, then translation.
+glm::mat4 ComposePose(const JointPose& pose)
+{
+    const glm::mat3 rotation = glm::mat3_cast(pose.rotation);
+
+    glm::mat4 matrix{1.0f};
+    matrix[0] = glm::vec4{rotation[0] * pose.scale.x, 0.0f};
+    matrix[1] = glm::vec4{rotation[1] * pose.scale.y, 0.0f};
+    matrix[2] = glm::vec4{rotation[2] * pose.scale.z, 0.0f};
+    matrix[3] = glm::vec4{pose.position, 1.0f};
+    return matrix;
+}
+
+/// @brief Writes @p a * @p b to @p out, which may not alias either input.
+void Multiply(const glm::mat4& a, const glm::mat4& b, glm::mat4& out)
+{
+#ifdef VELECS_SIMD_SSE2
+    // each column of the product is the columns of a weighted by one column of b
+    const __m128 a0 = _mm_loadu_ps(&a[0][0]);
+    const __m128 a1 = _mm_loadu_ps(&a[1][0]);
+    const __m128 a2 = _mm_loadu_ps(&a[2][0]);
+    const __m128 a3 = _mm_loadu_ps(&a[3][0]);
+    for (int column = 0; column < 4; ++column)
+    {
+        const float* const bColumn = &b[column][0];
+        __m128 result = _mm_mul_ps(a0, _mm_set1_ps(bColumn[0]));
+        result = _mm_add_ps(result, _mm_mul_ps(a1, _mm_set1_ps(bColumn[1])));
+        result = _mm_add_ps(result, _mm_mul_ps(a2, _mm_set1_ps(bColumn[2])));
+        result = _mm_add_ps(result, _mm_mul_ps(a3, _mm_set1_ps(bColumn[3])));
+        _mm_storeu_ps(&out[column][0], result);
+    }
+#else
+    out = a * b;
+#endif
+}
+
+} // namespace
+
+// Public Fields
+
+// Constructors and Destructors
+
+// Public Methods
+
+int32_t Skeleton::FindJoint(const std::string& name) const
+{
+    for (size_t i = 0; i < joints.size(); ++i)
+    {
+        if (joints[i].name == name)
+        {
+            return static_cast<int32_t>(i);
+        }
+    }
+    return NO_PARENT;
+}
+
+uint32_t Skeleton::GetBoneCount() const
+{
+    return static_cast<uint32_t>(boneJoints.size());
+}
+
+void Skeleton::GetBindPose(std::vector<JointPose>& pose) const
+{
+    pose.resize(joints.size());
+    for (size_t i = 0; i < joints.size(); ++i)
+    {
+        pose[i] = joints[i].bindPose;
+    }
+}
+
+void Skeleton::ComputeSkinMatrices(const JointPose* pose, glm::mat4* skinMatrices) const
+{
+    // reused across calls, workers of the thread pool each get their own
+    thread_local std::vector<glm::mat4> globals;
+    globals.resize(joints.size());
+
+    for (size_t i = 0; i < joints.size(); ++i)
+    {
+        const glm::mat4 local = ComposePose(pose[i]);
+        // the root is taken back to mesh space, so the vertices need no extra transform
+        const glm::mat4& parent = joints[i].parent == NO_PARENT ? rootInverse : globals[joints[i].parent];
+        Multiply(parent, local, globals[i]);
+    }
+
+    for (size_t bone = 0; bone < boneJoints.size(); ++bone)
+    {
+        Multiply(globals[boneJoints[bone]], inverseBindMatrices[bone], skinMatrices[bone]);
+    }
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+} // namespace velecs
@@ -0,0 +1,137 @@
+/// @file    ThreadPool.cpp
+/// @author  Matthew Green
+/// @date    2024-01-07 11:03:18
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Core/ThreadPool.h"
+
+namespace velecs {
+
+// Public Fields
+
+// Constructors and Destructors
+
+ThreadPool::ThreadPool(const size_t workerCount /*= DefaultWorkerCount()*/)
+{
+    workers.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; ++i)
+    {
+        workers.emplace_back([this]() { WorkerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeCondition.notify_all();
+
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+// Public Methods
+
+void ThreadPool::ParallelFor(const size_t count, const std::function<void(size_t index)>& job)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    if (workers.empty() || count == 1)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            job(i);
+        }
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        // A worker that woke up late for the previous job must let go of it before it is replaced
+        doneCondition.wait(lock, [this]() { return activeWorkers == 0; });
+
+        currentJob = &job;
+        jobCount = count;
+        nextIndex.store(0);
+        ++jobGeneration;
+    }
+    wakeCondition.notify_all();
+
+    RunIndices(job, count);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    doneCondition.wait(lock, [this]() { return activeWorkers == 0; });
+    currentJob = nullptr;
+}
+
+size_t ThreadPool::GetThreadCount() const
+{
+    return workers.size() + 1;
+}
+
+size_t ThreadPool::DefaultWorkerCount()
+{
+    const unsigned int hardwareThreads = std::thread::hardware_concurrency();
+    return hardwareThreads > 1 ? static_cast<size_t>(hardwareThreads - 1) : 0;
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+void ThreadPool::WorkerLoop()
+{
+    uint64_t seenGeneration = 0;
+    while (true)
+    {
+        const std::function<void(size_t)>* job = nullptr;
+        size_t count = 0;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeCondition.wait(lock, [&]() { return stopping || (currentJob != nullptr && jobGeneration != seenGeneration); });
+            if (stopping)
+            {
+                return;
+            }
+
+            seenGeneration = jobGeneration;
+            job = currentJob;
+            count = jobCount;
+            ++activeWorkers;
+        }
+
+        RunIndices(*job, count);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            --activeWorkers;
+        }
+        doneCondition.notify_all();
+    }
+}
+
+void ThreadPool::RunIndices(const std::function<void(size_t)>& job, const size_t count)
+{
+    for (size_t i = nextIndex.fetch_add(1); i < count; i = nextIndex.fetch_add(1))
+    {
+        job(i);
+    }
+}
+
+} // namespace velecs
@@ -0,0 +1,67 @@
+/// @file    Animator.cpp
+/// @author  Matthew Green
+/// @date    2024-01-23 13:59:02
+///
+/// @section LICENSE
+///
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/ECS/Components/Rendering/Animator.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace velecs {
+
+// Public Fields
+
+// Constructors and Destructors
+
+Animator::Animator(const uint32_t clip, const float speed /*= 1.0f*/, const bool loop /*= true*/)
+    : clip(clip), speed(speed), loop(loop) {}
+
+// Public Methods
+
+void Animator::Play(const uint32_t clip, const bool restart /*= true*/)
+{
+    this->clip = clip;
+    playing = true;
+    if (restart)
+    {
+        time = 0.0f;
+    }
+}
+
+void Animator::Advance(const float deltaTime, const float duration)
+{
+    if (!playing || duration <= 0.0f)
+    {
+        return;
+    }
+
+    time += deltaTime * speed;
+    if (loop)
+    {
+        time = std::fmod(time, duration);
+        if (time < 0.0f)
+        {
+            time += duration;
+        }
+    }
+    else
+    {
+        time = std::min(std::max(time, 0.0f), duration);
+    }
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+} // namespace velecs
@@ -16,6 +16,65 @@ namespace velecs {
 
 // Constructors and Destructors
 
+Material::Material
+(
+    const Color32 color,
+    VkPipeline* const pipeline,
+    VkPipelineLayout* const pipelineLayout,
+    const uint32_t textureIndex /*= BindlessTable::DEFAULT_TEXTURE_INDEX*/
+)
+    : color(color), pipeline(pipeline), pipelineLayout(pipelineLayout), textureIndex(textureIndex) {}
+
+Material::Material(const Material& other)
+    : color(other.color),
+      pipeline(other.pipeline),
+      pipelineLayout(other.pipelineLayout),
+      textureIndex(other.textureIndex),
+      materialIndex(BindlessTable::INVALID_INDEX) {}
+
+Material::Material(Material&& other) noexcept
+    : color(other.color),
+      pipeline(other.pipeline),
+      pipelineLayout(other.pipelineLayout),
+      textureIndex(other.textureIndex),
+      materialIndex(other.materialIndex)
+{
+    other.materialIndex = BindlessTable::INVALID_INDEX;
+}
+
+// Operators
+
+Material& Material::operator=(const Material& other)
+{
+    if (this != &other)
+    {
+        color = other.color;
+        pipeline = other.pipeline;
+        pipelineLayout = other.pipelineLayout;
+        textureIndex = other.textureIndex;
+    }
+    return *this;
+}
+
+Material& Material::operator=(Material&& other) noexcept
+{
+    if (this != &other)
+    {
+        color = other.color;
+        pipeline = other.pipeline;
+        pipelineLayout = other.pipelineLayout;
+        textureIndex = other.textureIndex;
+
+        // Keep our own record if we already have one so it is not leaked.
+        if (materialIndex == BindlessTable::INVALID_INDEX)
+        {
+            materialIndex = other.materialIndex;
+            other.materialIndex = BindlessTable::INVALID_INDEX;
+        }
+    }
+    return *this;
+}
+
 // Public Methods
 
 const Material* const Material::Create
@@ -24,12 +83,13 @@ const Material* const Material::Create
     const std::string& path,
     VkPipeline* const pipeline,
     VkPipelineLayout* const pipelineLayout,
-    const Color32 color /*= Color32::MAGENTA*/
+    const Color32 color /*= Color32::MAGENTA*/,
+    const uint32_t textureIndex /*= BindlessTable::DEFAULT_TEXTURE_INDEX*/
 )
 {
     flecs::entity entity = ecs.entity(path.c_str())
         .is_a<Material>()
-        .set<Material>({color, pipeline, pipelineLayout})
+        .set<Material>(Material{color, pipeline, pipelineLayout, textureIndex})
         ;
     return entity.get<Material>();
 }
@@ -12,6 +12,9 @@
 
 #include "velecs/Math/Vec3.h"
 
+#include "velecs/Rendering/VertexQuantization.h"
+#include "velecs/Rendering/MeshOptimizer.h"
+
 #include "velecs/FileManagement/Path.h"
 #include "velecs/FileManagement/File.h"
 
@@ -19,6 +22,9 @@
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
 
+#include <iomanip>
+#include <iostream>
+
 namespace velecs {
 
 // Public Fields
@@ -99,6 +105,24 @@ SimpleMesh SimpleMesh::Load(std::string filePath)
         }
     }
 
+    // Paid once here instead of every frame on the GPU
+    const MeshOptimizer::Report report = MeshOptimizer::Optimize(mesh._vertices, mesh._indices);
+    std::cout << "[INFO] [SimpleMesh] Optimized '" << filePath << "': "
+        << report.verticesBefore << " -> " << report.verticesAfter << " vertices, "
+        << report.trianglesBefore << " -> " << report.trianglesAfter << " triangles, ACMR "
+        << std::fixed << std::setprecision(3) << report.before.acmr << " -> " << report.after.acmr << ", ATVR "
+        << report.before.atvr << " -> " << report.after.atvr << std::defaultfloat << '.' << std::endl;
+
+    mesh.RecalculateBounds();
+    mesh._vertexFormat = VertexQuantization::ChooseFormat(mesh._bounds);
+
+    // Small meshes are cheaper to draw whole than to cull piece by piece
+    if (mesh._indices.size() / 3 >= CLUSTERED_TRIANGLE_THRESHOLD)
+    {
+        mesh.BuildMeshlets();
+        std::cout << "[INFO] [SimpleMesh] Split '" << filePath << "' into " << mesh._meshlets.size() << " meshlets." << std::endl;
+    }
+
     return mesh;
 }
 
@@ -115,6 +139,20 @@ bool SimpleMesh::TryLoad(const std::string& filePath, SimpleMesh*& mesh)
     return true;
 }
 
+void SimpleMesh::RecalculateBounds()
+{
+    _bounds = AABB{};
+    for (const SimpleVertex& vertex : _vertices)
+    {
+        _bounds.Encapsulate(vertex.position);
+    }
+}
+
+void SimpleMesh::BuildMeshlets()
+{
+    _meshlets = MeshOptimizer::BuildMeshlets(_vertices, _indices);
+}
+
 // Protected Fields
 
 // Protected Methods
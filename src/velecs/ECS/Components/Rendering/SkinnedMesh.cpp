@@ -0,0 +1,356 @@
+/// @file    SkinnedMesh.cpp
+/// @author  Matthew Green
+/// @date    2024-01-23 12:36:58
+///
+/// @section LICENSE
+///
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/ECS/Components/Rendering/SkinnedMesh.h"
+
+#include "velecs/Rendering/MeshOptimizer.h"
+
+#include "velecs/FileManagement/Path.h"
+
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+#include <assimp/postprocess.h>
+
+#include <glm/glm.hpp>
+
+#include <iostream>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+namespace velecs {
+
+namespace {
+
+/// @brief Converts a row-major Assimp matrix to a column-major glm one.
+glm::mat4 ToMat4(const aiMatrix4x4& m)
+{
+    return glm::mat4
+    {
+        m.a1, m.b1, m.c1, m.d1,
+        m.a2, m.b2, m.c2, m.d2,
+        m.a3, m.b3, m.c3, m.d3,
+        m.a4, m.b4, m.c4, m.d4
+    };
+}
+
+/// @brief Splits a node transform into the parts clips animate.
+JointPose ToPose(const aiMatrix4x4& m)
+{
+    aiVector3D scale;
+    aiQuaternion rotation;
+    aiVector3D position;
+    m.Decompose(scale, rotation, position);
+
+    JointPose pose;
+    pose.position = glm::vec3{position.x, position.y, position.z};
+    pose.rotation = glm::quat{rotation.w, rotation.x, rotation.y, rotation.z};
+    pose.scale = glm::vec3{scale.x, scale.y, scale.z};
+    return pose;
+}
+
+} // namespace
+
+// Public Fields
+
+// Constructors and Destructors
+
+// Public Methods
+
+SkinnedMesh SkinnedMesh::Load(std::string filePath)
+{
+    filePath = Path::Combine(Path::MESHES_DIR, filePath);
+
+    // At most four influences per vertex, the weakest are dropped and the rest renormalized
+    Assimp::Importer importer;
+    const aiScene* scene = importer.ReadFile(filePath,
+        aiProcess_ValidateDataStructure | aiProcess_Triangulate | aiProcess_JoinIdenticalVertices | aiProcess_LimitBoneWeights);
+
+    if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode)
+    {
+        throw std::runtime_error("Failed to load file: " + filePath + "; Error: " + importer.GetErrorString());
+    }
+
+    if (scene->mNumMeshes == 0)
+    {
+        throw std::runtime_error("No meshes found in file: " + filePath);
+    }
+    if (scene->mNumMeshes > 1)
+    {
+        throw std::runtime_error("More than one mesh found in file: " + filePath + "; Mesh count: " + std::to_string(scene->mNumMeshes));
+    }
+
+    const aiMesh* aiMesh = scene->mMeshes[0]; // Assuming one mesh per file
+
+    if (!aiMesh->HasBones())
+    {
+        throw std::runtime_error("No bones found in file: " + filePath + ", load it as a SimpleMesh instead.");
+    }
+    if (aiMesh->mNumBones > MAX_BONES)
+    {
+        throw std::runtime_error("Too many bones in file: " + filePath + "; Bone count: " + std::to_string(aiMesh->mNumBones) + ", at most " + std::to_string(MAX_BONES) + " are supported.");
+    }
+
+    // Extract vertices
+    SkinnedMesh mesh;
+    const size_t numVertices = aiMesh->mNumVertices;
+    mesh._vertices.reserve(numVertices);
+    for (size_t i = 0; i < numVertices; ++i)
+    {
+        SkinnedVertex vertex{glm::vec3{aiMesh->mVertices[i].x, aiMesh->mVertices[i].y, aiMesh->mVertices[i].z}};
+        vertex.boneWeights = glm::vec4{0.0f};
+        mesh._vertices.push_back(vertex);
+    }
+
+    for (size_t i = 0; i < aiMesh->mNumFaces; ++i)
+    {
+        const aiFace& face = aiMesh->mFaces[i];
+        if (face.mNumIndices != 3)
+        {
+            throw std::runtime_error("Face " + std::to_string(i) + " has invalid number of indices (" + std::to_string(face.mNumIndices) + "), expected 3.");
+        }
+
+        for (size_t j = 0; j < face.mNumIndices; ++j)
+        {
+            mesh._indices.emplace_back(face.mIndices[j]);
+        }
+    }
+
+    // Bone weights, each vertex fills its four influence slots in the order the bones list it
+    std::vector<uint32_t> influenceCounts(numVertices, 0);
+    std::unordered_map<std::string, uint32_t> boneIndices;
+    for (uint32_t bone = 0; bone < aiMesh->mNumBones; ++bone)
+    {
+        const aiBone* aiBone = aiMesh->mBones[bone];
+        boneIndices[aiBone->mName.C_Str()] = bone;
+
+        for (uint32_t i = 0; i < aiBone->mNumWeights; ++i)
+        {
+            const aiVertexWeight& weight = aiBone->mWeights[i];
+            if (weight.mWeight <= 0.0f || weight.mVertexId >= numVertices || influenceCounts[weight.mVertexId] >= 4)
+            {
+                continue;
+            }
+
+            SkinnedVertex& vertex = mesh._vertices[weight.mVertexId];
+            const uint32_t influence = influenceCounts[weight.mVertexId]++;
+            vertex.boneIndices |= bone << (influence * 8);
+            vertex.boneWeights[influence] = weight.mWeight;
+        }
+    }
+
+    size_t unweightedCount = 0;
+    for (SkinnedVertex& vertex : mesh._vertices)
+    {
+        const float totalWeight = vertex.boneWeights.x + vertex.boneWeights.y + vertex.boneWeights.z + vertex.boneWeights.w;
+        if (totalWeight > 0.0f)
+        {
+            vertex.boneWeights /= totalWeight;
+        }
+        else
+        {
+            vertex.boneIndices = 0;
+            vertex.boneWeights = glm::vec4{1.0f, 0.0f, 0.0f, 0.0f}; // Follows the first bone rather than collapsing to the origin
+            ++unweightedCount;
+        }
+    }
+
+    // Only the bones and the nodes above them become joints, the rest of the scene is not posed
+    std::unordered_set<const aiNode*> skeletonNodes;
+    for (uint32_t bone = 0; bone < aiMesh->mNumBones; ++bone)
+    {
+        const aiNode* node = scene->mRootNode->FindNode(aiMesh->mBones[bone]->mName);
+        if (node == nullptr)
+        {
+            throw std::runtime_error("Bone '" + std::string(aiMesh->mBones[bone]->mName.C_Str()) + "' has no node in file: " + filePath);
+        }
+        for (; node != nullptr && skeletonNodes.insert(node).second; node = node->mParent) {}
+    }
+
+    Skeleton& skeleton = mesh._skeleton;
+    skeleton.boneJoints.resize(aiMesh->mNumBones, 0);
+    skeleton.inverseBindMatrices.resize(aiMesh->mNumBones, glm::mat4{1.0f});
+    skeleton.rootInverse = glm::inverse(ToMat4(scene->mRootNode->mTransformation));
+
+    // Depth first, a node is only pushed once its parent has its index
+    std::vector<std::pair<const aiNode*, int32_t>> pending{{scene->mRootNode, Skeleton::NO_PARENT}};
+    while (!pending.empty())
+    {
+        const aiNode* const node = pending.back().first;
+        const int32_t parent = pending.back().second;
+        pending.pop_back();
+
+        const int32_t jointIndex = static_cast<int32_t>(skeleton.joints.size());
+
+        Skeleton::Joint joint;
+        joint.name = node->mName.C_Str();
+        joint.parent = parent;
+        joint.bindPose = ToPose(node->mTransformation);
+        skeleton.joints.push_back(joint);
+
+        const auto bone = boneIndices.find(joint.name);
+        if (bone != boneIndices.end())
+        {
+            skeleton.boneJoints[bone->second] = static_cast<uint32_t>(jointIndex);
+            skeleton.inverseBindMatrices[bone->second] = ToMat4(aiMesh->mBones[bone->second]->mOffsetMatrix);
+        }
+
+        for (uint32_t i = node->mNumChildren; i > 0; --i)
+        {
+            const aiNode* const child = node->mChildren[i - 1];
+            if (skeletonNodes.count(child) != 0)
+            {
+                pending.emplace_back(child, jointIndex);
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < scene->mNumAnimations; ++i)
+    {
+        const aiAnimation* const animation = scene->mAnimations[i];
+        const double ticksPerSecond = animation->mTicksPerSecond > 0.0 ? animation->mTicksPerSecond : 25.0; // Assimp's default when the file has none
+
+        AnimationClip clip;
+        clip.name = animation->mName.C_Str();
+        clip.duration = static_cast<float>(animation->mDuration / ticksPerSecond);
+
+        for (uint32_t c = 0; c < animation->mNumChannels; ++c)
+        {
+            const aiNodeAnim* const nodeAnim = animation->mChannels[c];
+            const int32_t joint = skeleton.FindJoint(nodeAnim->mNodeName.C_Str());
+            if (joint == Skeleton::NO_PARENT)
+            {
+                continue; // Animates a node that moves no bone
+            }
+
+            AnimationClip::Channel channel;
+            channel.joint = static_cast<uint32_t>(joint);
+
+            for (uint32_t k = 0; k < nodeAnim->mNumPositionKeys; ++k)
+            {
+                const aiVectorKey& key = nodeAnim->mPositionKeys[k];
+                channel.positionTimes.push_back(static_cast<float>(key.mTime / ticksPerSecond));
+                channel.positions.emplace_back(key.mValue.x, key.mValue.y, key.mValue.z);
+            }
+            for (uint32_t k = 0; k < nodeAnim->mNumRotationKeys; ++k)
+            {
+                const aiQuatKey& key = nodeAnim->mRotationKeys[k];
+                channel.rotationTimes.push_back(static_cast<float>(key.mTime / ticksPerSecond));
+                channel.rotations.emplace_back(key.mValue.w, key.mValue.x, key.mValue.y, key.mValue.z);
+            }
+            for (uint32_t k = 0; k < nodeAnim->mNumScalingKeys; ++k)
+            {
+                const aiVectorKey& key = nodeAnim->mScalingKeys[k];
+                channel.scaleTimes.push_back(static_cast<float>(key.mTime / ticksPerSecond));
+                channel.scales.emplace_back(key.mValue.x, key.mValue.y, key.mValue.z);
+            }
+
+            clip.channels.push_back(std::move(channel));
+        }
+
+        mesh._clips.push_back(std::move(clip));
+    }
+
+    // Only the triangle order, the skinning pass reads the vertices in place
+    MeshOptimizer::OptimizeVertexCache(mesh._indices, mesh._vertices.size());
+
+    mesh.RecalculateBounds();
+
+    std::cout << "[INFO] [SkinnedMesh] Loaded '" << filePath << "': "
+        << mesh._vertices.size() << " vertices, " << skeleton.GetBoneCount() << " bones, "
+        << skeleton.joints.size() << " joints, " << mesh._clips.size() << " clips." << std::endl;
+    if (unweightedCount > 0)
+    {
+        std::cout << "[WARNING] [SkinnedMesh] " << unweightedCount << " vertices of '" << filePath << "' have no bone weights and follow the first bone." << std::endl;
+    }
+
+    return mesh;
+}
+
+uint32_t SkinnedMesh::FindClip(const std::string& name) const
+{
+    for (size_t i = 0; i < _clips.size(); ++i)
+    {
+        if (_clips[i].name == name)
+        {
+            return static_cast<uint32_t>(i);
+        }
+    }
+    return UINT32_MAX;
+}
+
+void SkinnedMesh::Evaluate(const uint32_t clip, const float time, glm::mat4* skinMatrices) const
+{
+    // reused across calls, workers of the thread pool each get their own
+    thread_local std::vector<JointPose> pose;
+    _skeleton.GetBindPose(pose);
+
+    if (clip < _clips.size())
+    {
+        _clips[clip].Sample(time, pose.data());
+    }
+
+    _skeleton.ComputeSkinMatrices(pose.data(), skinMatrices);
+}
+
+void SkinnedMesh::RecalculateBounds()
+{
+    _bounds = AABB{};
+
+    // A skinned vertex is a weighted average of its bones' transforms of it, so it stays
+    // inside the union of each bone's bind space vertices carried along by that bone
+    const uint32_t boneCount = _skeleton.GetBoneCount();
+    std::vector<AABB> boneBounds(boneCount);
+    for (const SkinnedVertex& vertex : _vertices)
+    {
+        _bounds.Encapsulate(vertex.position);
+        for (uint32_t influence = 0; influence < 4; ++influence)
+        {
+            const uint32_t bone = vertex.GetBoneIndex(influence);
+            if (vertex.boneWeights[influence] > 0.0f && bone < boneCount)
+            {
+                boneBounds[bone].Encapsulate(vertex.position);
+            }
+        }
+    }
+
+    std::vector<glm::mat4> skinMatrices(boneCount);
+    for (uint32_t clip = 0; clip < _clips.size(); ++clip)
+    {
+        for (uint32_t sample = 0; sample < BOUNDS_SAMPLES_PER_CLIP; ++sample)
+        {
+            const float time = _clips[clip].duration * static_cast<float>(sample) / static_cast<float>(BOUNDS_SAMPLES_PER_CLIP - 1);
+            Evaluate(clip, time, skinMatrices.data());
+
+            for (uint32_t bone = 0; bone < boneCount; ++bone)
+            {
+                if (!boneBounds[bone].IsValid())
+                {
+                    continue;
+                }
+                for (const glm::vec3& corner : boneBounds[bone].GetCorners())
+                {
+                    _bounds.Encapsulate(glm::vec3{skinMatrices[bone] * glm::vec4{corner, 1.0f}});
+                }
+            }
+        }
+    }
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+} // namespace velecs
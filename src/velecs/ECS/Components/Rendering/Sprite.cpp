@@ -8,6 +8,7 @@
 /// Unauthorized copying of this file, via any medium is strictly prohibited
 /// Proprietary and confidential
 
+#define STB_IMAGE_IMPLEMENTATION
 #include "velecs/ECS/Components/Rendering/Sprite.h"
 
 namespace velecs {
@@ -76,6 +77,11 @@ const int Sprite::numChannels() const
     return _numChannels;
 }
 
+const unsigned char* Sprite::data() const
+{
+    return _data.get();
+}
+
 // Protected Fields
 
 // Protected Methods
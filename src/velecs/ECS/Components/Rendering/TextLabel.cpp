@@ -0,0 +1,53 @@
+/// @file    TextLabel.cpp
+/// @author  Matthew Green
+/// @date    2024-01-22 11:55:29
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/ECS/Components/Rendering/TextLabel.h"
+
+namespace velecs {
+
+// Public Fields
+
+// Constructors and Destructors
+
+TextLabel::TextLabel(const std::string& text, const float size /*= 1.0f*/, const Color32 color /*= Color32::WHITE*/)
+    : color(color), size(size), text(text) {}
+
+// Public Methods
+
+void TextLabel::SetText(const std::string& text)
+{
+    if (this->text == text)
+    {
+        return; // Setting the same text every frame does not cost a layout
+    }
+
+    this->text = text;
+    ++revision;
+}
+
+const std::string& TextLabel::GetText() const
+{
+    return text;
+}
+
+uint32_t TextLabel::GetRevision() const
+{
+    return revision;
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+} // namespace velecs
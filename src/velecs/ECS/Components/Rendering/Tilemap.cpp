@@ -0,0 +1,141 @@
+/// @file    Tilemap.cpp
+/// @author  Matthew Green
+/// @date    2024-01-21 10:31:44
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/ECS/Components/Rendering/Tilemap.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace velecs {
+
+// Public Fields
+
+// Constructors and Destructors
+
+Tilemap::Tilemap
+(
+    const uint32_t width,
+    const uint32_t height,
+    const float tileSize /*= 1.0f*/,
+    const uint32_t atlasColumns /*= 1*/,
+    const uint32_t atlasRows /*= 1*/
+)
+    : tileSize(tileSize),
+      atlasColumns(atlasColumns),
+      atlasRows(atlasRows),
+      width(width),
+      height(height),
+      chunkColumns((width + CHUNK_SIZE - 1) / CHUNK_SIZE),
+      chunkRows((height + CHUNK_SIZE - 1) / CHUNK_SIZE),
+      chunks(static_cast<size_t>(chunkColumns) * chunkRows) {}
+
+// Public Methods
+
+void Tilemap::SetTile(const uint32_t x, const uint32_t y, const uint16_t tile)
+{
+    CheckBounds(x, y);
+
+    Chunk& chunk = chunks[static_cast<size_t>(y / CHUNK_SIZE) * chunkColumns + x / CHUNK_SIZE];
+    uint16_t& slot = chunk.tiles[(y % CHUNK_SIZE) * CHUNK_SIZE + x % CHUNK_SIZE];
+    if (slot == tile)
+    {
+        return; // Repainting a tile with itself does not cost a rebuild
+    }
+
+    if (slot == EMPTY_TILE)
+    {
+        ++chunk.tileCount;
+    }
+    else if (tile == EMPTY_TILE)
+    {
+        --chunk.tileCount;
+    }
+
+    slot = tile;
+    ++chunk.revision;
+}
+
+uint16_t Tilemap::GetTile(const uint32_t x, const uint32_t y) const
+{
+    CheckBounds(x, y);
+
+    const Chunk& chunk = chunks[static_cast<size_t>(y / CHUNK_SIZE) * chunkColumns + x / CHUNK_SIZE];
+    return chunk.tiles[(y % CHUNK_SIZE) * CHUNK_SIZE + x % CHUNK_SIZE];
+}
+
+void Tilemap::Fill(const uint16_t tile)
+{
+    for (uint32_t chunkY = 0; chunkY < chunkRows; ++chunkY)
+    {
+        for (uint32_t chunkX = 0; chunkX < chunkColumns; ++chunkX)
+        {
+            Chunk& chunk = chunks[static_cast<size_t>(chunkY) * chunkColumns + chunkX];
+
+            // Edge chunks keep the tiles past the map empty
+            const uint32_t columns = std::min(CHUNK_SIZE, width - chunkX * CHUNK_SIZE);
+            const uint32_t rows = std::min(CHUNK_SIZE, height - chunkY * CHUNK_SIZE);
+            for (uint32_t y = 0; y < rows; ++y)
+            {
+                for (uint32_t x = 0; x < columns; ++x)
+                {
+                    chunk.tiles[y * CHUNK_SIZE + x] = tile;
+                }
+            }
+
+            chunk.tileCount = tile == EMPTY_TILE ? 0 : columns * rows;
+            ++chunk.revision;
+        }
+    }
+}
+
+uint32_t Tilemap::GetWidth() const
+{
+    return width;
+}
+
+uint32_t Tilemap::GetHeight() const
+{
+    return height;
+}
+
+uint32_t Tilemap::GetChunkColumns() const
+{
+    return chunkColumns;
+}
+
+uint32_t Tilemap::GetChunkRows() const
+{
+    return chunkRows;
+}
+
+const Tilemap::Chunk& Tilemap::GetChunk(const uint32_t chunkX, const uint32_t chunkY) const
+{
+    return chunks[static_cast<size_t>(chunkY) * chunkColumns + chunkX];
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+void Tilemap::CheckBounds(const uint32_t x, const uint32_t y) const
+{
+    if (x >= width || y >= height)
+    {
+        throw std::out_of_range("Tile (" + std::to_string(x) + ", " + std::to_string(y) + ") is outside of a " +
+            std::to_string(width) + "x" + std::to_string(height) + " tilemap.");
+    }
+}
+
+} // namespace velecs
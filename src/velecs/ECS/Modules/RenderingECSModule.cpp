@@ -20,12 +20,24 @@
 #include "velecs/Rendering/ShaderModule.h"
 #include "velecs/Rendering/PipelineBuilder.h"
 #include "velecs/Rendering/MeshPushConstants.h"
+#include "velecs/Rendering/FrameUniforms.h"
+#include "velecs/Rendering/BlockCompression.h"
+#include "velecs/Rendering/ParticlePushConstants.h"
+#include "velecs/Rendering/TextPushConstants.h"
+#include "velecs/Rendering/ImpostorPushConstants.h"
+#include "velecs/Rendering/QuantizedSimpleVertex.h"
+#include "velecs/Rendering/TileVertex.h"
+#include "velecs/Rendering/DebugDraw.h"
 #include "velecs/Graphics/Color32.h"
 #include "velecs/FileManagement/Path.h"
 
 #include <iostream>
 #include <fstream>
 #include <chrono>
+#include <limits>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
 
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_vulkan.h>
@@ -36,6 +48,8 @@
 #include <vma/vk_mem_alloc.h>
 
 #include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/constants.hpp>
+#include <glm/matrix.hpp>
 
 #include <imgui_internal.h>
 #include <backends/imgui_impl_sdl2.h>
@@ -69,19 +83,127 @@ RenderingECSModule::RenderingECSModule(flecs::world& ecs)
     InitVulkan();
     InitSwapchain();
     InitCommands();
+    InitUploadQueue();
     InitDefaultRenderPass();
     InitFrameBuffers();
+    InitSceneTarget();
     InitSyncStructures();
+    InitDescriptors();
+    InitBindlessTable();
+    InitTransformBuffer();
+    InitParticles();
+    InitTilemaps();
+    InitText();
+    InitSkinning();
+    InitMeshlets();
+    InitDynamicBatching();
+    InitDebugDraw();
     InitPipelines();
+    InitRenderTargets();
 
     InitImGui();
 
+    frameCapture.Init(_allocator);
+
+    #ifdef VELECS_NO_RENDER_THREAD
+        const bool threadedRendering = false;
+    #else
+        const bool threadedRendering = true;
+    #endif
+    renderThread.Start([this](RenderSnapshot& snapshot) { RenderFrame(snapshot); }, threadedRendering);
+
     ecs.component<Transform>();
     ecs.component<Mesh>();
     ecs.component<SimpleMesh>();
     ecs.component<Material>();
+    ecs.component<Occluder>();
+    ecs.component<TransformSlot>();
+    ecs.component<Static>();
+    ecs.component<StaticBatched>();
+    ecs.component<ParticleEmitter>();
+    ecs.component<Tilemap>();
+    ecs.component<TextLabel>();
+    ecs.component<SkinnedMesh>();
+    ecs.component<Animator>();
+    ecs.component<SkinSlot>();
+    ecs.component<RenderView>();
+    ecs.component<RenderTargetSlot>();
+    ecs.component<Impostor>();
+
+    occluderQuery = ecs.query_builder<const Transform, const SimpleMesh>()
+        .with<Occluder>()
+        .build();
+
+    staticQuery = ecs.query_builder<const Transform, const SimpleMesh, const Material>()
+        .with<Static>()
+        .without<StaticBatched>()
+        .build();
+
+    emitterQuery = ecs.query<const Transform, ParticleEmitter>();
+
+    tilemapQuery = ecs.query<const Tilemap, Material, const TransformSlot>();
+
+    textQuery = ecs.query<const Transform, TextLabel>();
+
+    skinnedQuery = ecs.query<SkinnedMesh, const Animator, Material, const TransformSlot, const SkinSlot>();
+
+    viewQuery = ecs.query<const RenderView>();
+
+    // The hook only holds a weak reference, Material components can outlive the module during world teardown.
+    std::weak_ptr<BindlessTable> weakBindlessTable = bindlessTable;
+    ecs.observer<Material>()
+        .event(flecs::OnRemove)
+        .each([weakBindlessTable](Material& material)
+        {
+            if (auto table = weakBindlessTable.lock())
+            {
+                table->ReleaseMaterial(material.materialIndex);
+            }
+            material.materialIndex = BindlessTable::INVALID_INDEX;
+        }
+    );
+
+    std::weak_ptr<TransformBuffer> weakTransformBuffer = transformBuffer;
+    ecs.observer<TransformSlot>()
+        .event(flecs::OnRemove)
+        .each([weakTransformBuffer](TransformSlot& slot)
+        {
+            if (auto buffer = weakTransformBuffer.lock())
+            {
+                buffer->Release(slot.index);
+            }
+            slot.index = TransformBuffer::INVALID_INDEX;
+        }
+    );
+
+    std::weak_ptr<SkinningSystem> weakSkinningSystem = skinningSystem;
+    ecs.observer<SkinSlot>()
+        .event(flecs::OnRemove)
+        .each([weakSkinningSystem](SkinSlot& slot)
+        {
+            if (auto system = weakSkinningSystem.lock())
+            {
+                system->Release(slot.index);
+            }
+            slot.index = SkinningSystem::INVALID_INDEX;
+        }
+    );
+
+    std::weak_ptr<RenderTargetPool> weakRenderTargets = renderTargets;
+    ecs.observer<RenderTargetSlot>()
+        .event(flecs::OnRemove)
+        .each([weakRenderTargets](RenderTargetSlot& slot)
+        {
+            if (auto pool = weakRenderTargets.lock())
+            {
+                pool->Release(slot.index);
+            }
+            slot.index = RenderTargetPool::INVALID_INDEX;
+            slot.textureIndex = BindlessTable::INVALID_INDEX;
+        }
+    );
 
-    const Material* const simpleMeshUnlit = Material::Create(ecs, "SimpleMesh/Color", &simpleMeshPipeline, &simpleMeshPipelineLayout);
+    const Material* const simpleMeshUnlit = CreateSimpleMeshMaterial("SimpleMesh/Color", SimpleMeshFeatures::MATERIAL_COLOR);
 
     flecs::entity trianglePrefab = Prefab::Create("PR_TriangleRender")
         .set<SimpleMesh>(SimpleMesh::EQUILATERAL_TRIANGLE())
@@ -102,6 +224,134 @@ RenderingECSModule::RenderingECSModule(flecs::world& ecs)
         }
     );
 
+    ecs.system()
+        .kind(stages->PreDraw)
+        .iter([this](flecs::iter& it)
+        {
+            if (staticQuery.is_true())
+            {
+                flecs::world ecs = it.world();
+                BakeStaticBatches(ecs);
+            }
+        }
+    );
+
+    // Static entities are only drawn through their batch
+    ecs.system<const Transform>()
+        .kind(stages->PreDraw)
+        .with<SimpleMesh>()
+        .with<Material>()
+        .without<Static>()
+        .without<TransformSlot>()
+        .write<TransformSlot>()
+        .each([this](flecs::entity entity, const Transform& transform)
+        {
+            entity.set<TransformSlot>({transformBuffer->Allocate()});
+        }
+    );
+
+    // A tilemap has one world matrix, its chunks are offset from it in the vertex shader
+    ecs.system<const Transform>()
+        .kind(stages->PreDraw)
+        .with<Tilemap>()
+        .with<Material>()
+        .without<TransformSlot>()
+        .write<TransformSlot>()
+        .each([this](flecs::entity entity, const Transform& transform)
+        {
+            entity.set<TransformSlot>({transformBuffer->Allocate()});
+        }
+    );
+
+    // The posed vertices stay in mesh space, the world matrix is applied when drawing
+    ecs.system<const Transform>()
+        .kind(stages->PreDraw)
+        .with<SkinnedMesh>()
+        .with<Material>()
+        .without<TransformSlot>()
+        .write<TransformSlot>()
+        .each([this](flecs::entity entity, const Transform& transform)
+        {
+            entity.set<TransformSlot>({transformBuffer->Allocate()});
+        }
+    );
+
+    ecs.system<const SkinnedMesh, const Animator>()
+        .kind(stages->PreDraw)
+        .with<Material>()
+        .without<SkinSlot>()
+        .write<SkinSlot>()
+        .each([this](flecs::entity entity, const SkinnedMesh& mesh, const Animator& animator)
+        {
+            entity.set<SkinSlot>({skinningSystem->Allocate()});
+        }
+    );
+
+    // Texture views get a target of their size, views moved back to the window give theirs up
+    ecs.system<const RenderView>()
+        .kind(stages->PreDraw)
+        .write<RenderTargetSlot>()
+        .each([this](flecs::entity entity, const RenderView& view)
+        {
+            const RenderTargetSlot* const slot = entity.get<RenderTargetSlot>();
+            if (!view.IsOffscreen())
+            {
+                if (slot != nullptr)
+                {
+                    entity.remove<RenderTargetSlot>();
+                }
+                return;
+            }
+
+            if (slot != nullptr && slot->width == view.textureWidth && slot->height == view.textureHeight)
+            {
+                return;
+            }
+
+            if (slot != nullptr)
+            {
+                renderTargets->Release(slot->index); // replaced without removing, so the observer does not run
+            }
+
+            bool created = false;
+            const uint32_t index = renderTargets->Acquire({view.textureWidth, view.textureHeight}, created);
+            const RenderTarget& target = renderTargets->Get(index);
+            if (created)
+            {
+                // materials may sample the texture before the view is first drawn
+                ImmediateSubmit([&target](VkCommandBuffer cmd) { RenderTargetPool::RecordInitialLayout(cmd, target); });
+            }
+
+            entity.set<RenderTargetSlot>({index, target.textureIndex, view.textureWidth, view.textureHeight});
+        }
+    );
+
+    ecs.system<const Transform, const TransformSlot>()
+        .kind(stages->PreDraw)
+        .iter([this](flecs::iter& it, const Transform* transforms, const TransformSlot* slots)
+        {
+            // Children also move with their parents, which does not touch their own table
+            if (!it.changed() && !it.table().has(flecs::ChildOf, flecs::Wildcard))
+            {
+                return; // Nothing in this table was written since the last frame
+            }
+
+            for (auto i : it)
+            {
+                transformBuffer->Write(slots[i].index, transforms[i].GetWorldMatrix());
+            }
+        }
+    );
+
+    ecs.system()
+        .kind(stages->PreDraw)
+        .iter([this](flecs::iter& it)
+        {
+            flecs::world ecs = it.world();
+            RasterizeOccluders(ecs);
+        }
+    );
+
     ecs.system()
         .kind(stages->PostDraw)
         .iter([this](flecs::iter& it)
@@ -121,68 +371,372 @@ RenderingECSModule::RenderingECSModule(flecs::world& ecs)
             }
         );
 
-    ecs.system<Transform, SimpleMesh, Material>()
+    // Before every extraction that culls or draws against the views
+    ecs.system()
         .kind(stages->Draw)
-        .iter([this](flecs::iter& it, Transform* transforms, SimpleMesh* meshes, Material* materials)
+        .iter([this](flecs::iter& it)
         {
-            float deltaTime = it.delta_time();
+            flecs::world ecs = it.world();
+            ExtractViews(ecs);
+        }
+    );
 
-            const auto mainCameraEntity = it.world().singleton<MainCamera>();
-            const auto cameraEntity = mainCameraEntity.get<MainCamera>()->camera;
-            const auto cameraTransform = cameraEntity.get<Transform>();
+    ecs.system()
+        .kind(stages->Draw)
+        .iter([this](flecs::iter& it)
+        {
+            flecs::world ecs = it.world();
+            ExtractParticleEmitters(ecs, it.delta_time());
+        }
+    );
 
-            const PerspectiveCamera* perspectiveCamera;
-            const OrthoCamera* orthoCamera;
-            bool usingPerspective = true;
+    ecs.system()
+        .kind(stages->Draw)
+        .iter([this](flecs::iter& it)
+        {
+            flecs::world ecs = it.world();
+            ExtractTilemaps(ecs);
+        }
+    );
 
-            if (cameraEntity.has<PerspectiveCamera>())
-            {
-                perspectiveCamera = cameraEntity.get<PerspectiveCamera>();
-                usingPerspective = true;
-            }
-            else if (cameraEntity.has<OrthoCamera>())
-            {
-                orthoCamera = cameraEntity.get<OrthoCamera>();
-                usingPerspective = false;
-            }
-            else
-            {
-                throw std::runtime_error("MainCamera singleton is missing a PerspectiveCamera or OrthoCamera component.");
-            }
+    ecs.system()
+        .kind(stages->Draw)
+        .iter([this](flecs::iter& it)
+        {
+            flecs::world ecs = it.world();
+            ExtractText(ecs);
+        }
+    );
 
+    ecs.system()
+        .kind(stages->Draw)
+        .iter([this](flecs::iter& it)
+        {
+            flecs::world ecs = it.world();
+            ExtractSkinnedMeshes(ecs);
+        }
+    );
+
+    // Every view is culled in one pass: each object's world bounds are computed once and tested
+    // against all frusta, so an additional view costs a few plane tests per object, not a scene walk
+    ecs.system<const Transform, SimpleMesh, Material, const TransformSlot>()
+        .kind(stages->Draw)
+        .iter([this](flecs::iter& it, const Transform* transforms, SimpleMesh* meshes, Material* materials, const TransformSlot* slots)
+        {
+            RenderSnapshot& snapshot = renderThread.GetWriteSnapshot();
+
+            /// @brief An entity ready to draw, waiting for its visibility mask.
+            struct CullCandidate {
+                size_t row;
+                VkPipeline pipeline;
+                bool occluder;
+                uint32_t impostorAtlas; /// @brief Index in impostorAtlases, Impostor::NO_ATLAS draws the mesh only.
+                float impostorFade; /// @brief 0 draws the mesh alone in the main view, 1 the impostor alone.
+                bool batched; /// @brief Merged into the dynamic batch of its material instead of drawn on its own.
+            };
+            std::vector<CullCandidate> candidates;
+            candidates.reserve(it.count());
+
+            const glm::vec3 cameraPosition = snapshot.views[0].position;
+
+            // uploads and material records are shared state, so the candidates are gathered serially
             for (auto i : it)
             {
-                const Transform& transform = transforms[i];
                 SimpleMesh& mesh = meshes[i];
-                const Material& material = materials[i];
-                const flecs::entity entity = it.entity(i);
+                Material& material = materials[i];
 
                 if (mesh._vertices.empty() || material.pipeline == VK_NULL_HANDLE || material.pipelineLayout == VK_NULL_HANDLE)
                 {
                     continue; // Not enough data to render? Skip entity
                 }
 
-                if (!mesh._vertexBuffer.IsInitialized())
+                const flecs::entity entity = it.entity(i);
+                const Impostor* const impostor = entity.get<Impostor>();
+                const bool hasImpostor = impostor != nullptr && impostor->atlas < impostorAtlases.size();
+
+                // batches hold world space vertices, which would slide the texture of the object space TEXTURED variants
+                const auto features = simpleMeshPipelineFeatures.find(*material.pipeline);
+                const bool textured = features != simpleMeshPipelineFeatures.end() && (features->second & SimpleMeshFeatures::TEXTURED) != 0;
+
+                // impostors and clusters need the mesh drawn on its own, batches only read the CPU copy of the mesh
+                const bool batched = !hasImpostor && !textured && mesh._meshlets.empty() && dynamicBatcher.IsBatchable(mesh);
+
+                VkPipeline pipeline = *material.pipeline;
+                if (!batched && mesh._vertexFormat == VertexFormat::Quantized16)
+                {
+                    const auto variant = quantizedPipelineVariants.find(pipeline);
+                    if (variant != quantizedPipelineVariants.end())
+                    {
+                        pipeline = variant->second;
+                    }
+                    else if (!mesh._vertexBuffer.IsInitialized())
+                    {
+                        mesh._vertexFormat = VertexFormat::Float32; // The material only reads full precision vertices
+                    }
+                    else if (uploadQueue.IsComplete(mesh._uploadValue))
+                    {
+                        // Uploaded quantized for an earlier material, the buffers are swapped once and the format sticks
+                        std::cout << "[WARNING] [Rendering] A quantized mesh now uses a material without a quantized variant, re-uploading it at full precision." << std::endl;
+
+                        for (AllocatedBuffer* buffer : {&mesh._vertexBuffer, &mesh._indexBuffer, &mesh._meshletBuffer})
+                        {
+                            if (buffer->IsInitialized())
+                            {
+                                snapshot.retiredBuffers.push_back(*buffer);
+                                *buffer = AllocatedBuffer{};
+                            }
+                        }
+                        mesh._vertexFormat = VertexFormat::Float32;
+                    }
+                    else
+                    {
+                        continue; // Still streaming in quantized, swapped once it lands
+                    }
+                }
+
+                // a mesh that stops being batchable, say the threshold dropped, is uploaded on first use
+                if (!batched && !mesh._vertexBuffer.IsInitialized())
                 {
                     UploadMesh(mesh);
                 }
 
-                if (currentPipeline != *material.pipeline)
+                if (!batched && !uploadQueue.IsComplete(mesh._uploadValue))
+                {
+                    continue; // Still streaming in
+                }
+
+                material.materialIndex = AcquireMaterialIndex(material);
+
+                CullCandidate candidate{i, pipeline, entity.has<Occluder>(), Impostor::NO_ATLAS, 0.0f, batched};
+
+                if (hasImpostor)
+                {
+                    const glm::mat4& world = transformBuffer->GetMatrix(slots[i].index);
+                    const glm::vec3 center{world * glm::vec4{impostorAtlases[impostor->atlas].center, 1.0f}};
+                    const float beyond = glm::length(center - cameraPosition) - impostor->distance;
+
+                    candidate.impostorAtlas = impostor->atlas;
+                    candidate.impostorFade = impostor->fadeRange > 0.0f
+                        ? std::clamp(beyond / impostor->fadeRange, 0.0f, 1.0f)
+                        : (beyond >= 0.0f ? 1.0f : 0.0f);
+                }
+
+                candidates.push_back(candidate);
+            }
+
+            const size_t viewCount = viewFrusta.size();
+            const uint32_t allViews = viewCount >= 32 ? UINT32_MAX : (1u << viewCount) - 1u;
+            const bool occlusion = mainViewPerspective && occlusionCullingEnabled;
+            const glm::mat4 mainViewProjection = snapshot.views[0].viewProjection;
+
+            // bit v is set when the candidate is visible in view v
+            std::vector<uint32_t> visibleViews(candidates.size(), 0);
+            std::atomic<uint32_t> occluded{0};
+
+            /// @brief Meshlets of a clustered candidate left after CPU culling in one view.
+            struct ClusterDraw {
+                uint32_t view;
+                MeshletCuller::IndexRange range;
+            };
+            std::vector<std::vector<ClusterDraw>> clusterDraws(candidates.size());
+            std::atomic<uint32_t> culledClusters{0};
+
+            const bool gpuClusters = gpuClusterCullingEnabled && capabilities.multiDrawIndirect;
+            const auto culledOnGPU = [&](const SimpleMesh& mesh)
+            {
+                return gpuClusters && mesh._meshletBuffer.IsInitialized();
+            };
+
+            threadPool.ParallelFor
+            (
+                candidates.size(),
+                [&](size_t index)
                 {
-                    BindPipeline(material);
+                    const CullCandidate& candidate = candidates[index];
+                    const AABB& bounds = meshes[candidate.row]._bounds;
+                    const glm::mat4& world = transformBuffer->GetMatrix(slots[candidate.row].index);
+
+                    uint32_t mask = allViews;
+                    if (bounds.IsValid())
+                    {
+                        const AABB worldBounds = bounds.Transformed(world);
+
+                        mask = 0;
+                        for (size_t view = 0; view < viewCount; ++view)
+                        {
+                            if (viewFrusta[view].Intersects(worldBounds))
+                            {
+                                mask |= 1u << view;
+                            }
+                        }
+                    }
+
+                    // the occlusion buffer was rasterized from the main camera only
+                    if ((mask & 1u) != 0 && occlusion && !candidate.occluder && !occlusionBuffer.IsVisible(mainViewProjection * world, bounds))
+                    {
+                        mask &= ~1u;
+                        occluded.fetch_add(1, std::memory_order_relaxed);
+                    }
+
+                    const SimpleMesh& mesh = meshes[candidate.row];
+                    if (!mesh._meshlets.empty() && !culledOnGPU(mesh))
+                    {
+                        std::vector<MeshletCuller::IndexRange> ranges;
+                        for (uint32_t view = 0; view < viewCount; ++view)
+                        {
+                            // a main view showing only the impostor does not draw the mesh
+                            const bool drawsMesh = view != 0 || candidate.impostorFade < 1.0f;
+                            if ((mask & (1u << view)) == 0 || !drawsMesh)
+                            {
+                                continue;
+                            }
+
+                            const ViewPacket& viewPacket = snapshot.views[view];
+                            const MeshletCullPushConstants constants = MeshletCuller::MakeCullConstants(world, viewFrusta[view], viewPacket.position, viewPacket.perspective, mesh._coneCulling);
+
+                            ranges.clear();
+                            culledClusters.fetch_add(MeshletCuller::Cull(mesh._meshlets, constants, ranges), std::memory_order_relaxed);
+                            if (ranges.empty())
+                            {
+                                mask &= ~(1u << view);
+                            }
+                            for (const MeshletCuller::IndexRange& range : ranges)
+                            {
+                                clusterDraws[index].push_back({view, range});
+                            }
+                        }
+                    }
+
+                    visibleViews[index] = mask;
                 }
+            );
 
-                if (usingPerspective)
+            occludedCount += occluded.load();
+            culledClusterCount += culledClusters.load();
+
+            // a clustered mesh is drawn as its visible ranges on the CPU path, or as one indirect
+            // call over all its meshlets on the GPU path, culled in the compute pass before the scene
+            const auto emit = [&](const size_t index, DrawPacket packet, const uint32_t view)
+            {
+                const CullCandidate& candidate = candidates[index];
+                const SimpleMesh& mesh = meshes[candidate.row];
+                packet.viewIndex = view;
+
+                if (mesh._meshlets.empty())
+                {
+                    snapshot.drawPackets.push_back(packet);
+                }
+                else if (culledOnGPU(mesh))
                 {
-                    const glm::mat4 renderMatrix = transform.GetRenderMatrix(cameraTransform, perspectiveCamera);
-                    Draw(deltaTime, renderMatrix, mesh, material);
+                    const ViewPacket& viewPacket = snapshot.views[view];
+                    const glm::mat4& world = transformBuffer->GetMatrix(slots[candidate.row].index);
+
+                    MeshletCuller::Dispatch dispatch;
+                    dispatch.meshlets = mesh._meshletBuffer._buffer;
+                    dispatch.constants = MeshletCuller::MakeCullConstants(world, viewFrusta[view], viewPacket.position, viewPacket.perspective, mesh._coneCulling);
+                    dispatch.constants.meshletCount = static_cast<uint32_t>(mesh._meshlets.size());
+                    dispatch.constants.firstCommand = snapshot.meshletCommandCount;
+                    snapshot.meshletDispatches.push_back(dispatch);
+
+                    packet.meshletCount = dispatch.constants.meshletCount;
+                    packet.firstCommand = dispatch.constants.firstCommand;
+                    snapshot.meshletCommandCount += dispatch.constants.meshletCount;
+                    snapshot.drawPackets.push_back(packet);
                 }
                 else
                 {
-                    const auto orthoCamera = cameraEntity.get<OrthoCamera>();
-                    // Draw(deltaTime, cameraEntity, orthoCamera, cameraTransform, entity, transform, mesh, material);
+                    for (const ClusterDraw& draw : clusterDraws[index])
+                    {
+                        if (draw.view == view)
+                        {
+                            packet.firstIndex = draw.range.firstIndex;
+                            packet.indexCount = draw.range.indexCount;
+                            snapshot.drawPackets.push_back(packet);
+                        }
+                    }
+                }
+            };
+
+            std::vector<DynamicBatcher::Source> batchSources;
+
+            for (size_t index = 0; index < candidates.size(); ++index)
+            {
+                uint32_t mask = visibleViews[index];
+                if (mask == 0)
+                {
+                    continue;
+                }
+
+                const CullCandidate& candidate = candidates[index];
+
+                if (candidate.batched)
+                {
+                    // the batch holds full precision world space vertices, so it draws with the material's own pipeline
+                    DrawPacket batchPacket;
+                    batchPacket.transformIndex = batchTransformIndex;
+                    batchPacket.pipeline = *materials[candidate.row].pipeline;
+                    batchPacket.pipelineLayout = *materials[candidate.row].pipelineLayout;
+                    batchPacket.materialIndex = materials[candidate.row].materialIndex;
+                    batchPacket.material = MaterialParams{materials[candidate.row].color, materials[candidate.row].textureIndex};
+
+                    DynamicBatcher::Source source;
+                    source.mesh = &meshes[candidate.row];
+                    source.world = transformBuffer->GetMatrix(slots[candidate.row].index);
+                    source.batch = dynamicBatcher.Find(batchPacket);
+                    source.viewMask = mask;
+                    batchSources.push_back(source);
+                    continue;
+                }
+
+                DrawPacket packet = ExtractDrawPacket(slots[candidate.row].index, meshes[candidate.row], materials[candidate.row], candidate.pipeline);
+
+                // only the main view swaps to the impostor, the other views keep the mesh
+                if ((mask & 1u) != 0 && candidate.impostorFade > 0.0f)
+                {
+                    // tinted like the mesh, so the colors match across the fade, pipelines from outside the variant cache keep the material color
+                    const auto features = simpleMeshPipelineFeatures.find(candidate.pipeline);
+                    const bool tinted = features == simpleMeshPipelineFeatures.end() || (features->second & SimpleMeshFeatures::MATERIAL_COLOR) != 0;
+                    const glm::vec4 tint = tinted ? static_cast<glm::vec4>(materials[candidate.row].color) : glm::vec4{1.0f};
+
+                    const glm::mat4& world = transformBuffer->GetMatrix(slots[candidate.row].index);
+                    AddImpostor(candidate.impostorAtlas, world, cameraPosition, tint, candidate.impostorFade);
+                    mask &= ~1u;
+
+                    if (candidate.impostorFade < 1.0f)
+                    {
+                        // dithered with the complement of the impostor's pattern, materials without a twin keep drawing whole
+                        DrawPacket faded = packet;
+                        const auto variant = fadePipelineVariants.find(candidate.pipeline);
+                        if (variant != fadePipelineVariants.end())
+                        {
+                            faded.pipeline = variant->second;
+                        }
+                        faded.fade = candidate.impostorFade;
+                        emit(index, faded, 0);
+                    }
+                }
+
+                for (uint32_t view = 0; mask != 0; ++view, mask >>= 1)
+                {
+                    if ((mask & 1u) != 0)
+                    {
+                        emit(index, packet, view);
+                    }
                 }
             }
+
+            // every table appends to the same batches, they are drawn once all are in, see PostDrawStep
+            dynamicBatcher.Append(threadPool, batchSources);
+        }
+    );
+
+    // Off screen entities keep playing, only their sampling is skipped
+    ecs.system<Animator, const SkinnedMesh>()
+        .kind(stages->Update)
+        .each([](flecs::iter& it, size_t i, Animator& animator, const SkinnedMesh& mesh)
+        {
+            const float duration = animator.clip < mesh._clips.size() ? mesh._clips[animator.clip].duration : 0.0f;
+            animator.Advance(it.delta_time(), duration);
         }
     );
 
@@ -199,6 +753,67 @@ RenderingECSModule::RenderingECSModule(flecs::world& ecs)
                 Uint32 toggle = SDL_GetWindowFlags(_window) & SDL_WINDOW_FULLSCREEN;
                 SDL_SetWindowFullscreen(_window, toggle ? 0 : SDL_WINDOW_FULLSCREEN_DESKTOP);
             }
+
+            if (input->IsPressed(SDLK_F9))
+            {
+                dynamicResolutionEnabled = !dynamicResolutionEnabled;
+                std::cout << "[INFO] [Rendering] Dynamic resolution " << (dynamicResolutionEnabled ? "enabled" : "disabled") << std::endl;
+                if (dynamicResolutionEnabled && timestampQueryPool == VK_NULL_HANDLE)
+                {
+                    std::cout << "[WARNING] [Rendering] GPU timestamps are unsupported, the render scale will stay at " << dynamicResolution.maxScale << std::endl;
+                }
+            }
+
+            if (input->IsPressed(SDLK_F7))
+            {
+                gpuClusterCullingEnabled = !gpuClusterCullingEnabled;
+                std::cout << "[INFO] [Rendering] GPU meshlet culling " << (gpuClusterCullingEnabled ? "enabled" : "disabled") << std::endl;
+                if (gpuClusterCullingEnabled && !capabilities.multiDrawIndirect)
+                {
+                    std::cout << "[WARNING] [Rendering] Multi-draw indirect is unsupported, meshlets will stay culled on the CPU" << std::endl;
+                }
+            }
+
+            if (input->IsPressed(SDLK_F12))
+            {
+                const auto now = std::chrono::system_clock::now().time_since_epoch();
+                const std::string fileName = "Screenshot_" + std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(now).count()) + ".png";
+                frameCapture.Capture(Path::Combine(Path::GAME_DIR, "captures", fileName));
+            }
+
+            if (input->IsPressed(SDLK_F10))
+            {
+                if (frameCapture.IsRecording())
+                {
+                    frameCapture.StopRecording();
+                    std::cout << "[INFO] [Rendering] Recording stopped, " << frameCapture.GetDroppedFrameCount() << " frames dropped" << std::endl;
+                }
+                else
+                {
+                    const auto now = std::chrono::system_clock::now().time_since_epoch();
+                    const std::string directoryName = "Recording_" + std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(now).count());
+                    frameCapture.StartRecording(Path::Combine(Path::GAME_DIR, "captures", directoryName));
+                    std::cout << "[INFO] [Rendering] Recording started" << std::endl;
+                }
+            }
+
+            if (input->IsPressed(SDLK_F8))
+            {
+                if (renderStatsLog.IsLogging())
+                {
+                    renderStatsLog.Stop();
+                    std::cout << "[INFO] [Rendering] Stats log stopped" << std::endl;
+                }
+                else
+                {
+                    const auto now = std::chrono::system_clock::now().time_since_epoch();
+                    const std::string fileName = "Stats_" + std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(now).count()) + ".csv";
+                    if (renderStatsLog.Start(Path::Combine(Path::GAME_DIR, "captures", fileName)))
+                    {
+                        std::cout << "[INFO] [Rendering] Stats log started" << std::endl;
+                    }
+                }
+            }
         }
     );
 
@@ -214,6 +829,7 @@ RenderingECSModule::RenderingECSModule(flecs::world& ecs)
                 {
                     PipelineStages* const pipelineStages = ecs.get_mut<PipelineStages>();
                     pipelineStages->FinalCleanup.add(flecs::Phase).depends_on(pipelineStages->Housekeeping);
+                    renderThread.WaitIdle();
                     vkWaitForFences(_device, 1, &_renderFence, true, 1000000000);
                 }
             }
@@ -237,17 +853,32 @@ RenderingECSModule::RenderingECSModule(flecs::world& ecs)
 
 RenderingECSModule::~RenderingECSModule()
 {
+    renderThread.Stop();
+
     // make sure the GPU has stopped doing its things
     vkWaitForFences(_device, 1, &_renderFence, true, 1000000000);
 
+    // before the deletion queue, which frees meshes that may still be the target of a copy
+    uploadQueue.Cleanup();
+    frameCapture.Cleanup();
+    renderTargets->Cleanup();
+
+    // retired by the last frames, or by a tick that was never rendered
+    DestroyBuffers(retiredBuffers);
+    DestroyBuffers(renderThread.GetWriteSnapshot().retiredBuffers);
+
     CleanupImGui();
 
     _mainDeletionQueue.Flush();
 
+    CleanupSceneTarget();
     CleanupFrameBuffers();
     CleanupSwapchain();
 
     vkDestroyRenderPass(_device, _renderPass, nullptr);
+    vkDestroyRenderPass(_device, sceneRenderPass, nullptr);
+    vkDestroyRenderPass(_device, compositeRenderPass, nullptr);
+    vkDestroyRenderPass(_device, offscreenRenderPass, nullptr);
     vkDestroyCommandPool(_device, _commandPool, nullptr);
 
     vmaDestroyAllocator(_allocator);
@@ -310,8 +941,11 @@ void RenderingECSModule::OnWindowResize()
         std::this_thread::sleep_for(std::chrono::milliseconds(100));
     }
 
+    // the render thread reads the swapchain and windowExtent
+    renderThread.WaitIdle();
     vkDeviceWaitIdle(_device);
 
+    CleanupSceneTarget();
     CleanupFrameBuffers();
     CleanupSwapchain();
 
@@ -322,6 +956,7 @@ void RenderingECSModule::OnWindowResize()
 
     InitSwapchain();
     InitFrameBuffers();
+    InitSceneTarget();
 }
 
 flecs::entity RenderingECSModule::CreatePerspectiveCamera
@@ -385,15 +1020,370 @@ const Rect RenderingECSModule::GetWindowExtent() const
     return Rect{Vec2::ZERO, Vec2{float(windowExtent.width), float(windowExtent.height)}};
 }
 
-// Protected Fields
+uint32_t RenderingECSModule::LoadTexture(const std::string& filePath)
+{
+    const std::string bakedExtension = TextureData::BAKED_EXTENSION;
+    const bool isBaked = filePath.size() >= bakedExtension.size() &&
+        filePath.compare(filePath.size() - bakedExtension.size(), bakedExtension.size(), bakedExtension) == 0;
 
-// Protected Methods
+    if (isBaked)
+    {
+        return UploadTexture(TextureData::LoadBaked(filePath));
+    }
 
-// Private Fields
+    const Sprite sprite = Sprite::Load(filePath);
+    if (!sprite.isValid())
+    {
+        throw std::runtime_error("Failed to load texture: " + filePath);
+    }
 
-// Private Methods
+    return UploadTexture(TextureData::FromSprite(sprite));
+}
 
-void RenderingECSModule::InitWindow()
+uint32_t RenderingECSModule::UploadTexture(const TextureData& texture)
+{
+    if (texture.mips.empty() || texture.width == 0 || texture.height == 0)
+    {
+        throw std::runtime_error("Cannot upload a texture without pixels.");
+    }
+
+    const bool isCompressed = BlockCompression::IsBlockCompressed(texture.format);
+    if (isCompressed && !capabilities.textureCompressionBC)
+    {
+        throw std::runtime_error("Device does not support BC textures, bake this texture as RGBA8 instead.");
+    }
+
+    // A lone base level gets a full chain, blitted on the GPU when the format allows linear blits
+    const TextureData* source = &texture;
+    TextureData cpuMips;
+    bool blitMips = false;
+    uint32_t mipLevels = static_cast<uint32_t>(texture.mips.size());
+    if (mipLevels == 1 && !isCompressed)
+    {
+        VkFormatProperties formatProperties;
+        vkGetPhysicalDeviceFormatProperties(_chosenGPU, texture.format, &formatProperties);
+
+        const VkFormatFeatureFlags blitFeatures =
+            VK_FORMAT_FEATURE_BLIT_SRC_BIT |
+            VK_FORMAT_FEATURE_BLIT_DST_BIT |
+            VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+        blitMips = (formatProperties.optimalTilingFeatures & blitFeatures) == blitFeatures;
+
+        if (blitMips)
+        {
+            mipLevels = TextureData::GetFullMipCount(texture.width, texture.height);
+        }
+        else if (texture.format == VK_FORMAT_R8G8B8A8_UNORM)
+        {
+            cpuMips = texture;
+            cpuMips.GenerateMips();
+            source = &cpuMips;
+            mipLevels = static_cast<uint32_t>(cpuMips.mips.size());
+        }
+    }
+
+    const VkDeviceSize imageSize = static_cast<VkDeviceSize>(source->GetTotalSize());
+    const VkExtent3D imageExtent = {texture.width, texture.height, 1};
+
+    VkBufferCreateInfo stagingBufferInfo = {};
+    stagingBufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    stagingBufferInfo.pNext = nullptr;
+    stagingBufferInfo.size = imageSize;
+    stagingBufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+
+    VmaAllocationCreateInfo stagingAllocInfo = {};
+    stagingAllocInfo.usage = VMA_MEMORY_USAGE_CPU_ONLY;
+
+    AllocatedBuffer stagingBuffer;
+    VK_CHECK(vmaCreateBuffer(_allocator, &stagingBufferInfo, &stagingAllocInfo,
+        &stagingBuffer._buffer,
+        &stagingBuffer._allocation,
+        nullptr));
+
+    // Levels are packed back to back, each one gets its own copy region
+    std::vector<VkBufferImageCopy> copyRegions;
+    copyRegions.reserve(source->mips.size());
+
+    void* data;
+    vmaMapMemory(_allocator, stagingBuffer._allocation, &data);
+    VkDeviceSize offset = 0;
+    for (uint32_t level = 0; level < source->mips.size(); ++level)
+    {
+        const std::vector<uint8_t>& mip = source->mips[level];
+        memcpy(static_cast<uint8_t*>(data) + offset, mip.data(), mip.size());
+
+        VkBufferImageCopy copyRegion = {};
+        copyRegion.bufferOffset = offset;
+        copyRegion.bufferRowLength = 0;
+        copyRegion.bufferImageHeight = 0;
+        copyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        copyRegion.imageSubresource.mipLevel = level;
+        copyRegion.imageSubresource.baseArrayLayer = 0;
+        copyRegion.imageSubresource.layerCount = 1;
+        copyRegion.imageExtent = {source->GetMipWidth(level), source->GetMipHeight(level), 1};
+        copyRegions.push_back(copyRegion);
+
+        offset += mip.size();
+    }
+    vmaUnmapMemory(_allocator, stagingBuffer._allocation);
+
+    VkImageUsageFlags usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    if (blitMips)
+    {
+        usage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+    }
+
+    VkImageCreateInfo imageInfo = vkinit::image_create_info(texture.format, usage, imageExtent);
+    imageInfo.mipLevels = mipLevels;
+
+    VmaAllocationCreateInfo imageAllocInfo = {};
+    imageAllocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+
+    AllocatedImage image;
+    VK_CHECK(vmaCreateImage(_allocator, &imageInfo, &imageAllocInfo, &image._image, &image._allocation, nullptr));
+
+    ImmediateSubmit
+    (
+        [&](VkCommandBuffer cmd)
+        {
+            VkImageMemoryBarrier toTransfer = {};
+            toTransfer.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            toTransfer.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            toTransfer.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            toTransfer.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            toTransfer.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            toTransfer.image = image._image;
+            toTransfer.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            toTransfer.subresourceRange.baseMipLevel = 0;
+            toTransfer.subresourceRange.levelCount = mipLevels;
+            toTransfer.subresourceRange.baseArrayLayer = 0;
+            toTransfer.subresourceRange.layerCount = 1;
+            toTransfer.srcAccessMask = 0;
+            toTransfer.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+            vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &toTransfer);
+
+            vkCmdCopyBufferToImage(cmd, stagingBuffer._buffer, image._image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                static_cast<uint32_t>(copyRegions.size()), copyRegions.data());
+
+            VkImageMemoryBarrier toReadable = toTransfer;
+            toReadable.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            toReadable.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            toReadable.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            toReadable.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+            if (blitMips)
+            {
+                // Each level is read once it has been written, then handed to the shaders
+                int32_t mipWidth = static_cast<int32_t>(texture.width);
+                int32_t mipHeight = static_cast<int32_t>(texture.height);
+                for (uint32_t level = 1; level < mipLevels; ++level)
+                {
+                    VkImageMemoryBarrier toSource = toTransfer;
+                    toSource.subresourceRange.baseMipLevel = level - 1;
+                    toSource.subresourceRange.levelCount = 1;
+                    toSource.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+                    toSource.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+                    toSource.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+                    toSource.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+
+                    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &toSource);
+
+                    const int32_t nextWidth = mipWidth > 1 ? mipWidth / 2 : 1;
+                    const int32_t nextHeight = mipHeight > 1 ? mipHeight / 2 : 1;
+
+                    VkImageBlit blit = {};
+                    blit.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+                    blit.srcSubresource.mipLevel = level - 1;
+                    blit.srcSubresource.baseArrayLayer = 0;
+                    blit.srcSubresource.layerCount = 1;
+                    blit.srcOffsets[1] = {mipWidth, mipHeight, 1};
+                    blit.dstSubresource = blit.srcSubresource;
+                    blit.dstSubresource.mipLevel = level;
+                    blit.dstOffsets[1] = {nextWidth, nextHeight, 1};
+
+                    vkCmdBlitImage(cmd,
+                        image._image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                        image._image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                        1, &blit, VK_FILTER_LINEAR);
+
+                    VkImageMemoryBarrier sourceToReadable = toSource;
+                    sourceToReadable.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+                    sourceToReadable.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+                    sourceToReadable.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+                    sourceToReadable.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+                    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &sourceToReadable);
+
+                    mipWidth = nextWidth;
+                    mipHeight = nextHeight;
+                }
+
+                // The last level was only ever written
+                toReadable.subresourceRange.baseMipLevel = mipLevels - 1;
+                toReadable.subresourceRange.levelCount = 1;
+            }
+
+            vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &toReadable);
+        }
+    );
+
+    vmaDestroyBuffer(_allocator, stagingBuffer._buffer, stagingBuffer._allocation);
+
+    VkImageViewCreateInfo viewInfo = vkinit::imageview_create_info(texture.format, image._image, VK_IMAGE_ASPECT_COLOR_BIT);
+    viewInfo.subresourceRange.levelCount = mipLevels;
+
+    VkImageView imageView;
+    VK_CHECK(vkCreateImageView(_device, &viewInfo, nullptr, &imageView));
+
+    // Without update-after-bind the slot may not be written while a frame still uses the set
+    if (!capabilities.descriptorIndexing)
+    {
+        renderThread.WaitIdle();
+        vkWaitForFences(_device, 1, &_renderFence, true, 1000000000);
+    }
+    const uint32_t textureIndex = bindlessTable->RegisterTexture(imageView);
+
+    _mainDeletionQueue.PushDeletor
+    (
+        [=]()
+        {
+            vkDestroyImageView(_device, imageView, nullptr);
+            vmaDestroyImage(_allocator, image._image, image._allocation);
+        }
+    );
+
+    std::cout << "[INFO] [Rendering] Uploaded " << texture.width << "x" << texture.height << " texture to slot " << textureIndex
+        << " with " << mipLevels << " mip levels" << (blitMips ? " blitted on the GPU" : "")
+        << (isCompressed ? ", block compressed" : "") << std::endl;
+
+    return textureIndex;
+}
+
+const Material* const RenderingECSModule::CreateSimpleMeshMaterial
+(
+    const std::string& path,
+    const uint32_t features,
+    const Color32 color /*= Color32::MAGENTA*/,
+    const uint32_t textureIndex /*= BindlessTable::DEFAULT_TEXTURE_INDEX*/
+)
+{
+    return Material::Create(ecs(), path, GetSimpleMeshVariant(features), &simpleMeshPipelineLayout, color, textureIndex);
+}
+
+uint32_t RenderingECSModule::LoadFont(const std::string& filePath)
+{
+    std::unique_ptr<GlyphAtlas> atlas = GlyphAtlas::Load(filePath);
+
+    const VkExtent3D imageExtent = {atlas->GetSize(), atlas->GetSize(), 1};
+    VkImageCreateInfo imageInfo = vkinit::image_create_info(VK_FORMAT_R8_UNORM, VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT, imageExtent);
+
+    VmaAllocationCreateInfo imageAllocInfo = {};
+    imageAllocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+
+    AllocatedImage image;
+    VK_CHECK(vmaCreateImage(_allocator, &imageInfo, &imageAllocInfo, &image._image, &image._allocation, nullptr));
+
+    // An empty atlas is zero everywhere, as far from every outline as it stores.
+    // From here on it only leaves the shader read layout for the row copies of the render thread
+    ImmediateSubmit
+    (
+        [&](VkCommandBuffer cmd)
+        {
+            VkImageSubresourceRange range = {};
+            range.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            range.baseMipLevel = 0;
+            range.levelCount = 1;
+            range.baseArrayLayer = 0;
+            range.layerCount = 1;
+
+            VkImageMemoryBarrier toTransfer = {};
+            toTransfer.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            toTransfer.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            toTransfer.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            toTransfer.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            toTransfer.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            toTransfer.image = image._image;
+            toTransfer.subresourceRange = range;
+            toTransfer.srcAccessMask = 0;
+            toTransfer.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+            vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &toTransfer);
+
+            VkClearColorValue clearColor = {};
+            vkCmdClearColorImage(cmd, image._image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, &clearColor, 1, &range);
+
+            VkImageMemoryBarrier toReadable = toTransfer;
+            toReadable.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            toReadable.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            toReadable.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            toReadable.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+            vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &toReadable);
+        }
+    );
+
+    VkImageViewCreateInfo viewInfo = vkinit::imageview_create_info(VK_FORMAT_R8_UNORM, image._image, VK_IMAGE_ASPECT_COLOR_BIT);
+
+    VkImageView imageView;
+    VK_CHECK(vkCreateImageView(_device, &viewInfo, nullptr, &imageView));
+
+    // Without update-after-bind the slot may not be written while a frame still uses the set
+    if (!capabilities.descriptorIndexing)
+    {
+        renderThread.WaitIdle();
+        vkWaitForFences(_device, 1, &_renderFence, true, 1000000000);
+    }
+    const uint32_t textureIndex = bindlessTable->RegisterTexture(imageView);
+
+    const uint32_t atlasSize = atlas->GetSize();
+    const uint32_t font = textRenderer.AddFont(std::move(atlas), image, imageView, textureIndex);
+
+    std::cout << "[INFO] [Rendering] Loaded font " << font << " from " << filePath << " with a "
+        << atlasSize << "x" << atlasSize << " glyph atlas in slot " << textureIndex << std::endl;
+
+    return font;
+}
+
+uint32_t RenderingECSModule::BakeImpostor
+(
+    const SimpleMesh& mesh,
+    const uint32_t frameCount /*= ImpostorBaker::DEFAULT_FRAME_COUNT*/,
+    const uint32_t frameSize /*= ImpostorBaker::DEFAULT_FRAME_SIZE*/
+)
+{
+    return RegisterImpostor(ImpostorBaker::Bake(mesh._vertices, mesh._indices, frameCount, frameSize));
+}
+
+uint32_t RenderingECSModule::RegisterImpostor(const ImpostorBaker::Result& baked)
+{
+    ImpostorAtlas atlas = baked.atlas;
+    atlas.colorTexture = UploadTexture(baked.color);
+    atlas.normalDepthTexture = UploadTexture(baked.normalDepth);
+
+    const uint32_t index = static_cast<uint32_t>(impostorAtlases.size());
+    impostorAtlases.push_back(atlas);
+
+    std::cout << "[INFO] [Rendering] Registered impostor " << index << " with " << atlas.frameCount << " frames in a "
+        << baked.color.width << "x" << baked.color.height << " atlas." << std::endl;
+
+    return index;
+}
+
+void RenderingECSModule::SetDynamicBatchThreshold(const uint32_t vertexThreshold)
+{
+    dynamicBatcher.SetVertexThreshold(vertexThreshold);
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+void RenderingECSModule::InitWindow()
 {
     // We initialize SDL and create a window with it. 
     SDL_Init(SDL_INIT_VIDEO);
@@ -502,8 +1492,121 @@ void RenderingECSModule::InitVulkan()
     }
     vkb::PhysicalDevice physicalDevice = phys_ret.value();
 
+    // BC formats are optional in core Vulkan, without them textures have to be baked as RGBA8
+    VkPhysicalDeviceFeatures supportedCoreFeatures = {};
+    vkGetPhysicalDeviceFeatures(physicalDevice.physical_device, &supportedCoreFeatures);
+    if (supportedCoreFeatures.textureCompressionBC)
+    {
+        physicalDevice.features.textureCompressionBC = VK_TRUE;
+        capabilities.textureCompressionBC = true;
+    }
+
+    // Invocation counts are only profiling data, the overlay and the stats log leave them out without it
+    if (supportedCoreFeatures.pipelineStatisticsQuery)
+    {
+        physicalDevice.features.pipelineStatisticsQuery = VK_TRUE;
+        capabilities.pipelineStatisticsQuery = true;
+    }
+
+    // Without multi-draw indirect clustered meshes are only culled on the CPU
+    if (supportedCoreFeatures.multiDrawIndirect)
+    {
+        physicalDevice.features.multiDrawIndirect = VK_TRUE;
+        capabilities.multiDrawIndirect = true;
+    }
+
+    // Descriptor indexing lets the bindless texture array stay partially bound and be updated while in use.
+    // Without it BindlessTable keeps every slot written, so the renderer still works on plain Vulkan 1.1.
+    VkPhysicalDeviceDescriptorIndexingFeaturesEXT indexingFeatures = {};
+    indexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+    if (physicalDevice.enable_extension_if_present(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME))
+    {
+        VkPhysicalDeviceFeatures2 supportedFeatures = {};
+        supportedFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        supportedFeatures.pNext = &indexingFeatures;
+        vkGetPhysicalDeviceFeatures2(physicalDevice.physical_device, &supportedFeatures);
+
+        capabilities.descriptorIndexing =
+            indexingFeatures.shaderSampledImageArrayNonUniformIndexing &&
+            indexingFeatures.descriptorBindingPartiallyBound &&
+            indexingFeatures.descriptorBindingSampledImageUpdateAfterBind &&
+            indexingFeatures.runtimeDescriptorArray;
+
+        // Only enable the bits the bindless table uses
+        indexingFeatures = {};
+        indexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+        indexingFeatures.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+        indexingFeatures.descriptorBindingPartiallyBound = VK_TRUE;
+        indexingFeatures.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+        indexingFeatures.runtimeDescriptorArray = VK_TRUE;
+    }
+
+    // Timeline semaphores let the transfer queue report progress with one counter instead of a fence per upload.
+    VkPhysicalDeviceTimelineSemaphoreFeaturesKHR timelineFeatures = {};
+    timelineFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR;
+    if (physicalDevice.enable_extension_if_present(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME))
+    {
+        VkPhysicalDeviceFeatures2 supportedFeatures = {};
+        supportedFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        supportedFeatures.pNext = &timelineFeatures;
+        vkGetPhysicalDeviceFeatures2(physicalDevice.physical_device, &supportedFeatures);
+
+        capabilities.timelineSemaphore = timelineFeatures.timelineSemaphore;
+
+        timelineFeatures = {};
+        timelineFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR;
+        timelineFeatures.timelineSemaphore = VK_TRUE;
+    }
+
+    // Dynamic rendering and synchronization2 record frames without render pass or framebuffer objects.
+    // They are only used together, without either one the Vulkan 1.1 render pass path is kept.
+    // The ImGui backend has to be built with dynamic rendering support too.
+    VkPhysicalDeviceDynamicRenderingFeaturesKHR dynamicRenderingFeatures = {};
+    dynamicRenderingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR;
+    VkPhysicalDeviceSynchronization2FeaturesKHR synchronization2Features = {};
+    synchronization2Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES_KHR;
+    #if defined(IMGUI_IMPL_VULKAN_HAS_DYNAMIC_RENDERING) && !defined(VELECS_NO_DYNAMIC_RENDERING)
+    if (physicalDevice.enable_extensions_if_present({
+            VK_KHR_CREATE_RENDERPASS_2_EXTENSION_NAME,
+            VK_KHR_DEPTH_STENCIL_RESOLVE_EXTENSION_NAME,
+            VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME,
+            VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME
+        }))
+    {
+        dynamicRenderingFeatures.pNext = &synchronization2Features;
+
+        VkPhysicalDeviceFeatures2 supportedFeatures = {};
+        supportedFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        supportedFeatures.pNext = &dynamicRenderingFeatures;
+        vkGetPhysicalDeviceFeatures2(physicalDevice.physical_device, &supportedFeatures);
+
+        capabilities.dynamicRendering = dynamicRenderingFeatures.dynamicRendering && synchronization2Features.synchronization2;
+
+        // vk-bootstrap links the chain itself
+        dynamicRenderingFeatures = {};
+        dynamicRenderingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR;
+        dynamicRenderingFeatures.dynamicRendering = VK_TRUE;
+        synchronization2Features = {};
+        synchronization2Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES_KHR;
+        synchronization2Features.synchronization2 = VK_TRUE;
+    }
+    #endif
+
     //create the final Vulkan device
     vkb::DeviceBuilder deviceBuilder{ physicalDevice };
+    if (capabilities.descriptorIndexing)
+    {
+        deviceBuilder.add_pNext(&indexingFeatures);
+    }
+    if (capabilities.timelineSemaphore)
+    {
+        deviceBuilder.add_pNext(&timelineFeatures);
+    }
+    if (capabilities.dynamicRendering)
+    {
+        deviceBuilder.add_pNext(&dynamicRenderingFeatures);
+        deviceBuilder.add_pNext(&synchronization2Features);
+    }
     // automatically propagate needed data from instance & physical device
     auto dev_ret = deviceBuilder.build();
     if (!dev_ret)
@@ -518,10 +1621,49 @@ void RenderingECSModule::InitVulkan()
     _device = vkbDevice.device;
     _chosenGPU = physicalDevice.physical_device;
 
+    if (capabilities.dynamicRendering)
+    {
+        cmdBeginRendering = reinterpret_cast<PFN_vkCmdBeginRenderingKHR>(vkGetDeviceProcAddr(_device, "vkCmdBeginRenderingKHR"));
+        cmdEndRendering = reinterpret_cast<PFN_vkCmdEndRenderingKHR>(vkGetDeviceProcAddr(_device, "vkCmdEndRenderingKHR"));
+        cmdPipelineBarrier2 = reinterpret_cast<PFN_vkCmdPipelineBarrier2KHR>(vkGetDeviceProcAddr(_device, "vkCmdPipelineBarrier2KHR"));
+        queueSubmit2 = reinterpret_cast<PFN_vkQueueSubmit2KHR>(vkGetDeviceProcAddr(_device, "vkQueueSubmit2KHR"));
+
+        capabilities.dynamicRendering = cmdBeginRendering != nullptr && cmdEndRendering != nullptr &&
+            cmdPipelineBarrier2 != nullptr && queueSubmit2 != nullptr;
+    }
+    std::cout << "[INFO] [Rendering] Frames are recorded with "
+        << (capabilities.dynamicRendering ? "dynamic rendering and synchronization2" : "render passes") << std::endl;
+
     // use vkbootstrap to get a Graphics queue
     _graphicsQueue = vkbDevice.get_queue(vkb::QueueType::graphics).value();
     _graphicsQueueFamily = vkbDevice.get_queue_index(vkb::QueueType::graphics).value();
 
+    // uploads go to a transfer-only family when there is one, so they run beside rendering instead of between frames
+    auto transferQueueRet = vkbDevice.get_dedicated_queue(vkb::QueueType::transfer);
+    if (transferQueueRet)
+    {
+        transferQueue = transferQueueRet.value();
+        transferQueueFamily = vkbDevice.get_dedicated_queue_index(vkb::QueueType::transfer).value();
+        capabilities.dedicatedTransferQueue = true;
+    }
+    else
+    {
+        transferQueue = _graphicsQueue;
+        transferQueueFamily = _graphicsQueueFamily;
+    }
+
+    // GPU frame timing drives dynamic resolution, it stays off when the graphics queue cannot write timestamps.
+    uint32_t queueFamilyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(_chosenGPU, &queueFamilyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(_chosenGPU, &queueFamilyCount, queueFamilies.data());
+    if (queueFamilies[_graphicsQueueFamily].timestampValidBits > 0)
+    {
+        VkPhysicalDeviceProperties properties = {};
+        vkGetPhysicalDeviceProperties(_chosenGPU, &properties);
+        capabilities.timestampPeriod = properties.limits.timestampPeriod;
+    }
+
     //initialize the memory allocator
     VmaAllocatorCreateInfo allocatorInfo = {};
     allocatorInfo.physicalDevice = _chosenGPU;
@@ -541,6 +1683,7 @@ void RenderingECSModule::InitSwapchain()
 
     vkb::Result<vkb::Swapchain> vkbSwapchainRet = swapchainBuilder
         .set_desired_format(surfaceFormat)
+        .add_image_usage_flags(VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT) // the upscaled scene is blitted in, captures are copied out
         // .use_default_format_selection()
         .build()
         ;
@@ -664,8 +1807,29 @@ void RenderingECSModule::InitCommands()
     VK_CHECK(vkAllocateCommandBuffers(_device, &cmdAllocInfo2, &_uploadContext._commandBuffer));
 }
 
+void RenderingECSModule::InitUploadQueue()
+{
+    uploadQueue.Init
+    (
+        _device,
+        transferQueue,
+        transferQueueFamily,
+        _graphicsQueueFamily,
+        capabilities.timelineSemaphore,
+        capabilities.dedicatedTransferQueue ? nullptr : &queueMutex
+    );
+
+    std::cout << "[INFO] [Rendering] Uploads use " << (capabilities.dedicatedTransferQueue ? "a dedicated transfer queue" : "the graphics queue")
+        << " tracked with " << (uploadQueue.GetTimelineSemaphore() != VK_NULL_HANDLE ? "a timeline semaphore" : "fences") << '.' << std::endl;
+}
+
 void RenderingECSModule::InitDefaultRenderPass()
 {
+    if (capabilities.dynamicRendering)
+    {
+        return;
+    }
+
     // ATTACHMENTS
 
     VkAttachmentDescription color_attachment = {};
@@ -743,10 +1907,81 @@ void RenderingECSModule::InitDefaultRenderPass()
     render_pass_info.pDependencies = &dependencies[0];
 
     VK_CHECK(vkCreateRenderPass(_device, &render_pass_info, nullptr, &_renderPass));
+
+    // Dynamic resolution splits the frame in two passes. Both keep the attachment formats of _renderPass,
+    // so they stay compatible with every pipeline and with ImGui, which were all built against it.
+
+    // SCENE PASS: clears the offscreen target, then hands it to the blit
+
+    attachments[0].format = _swapchainImageFormat;
+    attachments[0].finalLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+
+    VkSubpassDependency scene_blit_dependency = {};
+    scene_blit_dependency.srcSubpass = 0;
+    scene_blit_dependency.dstSubpass = VK_SUBPASS_EXTERNAL;
+    scene_blit_dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    scene_blit_dependency.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    scene_blit_dependency.dstStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT;
+    scene_blit_dependency.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+
+    VkSubpassDependency scene_dependencies[3] = { dependency, depth_dependency, scene_blit_dependency };
+
+    render_pass_info.pAttachments = &attachments[0];
+    render_pass_info.dependencyCount = 3;
+    render_pass_info.pDependencies = &scene_dependencies[0];
+
+    VK_CHECK(vkCreateRenderPass(_device, &render_pass_info, nullptr, &sceneRenderPass));
+
+    // COMPOSITE PASS: keeps the blitted swapchain contents and presents after ImGui
+
+    attachments[0].loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+    attachments[0].initialLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    attachments[0].finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+
+    VkSubpassDependency blit_composite_dependency = {};
+    blit_composite_dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
+    blit_composite_dependency.dstSubpass = 0;
+    blit_composite_dependency.srcStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT;
+    blit_composite_dependency.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    blit_composite_dependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    blit_composite_dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+
+    VkSubpassDependency composite_dependencies[2] = { blit_composite_dependency, depth_dependency };
+
+    render_pass_info.dependencyCount = 2;
+    render_pass_info.pDependencies = &composite_dependencies[0];
+
+    VK_CHECK(vkCreateRenderPass(_device, &render_pass_info, nullptr, &compositeRenderPass));
+
+    // OFFSCREEN PASS: clears a RenderView's texture, then hands it to the fragment shaders of the scene
+
+    attachments[0].loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+    attachments[0].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    attachments[0].finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+    VkSubpassDependency offscreen_sample_dependency = {};
+    offscreen_sample_dependency.srcSubpass = 0;
+    offscreen_sample_dependency.dstSubpass = VK_SUBPASS_EXTERNAL;
+    offscreen_sample_dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    offscreen_sample_dependency.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    offscreen_sample_dependency.dstStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+    offscreen_sample_dependency.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+    VkSubpassDependency offscreen_dependencies[3] = { dependency, depth_dependency, offscreen_sample_dependency };
+
+    render_pass_info.dependencyCount = 3;
+    render_pass_info.pDependencies = &offscreen_dependencies[0];
+
+    VK_CHECK(vkCreateRenderPass(_device, &render_pass_info, nullptr, &offscreenRenderPass));
 }
 
 void RenderingECSModule::InitFrameBuffers()
 {
+    if (capabilities.dynamicRendering)
+    {
+        return;
+    }
+
     //create the framebuffers for the swapchain images. This will connect the render-pass to the images for rendering
     VkFramebufferCreateInfo fb_info = {};
     fb_info.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
@@ -785,6 +2020,69 @@ void RenderingECSModule::CleanupFrameBuffers()
     _framebuffers.clear();
 }
 
+void RenderingECSModule::InitSceneTarget()
+{
+    VkExtent3D imageExtent = {
+        windowExtent.width,
+        windowExtent.height,
+        1
+    };
+
+    VkImageCreateInfo imageInfo = vkinit::image_create_info(_swapchainImageFormat, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT, imageExtent);
+
+    VmaAllocationCreateInfo imageAllocInfo = {};
+    imageAllocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+    imageAllocInfo.requiredFlags = VkMemoryPropertyFlags(VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+    VK_CHECK(vmaCreateImage(_allocator, &imageInfo, &imageAllocInfo, &sceneColorImage._image, &sceneColorImage._allocation, nullptr));
+
+    VkImageViewCreateInfo viewInfo = vkinit::imageview_create_info(_swapchainImageFormat, sceneColorImage._image, VK_IMAGE_ASPECT_COLOR_BIT);
+    VK_CHECK(vkCreateImageView(_device, &viewInfo, nullptr, &sceneColorImageView));
+
+    if (capabilities.dynamicRendering)
+    {
+        return;
+    }
+
+    VkImageView attachments[2];
+    attachments[0] = sceneColorImageView;
+    attachments[1] = _depthImageView;
+
+    VkFramebufferCreateInfo fb_info = {};
+    fb_info.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+    fb_info.pNext = nullptr;
+    fb_info.renderPass = sceneRenderPass;
+    fb_info.attachmentCount = 2;
+    fb_info.pAttachments = attachments;
+    fb_info.width = windowExtent.width;
+    fb_info.height = windowExtent.height;
+    fb_info.layers = 1;
+
+    VK_CHECK(vkCreateFramebuffer(_device, &fb_info, nullptr, &sceneFramebuffer));
+}
+
+void RenderingECSModule::CleanupSceneTarget()
+{
+    if (sceneFramebuffer != VK_NULL_HANDLE)
+    {
+        vkDestroyFramebuffer(_device, sceneFramebuffer, nullptr);
+        sceneFramebuffer = VK_NULL_HANDLE;
+    }
+
+    if (sceneColorImageView != VK_NULL_HANDLE)
+    {
+        vkDestroyImageView(_device, sceneColorImageView, nullptr);
+        sceneColorImageView = VK_NULL_HANDLE;
+    }
+
+    if (sceneColorImage._image != VK_NULL_HANDLE || sceneColorImage._allocation != VK_NULL_HANDLE)
+    {
+        vmaDestroyImage(_allocator, sceneColorImage._image, sceneColorImage._allocation);
+        sceneColorImage._image = VK_NULL_HANDLE;
+        sceneColorImage._allocation = VK_NULL_HANDLE;
+    }
+}
+
 void RenderingECSModule::InitSyncStructures()
 {
     //we want to create the fence with the Create Signaled flag, so we can wait on it before using it on a GPU command (for the first frame)
@@ -802,10 +2100,43 @@ void RenderingECSModule::InitSyncStructures()
     VK_CHECK(vkCreateSemaphore(_device, &semaphoreCreateInfo, nullptr, &_presentSemaphore));
     VK_CHECK(vkCreateSemaphore(_device, &semaphoreCreateInfo, nullptr, &_renderSemaphore));
 
+    if (capabilities.timestampPeriod > 0.0f)
+    {
+        VkQueryPoolCreateInfo queryPoolInfo = {};
+        queryPoolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        queryPoolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+        queryPoolInfo.queryCount = 2;
+
+        VK_CHECK(vkCreateQueryPool(_device, &queryPoolInfo, nullptr, &timestampQueryPool));
+    }
+
+    if (capabilities.pipelineStatisticsQuery)
+    {
+        VkQueryPoolCreateInfo queryPoolInfo = {};
+        queryPoolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        queryPoolInfo.queryType = VK_QUERY_TYPE_PIPELINE_STATISTICS;
+        queryPoolInfo.queryCount = 2; // the main view, then the offscreen views
+        queryPoolInfo.pipelineStatistics =
+            VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT |
+            VK_QUERY_PIPELINE_STATISTIC_CLIPPING_INVOCATIONS_BIT |
+            VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT;
+
+        VK_CHECK(vkCreateQueryPool(_device, &queryPoolInfo, nullptr, &pipelineStatisticsQueryPool));
+    }
+
     _mainDeletionQueue.PushDeletor
     (
         [=]()
         {
+            if (timestampQueryPool != VK_NULL_HANDLE)
+            {
+                vkDestroyQueryPool(_device, timestampQueryPool, nullptr);
+            }
+            if (pipelineStatisticsQueryPool != VK_NULL_HANDLE)
+            {
+                vkDestroyQueryPool(_device, pipelineStatisticsQueryPool, nullptr);
+            }
+
             vkDestroyFence(_device, _uploadContext._uploadFence, nullptr);
             vkDestroyFence(_device, _renderFence, nullptr);
 
@@ -815,27 +2146,287 @@ void RenderingECSModule::InitSyncStructures()
     );
 }
 
-void RenderingECSModule::InitPipelines()
+void RenderingECSModule::InitDescriptors()
 {
-    //build the stage-create-info for both vertex and fragment stages. This lets the pipeline know the shader modules per stage
-    PipelineBuilder pipelineBuilder;
+    descriptorLayoutCache.Init(_device);
+    descriptorAllocator.Init(_device);
+    frameDescriptorAllocator.Init(_device);
 
-    //vertex input controls how to read vertices from vertex buffers. We aren't using it yet
-    pipelineBuilder._vertexInputInfo = vkinit::vertex_input_state_create_info();
+    frameRing.Init(_device, _chosenGPU, _allocator, descriptorLayoutCache, descriptorAllocator);
 
-    //input assembly is the configuration for drawing triangle lists, strips, or individual points.
-    //we are just going to draw triangle list
-    pipelineBuilder._inputAssembly = vkinit::input_assembly_create_info(VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST);
+    _mainDeletionQueue.PushDeletor
+    (
+        [=]()
+        {
+            frameRing.Cleanup();
+            frameDescriptorAllocator.Cleanup();
+            descriptorAllocator.Cleanup();
+            descriptorLayoutCache.Cleanup();
+        }
+    );
+}
 
-    //build viewport and scissor from the swapchain extents
-    pipelineBuilder._viewport.x = 0.0f;
-    pipelineBuilder._viewport.y = 0.0f;
-    pipelineBuilder._viewport.width = (float)windowExtent.width;
-    pipelineBuilder._viewport.height = (float)windowExtent.height;
-    pipelineBuilder._viewport.minDepth = 0.0f;
-    pipelineBuilder._viewport.maxDepth = 1.0f;
+void RenderingECSModule::InitBindlessTable()
+{
+    bindlessTable = std::make_shared<BindlessTable>();
+    bindlessTable->Init(_device, _allocator, capabilities);
+
+    // 1x1 white texture, so untextured materials sample their color unchanged
+    const uint32_t whitePixel = 0xFFFFFFFF;
+    const VkDeviceSize imageSize = sizeof(whitePixel);
+    const VkExtent3D imageExtent = {1, 1, 1};
+
+    VkBufferCreateInfo stagingBufferInfo = {};
+    stagingBufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    stagingBufferInfo.pNext = nullptr;
+    stagingBufferInfo.size = imageSize;
+    stagingBufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+
+    VmaAllocationCreateInfo stagingAllocInfo = {};
+    stagingAllocInfo.usage = VMA_MEMORY_USAGE_CPU_ONLY;
+
+    AllocatedBuffer stagingBuffer;
+    VK_CHECK(vmaCreateBuffer(_allocator, &stagingBufferInfo, &stagingAllocInfo,
+        &stagingBuffer._buffer,
+        &stagingBuffer._allocation,
+        nullptr));
 
-    pipelineBuilder._scissor.offset = { 0, 0 };
+    void* data;
+    vmaMapMemory(_allocator, stagingBuffer._allocation, &data);
+    memcpy(data, &whitePixel, static_cast<size_t>(imageSize));
+    vmaUnmapMemory(_allocator, stagingBuffer._allocation);
+
+    VkImageCreateInfo imageInfo = vkinit::image_create_info(VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT, imageExtent);
+
+    VmaAllocationCreateInfo imageAllocInfo = {};
+    imageAllocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+
+    VK_CHECK(vmaCreateImage(_allocator, &imageInfo, &imageAllocInfo, &defaultTexture._image, &defaultTexture._allocation, nullptr));
+
+    ImmediateSubmit
+    (
+        [&](VkCommandBuffer cmd)
+        {
+            VkImageSubresourceRange range = {};
+            range.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            range.baseMipLevel = 0;
+            range.levelCount = 1;
+            range.baseArrayLayer = 0;
+            range.layerCount = 1;
+
+            VkImageMemoryBarrier toTransfer = {};
+            toTransfer.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            toTransfer.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            toTransfer.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            toTransfer.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            toTransfer.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            toTransfer.image = defaultTexture._image;
+            toTransfer.subresourceRange = range;
+            toTransfer.srcAccessMask = 0;
+            toTransfer.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+            vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &toTransfer);
+
+            VkBufferImageCopy copyRegion = {};
+            copyRegion.bufferOffset = 0;
+            copyRegion.bufferRowLength = 0;
+            copyRegion.bufferImageHeight = 0;
+            copyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            copyRegion.imageSubresource.mipLevel = 0;
+            copyRegion.imageSubresource.baseArrayLayer = 0;
+            copyRegion.imageSubresource.layerCount = 1;
+            copyRegion.imageExtent = imageExtent;
+
+            vkCmdCopyBufferToImage(cmd, stagingBuffer._buffer, defaultTexture._image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &copyRegion);
+
+            VkImageMemoryBarrier toReadable = toTransfer;
+            toReadable.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            toReadable.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            toReadable.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            toReadable.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+            vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &toReadable);
+        }
+    );
+
+    vmaDestroyBuffer(_allocator, stagingBuffer._buffer, stagingBuffer._allocation);
+
+    VkImageViewCreateInfo viewInfo = vkinit::imageview_create_info(VK_FORMAT_R8G8B8A8_UNORM, defaultTexture._image, VK_IMAGE_ASPECT_COLOR_BIT);
+    VK_CHECK(vkCreateImageView(_device, &viewInfo, nullptr, &defaultTextureView));
+
+    // First registration, so it lands in BindlessTable::DEFAULT_TEXTURE_INDEX
+    bindlessTable->RegisterTexture(defaultTextureView);
+    bindlessTable->SetFallbackTexture(defaultTextureView);
+
+    _mainDeletionQueue.PushDeletor
+    (
+        [=]()
+        {
+            bindlessTable->Cleanup();
+            vkDestroyImageView(_device, defaultTextureView, nullptr);
+            vmaDestroyImage(_allocator, defaultTexture._image, defaultTexture._allocation);
+        }
+    );
+}
+
+void RenderingECSModule::InitTransformBuffer()
+{
+    transformBuffer = std::make_shared<TransformBuffer>();
+    transformBuffer->Init(_device, _allocator);
+
+    _mainDeletionQueue.PushDeletor
+    (
+        [=]()
+        {
+            transformBuffer->Cleanup();
+        }
+    );
+}
+
+void RenderingECSModule::InitParticles()
+{
+    #ifdef VELECS_CPU_PARTICLES
+        const bool cpuParticles = true;
+    #else
+        const bool cpuParticles = false;
+    #endif
+    particleSystem.Init(_device, _allocator, descriptorLayoutCache, descriptorAllocator, frameRing.GetLayout(), cpuParticles);
+
+    std::cout << "[INFO] [Rendering] Particles are simulated on the " << (cpuParticles ? "CPU" : "GPU")
+        << ", up to " << particleSystem.GetCapacity() << " alive at once" << std::endl;
+
+    _mainDeletionQueue.PushDeletor
+    (
+        [=]()
+        {
+            particleSystem.Cleanup();
+        }
+    );
+}
+
+void RenderingECSModule::InitTilemaps()
+{
+    tilemapRenderer.Init(_allocator, uploadQueue);
+
+    _mainDeletionQueue.PushDeletor
+    (
+        [=]()
+        {
+            tilemapRenderer.Cleanup();
+        }
+    );
+}
+
+void RenderingECSModule::InitText()
+{
+    textRenderer.Init(_device, _allocator, descriptorLayoutCache);
+
+    _mainDeletionQueue.PushDeletor
+    (
+        [=]()
+        {
+            textRenderer.Cleanup();
+        }
+    );
+}
+
+void RenderingECSModule::InitSkinning()
+{
+    skinningSystem = std::make_shared<SkinningSystem>();
+    skinningSystem->Init(_device, _allocator, descriptorLayoutCache);
+
+    _mainDeletionQueue.PushDeletor
+    (
+        [=]()
+        {
+            skinningSystem->Cleanup();
+        }
+    );
+}
+
+void RenderingECSModule::InitMeshlets()
+{
+    meshletCuller.Init(_device, _allocator, descriptorLayoutCache);
+
+    _mainDeletionQueue.PushDeletor
+    (
+        [=]()
+        {
+            meshletCuller.Cleanup();
+        }
+    );
+}
+
+void RenderingECSModule::InitDynamicBatching()
+{
+    dynamicBatcher.Init(_allocator);
+
+    batchTransformIndex = transformBuffer->Allocate();
+    transformBuffer->Write(batchTransformIndex, glm::mat4{1.0f});
+
+    _mainDeletionQueue.PushDeletor
+    (
+        [=]()
+        {
+            dynamicBatcher.Cleanup();
+        }
+    );
+}
+
+void RenderingECSModule::InitDebugDraw()
+{
+    _mainDeletionQueue.PushDeletor
+    (
+        [=]()
+        {
+            if (debugLineBuffer.IsInitialized())
+            {
+                vmaDestroyBuffer(_allocator, debugLineBuffer._buffer, debugLineBuffer._allocation);
+                debugLineBuffer = AllocatedBuffer{};
+            }
+        }
+    );
+}
+
+void RenderingECSModule::InitRenderTargets()
+{
+    renderTargets = std::make_shared<RenderTargetPool>();
+    renderTargets->Init(_device, _allocator, bindlessTable.get(), _swapchainImageFormat, _depthFormat, offscreenRenderPass);
+}
+
+void RenderingECSModule::InitPipelines()
+{
+    //build the stage-create-info for both vertex and fragment stages. This lets the pipeline know the shader modules per stage
+    PipelineBuilder pipelineBuilder;
+
+    //without render passes the pipelines are built against the attachment formats directly.
+    //the scene target shares the swapchain format, so one description fits every frame
+    VkPipelineRenderingCreateInfoKHR renderingInfo = {};
+    renderingInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR;
+    renderingInfo.colorAttachmentCount = 1;
+    renderingInfo.pColorAttachmentFormats = &_swapchainImageFormat;
+    renderingInfo.depthAttachmentFormat = _depthFormat;
+    if (capabilities.dynamicRendering)
+    {
+        pipelineBuilder._renderingInfo = &renderingInfo;
+    }
+
+    //vertex input controls how to read vertices from vertex buffers. We aren't using it yet
+    pipelineBuilder._vertexInputInfo = vkinit::vertex_input_state_create_info();
+
+    //input assembly is the configuration for drawing triangle lists, strips, or individual points.
+    //we are just going to draw triangle list
+    pipelineBuilder._inputAssembly = vkinit::input_assembly_create_info(VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST);
+
+    //build viewport and scissor from the swapchain extents
+    pipelineBuilder._viewport.x = 0.0f;
+    pipelineBuilder._viewport.y = 0.0f;
+    pipelineBuilder._viewport.width = (float)windowExtent.width;
+    pipelineBuilder._viewport.height = (float)windowExtent.height;
+    pipelineBuilder._viewport.minDepth = 0.0f;
+    pipelineBuilder._viewport.maxDepth = 1.0f;
+
+    pipelineBuilder._scissor.offset = { 0, 0 };
     pipelineBuilder._scissor.extent = windowExtent;
 
     //configure the rasterizer to draw filled triangles
@@ -875,6 +2466,12 @@ void RenderingECSModule::InitPipelines()
     mesh_pipeline_layout_info.pPushConstantRanges = &push_constant;
     mesh_pipeline_layout_info.pushConstantRangeCount = 1;
 
+    //every pipeline reads textures and materials from the bindless table at set 0, world matrices from the transform buffer at set 1
+    //and per-frame data from the dynamic ring at set 2
+    const VkDescriptorSetLayout setLayouts[] = {bindlessTable->GetLayout(), transformBuffer->GetLayout(), frameRing.GetLayout()};
+    mesh_pipeline_layout_info.pSetLayouts = setLayouts;
+    mesh_pipeline_layout_info.setLayoutCount = (uint32_t)std::size(setLayouts);
+
     VK_CHECK(vkCreatePipelineLayout(_device, &mesh_pipeline_layout_info, nullptr, &_meshPipelineLayout));
 
     VertexInputAttributeDescriptor vertexDescription = Vertex::GetVertexDescription();
@@ -926,45 +2523,231 @@ void RenderingECSModule::InitPipelines()
     simple_mesh_pipeline_layout_info.pPushConstantRanges = &simple_mesh_push_constant;
     simple_mesh_pipeline_layout_info.pushConstantRangeCount = 1;
 
+    simple_mesh_pipeline_layout_info.pSetLayouts = setLayouts;
+    simple_mesh_pipeline_layout_info.setLayoutCount = (uint32_t)std::size(setLayouts);
+
     VK_CHECK(vkCreatePipelineLayout(_device, &simple_mesh_pipeline_layout_info, nullptr, &simpleMeshPipelineLayout));
 
-    VertexInputAttributeDescriptor simpleMeshVertexDescription = SimpleVertex::GetVertexDescription();
+    //one shader pair for every SimpleMesh material, specialized per feature set and vertex format on first use
+    pipelineBuilder._pipelineLayout = simpleMeshPipelineLayout;
+    simpleMeshVariants.Init(_device, _renderPass, pipelineBuilder, "SimpleMesh/SimpleMesh.vert.spv", "SimpleMesh/SimpleMesh.frag.spv");
+    simpleMeshVariants.SetVertexInput(VertexFormat::Float32, SimpleVertex::GetVertexDescription());
+    simpleMeshVariants.SetVertexInput(VertexFormat::Quantized16, QuantizedSimpleVertex::GetVertexDescription());
+    _mainDeletionQueue.PushDeletor([=]() { simpleMeshVariants.Cleanup(); });
+
+    CreateSimpleMeshMaterial("SimpleMesh/SolidColor", SimpleMeshFeatures::MATERIAL_COLOR);
+    CreateSimpleMeshMaterial("SimpleMesh/Rainbow", SimpleMeshFeatures::VERTEX_COLOR);
+    CreateSimpleMeshMaterial("SimpleMesh/Textured", SimpleMeshFeatures::MATERIAL_COLOR | SimpleMeshFeatures::TEXTURED, Color32::WHITE);
 
-    //connect the pipeline builder vertex input info to the one we get from Vertex
-    pipelineBuilder._vertexInputInfo.pVertexAttributeDescriptions = simpleMeshVertexDescription.attributes.data();
-    pipelineBuilder._vertexInputInfo.vertexAttributeDescriptionCount = (uint32_t)simpleMeshVertexDescription.attributes.size();
 
-    pipelineBuilder._vertexInputInfo.pVertexBindingDescriptions = simpleMeshVertexDescription.bindings.data();
-    pipelineBuilder._vertexInputInfo.vertexBindingDescriptionCount = (uint32_t)simpleMeshVertexDescription.bindings.size();
 
-    
-    const ShaderModule simpleMeshVertShader = ShaderModule::CreateVertShader(_device, "SimpleMesh/SolidColor.vert.spv");
-    pipelineBuilder._shaderStages.push_back(simpleMeshVertShader.pipelineShaderStageCreateInfo);
+    //tilemap chunks use the mesh push constants, with the chunk origin and tile size as the position offset and scale
+    VkPipelineLayoutCreateInfo tilemap_pipeline_layout_info = vkinit::pipeline_layout_create_info();
 
-    //make sure that triangleFragShader is holding the compiled colored_triangle.frag
-    const ShaderModule simpleMeshFragShader = ShaderModule::CreateFragShader(_device, "SimpleMesh/SolidColor.frag.spv");
-    pipelineBuilder._shaderStages.push_back(simpleMeshFragShader.pipelineShaderStageCreateInfo);
+    VkPushConstantRange tilemap_push_constant = {};
+    tilemap_push_constant.offset = 0;
+    tilemap_push_constant.size = sizeof(MeshPushConstants);
+    tilemap_push_constant.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
 
-    pipelineBuilder._pipelineLayout = simpleMeshPipelineLayout;
+    tilemap_pipeline_layout_info.pPushConstantRanges = &tilemap_push_constant;
+    tilemap_pipeline_layout_info.pushConstantRangeCount = 1;
+
+    tilemap_pipeline_layout_info.pSetLayouts = setLayouts;
+    tilemap_pipeline_layout_info.setLayoutCount = (uint32_t)std::size(setLayouts);
+
+    VK_CHECK(vkCreatePipelineLayout(_device, &tilemap_pipeline_layout_info, nullptr, &tilemapPipelineLayout));
+
+    VertexInputAttributeDescriptor tileVertexDescription = TileVertex::GetVertexDescription();
 
-    //build the mesh triangle pipeline
-    simpleMeshPipeline = pipelineBuilder.BuildPipeline(_device, _renderPass);
+    pipelineBuilder._vertexInputInfo.pVertexAttributeDescriptions = tileVertexDescription.attributes.data();
+    pipelineBuilder._vertexInputInfo.vertexAttributeDescriptionCount = (uint32_t)tileVertexDescription.attributes.size();
 
-    Material::Create(ecs(), "SimpleMesh/SolidColor", &simpleMeshPipeline, &simpleMeshPipelineLayout);
+    pipelineBuilder._vertexInputInfo.pVertexBindingDescriptions = tileVertexDescription.bindings.data();
+    pipelineBuilder._vertexInputInfo.vertexBindingDescriptionCount = (uint32_t)tileVertexDescription.bindings.size();
+
+    const ShaderModule tileVertShader = ShaderModule::CreateVertShader(_device, "Tilemap/Tile.vert.spv");
+    pipelineBuilder._shaderStages.push_back(tileVertShader.pipelineShaderStageCreateInfo);
+    const ShaderModule tileFragShader = ShaderModule::CreateFragShader(_device, "Tilemap/Tile.frag.spv");
+    pipelineBuilder._shaderStages.push_back(tileFragShader.pipelineShaderStageCreateInfo);
+
+    pipelineBuilder._pipelineLayout = tilemapPipelineLayout;
+
+    tilemapPipeline = pipelineBuilder.BuildPipeline(_device, _renderPass);
+
+    Material::Create(ecs(), "Tilemap/Atlas", &tilemapPipeline, &tilemapPipelineLayout, Color32::WHITE);
 
     pipelineBuilder._shaderStages.clear();
 
 
 
-    //add the other shaders
-    const ShaderModule rainbowTriangleVertShader = ShaderModule::CreateVertShader(_device, "SimpleMesh/Rainbow.vert.spv");
-    pipelineBuilder._shaderStages.push_back(rainbowTriangleVertShader.pipelineShaderStageCreateInfo);
-    const ShaderModule rainbowTriangleFragShader = ShaderModule::CreateFragShader(_device, "SimpleMesh/Rainbow.frag.spv");
-    pipelineBuilder._shaderStages.push_back(rainbowTriangleFragShader.pipelineShaderStageCreateInfo);
+    //impostor billboards are expanded from gl_VertexIndex and gl_InstanceIndex, their instances are read from the frame ring
+    VkPipelineLayoutCreateInfo impostor_pipeline_layout_info = vkinit::pipeline_layout_create_info();
+
+    VkPushConstantRange impostor_push_constant = {};
+    impostor_push_constant.offset = 0;
+    impostor_push_constant.size = sizeof(ImpostorPushConstants);
+    impostor_push_constant.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+
+    impostor_pipeline_layout_info.pPushConstantRanges = &impostor_push_constant;
+    impostor_pipeline_layout_info.pushConstantRangeCount = 1;
+
+    impostor_pipeline_layout_info.pSetLayouts = setLayouts;
+    impostor_pipeline_layout_info.setLayoutCount = (uint32_t)std::size(setLayouts);
+
+    VK_CHECK(vkCreatePipelineLayout(_device, &impostor_pipeline_layout_info, nullptr, &impostorPipelineLayout));
+
+    //opaque like the meshes they replace, alpha tested and writing the baked depth
+    pipelineBuilder._vertexInputInfo = vkinit::vertex_input_state_create_info();
+
+    const ShaderModule impostorVertShader = ShaderModule::CreateVertShader(_device, "Impostor/Impostor.vert.spv");
+    pipelineBuilder._shaderStages.push_back(impostorVertShader.pipelineShaderStageCreateInfo);
+    const ShaderModule impostorFragShader = ShaderModule::CreateFragShader(_device, "Impostor/Impostor.frag.spv");
+    pipelineBuilder._shaderStages.push_back(impostorFragShader.pipelineShaderStageCreateInfo);
+
+    pipelineBuilder._pipelineLayout = impostorPipelineLayout;
+
+    impostorPipeline = pipelineBuilder.BuildPipeline(_device, _renderPass);
+
+    pipelineBuilder._shaderStages.clear();
+
+
+
+    //particle billboards are expanded from gl_VertexIndex and gl_InstanceIndex, nothing comes from vertex buffers
+    VkPipelineLayoutCreateInfo particle_pipeline_layout_info = vkinit::pipeline_layout_create_info();
+
+    VkPushConstantRange particle_push_constant = {};
+    particle_push_constant.offset = 0;
+    particle_push_constant.size = sizeof(ParticlePushConstants);
+    particle_push_constant.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+
+    particle_pipeline_layout_info.pPushConstantRanges = &particle_push_constant;
+    particle_pipeline_layout_info.pushConstantRangeCount = 1;
+
+    //the particles take the transform buffer's place at set 1, the bindless table and the frame ring stay where every pipeline has them
+    const VkDescriptorSetLayout particleSetLayouts[] = {bindlessTable->GetLayout(), particleSystem.GetRenderLayout(), frameRing.GetLayout()};
+    particle_pipeline_layout_info.pSetLayouts = particleSetLayouts;
+    particle_pipeline_layout_info.setLayoutCount = (uint32_t)std::size(particleSetLayouts);
+
+    VK_CHECK(vkCreatePipelineLayout(_device, &particle_pipeline_layout_info, nullptr, &particlePipelineLayout));
+
+    pipelineBuilder._vertexInputInfo = vkinit::vertex_input_state_create_info();
+
+    //blended over the scene and tested against its depth, without writing depth so particles never hide each other
+    pipelineBuilder._colorBlendAttachment.blendEnable = VK_TRUE;
+    pipelineBuilder._colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+    pipelineBuilder._colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+    pipelineBuilder._colorBlendAttachment.colorBlendOp = VK_BLEND_OP_ADD;
+    pipelineBuilder._colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+    pipelineBuilder._colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+    pipelineBuilder._colorBlendAttachment.alphaBlendOp = VK_BLEND_OP_ADD;
+    pipelineBuilder._depthStencil = vkinit::depth_stencil_create_info(true, false, VK_COMPARE_OP_LESS_OR_EQUAL);
+
+    const ShaderModule particleVertShader = ShaderModule::CreateVertShader(_device, "Particles/Particle.vert.spv");
+    pipelineBuilder._shaderStages.push_back(particleVertShader.pipelineShaderStageCreateInfo);
+    const ShaderModule particleFragShader = ShaderModule::CreateFragShader(_device, "Particles/Particle.frag.spv");
+    pipelineBuilder._shaderStages.push_back(particleFragShader.pipelineShaderStageCreateInfo);
+
+    pipelineBuilder._pipelineLayout = particlePipelineLayout;
+
+    particlePipeline = pipelineBuilder.BuildPipeline(_device, _renderPass);
+
+    pipelineBuilder._shaderStages.clear();
+
+
+
+    //glyph quads are expanded from gl_VertexIndex and gl_InstanceIndex like the particles, blended the same way
+    VkPipelineLayoutCreateInfo text_pipeline_layout_info = vkinit::pipeline_layout_create_info();
+
+    VkPushConstantRange text_push_constant = {};
+    text_push_constant.offset = 0;
+    text_push_constant.size = sizeof(TextPushConstants);
+    text_push_constant.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+
+    text_pipeline_layout_info.pPushConstantRanges = &text_push_constant;
+    text_pipeline_layout_info.pushConstantRangeCount = 1;
+
+    //the camera is pushed, so the frame ring is not part of the layout
+    const VkDescriptorSetLayout textSetLayouts[] = {bindlessTable->GetLayout(), textRenderer.GetLayout()};
+    text_pipeline_layout_info.pSetLayouts = textSetLayouts;
+    text_pipeline_layout_info.setLayoutCount = (uint32_t)std::size(textSetLayouts);
+
+    VK_CHECK(vkCreatePipelineLayout(_device, &text_pipeline_layout_info, nullptr, &textPipelineLayout));
+
+    const ShaderModule textVertShader = ShaderModule::CreateVertShader(_device, "Text/Text.vert.spv");
+    pipelineBuilder._shaderStages.push_back(textVertShader.pipelineShaderStageCreateInfo);
+    const ShaderModule textFragShader = ShaderModule::CreateFragShader(_device, "Text/Text.frag.spv");
+    pipelineBuilder._shaderStages.push_back(textFragShader.pipelineShaderStageCreateInfo);
+
+    pipelineBuilder._pipelineLayout = textPipelineLayout;
+
+    textPipeline = pipelineBuilder.BuildPipeline(_device, _renderPass);
+
+    pipelineBuilder._shaderStages.clear();
+
+
+
+    //debug lines read the camera from the frame ring, so the shared layout fits without push constants
+    VkPipelineLayoutCreateInfo debug_line_pipeline_layout_info = vkinit::pipeline_layout_create_info();
+
+    debug_line_pipeline_layout_info.pSetLayouts = setLayouts;
+    debug_line_pipeline_layout_info.setLayoutCount = (uint32_t)std::size(setLayouts);
+
+    VK_CHECK(vkCreatePipelineLayout(_device, &debug_line_pipeline_layout_info, nullptr, &debugLinePipelineLayout));
 
-    _rainbowSimpleMeshPipeline = pipelineBuilder.BuildPipeline(_device, _renderPass);
+    VertexInputAttributeDescriptor debugVertexDescription = DebugVertex::GetVertexDescription();
 
-    Material::Create(ecs(), "SimpleMesh/Rainbow", &_rainbowSimpleMeshPipeline, &simpleMeshPipelineLayout);
+    pipelineBuilder._vertexInputInfo.pVertexAttributeDescriptions = debugVertexDescription.attributes.data();
+    pipelineBuilder._vertexInputInfo.vertexAttributeDescriptionCount = (uint32_t)debugVertexDescription.attributes.size();
+
+    pipelineBuilder._vertexInputInfo.pVertexBindingDescriptions = debugVertexDescription.bindings.data();
+    pipelineBuilder._vertexInputInfo.vertexBindingDescriptionCount = (uint32_t)debugVertexDescription.bindings.size();
+
+    //every line of every thread in one draw, blended and depth tested like the particles
+    pipelineBuilder._inputAssembly = vkinit::input_assembly_create_info(VK_PRIMITIVE_TOPOLOGY_LINE_LIST);
+
+    const ShaderModule debugLineVertShader = ShaderModule::CreateVertShader(_device, "Debug/Line.vert.spv");
+    pipelineBuilder._shaderStages.push_back(debugLineVertShader.pipelineShaderStageCreateInfo);
+    const ShaderModule debugLineFragShader = ShaderModule::CreateFragShader(_device, "Debug/Line.frag.spv");
+    pipelineBuilder._shaderStages.push_back(debugLineFragShader.pipelineShaderStageCreateInfo);
+
+    pipelineBuilder._pipelineLayout = debugLinePipelineLayout;
+
+    debugLinePipeline = pipelineBuilder.BuildPipeline(_device, _renderPass);
+
+    _mainDeletionQueue.PushDeletor
+    (
+        [=]()
+        {
+            vkDestroyPipeline(_device, particlePipeline, nullptr);
+            vkDestroyPipelineLayout(_device, particlePipelineLayout, nullptr);
+            vkDestroyPipeline(_device, textPipeline, nullptr);
+            vkDestroyPipelineLayout(_device, textPipelineLayout, nullptr);
+            vkDestroyPipeline(_device, impostorPipeline, nullptr);
+            vkDestroyPipelineLayout(_device, impostorPipelineLayout, nullptr);
+            vkDestroyPipeline(_device, debugLinePipeline, nullptr);
+            vkDestroyPipelineLayout(_device, debugLinePipelineLayout, nullptr);
+        }
+    );
+}
+
+VkPipeline* RenderingECSModule::GetSimpleMeshVariant(const uint32_t features)
+{
+    VkPipeline* const pipeline = simpleMeshVariants.Get(features, VertexFormat::Float32);
+
+    // The Material stores the SimpleVertex pipeline, quantized meshes look up its twin when drawn
+    const VkPipeline quantized = *simpleMeshVariants.Get(features, VertexFormat::Quantized16);
+    quantizedPipelineVariants[*pipeline] = quantized;
+    simpleMeshPipelineFeatures[*pipeline] = features;
+    simpleMeshPipelineFeatures[quantized] = features;
+
+    // Entities fading into an impostor swap to the dithered twin of whichever pipeline they draw with
+    if ((features & SimpleMeshFeatures::DITHER_FADE) == 0)
+    {
+        fadePipelineVariants[*pipeline] = *simpleMeshVariants.Get(features | SimpleMeshFeatures::DITHER_FADE, VertexFormat::Float32);
+        fadePipelineVariants[quantized] = *simpleMeshVariants.Get(features | SimpleMeshFeatures::DITHER_FADE, VertexFormat::Quantized16);
+    }
+
+    return pipeline;
 }
 
 static void check_vk_result(VkResult err)
@@ -1028,6 +2811,11 @@ void RenderingECSModule::InitImGui()
     init_info.MSAASamples = VK_SAMPLE_COUNT_1_BIT;
     // init_info.Allocator = YOUR_ALLOCATOR;
     init_info.CheckVkResultFn = check_vk_result;
+    #ifdef IMGUI_IMPL_VULKAN_HAS_DYNAMIC_RENDERING
+        // ImGui is drawn in its own color-only rendering scope, after the scene
+        init_info.UseDynamicRendering = capabilities.dynamicRendering;
+        init_info.ColorAttachmentFormat = _swapchainImageFormat;
+    #endif
     ImGui_ImplVulkan_Init(&init_info, _renderPass);
 }
 
@@ -1037,177 +2825,1629 @@ void RenderingECSModule::CleanupImGui()
     ImGui_ImplSDL2_Shutdown();
     ImGui::DestroyContext();
 
-    vkDestroyDescriptorPool(_device, imguiPool, nullptr);
+    vkDestroyDescriptorPool(_device, imguiPool, nullptr);
+}
+
+void RenderingECSModule::PreDrawStep(float deltaTime)
+{
+    // Start the Dear ImGui frame
+    {
+        // the Vulkan backend may upload its font texture here, which shares the queue with the render thread
+        std::lock_guard<std::mutex> queueLock(queueMutex);
+        ImGui_ImplVulkan_NewFrame();
+    }
+    ImGui_ImplSDL2_NewFrame();
+    ImGui::NewFrame();
+
+    // decides which uploads the Draw phase may use this tick
+    uploadQueue.Collect();
+}
+
+void RenderingECSModule::PostDrawStep(float deltaTime)
+{
+    ImGui::Render();
+
+    RenderSnapshot& snapshot = renderThread.GetWriteSnapshot();
+    snapshot.CaptureUI(ImGui::GetDrawData());
+    snapshot.dynamicResolution = dynamicResolutionEnabled;
+    transformBuffer->ExtractUploads(snapshot.transformUploads, snapshot.transformUploadData);
+    uploadQueue.TakeAcquires(snapshot.ownershipAcquires);
+    snapshot.transferWaitValue = uploadQueue.GetCompletedValue();
+
+    // gathered per atlas, so each atlas is one instanced draw
+    for (uint32_t atlasIndex = 0; atlasIndex < pendingImpostors.size(); ++atlasIndex)
+    {
+        std::vector<ImpostorInstance>& instances = pendingImpostors[atlasIndex];
+        if (instances.empty())
+        {
+            continue;
+        }
+
+        const ImpostorAtlas& atlas = impostorAtlases[atlasIndex];
+
+        ImpostorBatch batch;
+        batch.colorTexture = atlas.colorTexture;
+        batch.normalDepthTexture = atlas.normalDepthTexture;
+        batch.columns = atlas.columns;
+        batch.rows = atlas.rows;
+        batch.firstInstance = static_cast<uint32_t>(snapshot.impostorInstances.size());
+        batch.instanceCount = static_cast<uint32_t>(instances.size());
+        snapshot.impostorBatches.push_back(batch);
+
+        snapshot.impostorInstances.insert(snapshot.impostorInstances.end(), instances.begin(), instances.end());
+        instances.clear();
+    }
+
+    snapshot.batchedCount = dynamicBatcher.Flatten(snapshot.batchGeometry, snapshot.drawPackets);
+    DebugDraw::Collect(snapshot.debugVertices);
+
+    renderThread.Publish();
+}
+
+void RenderingECSModule::RenderFrame(RenderSnapshot& snapshot)
+{
+    const int frameNumber = _frameNumber;
+    recordedStats = RenderStats{};
+
+    BeginFrame(snapshot);
+
+    //the main view's, begun and ended inside its render pass so ImGui drawn after it is left out
+    if (pipelineStatisticsQueryPool != VK_NULL_HANDLE)
+    {
+        vkCmdBeginQuery(_mainCommandBuffer, pipelineStatisticsQueryPool, 0, 0);
+    }
+
+    //leaves the main view bound for the passes drawn over every view
+    DrawWindowViews(snapshot);
+    DrawImpostors(snapshot);
+
+    //blended, so after every opaque draw
+    DrawParticles(snapshot);
+    DrawTextLabels(snapshot);
+    DrawDebugLines(snapshot);
+
+    EndFrame(snapshot);
+
+    //this frame may be the last to read them, they are freed once its fence signals
+    retiredBuffers.swap(snapshot.retiredBuffers);
+
+    recordedStats.renderScale = dynamicResolution.GetScale();
+    recordedStats.renderExtent = renderExtent;
+    recordedStats.gpuFrameTimeMs = dynamicResolution.GetSmoothedFrameTimeMs();
+    recordedStats.transformUploadCount = static_cast<uint32_t>(snapshot.transformUploadData.size());
+    recordedStats.glyphCount = static_cast<uint32_t>(snapshot.glyphInstances.size());
+    recordedStats.skinnedCount = static_cast<uint32_t>(snapshot.skinDispatches.size());
+    recordedStats.impostorCount = static_cast<uint32_t>(snapshot.impostorInstances.size());
+    recordedStats.batchedCount = snapshot.batchedCount;
+
+    renderStatsLog.Append(frameNumber, recordedStats);
+
+    std::lock_guard<std::mutex> statsLock(renderStatsMutex);
+    renderStats = recordedStats;
+}
+
+void RenderingECSModule::BeginFrame(const RenderSnapshot& snapshot)
+{
+    if (dynamicResolution.enabled != snapshot.dynamicResolution)
+    {
+        dynamicResolution.enabled = snapshot.dynamicResolution;
+        dynamicResolution.Reset();
+    }
+
+    //wait until the GPU has finished rendering the last frame. Timeout of 1 second
+    VK_CHECK(vkWaitForFences(_device, 1, &_renderFence, true, 1000000000));
+    VK_CHECK(vkResetFences(_device, 1, &_renderFence));
+
+    //the copies recorded last frame have landed, hand them to the encoder
+    frameCapture.OnFrameRetired();
+
+    //nothing reads last frame's descriptor sets or ring data anymore
+    frameDescriptorAllocator.Reset();
+    frameRing.Reset();
+    DestroyBuffers(retiredBuffers);
+
+    //written once per view, every pipeline bind selects its view's with a dynamic offset
+    PushViewUniforms(snapshot);
+
+    UpdateRenderScale();
+    ReadPipelineStatistics();
+
+    //request image from the swapchain, one second timeout
+    VK_CHECK(vkAcquireNextImageKHR(_device, _swapchain, 1000000000, _presentSemaphore, nullptr, &swapchainImageIndex));
+
+    //now that we are sure that the commands finished executing, we can safely reset the command buffer to begin recording again.
+    VK_CHECK(vkResetCommandBuffer(_mainCommandBuffer, 0));
+
+    //begin the command buffer recording. We will use this command buffer exactly once, so we want to let Vulkan know that
+    VkCommandBufferBeginInfo cmdBeginInfo = {};
+    cmdBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    cmdBeginInfo.pNext = nullptr;
+
+    cmdBeginInfo.pInheritanceInfo = nullptr;
+    cmdBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+    VK_CHECK(vkBeginCommandBuffer(_mainCommandBuffer, &cmdBeginInfo));
+
+    if (timestampQueryPool != VK_NULL_HANDLE)
+    {
+        vkCmdResetQueryPool(_mainCommandBuffer, timestampQueryPool, 0, 2);
+        vkCmdWriteTimestamp(_mainCommandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, timestampQueryPool, 0);
+    }
+    if (pipelineStatisticsQueryPool != VK_NULL_HANDLE)
+    {
+        vkCmdResetQueryPool(_mainCommandBuffer, pipelineStatisticsQueryPool, 0, 2);
+    }
+
+    //take ownership of buffers the transfer queue finished since the last frame
+    TransferQueue::RecordAcquires(_mainCommandBuffer, snapshot.ownershipAcquires);
+
+    //copy the matrices that changed since the last frame, the fence above guarantees the staging buffer is free
+    transformBuffer->RecordUploads(_mainCommandBuffer, snapshot.transformUploads, snapshot.transformUploadData);
+
+    //spawn, move and compact the particles before the render pass draws them
+    particleSystem.RecordSimulation(_mainCommandBuffer, frameRing, snapshot.particleEmitters, snapshot.particleDeltaTime);
+
+    //pose the animated instances before the render pass draws them
+    skinningSystem->RecordSkinning(_mainCommandBuffer, frameDescriptorAllocator, snapshot.skinDispatches, snapshot.skinMatrices);
+    meshletCuller.RecordCulling(_mainCommandBuffer, frameDescriptorAllocator, snapshot.meshletDispatches, snapshot.meshletCommandCount);
+
+    //glyphs rasterized during the tick, before the text pass samples them
+    textRenderer.RecordUploads(_mainCommandBuffer, snapshot.atlasUploads, snapshot.atlasUploadPixels);
+    dynamicBatcher.Upload(snapshot.batchGeometry);
+    UploadDebugLines(snapshot.debugVertices);
+
+    VkClearValue clearValue = {};
+    // float flash = abs(sin(_frameNumber / 3840.f));
+    // clearValue.color = { { 0.0f, 0.0f, flash, 1.0f } };
+    Color32 color = Color32::FromHex("#181818");
+    clearValue.color = { { color.r/255.0f, color.g/255.0f, color.b/255.0f, color.a/255.0f } };
+
+    //clear depth at 1
+	VkClearValue depthClear;
+	depthClear.depthStencil.depth = 1.f;
+
+    VkClearValue clearValues[] = { clearValue, depthClear };
+    viewClearValues[0] = clearValue;
+    viewClearValues[1] = depthClear;
+
+    //textures sampled by the scene are drawn before its pass begins.
+    //Their passes are all closed again when it returns, so their query spans them from outside
+    if (pipelineStatisticsQueryPool != VK_NULL_HANDLE)
+    {
+        vkCmdBeginQuery(_mainCommandBuffer, pipelineStatisticsQueryPool, 1, 0);
+    }
+    DrawOffscreenViews(snapshot);
+    if (pipelineStatisticsQueryPool != VK_NULL_HANDLE)
+    {
+        vkCmdEndQuery(_mainCommandBuffer, pipelineStatisticsQueryPool, 1);
+    }
+
+    //start the main renderpass.
+    //We will use the clear color from above, and the framebuffer of the index the swapchain gave us,
+    //or the corner of the offscreen scene target when the resolution is scaled
+    renderingToSceneTarget = dynamicResolution.enabled;
+    renderExtent = dynamicResolution.GetRenderExtent(windowExtent);
+
+    if (capabilities.dynamicRendering)
+    {
+        //the layout transitions the render passes did through their attachment descriptions
+        const VkImageMemoryBarrier2KHR barriers[] =
+        {
+            // the submit waits for the swapchain image at this stage, so the transition chains onto that wait
+            vkinit::image_memory_barrier2
+            (
+                renderingToSceneTarget ? sceneColorImage._image : _swapchainImages[swapchainImageIndex],
+                VK_IMAGE_ASPECT_COLOR_BIT,
+                VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT_KHR, VK_ACCESS_2_NONE_KHR,
+                VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT_KHR, VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT_KHR
+            ),
+            vkinit::image_memory_barrier2
+            (
+                _depthImage._image,
+                VK_IMAGE_ASPECT_DEPTH_BIT,
+                VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+                VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT_KHR | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT_KHR, VK_ACCESS_2_NONE_KHR,
+                VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT_KHR | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT_KHR, VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT_KHR
+            )
+        };
+        RecordImageBarriers(barriers, (uint32_t)std::size(barriers));
+
+        BeginRendering
+        (
+            renderingToSceneTarget ? sceneColorImageView : _swapchainImageViews[swapchainImageIndex],
+            &clearValue,
+            _depthImageView,
+            renderExtent
+        );
+        return;
+    }
+
+    VkRenderPassBeginInfo rpInfo = {};
+    rpInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+    rpInfo.pNext = nullptr;
+
+    rpInfo.renderPass = renderingToSceneTarget ? sceneRenderPass : _renderPass;
+    rpInfo.renderArea.offset.x = 0;
+    rpInfo.renderArea.offset.y = 0;
+    rpInfo.renderArea.extent = renderExtent;
+    rpInfo.framebuffer = renderingToSceneTarget ? sceneFramebuffer : _framebuffers[swapchainImageIndex];
+
+    //connect clear values
+    rpInfo.clearValueCount = 2;
+    rpInfo.pClearValues = &clearValues[0];
+
+    vkCmdBeginRenderPass(_mainCommandBuffer, &rpInfo, VK_SUBPASS_CONTENTS_INLINE);
+}
+
+void RenderingECSModule::EndFrame(RenderSnapshot& snapshot)
+{
+    if (pipelineStatisticsQueryPool != VK_NULL_HANDLE)
+    {
+        vkCmdEndQuery(_mainCommandBuffer, pipelineStatisticsQueryPool, 0);
+    }
+    pipelineStatisticsWritten = pipelineStatisticsQueryPool != VK_NULL_HANDLE;
+
+    // ImGui is not scaled, so only the scene is timed
+    if (timestampQueryPool != VK_NULL_HANDLE)
+    {
+        vkCmdWriteTimestamp(_mainCommandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, timestampQueryPool, 1);
+    }
+    timestampsWritten = timestampQueryPool != VK_NULL_HANDLE;
+
+    if (capabilities.dynamicRendering)
+    {
+        CompositeWithDynamicRendering(snapshot);
+    }
+    else if (renderingToSceneTarget)
+    {
+        // leaves sceneColorImage in VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
+        vkCmdEndRenderPass(_mainCommandBuffer);
+
+        VkImageSubresourceRange range = {};
+        range.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        range.baseMipLevel = 0;
+        range.levelCount = 1;
+        range.baseArrayLayer = 0;
+        range.layerCount = 1;
+
+        VkImageMemoryBarrier toTransfer = {};
+        toTransfer.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        toTransfer.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        toTransfer.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        toTransfer.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        toTransfer.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        toTransfer.image = _swapchainImages[swapchainImageIndex];
+        toTransfer.subresourceRange = range;
+        toTransfer.srcAccessMask = 0;
+        toTransfer.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+        // the submit waits for the swapchain image at the transfer stage, so this chains onto that wait
+        vkCmdPipelineBarrier(_mainCommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &toTransfer);
+
+        VkImageBlit blit = {};
+        blit.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        blit.srcSubresource.mipLevel = 0;
+        blit.srcSubresource.baseArrayLayer = 0;
+        blit.srcSubresource.layerCount = 1;
+        blit.srcOffsets[1] = { static_cast<int32_t>(renderExtent.width), static_cast<int32_t>(renderExtent.height), 1 };
+        blit.dstSubresource = blit.srcSubresource;
+        blit.dstOffsets[1] = { static_cast<int32_t>(windowExtent.width), static_cast<int32_t>(windowExtent.height), 1 };
+
+        vkCmdBlitImage
+        (
+            _mainCommandBuffer,
+            sceneColorImage._image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+            _swapchainImages[swapchainImageIndex], VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            1, &blit,
+            VK_FILTER_LINEAR
+        );
+
+        frameCapture.RecordCopy(_mainCommandBuffer, FrameCapture::Source::Scene, sceneColorImage._image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, _swapchainImageFormat, renderExtent);
+
+        VkClearValue clearValues[2] = {};
+        clearValues[1].depthStencil.depth = 1.f;
+
+        VkRenderPassBeginInfo rpInfo = {};
+        rpInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+        rpInfo.pNext = nullptr;
+        rpInfo.renderPass = compositeRenderPass;
+        rpInfo.renderArea.offset = {0, 0};
+        rpInfo.renderArea.extent = windowExtent;
+        rpInfo.framebuffer = _framebuffers[swapchainImageIndex];
+        rpInfo.clearValueCount = 2;
+        rpInfo.pClearValues = &clearValues[0];
+
+        vkCmdBeginRenderPass(_mainCommandBuffer, &rpInfo, VK_SUBPASS_CONTENTS_INLINE);
+    }
+
+    if (!capabilities.dynamicRendering)
+    {
+        // Rendering imgui, from the copy taken when the snapshot was published
+        ImGui_ImplVulkan_RenderDrawData(snapshot.GetUIDrawData(), _mainCommandBuffer);
+
+        //finalize the render pass
+        vkCmdEndRenderPass(_mainCommandBuffer);
+    }
+
+    frameCapture.RecordCopy
+    (
+        _mainCommandBuffer,
+        FrameCapture::Source::Swapchain,
+        _swapchainImages[swapchainImageIndex],
+        VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+        _swapchainImageFormat,
+        windowExtent,
+        !renderingToSceneTarget
+    );
+
+    //finalize the command buffer (we can no longer add commands, but it can now be executed)
+    VK_CHECK(vkEndCommandBuffer(_mainCommandBuffer));
+
+
+    //prepare the submission to the queue.
+    //we want to wait on the _presentSemaphore, as that semaphore is signaled when the swapchain is ready
+    //we will signal the _renderSemaphore, to signal that rendering has finished
+
+    VkSubmitInfo submit = {};
+    submit.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submit.pNext = nullptr;
+
+    VkSemaphore waitSemaphores[] = {_presentSemaphore, uploadQueue.GetTimelineSemaphore()};
+    VkPipelineStageFlags waitStages[] = {
+        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT
+    };
+    const uint64_t waitValues[] = {0, snapshot.transferWaitValue}; // the binary semaphore ignores its value
+
+    submit.pWaitDstStageMask = waitStages;
+    submit.pWaitSemaphores = waitSemaphores;
+    submit.waitSemaphoreCount = 1;
+
+    //the uploads drawn this frame were already seen complete on the CPU, so this wait never stalls
+    VkTimelineSemaphoreSubmitInfoKHR timelineInfo = {};
+    timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR;
+    if (waitSemaphores[1] != VK_NULL_HANDLE && snapshot.transferWaitValue > 0)
+    {
+        timelineInfo.waitSemaphoreValueCount = 2;
+        timelineInfo.pWaitSemaphoreValues = waitValues;
+        submit.pNext = &timelineInfo;
+        submit.waitSemaphoreCount = 2;
+    }
+
+    submit.signalSemaphoreCount = 1;
+    submit.pSignalSemaphores = &_renderSemaphore;
+
+    submit.commandBufferCount = 1;
+    submit.pCommandBuffers = &_mainCommandBuffer;
+
+    //submit command buffer to the queue and execute it.
+    // _renderFence will now block until the graphic commands finish execution
+    std::unique_lock<std::mutex> queueLock(queueMutex);
+    if (capabilities.dynamicRendering)
+    {
+        //same waits as above, synchronization2 takes the timeline value per semaphore
+        VkSemaphoreSubmitInfoKHR waitInfos[2] = {};
+        waitInfos[0].sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO_KHR;
+        waitInfos[0].semaphore = _presentSemaphore;
+        waitInfos[0].stageMask = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT_KHR | VK_PIPELINE_STAGE_2_BLIT_BIT_KHR;
+        waitInfos[1].sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO_KHR;
+        waitInfos[1].semaphore = waitSemaphores[1];
+        waitInfos[1].value = snapshot.transferWaitValue;
+        waitInfos[1].stageMask = VK_PIPELINE_STAGE_2_VERTEX_INPUT_BIT_KHR | VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT_KHR | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT_KHR;
+
+        VkSemaphoreSubmitInfoKHR signalInfo = {};
+        signalInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO_KHR;
+        signalInfo.semaphore = _renderSemaphore;
+        signalInfo.stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT_KHR;
+
+        VkCommandBufferSubmitInfoKHR commandBufferInfo = {};
+        commandBufferInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO_KHR;
+        commandBufferInfo.commandBuffer = _mainCommandBuffer;
+
+        VkSubmitInfo2KHR submit2 = {};
+        submit2.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2_KHR;
+        submit2.waitSemaphoreInfoCount = submit.waitSemaphoreCount;
+        submit2.pWaitSemaphoreInfos = waitInfos;
+        submit2.commandBufferInfoCount = 1;
+        submit2.pCommandBufferInfos = &commandBufferInfo;
+        submit2.signalSemaphoreInfoCount = 1;
+        submit2.pSignalSemaphoreInfos = &signalInfo;
+
+        VK_CHECK(queueSubmit2(_graphicsQueue, 1, &submit2, _renderFence));
+    }
+    else
+    {
+        VK_CHECK(vkQueueSubmit(_graphicsQueue, 1, &submit, _renderFence));
+    }
+
+
+    // this will put the image we just rendered into the visible window.
+    // we want to wait on the _renderSemaphore for that,
+    // as it's necessary that drawing commands have finished before the image is displayed to the user
+    VkPresentInfoKHR presentInfo = {};
+    presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+    presentInfo.pNext = nullptr;
+
+    presentInfo.pSwapchains = &_swapchain;
+    presentInfo.swapchainCount = 1;
+
+    presentInfo.pWaitSemaphores = &_renderSemaphore;
+    presentInfo.waitSemaphoreCount = 1;
+
+    presentInfo.pImageIndices = &swapchainImageIndex;
+
+    VkResult result = vkQueuePresentKHR(_graphicsQueue, &presentInfo);
+    queueLock.unlock();
+    if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR)
+    {
+    }
+    else
+    {
+        VK_CHECK(result);
+    }
+
+    //increase the number of frames drawn
+    _frameNumber++;
+}
+
+void RenderingECSModule::CompositeWithDynamicRendering(RenderSnapshot& snapshot)
+{
+    cmdEndRendering(_mainCommandBuffer);
+
+    VkImage swapchainImage = _swapchainImages[swapchainImageIndex];
+
+    if (renderingToSceneTarget)
+    {
+        const VkImageMemoryBarrier2KHR toTransfer[] =
+        {
+            vkinit::image_memory_barrier2
+            (
+                sceneColorImage._image,
+                VK_IMAGE_ASPECT_COLOR_BIT,
+                VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT_KHR, VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT_KHR,
+                VK_PIPELINE_STAGE_2_BLIT_BIT_KHR, VK_ACCESS_2_TRANSFER_READ_BIT_KHR
+            ),
+            // the submit waits for the swapchain image at the blit stage, so this chains onto that wait
+            vkinit::image_memory_barrier2
+            (
+                swapchainImage,
+                VK_IMAGE_ASPECT_COLOR_BIT,
+                VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                VK_PIPELINE_STAGE_2_BLIT_BIT_KHR, VK_ACCESS_2_NONE_KHR,
+                VK_PIPELINE_STAGE_2_BLIT_BIT_KHR, VK_ACCESS_2_TRANSFER_WRITE_BIT_KHR
+            )
+        };
+        RecordImageBarriers(toTransfer, (uint32_t)std::size(toTransfer));
+
+        VkImageBlit blit = {};
+        blit.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        blit.srcSubresource.mipLevel = 0;
+        blit.srcSubresource.baseArrayLayer = 0;
+        blit.srcSubresource.layerCount = 1;
+        blit.srcOffsets[1] = { static_cast<int32_t>(renderExtent.width), static_cast<int32_t>(renderExtent.height), 1 };
+        blit.dstSubresource = blit.srcSubresource;
+        blit.dstOffsets[1] = { static_cast<int32_t>(windowExtent.width), static_cast<int32_t>(windowExtent.height), 1 };
+
+        vkCmdBlitImage
+        (
+            _mainCommandBuffer,
+            sceneColorImage._image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+            swapchainImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            1, &blit,
+            VK_FILTER_LINEAR
+        );
+
+        frameCapture.RecordCopy(_mainCommandBuffer, FrameCapture::Source::Scene, sceneColorImage._image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, _swapchainImageFormat, renderExtent);
+
+        const VkImageMemoryBarrier2KHR toAttachment = vkinit::image_memory_barrier2
+        (
+            swapchainImage,
+            VK_IMAGE_ASPECT_COLOR_BIT,
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+            VK_PIPELINE_STAGE_2_BLIT_BIT_KHR, VK_ACCESS_2_TRANSFER_WRITE_BIT_KHR,
+            VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT_KHR, VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT_KHR | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT_KHR
+        );
+        RecordImageBarriers(&toAttachment, 1);
+    }
+    else
+    {
+        // the scene was drawn straight into the swapchain image, ImGui blends over it
+        const VkImageMemoryBarrier2KHR sceneToUI = vkinit::image_memory_barrier2
+        (
+            swapchainImage,
+            VK_IMAGE_ASPECT_COLOR_BIT,
+            VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+            VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT_KHR, VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT_KHR,
+            VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT_KHR, VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT_KHR | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT_KHR
+        );
+        RecordImageBarriers(&sceneToUI, 1);
+    }
+
+    // ImGui was built without a depth format, so it gets its own color-only scope over the whole window
+    BeginRendering(_swapchainImageViews[swapchainImageIndex], nullptr, VK_NULL_HANDLE, windowExtent);
+
+    // Rendering imgui, from the copy taken when the snapshot was published
+    ImGui_ImplVulkan_RenderDrawData(snapshot.GetUIDrawData(), _mainCommandBuffer);
+
+    cmdEndRendering(_mainCommandBuffer);
+
+    // presentation and FrameCapture expect the layout the render passes left the image in,
+    // the transfer stage lets the capture copy chain onto this transition
+    const VkImageMemoryBarrier2KHR toPresent = vkinit::image_memory_barrier2
+    (
+        swapchainImage,
+        VK_IMAGE_ASPECT_COLOR_BIT,
+        VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+        VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT_KHR, VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT_KHR,
+        VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT_KHR, VK_ACCESS_2_NONE_KHR
+    );
+    RecordImageBarriers(&toPresent, 1);
+}
+
+void RenderingECSModule::BeginRendering(VkImageView colorView, const VkClearValue* colorClear, VkImageView depthView, const VkExtent2D extent)
+{
+    const VkRenderingAttachmentInfoKHR colorAttachment = vkinit::rendering_attachment_info(colorView, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, colorClear);
+
+    //clear depth at 1, nothing reads it after the scene so it is not stored
+    VkClearValue depthClear = {};
+    depthClear.depthStencil.depth = 1.f;
+    VkRenderingAttachmentInfoKHR depthAttachment = vkinit::rendering_attachment_info(depthView, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL, &depthClear);
+    depthAttachment.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+
+    VkRenderingInfoKHR renderingInfo = {};
+    renderingInfo.sType = VK_STRUCTURE_TYPE_RENDERING_INFO_KHR;
+    renderingInfo.renderArea.offset = {0, 0};
+    renderingInfo.renderArea.extent = extent;
+    renderingInfo.layerCount = 1;
+    renderingInfo.colorAttachmentCount = 1;
+    renderingInfo.pColorAttachments = &colorAttachment;
+    renderingInfo.pDepthAttachment = depthView != VK_NULL_HANDLE ? &depthAttachment : nullptr;
+
+    cmdBeginRendering(_mainCommandBuffer, &renderingInfo);
+}
+
+void RenderingECSModule::RecordImageBarriers(const VkImageMemoryBarrier2KHR* barriers, const uint32_t count)
+{
+    VkDependencyInfoKHR dependencyInfo = {};
+    dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO_KHR;
+    dependencyInfo.imageMemoryBarrierCount = count;
+    dependencyInfo.pImageMemoryBarriers = barriers;
+
+    cmdPipelineBarrier2(_mainCommandBuffer, &dependencyInfo);
+}
+
+void RenderingECSModule::PushViewUniforms(const RenderSnapshot& snapshot)
+{
+    viewUniformOffsets.clear();
+    for (const ViewPacket& view : snapshot.views)
+    {
+        viewUniformOffsets.push_back(frameRing.Push(FrameUniforms{view.viewProjection}));
+    }
+    frameUniformsOffset = viewUniformOffsets[0];
+}
+
+void RenderingECSModule::DrawOffscreenViews(const RenderSnapshot& snapshot)
+{
+    for (uint32_t viewIndex = 0; viewIndex < snapshot.views.size(); ++viewIndex)
+    {
+        const ViewPacket& view = snapshot.views[viewIndex];
+        if (!view.offscreen || !SetViewArea(view, view.target.extent))
+        {
+            continue;
+        }
+
+        const RenderTarget& target = view.target;
+
+        if (capabilities.dynamicRendering)
+        {
+            //the texture is cleared, so the layout it was sampled in is dropped
+            const VkImageMemoryBarrier2KHR barriers[] =
+            {
+                vkinit::image_memory_barrier2
+                (
+                    target.colorImage._image,
+                    VK_IMAGE_ASPECT_COLOR_BIT,
+                    VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                    VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT_KHR, VK_ACCESS_2_NONE_KHR,
+                    VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT_KHR, VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT_KHR
+                ),
+                vkinit::image_memory_barrier2
+                (
+                    target.depthImage._image,
+                    VK_IMAGE_ASPECT_DEPTH_BIT,
+                    VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+                    VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT_KHR | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT_KHR, VK_ACCESS_2_NONE_KHR,
+                    VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT_KHR | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT_KHR, VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT_KHR
+                )
+            };
+            RecordImageBarriers(barriers, (uint32_t)std::size(barriers));
+
+            BeginRendering(target.colorView, &viewClearValues[0], target.depthView, target.extent);
+        }
+        else
+        {
+            VkRenderPassBeginInfo rpInfo = {};
+            rpInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+            rpInfo.pNext = nullptr;
+            rpInfo.renderPass = offscreenRenderPass;
+            rpInfo.renderArea.offset = {0, 0};
+            rpInfo.renderArea.extent = target.extent;
+            rpInfo.framebuffer = target.framebuffer;
+            rpInfo.clearValueCount = 2;
+            rpInfo.pClearValues = &viewClearValues[0];
+
+            vkCmdBeginRenderPass(_mainCommandBuffer, &rpInfo, VK_SUBPASS_CONTENTS_INLINE);
+        }
+
+        DrawView(snapshot, viewIndex);
+
+        if (capabilities.dynamicRendering)
+        {
+            cmdEndRendering(_mainCommandBuffer);
+
+            //what offscreenRenderPass does through its final layout
+            const VkImageMemoryBarrier2KHR toSampled = vkinit::image_memory_barrier2
+            (
+                target.colorImage._image,
+                VK_IMAGE_ASPECT_COLOR_BIT,
+                VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT_KHR, VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT_KHR,
+                VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT_KHR, VK_ACCESS_2_SHADER_READ_BIT_KHR
+            );
+            RecordImageBarriers(&toSampled, 1);
+        }
+        else
+        {
+            vkCmdEndRenderPass(_mainCommandBuffer);
+        }
+    }
+}
+
+void RenderingECSModule::DrawWindowViews(const RenderSnapshot& snapshot)
+{
+    std::vector<uint32_t> windowViews;
+    for (uint32_t viewIndex = 0; viewIndex < snapshot.views.size(); ++viewIndex)
+    {
+        if (!snapshot.views[viewIndex].offscreen)
+        {
+            windowViews.push_back(viewIndex);
+        }
+    }
+
+    std::stable_sort
+    (
+        windowViews.begin(), windowViews.end(),
+        [&snapshot](const uint32_t a, const uint32_t b) { return snapshot.views[a].order < snapshot.views[b].order; }
+    );
+
+    bool firstView = true;
+    for (const uint32_t viewIndex : windowViews)
+    {
+        if (!SetViewArea(snapshot.views[viewIndex], renderExtent))
+        {
+            continue;
+        }
+
+        //the pass cleared the whole target for the first view, the others only clear what they cover
+        if (!firstView)
+        {
+            VkClearAttachment clears[2] = {};
+            clears[0].aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            clears[0].colorAttachment = 0;
+            clears[0].clearValue = viewClearValues[0];
+            clears[1].aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+            clears[1].clearValue = viewClearValues[1];
+
+            VkClearRect clearRect = {};
+            clearRect.rect = viewArea;
+            clearRect.baseArrayLayer = 0;
+            clearRect.layerCount = 1;
+
+            vkCmdClearAttachments(_mainCommandBuffer, 2, clears, 1, &clearRect);
+        }
+        firstView = false;
+
+        DrawView(snapshot, viewIndex);
+    }
+
+    SetViewArea(snapshot.views[0], renderExtent);
+    frameUniformsOffset = viewUniformOffsets[0];
+}
+
+void RenderingECSModule::DrawView(const RenderSnapshot& snapshot, const uint32_t viewIndex)
+{
+    frameUniformsOffset = viewUniformOffsets[viewIndex];
+
+    //the frame ring offset changed, so the first pipeline is bound again even if it is current
+    currentPipeline = VK_NULL_HANDLE;
+    for (const DrawPacket& packet : snapshot.drawPackets)
+    {
+        if (packet.viewIndex != viewIndex)
+        {
+            continue;
+        }
+
+        if (currentPipeline != packet.pipeline)
+        {
+            BindPipeline(packet.pipeline, packet.pipelineLayout);
+        }
+
+        // the frame fence was waited on in BeginFrame, so the GPU is no longer reading material records
+        bindlessTable->SetMaterial(packet.materialIndex, packet.material);
+
+        Draw(packet);
+    }
+}
+
+bool RenderingECSModule::SetViewArea(const ViewPacket& view, const VkExtent2D extent)
+{
+    const float width = static_cast<float>(extent.width);
+    const float height = static_cast<float>(extent.height);
+
+    const int32_t left = static_cast<int32_t>(std::lround(std::clamp(view.viewport.x, 0.0f, 1.0f) * width));
+    const int32_t top = static_cast<int32_t>(std::lround(std::clamp(view.viewport.y, 0.0f, 1.0f) * height));
+    const int32_t right = static_cast<int32_t>(std::lround(std::clamp(view.viewport.x + view.viewport.z, 0.0f, 1.0f) * width));
+    const int32_t bottom = static_cast<int32_t>(std::lround(std::clamp(view.viewport.y + view.viewport.w, 0.0f, 1.0f) * height));
+
+    viewArea.offset = {left, top};
+    viewArea.extent.width = static_cast<uint32_t>(std::max(right - left, 0));
+    viewArea.extent.height = static_cast<uint32_t>(std::max(bottom - top, 0));
+
+    return viewArea.extent.width != 0 && viewArea.extent.height != 0;
+}
+
+void RenderingECSModule::ExtractViews(flecs::world& ecs)
+{
+    RenderSnapshot& snapshot = renderThread.GetWriteSnapshot();
+
+    const MainCamera* const mainCamera = ecs.get<MainCamera>();
+    const flecs::entity mainCameraEntity = mainCamera != nullptr ? mainCamera->camera : flecs::entity::null();
+
+    // the main view always exists and always comes first, occlusion and the blended passes use it
+    ViewPacket mainView;
+    mainView.order = std::numeric_limits<int32_t>::min();
+    mainViewPerspective = false;
+    if (mainCameraEntity && !GetViewProjection(mainCameraEntity, mainView.viewProjection, mainView.position, mainViewPerspective))
+    {
+        throw std::runtime_error("MainCamera singleton is missing a PerspectiveCamera or OrthoCamera component.");
+    }
+    mainView.perspective = mainViewPerspective;
+    snapshot.views.push_back(mainView);
+
+    viewQuery.each
+    (
+        [&](flecs::entity entity, const RenderView& view)
+        {
+            ViewPacket packet;
+            if (!GetViewProjection(view.camera, packet.viewProjection, packet.position, packet.perspective))
+            {
+                return; // Not a camera, or not one yet
+            }
+
+            packet.viewport = glm::vec4{view.viewport.min.x, view.viewport.min.y, view.viewport.GetWidth(), view.viewport.GetLength()};
+            packet.order = view.order;
+
+            if (!view.IsOffscreen() && view.camera == mainCameraEntity)
+            {
+                // places the main view instead of drawing the same camera twice
+                snapshot.views[0].viewport = packet.viewport;
+                snapshot.views[0].order = packet.order;
+                return;
+            }
+
+            if (view.IsOffscreen())
+            {
+                const RenderTargetSlot* const slot = entity.get<RenderTargetSlot>();
+                if (slot == nullptr || slot->index == RenderTargetPool::INVALID_INDEX)
+                {
+                    return; // The target is created in the next PreDraw
+                }
+
+                packet.offscreen = true;
+                packet.target = renderTargets->Get(slot->index);
+            }
+
+            if (snapshot.views.size() >= MAX_VIEWS)
+            {
+                return; // Every view needs a bit in the visibility masks
+            }
+
+            snapshot.views.push_back(packet);
+        }
+    );
+
+    viewFrusta.clear();
+    for (const ViewPacket& view : snapshot.views)
+    {
+        viewFrusta.push_back(Frustum::FromViewProjection(view.viewProjection));
+    }
+}
+
+bool RenderingECSModule::GetViewProjection(const flecs::entity camera, glm::mat4& viewProjection, glm::vec3& position, bool& perspective)
+{
+    const Transform* const cameraTransform = camera ? camera.get<Transform>() : nullptr;
+    if (cameraTransform == nullptr)
+    {
+        return false;
+    }
+
+    position = cameraTransform->GetAbsPosition();
+
+    if (const PerspectiveCamera* const perspectiveCamera = camera.get<PerspectiveCamera>())
+    {
+        viewProjection = perspectiveCamera->GetProjectionMatrix() * cameraTransform->GetViewMatrix();
+        perspective = true;
+        return true;
+    }
+
+    if (const OrthoCamera* const orthoCamera = camera.get<OrthoCamera>())
+    {
+        viewProjection = orthoCamera->GetProjectionMatrix() * cameraTransform->GetViewMatrix();
+        perspective = false;
+        return true;
+    }
+
+    return false;
+}
+
+void RenderingECSModule::RasterizeOccluders(flecs::world& ecs)
+{
+    occlusionBuffer.Clear();
+    occludedCount = 0;
+    culledClusterCount = 0;
+
+    if (!occlusionCullingEnabled)
+    {
+        return;
+    }
+
+    const MainCamera* const mainCamera = ecs.get<MainCamera>();
+    if (mainCamera == nullptr || !mainCamera->camera)
+    {
+        return;
+    }
+
+    const flecs::entity cameraEntity = mainCamera->camera;
+    const Transform* const cameraTransform = cameraEntity.get<Transform>();
+    const PerspectiveCamera* const perspectiveCamera = cameraEntity.get<PerspectiveCamera>();
+    if (cameraTransform == nullptr || perspectiveCamera == nullptr)
+    {
+        return; // Only perspective views are culled
+    }
+
+    occluderQuery.iter
+    (
+        [&](flecs::iter& it, const Transform* transforms, const SimpleMesh* meshes)
+        {
+            for (auto i : it)
+            {
+                const glm::mat4 renderMatrix = transforms[i].GetRenderMatrix(cameraTransform, perspectiveCamera);
+                occlusionBuffer.AddOccluder(renderMatrix, meshes[i]._vertices, meshes[i]._indices);
+            }
+        }
+    );
+
+    occlusionBuffer.Rasterize(threadPool);
+}
+
+void RenderingECSModule::BakeStaticBatches(flecs::world& ecs)
+{
+    StaticBatcher batcher;
+    std::vector<Material> groupMaterials; // One group per distinct material, a batch is drawn with a single one
+    std::vector<flecs::entity> sources;
+
+    staticQuery.each
+    (
+        [&](flecs::entity entity, const Transform& transform, const SimpleMesh& mesh, const Material& material)
+        {
+            sources.push_back(entity);
+
+            if (mesh._vertices.empty() || mesh._indices.empty() || material.pipeline == nullptr || material.pipelineLayout == nullptr)
+            {
+                return; // Nothing that could be drawn
+            }
+
+            uint32_t group = 0;
+            while (group < groupMaterials.size())
+            {
+                const Material& other = groupMaterials[group];
+                if (other.pipeline == material.pipeline && other.pipelineLayout == material.pipelineLayout &&
+                    other.color == material.color && other.textureIndex == material.textureIndex)
+                {
+                    break;
+                }
+                ++group;
+            }
+            if (group == groupMaterials.size())
+            {
+                groupMaterials.push_back(material);
+            }
+
+            batcher.Add(group, transform.GetWorldMatrix(), mesh);
+        }
+    );
+
+    std::vector<StaticBatcher::Batch> batches = batcher.Build();
+    for (StaticBatcher::Batch& batch : batches)
+    {
+        flecs::entity batchEntity = ecs.entity();
+        batchEntity.set<Transform>({batchEntity});
+        batchEntity.set<SimpleMesh>(std::move(batch.mesh));
+        batchEntity.set<Material>(groupMaterials[batch.group]);
+    }
+
+    for (flecs::entity source : sources)
+    {
+        source.add<StaticBatched>();
+        source.remove<TransformSlot>();
+    }
+
+    std::cout << "[INFO] [Rendering] Baked " << sources.size() << " static entities into " << batches.size() << " batches." << std::endl;
+}
+
+void RenderingECSModule::ExtractParticleEmitters(flecs::world& ecs, const float deltaTime)
+{
+    RenderSnapshot& snapshot = renderThread.GetWriteSnapshot();
+    snapshot.particleDeltaTime = deltaTime;
+
+    const MainCamera* const mainCamera = ecs.get<MainCamera>();
+    if (mainCamera != nullptr && mainCamera->camera)
+    {
+        const Transform* const cameraTransform = mainCamera->camera.get<Transform>();
+        if (cameraTransform != nullptr)
+        {
+            ExtractCameraAxes(cameraTransform->GetViewMatrix(), snapshot);
+        }
+    }
+
+    // unpackUnorm4x8 reads red from the lowest byte
+    auto packColor = [](const Color32 color)
+    {
+        return uint32_t(color.r) | (uint32_t(color.g) << 8) | (uint32_t(color.b) << 16) | (uint32_t(color.a) << 24);
+    };
+
+    const uint32_t capacity = particleSystem.GetCapacity();
+    uint32_t spawnOffset = 0;
+    emitterQuery.each
+    (
+        [&](flecs::entity entity, const Transform& transform, ParticleEmitter& emitter)
+        {
+            if (!emitter.emitting || snapshot.particleEmitters.size() >= ParticleSystem::MAX_EMITTERS)
+            {
+                return;
+            }
+
+            // fractions of a particle carry over, so low rates still spawn at high frame rates
+            emitter.spawnAccumulator += emitter.rate * deltaTime;
+            const uint32_t wholeParticles = static_cast<uint32_t>(emitter.spawnAccumulator);
+            emitter.spawnAccumulator -= static_cast<float>(wholeParticles);
+
+            ParticleEmitterParams params;
+            params.position = glm::vec4{glm::vec3{transform.GetAbsPosition()}, 1.0f};
+            params.velocitySpread = glm::vec4{glm::vec3{emitter.velocity}, emitter.spread};
+            params.accelerationDrag = glm::vec4{glm::vec3{emitter.acceleration}, emitter.drag};
+            params.startColor = packColor(emitter.startColor);
+            params.endColor = packColor(emitter.endColor);
+            params.startSize = emitter.startSize;
+            params.endSize = emitter.endSize;
+            params.spawnOffset = spawnOffset;
+            params.spawnCount = std::min(wholeParticles, capacity - spawnOffset);
+            params.lifetime = emitter.lifetime;
+            params.seed = static_cast<uint32_t>(entity.id());
+
+            spawnOffset += params.spawnCount;
+            snapshot.particleEmitters.push_back(params);
+        }
+    );
+}
+
+void RenderingECSModule::DrawParticles(const RenderSnapshot& snapshot)
+{
+    vkCmdBindPipeline(_mainCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, particlePipeline);
+    currentPipeline = particlePipeline;
+
+    bindlessTable->Bind(_mainCommandBuffer, particlePipelineLayout);
+    frameRing.Bind(_mainCommandBuffer, particlePipelineLayout, frameUniformsOffset);
+
+    SetRenderArea();
+
+    ParticlePushConstants constants;
+    constants.cameraRight = snapshot.cameraRight;
+    constants.cameraUp = snapshot.cameraUp;
+    vkCmdPushConstants(_mainCommandBuffer, particlePipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(ParticlePushConstants), &constants);
+
+    //the instance count was written on the GPU by this frame's simulation step
+    particleSystem.RecordDraw(_mainCommandBuffer, particlePipelineLayout);
+
+    //the particles themselves only show up in the pipeline statistics
+    ++recordedStats.pipelineBindCount;
+    recordedStats.bufferBindCount += 3; // bindless table, frame ring, particles
+    recordedStats.pushConstantBytes += sizeof(ParticlePushConstants);
+    ++recordedStats.drawCount;
+}
+
+void RenderingECSModule::ExtractTilemaps(flecs::world& ecs)
+{
+    RenderSnapshot& snapshot = renderThread.GetWriteSnapshot();
+
+    const MainCamera* const mainCamera = ecs.get<MainCamera>();
+    const flecs::entity cameraEntity = mainCamera != nullptr ? mainCamera->camera : flecs::entity::null();
+    const Transform* const cameraTransform = cameraEntity ? cameraEntity.get<Transform>() : nullptr;
+    const PerspectiveCamera* const perspectiveCamera = cameraEntity ? cameraEntity.get<PerspectiveCamera>() : nullptr;
+    if (cameraTransform == nullptr || perspectiveCamera == nullptr)
+    {
+        return; // Only perspective views are drawn
+    }
+
+    const glm::mat4 viewProjection = perspectiveCamera->GetProjectionMatrix() * cameraTransform->GetViewMatrix();
+
+    tilemapQuery.each
+    (
+        [&](flecs::entity entity, const Tilemap& tilemap, Material& material, const TransformSlot& slot)
+        {
+            if (material.pipeline == nullptr || material.pipelineLayout == nullptr)
+            {
+                return; // Not enough data to render
+            }
+
+            material.materialIndex = AcquireMaterialIndex(material);
+
+            DrawPacket packet;
+            packet.transformIndex = slot.index;
+            packet.pipeline = *material.pipeline;
+            packet.pipelineLayout = *material.pipelineLayout;
+            packet.materialIndex = material.materialIndex;
+            packet.material = MaterialParams{material.color, material.textureIndex};
+
+            const glm::mat4 renderMatrix = viewProjection * transformBuffer->GetMatrix(slot.index);
+            const OcclusionBuffer* const occluders = occlusionCullingEnabled && !entity.has<Occluder>() ? &occlusionBuffer : nullptr;
+            tilemapRenderer.Extract(entity.id(), tilemap, renderMatrix, packet, occluders, snapshot.drawPackets, snapshot.retiredBuffers);
+        }
+    );
+
+    // Tilemaps that were not extracted, removed ones, give their meshes back
+    tilemapRenderer.EndFrame(snapshot.retiredBuffers);
+}
+
+void RenderingECSModule::ExtractText(flecs::world& ecs)
+{
+    RenderSnapshot& snapshot = renderThread.GetWriteSnapshot();
+
+    const MainCamera* const mainCamera = ecs.get<MainCamera>();
+    const flecs::entity cameraEntity = mainCamera != nullptr ? mainCamera->camera : flecs::entity::null();
+    const Transform* const cameraTransform = cameraEntity ? cameraEntity.get<Transform>() : nullptr;
+    if (cameraTransform == nullptr)
+    {
+        return; // Glyphs rasterized meanwhile are uploaded with the next extracted frame
+    }
+
+    glm::mat4 projection{1.0f};
+    if (const PerspectiveCamera* const perspectiveCamera = cameraEntity.get<PerspectiveCamera>())
+    {
+        projection = perspectiveCamera->GetProjectionMatrix();
+    }
+    else if (const OrthoCamera* const orthoCamera = cameraEntity.get<OrthoCamera>())
+    {
+        projection = orthoCamera->GetProjectionMatrix();
+    }
+    else
+    {
+        return;
+    }
+
+    const glm::mat4 view = cameraTransform->GetViewMatrix();
+    const glm::mat4 viewProjection = projection * view;
+    snapshot.textViewProjection = viewProjection;
+    ExtractCameraAxes(view, snapshot);
+
+    textQuery.each
+    (
+        [&](flecs::entity entity, const Transform& transform, TextLabel& label)
+        {
+            textRenderer.Extract(label, transform.GetWorldMatrix(), viewProjection, snapshot.textLabels);
+        }
+    );
+
+    textRenderer.EndFrame(snapshot.glyphInstances, snapshot.textBatches, snapshot.atlasUploads, snapshot.atlasUploadPixels);
+}
+
+void RenderingECSModule::ExtractSkinnedMeshes(flecs::world& ecs)
+{
+    RenderSnapshot& snapshot = renderThread.GetWriteSnapshot();
+
+    // Instances released this tick give their vertex buffers back whether or not anything is drawn
+    skinningSystem->EndFrame(snapshot.retiredBuffers);
+
+    const MainCamera* const mainCamera = ecs.get<MainCamera>();
+    const flecs::entity cameraEntity = mainCamera != nullptr ? mainCamera->camera : flecs::entity::null();
+    const Transform* const cameraTransform = cameraEntity ? cameraEntity.get<Transform>() : nullptr;
+    const PerspectiveCamera* const perspectiveCamera = cameraEntity ? cameraEntity.get<PerspectiveCamera>() : nullptr;
+    if (cameraTransform == nullptr || perspectiveCamera == nullptr)
+    {
+        return; // Only perspective views are drawn
+    }
+
+    const glm::mat4 viewProjection = perspectiveCamera->GetProjectionMatrix() * cameraTransform->GetViewMatrix();
+
+    /// @brief Pose of one visible instance, sampled once every instance is known.
+    struct SkinningJob {
+        const SkinnedMesh* mesh;
+        uint32_t clip;
+        float time;
+    };
+    std::vector<SkinningJob> jobs;
+    uint32_t boneCount = 0;
+
+    skinnedQuery.each
+    (
+        [&](flecs::entity entity, SkinnedMesh& mesh, const Animator& animator, Material& material, const TransformSlot& transformSlot, const SkinSlot& skinSlot)
+        {
+            if (mesh._vertices.empty() || material.pipeline == nullptr || material.pipelineLayout == nullptr)
+            {
+                return; // Not enough data to render
+            }
+
+            // the bounds cover every clip, so culling does not depend on the pose
+            const glm::mat4 renderMatrix = viewProjection * transformBuffer->GetMatrix(transformSlot.index);
+            if (!Frustum::FromViewProjection(renderMatrix).Intersects(mesh._bounds))
+            {
+                return;
+            }
+            if (occlusionCullingEnabled && !entity.has<Occluder>() && !occlusionBuffer.IsVisible(renderMatrix, mesh._bounds))
+            {
+                ++occludedCount;
+                return; // Hidden behind occluders
+            }
+
+            if (!mesh._vertexBuffer.IsInitialized())
+            {
+                UploadMesh(mesh);
+            }
+
+            if (!uploadQueue.IsComplete(mesh._uploadValue))
+            {
+                return; // Still streaming in
+            }
+
+            material.materialIndex = AcquireMaterialIndex(material);
+
+            const uint32_t vertexCount = static_cast<uint32_t>(mesh._vertices.size());
+
+            SkinningSystem::Dispatch dispatch;
+            dispatch.bindPose = mesh._vertexBuffer._buffer;
+            dispatch.output = skinningSystem->Reserve(skinSlot.index, vertexCount, snapshot.retiredBuffers);
+            dispatch.vertexCount = vertexCount;
+            dispatch.firstBone = boneCount;
+            snapshot.skinDispatches.push_back(dispatch);
+
+            jobs.push_back({&mesh, animator.clip, animator.time});
+            boneCount += mesh._skeleton.GetBoneCount();
+
+            // drawn like any full precision SimpleMesh, from the instance's posed copy
+            DrawPacket packet;
+            packet.transformIndex = transformSlot.index;
+            packet.vertexBuffer = dispatch.output;
+            packet.indexBuffer = mesh._indexBuffer._buffer;
+            packet.indexType = mesh._indexType;
+            packet.indexCount = static_cast<uint32_t>(mesh._indices.size());
+            packet.pipeline = *material.pipeline;
+            packet.pipelineLayout = *material.pipelineLayout;
+            packet.materialIndex = material.materialIndex;
+            packet.material = MaterialParams{material.color, material.textureIndex};
+            snapshot.drawPackets.push_back(packet);
+        }
+    );
+
+    // Each instance writes only its own range, so the clips are sampled without locking
+    snapshot.skinMatrices.resize(boneCount);
+    threadPool.ParallelFor
+    (
+        jobs.size(),
+        [&](size_t index)
+        {
+            const SkinningJob& job = jobs[index];
+            job.mesh->Evaluate(job.clip, job.time, snapshot.skinMatrices.data() + snapshot.skinDispatches[index].firstBone);
+        }
+    );
+}
+
+void RenderingECSModule::DrawTextLabels(const RenderSnapshot& snapshot)
+{
+    if (snapshot.textBatches.empty())
+    {
+        return;
+    }
+
+    vkCmdBindPipeline(_mainCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, textPipeline);
+    currentPipeline = textPipeline;
+
+    bindlessTable->Bind(_mainCommandBuffer, textPipelineLayout);
+
+    SetRenderArea();
+
+    TextPushConstants constants;
+    constants.viewProjection = snapshot.textViewProjection;
+    constants.cameraRight = snapshot.cameraRight;
+    constants.cameraUp = snapshot.cameraUp;
+
+    //one instanced draw per font, the labels and glyphs are written into the renderer's buffers first
+    textRenderer.RecordDraw(_mainCommandBuffer, textPipelineLayout, frameDescriptorAllocator,
+        snapshot.textLabels, snapshot.glyphInstances, snapshot.textBatches, constants);
+
+    const uint32_t batchCount = static_cast<uint32_t>(snapshot.textBatches.size());
+    const uint32_t glyphCount = static_cast<uint32_t>(snapshot.glyphInstances.size());
+    ++recordedStats.pipelineBindCount;
+    recordedStats.bufferBindCount += 2; // bindless table, labels and glyphs
+    recordedStats.pushConstantBytes += batchCount * static_cast<uint32_t>(sizeof(TextPushConstants));
+    recordedStats.drawCount += batchCount;
+    recordedStats.instanceCount += glyphCount;
+    recordedStats.triangleCount += glyphCount * 2;
 }
 
-void RenderingECSModule::PreDrawStep(float deltaTime)
+void RenderingECSModule::UploadDebugLines(const std::vector<DebugVertex>& vertices)
 {
-    // Start the Dear ImGui frame
-    ImGui_ImplVulkan_NewFrame();
-    ImGui_ImplSDL2_NewFrame();
-    ImGui::NewFrame();
+    const VkDeviceSize bytes = vertices.size() * sizeof(DebugVertex);
+    if (bytes == 0)
+    {
+        return;
+    }
 
-    //wait until the GPU has finished rendering the last frame. Timeout of 1 second
-    VK_CHECK(vkWaitForFences(_device, 1, &_renderFence, true, 1000000000));
-    VK_CHECK(vkResetFences(_device, 1, &_renderFence));
+    if (bytes > debugLineCapacity)
+    {
+        if (debugLineBuffer.IsInitialized())
+        {
+            vmaDestroyBuffer(_allocator, debugLineBuffer._buffer, debugLineBuffer._allocation);
+            debugLineBuffer = AllocatedBuffer{};
+            mappedDebugLines = nullptr;
+            debugLineCapacity = 0;
+        }
 
-    //request image from the swapchain, one second timeout
-    VK_CHECK(vkAcquireNextImageKHR(_device, _swapchain, 1000000000, _presentSemaphore, nullptr, &swapchainImageIndex));
+        // doubles, like the dynamic batches, so a busy frame only reallocates a handful of times
+        VkDeviceSize newCapacity = 64 * 1024;
+        while (newCapacity < bytes)
+        {
+            newCapacity *= 2;
+        }
 
-    //now that we are sure that the commands finished executing, we can safely reset the command buffer to begin recording again.
-    VK_CHECK(vkResetCommandBuffer(_mainCommandBuffer, 0));
+        VkBufferCreateInfo bufferInfo = {};
+        bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferInfo.size = newCapacity;
+        bufferInfo.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
 
-    //begin the command buffer recording. We will use this command buffer exactly once, so we want to let Vulkan know that
-    VkCommandBufferBeginInfo cmdBeginInfo = {};
-    cmdBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-    cmdBeginInfo.pNext = nullptr;
+        VmaAllocationCreateInfo allocInfo = {};
+        allocInfo.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
+        allocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+        allocInfo.requiredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
 
-    cmdBeginInfo.pInheritanceInfo = nullptr;
-    cmdBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        VmaAllocationInfo allocationInfo = {};
+        if (vmaCreateBuffer(_allocator, &bufferInfo, &allocInfo, &debugLineBuffer._buffer, &debugLineBuffer._allocation, &allocationInfo) != VK_SUCCESS)
+        {
+            debugLineBuffer = AllocatedBuffer{};
+            throw std::runtime_error("Failed to create the debug line buffer.");
+        }
+        mappedDebugLines = allocationInfo.pMappedData;
+        debugLineCapacity = newCapacity;
+    }
 
-    VK_CHECK(vkBeginCommandBuffer(_mainCommandBuffer, &cmdBeginInfo));
+    memcpy(mappedDebugLines, vertices.data(), static_cast<size_t>(bytes));
+}
 
-    VkClearValue clearValue = {};
-    // float flash = abs(sin(_frameNumber / 3840.f));
-    // clearValue.color = { { 0.0f, 0.0f, flash, 1.0f } };
-    Color32 color = Color32::FromHex("#181818");
-    clearValue.color = { { color.r/255.0f, color.g/255.0f, color.b/255.0f, color.a/255.0f } };
+void RenderingECSModule::DrawDebugLines(const RenderSnapshot& snapshot)
+{
+    if (snapshot.debugVertices.empty())
+    {
+        return;
+    }
 
-    //clear depth at 1
-	VkClearValue depthClear;
-	depthClear.depthStencil.depth = 1.f;
+    vkCmdBindPipeline(_mainCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, debugLinePipeline);
+    currentPipeline = debugLinePipeline;
 
-    VkClearValue clearValues[] = { clearValue, depthClear };
+    frameRing.Bind(_mainCommandBuffer, debugLinePipelineLayout, frameUniformsOffset);
 
-    //start the main renderpass.
-    //We will use the clear color from above, and the framebuffer of the index the swapchain gave us
-    VkRenderPassBeginInfo rpInfo = {};
-    rpInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-    rpInfo.pNext = nullptr;
+    SetRenderArea();
 
-    rpInfo.renderPass = _renderPass;
-    rpInfo.renderArea.offset.x = 0;
-    rpInfo.renderArea.offset.y = 0;
-    rpInfo.renderArea.extent = windowExtent;
-    rpInfo.framebuffer = _framebuffers[swapchainImageIndex];
+    const VkDeviceSize offset = 0;
+    vkCmdBindVertexBuffers(_mainCommandBuffer, 0, 1, &debugLineBuffer._buffer, &offset);
 
-    //connect clear values
-    rpInfo.clearValueCount = 2;
-    rpInfo.pClearValues = &clearValues[0];
+    //lines from every thread of the tick, drawn at once
+    const uint32_t vertexCount = static_cast<uint32_t>(snapshot.debugVertices.size());
+    vkCmdDraw(_mainCommandBuffer, vertexCount, 1, 0, 0);
 
-    vkCmdBeginRenderPass(_mainCommandBuffer, &rpInfo, VK_SUBPASS_CONTENTS_INLINE);
+    ++recordedStats.pipelineBindCount;
+    recordedStats.bufferBindCount += 2; // frame ring, debug lines
+    ++recordedStats.drawCount;
 }
 
-void RenderingECSModule::PostDrawStep(float deltaTime)
+void RenderingECSModule::AddImpostor(const uint32_t atlasIndex, const glm::mat4& world, const glm::vec3& cameraPosition, const glm::vec4& color, const float fade)
 {
-    // Rendering imgui
-    ImGui::Render();
-    ImGui_ImplVulkan_RenderDrawData(ImGui::GetDrawData(), _mainCommandBuffer);
+    const ImpostorAtlas& atlas = impostorAtlases[atlasIndex];
 
-    //finalize the render pass
-    vkCmdEndRenderPass(_mainCommandBuffer);
-    //finalize the command buffer (we can no longer add commands, but it can now be executed)
-    VK_CHECK(vkEndCommandBuffer(_mainCommandBuffer));
+    // frames were baked around the mesh's own Y axis, so the camera's yaw is measured in local space
+    const glm::vec3 localCamera = glm::vec3{glm::inverse(world) * glm::vec4{cameraPosition, 1.0f}} - atlas.center;
+    float yaw = std::atan2(localCamera.x, localCamera.z);
+    if (yaw < 0.0f)
+    {
+        yaw += glm::two_pi<float>();
+    }
+    const float frame = yaw / glm::two_pi<float>() * static_cast<float>(atlas.frameCount);
+    const float firstFrame = std::floor(frame);
 
+    const float scale = std::max({glm::length(glm::vec3{world[0]}), glm::length(glm::vec3{world[1]}), glm::length(glm::vec3{world[2]})});
 
-    //prepare the submission to the queue.
-    //we want to wait on the _presentSemaphore, as that semaphore is signaled when the swapchain is ready
-    //we will signal the _renderSemaphore, to signal that rendering has finished
+    ImpostorInstance instance;
+    instance.center = glm::vec4{glm::vec3{world * glm::vec4{atlas.center, 1.0f}}, atlas.radius * scale};
+    instance.color = color;
+    instance.frameA = static_cast<uint32_t>(firstFrame) % atlas.frameCount;
+    instance.frameB = (instance.frameA + 1) % atlas.frameCount;
+    instance.frameBlend = frame - firstFrame;
+    instance.fade = fade;
 
-    VkSubmitInfo submit = {};
-    submit.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    submit.pNext = nullptr;
+    if (pendingImpostors.size() < impostorAtlases.size())
+    {
+        pendingImpostors.resize(impostorAtlases.size());
+    }
+    pendingImpostors[atlasIndex].push_back(instance);
+}
 
-    VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+void RenderingECSModule::DrawImpostors(const RenderSnapshot& snapshot)
+{
+    if (snapshot.impostorBatches.empty())
+    {
+        return;
+    }
 
-    submit.pWaitDstStageMask = &waitStage;
+    vkCmdBindPipeline(_mainCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, impostorPipeline);
+    currentPipeline = impostorPipeline;
 
-    submit.waitSemaphoreCount = 1;
-    submit.pWaitSemaphores = &_presentSemaphore;
+    bindlessTable->Bind(_mainCommandBuffer, impostorPipelineLayout);
 
-    submit.signalSemaphoreCount = 1;
-    submit.pSignalSemaphores = &_renderSemaphore;
+    SetRenderArea();
 
-    submit.commandBufferCount = 1;
-    submit.pCommandBuffers = &_mainCommandBuffer;
+    ImpostorPushConstants constants;
+    constants.cameraPosition = glm::vec4{snapshot.views[0].position, 1.0f};
 
-    //submit command buffer to the queue and execute it.
-    // _renderFence will now block until the graphic commands finish execution
-    VK_CHECK(vkQueueSubmit(_graphicsQueue, 1, &submit, _renderFence));
+    //instances are copied into the frame ring, as many per draw as one storage range shows
+    const uint32_t instancesPerDraw = static_cast<uint32_t>(DynamicRingBuffer::STORAGE_RANGE / sizeof(ImpostorInstance));
+    uint32_t batchCount = 0;
+    uint32_t drawCount = 0;
+    uint32_t drawnCount = 0;
 
+    for (const ImpostorBatch& batch : snapshot.impostorBatches)
+    {
+        // the ring is shared by the whole frame, so what does not fit is dropped instead of taking the frame down
+        if (!frameRing.HasRoom(DynamicRingBuffer::Usage::Storage))
+        {
+            break;
+        }
 
-    // this will put the image we just rendered into the visible window.
-    // we want to wait on the _renderSemaphore for that,
-    // as it's necessary that drawing commands have finished before the image is displayed to the user
-    VkPresentInfoKHR presentInfo = {};
-    presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
-    presentInfo.pNext = nullptr;
+        constants.colorTexture = batch.colorTexture;
+        constants.normalDepthTexture = batch.normalDepthTexture;
+        constants.columns = batch.columns;
+        constants.rows = batch.rows;
+        vkCmdPushConstants(_mainCommandBuffer, impostorPipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(ImpostorPushConstants), &constants);
+        ++batchCount;
 
-    presentInfo.pSwapchains = &_swapchain;
-    presentInfo.swapchainCount = 1;
+        for (uint32_t first = 0; first < batch.instanceCount; first += instancesPerDraw)
+        {
+            if (!frameRing.HasRoom(DynamicRingBuffer::Usage::Storage))
+            {
+                break;
+            }
 
-    presentInfo.pWaitSemaphores = &_renderSemaphore;
-    presentInfo.waitSemaphoreCount = 1;
+            const uint32_t count = std::min(instancesPerDraw, batch.instanceCount - first);
+            const DynamicRingBuffer::Allocation instances = frameRing.Allocate(count * sizeof(ImpostorInstance), DynamicRingBuffer::Usage::Storage);
+            std::memcpy(instances.data, snapshot.impostorInstances.data() + batch.firstInstance + first, count * sizeof(ImpostorInstance));
 
-    presentInfo.pImageIndices = &swapchainImageIndex;
+            frameRing.Bind(_mainCommandBuffer, impostorPipelineLayout, frameUniformsOffset, instances.offset);
+            vkCmdDraw(_mainCommandBuffer, 6, count, 0, 0);
+            ++drawCount;
+            drawnCount += count;
+        }
+    }
 
-    VkResult result = vkQueuePresentKHR(_graphicsQueue, &presentInfo);
-    if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR)
+    const uint32_t impostorCount = static_cast<uint32_t>(snapshot.impostorInstances.size());
+    if (drawnCount < impostorCount && !warnedImpostorsDropped)
     {
+        std::cout << "[WARNING] [Rendering] The frame ring is full, " << impostorCount - drawnCount << " of " << impostorCount
+            << " impostors were not drawn." << std::endl;
+        warnedImpostorsDropped = true;
     }
-    else
+
+    ++recordedStats.pipelineBindCount;
+    recordedStats.bufferBindCount += 1 + drawCount; // bindless table, frame ring per draw
+    recordedStats.pushConstantBytes += batchCount * static_cast<uint32_t>(sizeof(ImpostorPushConstants));
+    recordedStats.drawCount += drawCount;
+    recordedStats.instanceCount += drawnCount;
+    recordedStats.triangleCount += drawnCount * 2;
+}
+
+void RenderingECSModule::DestroyBuffers(std::vector<AllocatedBuffer>& buffers)
+{
+    for (const AllocatedBuffer& buffer : buffers)
     {
-        VK_CHECK(result);
+        vmaDestroyBuffer(_allocator, buffer._buffer, buffer._allocation);
     }
+    buffers.clear();
+}
 
-    //increase the number of frames drawn
-    _frameNumber++;
+void RenderingECSModule::UpdateRenderScale()
+{
+    if (!timestampsWritten)
+    {
+        return;
+    }
+    timestampsWritten = false;
+
+    uint64_t timestamps[2] = {0, 0};
+    const VkResult result = vkGetQueryPoolResults
+    (
+        _device, timestampQueryPool,
+        0, 2,
+        sizeof(timestamps), timestamps, sizeof(uint64_t),
+        VK_QUERY_RESULT_64_BIT
+    );
+    if (result != VK_SUCCESS || timestamps[1] <= timestamps[0])
+    {
+        return;
+    }
+
+    if (dynamicResolution.enabled)
+    {
+        const double nanoseconds = static_cast<double>(timestamps[1] - timestamps[0]) * capabilities.timestampPeriod;
+        dynamicResolution.Update(static_cast<float>(nanoseconds / 1000000.0));
+    }
+}
+
+void RenderingECSModule::ReadPipelineStatistics()
+{
+    if (!pipelineStatisticsWritten)
+    {
+        return;
+    }
+    pipelineStatisticsWritten = false;
+
+    //one value per enabled statistic, in bit order, for the main view then the offscreen views
+    uint64_t statistics[2][3] = {};
+    const VkResult result = vkGetQueryPoolResults
+    (
+        _device, pipelineStatisticsQueryPool,
+        0, 2,
+        sizeof(statistics), statistics, sizeof(statistics[0]),
+        VK_QUERY_RESULT_64_BIT
+    );
+    if (result != VK_SUCCESS)
+    {
+        return;
+    }
+
+    recordedStats.pipelineStatisticsValid = true;
+    recordedStats.vertexInvocations = statistics[0][0] + statistics[1][0];
+    recordedStats.clippingInvocations = statistics[0][1] + statistics[1][1];
+    recordedStats.fragmentInvocations = statistics[0][2] + statistics[1][2];
 }
 
-void RenderingECSModule::BindPipeline(const Material& material)
+void RenderingECSModule::BindPipeline(const VkPipeline pipeline, const VkPipelineLayout pipelineLayout)
 {
-    vkCmdBindPipeline(_mainCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, *material.pipeline);
+    vkCmdBindPipeline(_mainCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+    currentPipeline = pipeline;
+
+    bindlessTable->Bind(_mainCommandBuffer, pipelineLayout);
+    transformBuffer->Bind(_mainCommandBuffer, pipelineLayout);
+    frameRing.Bind(_mainCommandBuffer, pipelineLayout, frameUniformsOffset);
+
+    SetRenderArea();
+
+    ++recordedStats.pipelineBindCount;
+    recordedStats.bufferBindCount += 3; // bindless table, transform buffer, frame ring
+}
 
+void RenderingECSModule::SetRenderArea()
+{
     VkViewport viewport = {};
-    viewport.x = 0.0f;
-    viewport.y = 0.0f;
-    viewport.width = static_cast<float>(windowExtent.width);
-    viewport.height = static_cast<float>(windowExtent.height);
+    viewport.x = static_cast<float>(viewArea.offset.x);
+    viewport.y = static_cast<float>(viewArea.offset.y);
+    viewport.width = static_cast<float>(viewArea.extent.width);
+    viewport.height = static_cast<float>(viewArea.extent.height);
     viewport.minDepth = 0.0f;
     viewport.maxDepth = 1.0f;
 
-    VkRect2D scissor = {};
-    scissor.offset = {0, 0};
-    scissor.extent = {static_cast<uint32_t>(windowExtent.width), static_cast<uint32_t>(windowExtent.height)};
-
     vkCmdSetViewport(_mainCommandBuffer, 0, 1, &viewport);
-    vkCmdSetScissor(_mainCommandBuffer, 0, 1, &scissor);
+    vkCmdSetScissor(_mainCommandBuffer, 0, 1, &viewArea);
+}
+
+uint32_t RenderingECSModule::AcquireMaterialIndex(const Material& material)
+{
+    // shared with every material of the same values, so entities do not each take a record
+    return bindlessTable->AcquireMaterial(material.materialIndex, *material.pipeline, MaterialParams{material.color, material.textureIndex});
+}
+
+void RenderingECSModule::ExtractCameraAxes(const glm::mat4& view, RenderSnapshot& snapshot)
+{
+    // the rows of the view matrix are the camera axes in world space
+    snapshot.cameraRight = glm::vec4{view[0][0], view[1][0], view[2][0], 0.0f};
+    snapshot.cameraUp = glm::vec4{view[0][1], view[1][1], view[2][1], 0.0f};
 }
 
-void RenderingECSModule::Draw
+DrawPacket RenderingECSModule::ExtractDrawPacket
 (
-    const float deltaTime,
-    const glm::mat4 renderMatrix,
+    const uint32_t transformIndex,
     const SimpleMesh& mesh,
-    const Material& material
-)
+    const Material& material,
+    const VkPipeline pipeline
+) const
+{
+    DrawPacket packet;
+
+    packet.transformIndex = transformIndex;
+
+    //quantized positions arrive in [0, 1], scale them back out to the mesh bounds
+    if (mesh._vertexFormat == VertexFormat::Quantized16)
+    {
+        packet.positionOffset = glm::vec4{mesh._bounds.min, 0.0f};
+        packet.positionScale = glm::vec4{mesh._bounds.max - mesh._bounds.min, 1.0f};
+    }
+
+    packet.vertexBuffer = mesh._vertexBuffer._buffer;
+    packet.indexBuffer = mesh._indexBuffer._buffer;
+    packet.indexType = mesh._indexType;
+    packet.indexCount = static_cast<uint32_t>(mesh._indices.size());
+    packet.pipeline = pipeline;
+    packet.pipelineLayout = *material.pipelineLayout;
+    packet.materialIndex = material.materialIndex;
+    packet.material = MaterialParams{material.color, material.textureIndex};
+
+    return packet;
+}
+
+void RenderingECSModule::Draw(const DrawPacket& packet)
 {
+    //dynamic batches live in the buffers of the frame, which may have been regrown since the packet was made
+    const VkBuffer vertexBuffer = packet.dynamicBatch ? dynamicBatcher.GetVertexBuffer() : packet.vertexBuffer;
+    const VkBuffer indexBuffer = packet.dynamicBatch ? dynamicBatcher.GetIndexBuffer() : packet.indexBuffer;
+
     //bind the mesh vertex buffer with offset 0
     VkDeviceSize offset = 0;
-    vkCmdBindVertexBuffers(_mainCommandBuffer, 0, 1, &mesh._vertexBuffer._buffer, &offset);
+    vkCmdBindVertexBuffers(_mainCommandBuffer, 0, 1, &vertexBuffer, &offset);
 
-    vkCmdBindIndexBuffer(_mainCommandBuffer, mesh._indexBuffer._buffer, 0, VK_INDEX_TYPE_UINT32);
+    vkCmdBindIndexBuffer(_mainCommandBuffer, indexBuffer, 0, packet.indexType);
 
     MeshPushConstants constants = {};
-    
-    constants.color = material.color;
-    constants.renderMatrix = renderMatrix;
+    constants.positionOffset = packet.positionOffset;
+    constants.positionScale = packet.positionScale;
+    constants.materialIndex = packet.materialIndex;
+    constants.transformIndex = packet.transformIndex;
+    constants.fade = packet.fade;
 
-    //upload the matrix to the GPU via push constants
-    vkCmdPushConstants(_mainCommandBuffer, *material.pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(MeshPushConstants), &constants);
+    //the world matrix and the camera are already on the GPU, push only the slots to read them from
+    vkCmdPushConstants(_mainCommandBuffer, packet.pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(MeshPushConstants), &constants);
 
     //we can now draw the mesh
-    vkCmdDrawIndexed(_mainCommandBuffer, (uint32_t)mesh._indices.size(), 1, 0, 0, 0);
+    if (packet.meshletCount > 0)
+    {
+        //one command per meshlet, the culling pass left the hidden ones without instances
+        const VkDeviceSize commandOffset = sizeof(VkDrawIndexedIndirectCommand) * static_cast<VkDeviceSize>(packet.firstCommand);
+        vkCmdDrawIndexedIndirect(_mainCommandBuffer, meshletCuller.GetCommandBuffer(), commandOffset, packet.meshletCount, sizeof(VkDrawIndexedIndirectCommand));
+    }
+    else
+    {
+        vkCmdDrawIndexed(_mainCommandBuffer, packet.indexCount, 1, packet.firstIndex, packet.vertexOffset, 0);
+    }
+
+    recordedStats.bufferBindCount += 2; // vertex and index buffer
+    recordedStats.pushConstantBytes += sizeof(MeshPushConstants);
+
+    //how many meshlets survive is only known to the GPU, so only the commands are counted
+    if (packet.meshletCount > 0)
+    {
+        recordedStats.drawCount += packet.meshletCount;
+        return;
+    }
+
+    ++recordedStats.drawCount;
+    ++recordedStats.instanceCount;
+    recordedStats.triangleCount += packet.indexCount / 3;
 }
 
 template<typename TMesh>
@@ -1218,7 +4458,86 @@ void RenderingECSModule::UploadMesh(TMesh& mesh)
         throw std::exception("Anything other than SimpleMesh is the only thing implemented at the moment.");
     }
 
-    const size_t verticesBufferSize = mesh._vertices.size() * sizeof(SimpleMesh);
+    // Encode the vertices in the layout chosen at import
+    std::vector<uint8_t> vertexBytes;
+    if (mesh._vertexFormat == VertexFormat::Quantized16)
+    {
+        std::vector<QuantizedSimpleVertex> quantizedVertices;
+        quantizedVertices.reserve(mesh._vertices.size());
+        for (const SimpleVertex& vertex : mesh._vertices)
+        {
+            quantizedVertices.emplace_back(vertex.position, mesh._bounds);
+        }
+        vertexBytes.resize(quantizedVertices.size() * sizeof(QuantizedSimpleVertex));
+        memcpy(vertexBytes.data(), quantizedVertices.data(), vertexBytes.size());
+    }
+    else
+    {
+        vertexBytes.resize(mesh._vertices.size() * sizeof(SimpleVertex));
+        memcpy(vertexBytes.data(), mesh._vertices.data(), vertexBytes.size());
+    }
+
+    mesh._uploadValue = UploadMeshBuffers
+    (
+        vertexBytes, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+        mesh._indices, mesh._vertices.size(),
+        mesh._vertexBuffer, mesh._indexBuffer, mesh._indexType
+    );
+
+    // Uploaded even while clusters are culled on the CPU, so the GPU path can be toggled at any time
+    if (!mesh._meshlets.empty())
+    {
+        std::vector<uint8_t> meshletBytes(mesh._meshlets.size() * sizeof(Meshlet));
+        memcpy(meshletBytes.data(), mesh._meshlets.data(), meshletBytes.size());
+        mesh._uploadValue = std::max(mesh._uploadValue, UploadStorageBuffer(meshletBytes, mesh._meshletBuffer));
+    }
+}
+
+void RenderingECSModule::UploadMesh(SkinnedMesh& mesh)
+{
+    // The bind pose is only read by the skinning pass, each instance draws its own posed copy
+    std::vector<uint8_t> vertexBytes(mesh._vertices.size() * sizeof(SkinnedVertex));
+    memcpy(vertexBytes.data(), mesh._vertices.data(), vertexBytes.size());
+
+    mesh._uploadValue = UploadMeshBuffers
+    (
+        vertexBytes, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+        mesh._indices, mesh._vertices.size(),
+        mesh._vertexBuffer, mesh._indexBuffer, mesh._indexType
+    );
+}
+
+uint64_t RenderingECSModule::UploadMeshBuffers
+(
+    const std::vector<uint8_t>& vertexBytes,
+    const VkBufferUsageFlags vertexUsage,
+    const std::vector<uint32_t>& indices,
+    const size_t vertexCount,
+    AllocatedBuffer& vertexBufferOut,
+    AllocatedBuffer& indexBufferOut,
+    VkIndexType& indexType
+)
+{
+    // 16-bit indices whenever every vertex can be addressed with them
+    std::vector<uint8_t> indexBytes;
+    if (vertexCount <= std::numeric_limits<uint16_t>::max())
+    {
+        indexType = VK_INDEX_TYPE_UINT16;
+        indexBytes.resize(indices.size() * sizeof(uint16_t));
+        for (size_t i = 0; i < indices.size(); ++i)
+        {
+            const uint16_t index = static_cast<uint16_t>(indices[i]);
+            memcpy(indexBytes.data() + i * sizeof(uint16_t), &index, sizeof(uint16_t));
+        }
+    }
+    else
+    {
+        indexType = VK_INDEX_TYPE_UINT32;
+        indexBytes.resize(indices.size() * sizeof(uint32_t));
+        memcpy(indexBytes.data(), indices.data(), indexBytes.size());
+    }
+
+    const size_t verticesBufferSize = vertexBytes.size();
     //allocate vertex buffer
     VkBufferCreateInfo stagingVerticesBufferInfo = {};
     stagingVerticesBufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
@@ -1241,7 +4560,7 @@ void RenderingECSModule::UploadMesh(TMesh& mesh)
         nullptr));
     
     // Allocate index buffer
-    const size_t indicesBufferSize = mesh._indices.size() * sizeof(uint32_t); // Size of index buffer in bytes
+    const size_t indicesBufferSize = indexBytes.size(); // Size of index buffer in bytes
     VkBufferCreateInfo stagingIndicesBufferInfo = {};
     stagingIndicesBufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
     stagingIndicesBufferInfo.size =  indicesBufferSize;
@@ -1261,13 +4580,13 @@ void RenderingECSModule::UploadMesh(TMesh& mesh)
     //copy vertex data
     void* vertexData;
     vmaMapMemory(_allocator, stagingVerticesBuffer._allocation, &vertexData);
-    memcpy(vertexData, mesh._vertices.data(), mesh._vertices.size() * sizeof(SimpleVertex));
+    memcpy(vertexData, vertexBytes.data(), vertexBytes.size());
     vmaUnmapMemory(_allocator, stagingVerticesBuffer._allocation);
 
     // Copy index data
     void* indexData;
     vmaMapMemory(_allocator, stagingIndicesBuffer._allocation, &indexData);
-    memcpy(indexData, mesh._indices.data(), mesh._indices.size() * sizeof(uint32_t));
+    memcpy(indexData, indexBytes.data(), indexBytes.size());
     vmaUnmapMemory(_allocator, stagingIndicesBuffer._allocation);
 
 
@@ -1281,15 +4600,15 @@ void RenderingECSModule::UploadMesh(TMesh& mesh)
     //this is the total size, in bytes, of the buffer we are allocating
     verticesBufferInfo.size = verticesBufferSize;
     //this buffer is going to be used as a Vertex Buffer
-    verticesBufferInfo.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    verticesBufferInfo.usage = vertexUsage | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
 
     //let the VMA library know that this data should be GPU native
     vmaallocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
 
     //allocate the buffer
     VK_CHECK(vmaCreateBuffer(_allocator, &verticesBufferInfo, &vmaallocInfo,
-        &mesh._vertexBuffer._buffer,
-        &mesh._vertexBuffer._allocation,
+        &vertexBufferOut._buffer,
+        &vertexBufferOut._allocation,
         nullptr));
     
     VkBufferCreateInfo indicesBufferInfo = {};
@@ -1305,11 +4624,17 @@ void RenderingECSModule::UploadMesh(TMesh& mesh)
 
     //allocate the buffer
     VK_CHECK(vmaCreateBuffer(_allocator, &indicesBufferInfo, &vmaallocInfo,
-        &mesh._indexBuffer._buffer,
-        &mesh._indexBuffer._allocation,
+        &indexBufferOut._buffer,
+        &indexBufferOut._allocation,
         nullptr));
     
-    ImmediateSubmit
+    const VkBuffer vertexBuffer = vertexBufferOut._buffer;
+    const VkBuffer indexBuffer = indexBufferOut._buffer;
+    const VmaAllocation vertexAllocation = vertexBufferOut._allocation;
+    const VmaAllocation indexAllocation = indexBufferOut._allocation;
+
+    // Both copies go in one submission, the Draw phase skips the mesh until it has finished
+    const uint64_t uploadValue = uploadQueue.Submit
     (
         [=](VkCommandBuffer cmd)
         {
@@ -1317,37 +4642,100 @@ void RenderingECSModule::UploadMesh(TMesh& mesh)
             copy.dstOffset = 0;
             copy.srcOffset = 0;
             copy.size = verticesBufferSize;
-            vkCmdCopyBuffer(cmd, stagingVerticesBuffer._buffer, mesh._vertexBuffer._buffer, 1, &copy);
+            vkCmdCopyBuffer(cmd, stagingVerticesBuffer._buffer, vertexBuffer, 1, &copy);
+
+            copy.size = indicesBufferSize;
+            vkCmdCopyBuffer(cmd, stagingIndicesBuffer._buffer, indexBuffer, 1, &copy);
+        },
+        {vertexBuffer, indexBuffer},
+        [=]()
+        {
+            vmaDestroyBuffer(_allocator, stagingVerticesBuffer._buffer, stagingVerticesBuffer._allocation);
+            vmaDestroyBuffer(_allocator, stagingIndicesBuffer._buffer, stagingIndicesBuffer._allocation);
         }
     );
 
-    ImmediateSubmit
+    // ------------------------------------------------------
+    // --- CPU & GPU Buffers Cleanup ------------------------
+    // ------------------------------------------------------
+
+    _mainDeletionQueue.PushDeletor
+    (
+        [=]()
+        {
+            vmaDestroyBuffer(_allocator, vertexBuffer, vertexAllocation);
+            vmaDestroyBuffer(_allocator, indexBuffer, indexAllocation);
+        }
+    );
+
+    return uploadValue;
+}
+
+uint64_t RenderingECSModule::UploadStorageBuffer(const std::vector<uint8_t>& bytes, AllocatedBuffer& bufferOut)
+{
+    const size_t bufferSize = bytes.size();
+
+    VkBufferCreateInfo stagingBufferInfo = {};
+    stagingBufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    stagingBufferInfo.size = bufferSize;
+    stagingBufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+
+    VmaAllocationCreateInfo stagingAllocInfo = {};
+    stagingAllocInfo.usage = VMA_MEMORY_USAGE_CPU_ONLY;
+
+    AllocatedBuffer stagingBuffer;
+    VK_CHECK(vmaCreateBuffer(_allocator, &stagingBufferInfo, &stagingAllocInfo,
+        &stagingBuffer._buffer,
+        &stagingBuffer._allocation,
+        nullptr));
+
+    void* data;
+    vmaMapMemory(_allocator, stagingBuffer._allocation, &data);
+    memcpy(data, bytes.data(), bufferSize);
+    vmaUnmapMemory(_allocator, stagingBuffer._allocation);
+
+    VkBufferCreateInfo bufferInfo = {};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = bufferSize;
+    bufferInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+
+    VmaAllocationCreateInfo allocInfo = {};
+    allocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+
+    VK_CHECK(vmaCreateBuffer(_allocator, &bufferInfo, &allocInfo,
+        &bufferOut._buffer,
+        &bufferOut._allocation,
+        nullptr));
+
+    const VkBuffer buffer = bufferOut._buffer;
+    const VmaAllocation allocation = bufferOut._allocation;
+
+    const uint64_t uploadValue = uploadQueue.Submit
     (
         [=](VkCommandBuffer cmd)
         {
             VkBufferCopy copy;
             copy.dstOffset = 0;
             copy.srcOffset = 0;
-            copy.size = indicesBufferSize;
-            vkCmdCopyBuffer(cmd, stagingIndicesBuffer._buffer, mesh._indexBuffer._buffer, 1, &copy);
+            copy.size = bufferSize;
+            vkCmdCopyBuffer(cmd, stagingBuffer._buffer, buffer, 1, &copy);
+        },
+        {buffer},
+        [=]()
+        {
+            vmaDestroyBuffer(_allocator, stagingBuffer._buffer, stagingBuffer._allocation);
         }
     );
 
-    // ------------------------------------------------------
-    // --- CPU & GPU Buffers Cleanup ------------------------
-    // ------------------------------------------------------
-
     _mainDeletionQueue.PushDeletor
     (
         [=]()
         {
-            vmaDestroyBuffer(_allocator, mesh._vertexBuffer._buffer, mesh._vertexBuffer._allocation);
-            vmaDestroyBuffer(_allocator, mesh._indexBuffer._buffer, mesh._indexBuffer._allocation);
+            vmaDestroyBuffer(_allocator, buffer, allocation);
         }
     );
 
-    vmaDestroyBuffer(_allocator, stagingVerticesBuffer._buffer, stagingVerticesBuffer._allocation);
-    vmaDestroyBuffer(_allocator, stagingIndicesBuffer._buffer, stagingIndicesBuffer._allocation);
+    return uploadValue;
 }
 
 void RenderingECSModule::ImmediateSubmit(std::function<void(VkCommandBuffer cmd)>&& function)
@@ -1369,7 +4757,10 @@ void RenderingECSModule::ImmediateSubmit(std::function<void(VkCommandBuffer cmd)
 
     //submit command buffer to the queue and execute it.
     // _uploadFence will now block until the graphic commands finish execution
-    VK_CHECK(vkQueueSubmit(_graphicsQueue, 1, &submit, _uploadContext._uploadFence));
+    {
+        std::lock_guard<std::mutex> queueLock(queueMutex);
+        VK_CHECK(vkQueueSubmit(_graphicsQueue, 1, &submit, _uploadContext._uploadFence));
+    }
 
     vkWaitForFences(_device, 1, &_uploadContext._uploadFence, true, 9999999999);
     vkResetFences(_device, 1, &_uploadContext._uploadFence);
@@ -1402,6 +4793,42 @@ void RenderingECSModule::DisplayFPSCounter() const
     // Display FPS
     ImGui::Text("FPS: %.1f", io.Framerate);
     ImGui::Text("ms/frame: %.3f", 1000.0f / io.Framerate);
+    ImGui::Text("Occluded: %u", occludedCount);
+    ImGui::Text("Culled meshlets: %u", culledClusterCount);
+
+    RenderStats stats;
+    {
+        std::lock_guard<std::mutex> statsLock(renderStatsMutex);
+        stats = renderStats;
+    }
+    ImGui::Text("Draws: %u (%u instances, %u triangles)", stats.drawCount, stats.instanceCount, stats.triangleCount);
+    ImGui::Text("Binds: %u pipelines, %u buffers", stats.pipelineBindCount, stats.bufferBindCount);
+    ImGui::Text("Push constants: %u B", stats.pushConstantBytes);
+    if (stats.pipelineStatisticsValid)
+    {
+        ImGui::Text("Invocations: %llu VS, %llu clip, %llu FS",
+            (unsigned long long)stats.vertexInvocations,
+            (unsigned long long)stats.clippingInvocations,
+            (unsigned long long)stats.fragmentInvocations);
+    }
+    ImGui::Text("Transform uploads: %u", stats.transformUploadCount);
+    ImGui::Text("Glyphs: %u", stats.glyphCount);
+    ImGui::Text("Skinned: %u", stats.skinnedCount);
+    ImGui::Text("Impostors: %u", stats.impostorCount);
+    ImGui::Text("Batched: %u", stats.batchedCount);
+    if (frameCapture.IsRecording())
+    {
+        ImGui::Text("Recording (%u dropped)", frameCapture.GetDroppedFrameCount());
+    }
+    if (renderStatsLog.IsLogging())
+    {
+        ImGui::Text("Logging stats");
+    }
+    if (dynamicResolutionEnabled)
+    {
+        ImGui::Text("Render scale: %.0f%% (%ux%u)", stats.renderScale * 100.0f, stats.renderExtent.width, stats.renderExtent.height);
+        ImGui::Text("GPU ms: %.2f", stats.gpuFrameTimeMs);
+    }
 
     // End the window
     ImGui::End();
@@ -240,4 +240,58 @@ VkSubmitInfo vkinit::submit_info(VkCommandBuffer* cmd)
     return info;
 }
 
+VkImageMemoryBarrier2KHR vkinit::image_memory_barrier2
+(
+    VkImage image,
+    VkImageAspectFlags aspectMask,
+    VkImageLayout oldLayout,
+    VkImageLayout newLayout,
+    VkPipelineStageFlags2KHR srcStageMask,
+    VkAccessFlags2KHR srcAccessMask,
+    VkPipelineStageFlags2KHR dstStageMask,
+    VkAccessFlags2KHR dstAccessMask
+)
+{
+    VkImageMemoryBarrier2KHR barrier = {};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2_KHR;
+    barrier.pNext = nullptr;
+
+    barrier.srcStageMask = srcStageMask;
+    barrier.srcAccessMask = srcAccessMask;
+    barrier.dstStageMask = dstStageMask;
+    barrier.dstAccessMask = dstAccessMask;
+    barrier.oldLayout = oldLayout;
+    barrier.newLayout = newLayout;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = image;
+    barrier.subresourceRange.aspectMask = aspectMask;
+    barrier.subresourceRange.baseMipLevel = 0;
+    barrier.subresourceRange.levelCount = 1;
+    barrier.subresourceRange.baseArrayLayer = 0;
+    barrier.subresourceRange.layerCount = 1;
+
+    return barrier;
+}
+
+VkRenderingAttachmentInfoKHR vkinit::rendering_attachment_info(VkImageView imageView, VkImageLayout layout, const VkClearValue* clear)
+{
+    VkRenderingAttachmentInfoKHR info = {};
+    info.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR;
+    info.pNext = nullptr;
+
+    info.imageView = imageView;
+    info.imageLayout = layout;
+    info.resolveMode = VK_RESOLVE_MODE_NONE;
+    //clear when a value is given, otherwise keep what is already in the image
+    info.loadOp = clear != nullptr ? VK_ATTACHMENT_LOAD_OP_CLEAR : VK_ATTACHMENT_LOAD_OP_LOAD;
+    info.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+    if (clear != nullptr)
+    {
+        info.clearValue = *clear;
+    }
+
+    return info;
+}
+
 } // namespace vkinit
@@ -0,0 +1,89 @@
+/// @file    AABB.cpp
+/// @author  Matthew Green
+/// @date    2024-01-07 10:20:31
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Math/AABB.h"
+
+#include <glm/common.hpp>
+
+namespace velecs {
+
+// Public Fields
+
+// Constructors and Destructors
+
+AABB::AABB(const glm::vec3 min, const glm::vec3 max)
+    : min(min), max(max) {}
+
+// Public Methods
+
+void AABB::Encapsulate(const glm::vec3 point)
+{
+    min = glm::min(min, point);
+    max = glm::max(max, point);
+}
+
+void AABB::Encapsulate(const AABB& other)
+{
+    min = glm::min(min, other.min);
+    max = glm::max(max, other.max);
+}
+
+bool AABB::IsValid() const
+{
+    return min.x <= max.x && min.y <= max.y && min.z <= max.z;
+}
+
+glm::vec3 AABB::GetCenter() const
+{
+    return (min + max) * 0.5f;
+}
+
+glm::vec3 AABB::GetExtents() const
+{
+    return (max - min) * 0.5f;
+}
+
+std::array<glm::vec3, 8> AABB::GetCorners() const
+{
+    std::array<glm::vec3, 8> corners;
+    for (size_t i = 0; i < corners.size(); ++i)
+    {
+        corners[i] = glm::vec3
+        {
+            (i & 1) ? max.x : min.x,
+            (i & 2) ? max.y : min.y,
+            (i & 4) ? max.z : min.z
+        };
+    }
+    return corners;
+}
+
+AABB AABB::Transformed(const glm::mat4& matrix) const
+{
+    // The extents along each world axis are the absolute values of the rotated and scaled local extents
+    const glm::vec3 center = glm::vec3{matrix * glm::vec4{GetCenter(), 1.0f}};
+    const glm::vec3 extents = GetExtents();
+    const glm::vec3 worldExtents =
+        glm::abs(glm::vec3{matrix[0]}) * extents.x +
+        glm::abs(glm::vec3{matrix[1]}) * extents.y +
+        glm::abs(glm::vec3{matrix[2]}) * extents.z;
+
+    return AABB{center - worldExtents, center + worldExtents};
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+} // namespace velecs
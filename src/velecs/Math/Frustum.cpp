@@ -0,0 +1,73 @@
+/// @file    Frustum.cpp
+/// @author  Matthew Green
+/// @date    2024-01-26 09:12:40
+///
+/// @section LICENSE
+///
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Math/Frustum.h"
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+
+namespace velecs {
+
+// Public Fields
+
+// Constructors and Destructors
+
+Frustum::Frustum()
+{
+    planes.fill(glm::vec4{0.0f, 0.0f, 0.0f, 1.0f});
+}
+
+// Public Methods
+
+Frustum Frustum::FromViewProjection(const glm::mat4& viewProjection)
+{
+    // glm is column major, so row i of the matrix is the i-th component of every column
+    const glm::vec4 row0{viewProjection[0][0], viewProjection[1][0], viewProjection[2][0], viewProjection[3][0]};
+    const glm::vec4 row1{viewProjection[0][1], viewProjection[1][1], viewProjection[2][1], viewProjection[3][1]};
+    const glm::vec4 row2{viewProjection[0][2], viewProjection[1][2], viewProjection[2][2], viewProjection[3][2]};
+    const glm::vec4 row3{viewProjection[0][3], viewProjection[1][3], viewProjection[2][3], viewProjection[3][3]};
+
+    Frustum frustum;
+    frustum.planes[0] = row3 + row0; // -w <= x
+    frustum.planes[1] = row3 - row0; // x <= w
+    frustum.planes[2] = row3 + row1; // -w <= y
+    frustum.planes[3] = row3 - row1; // y <= w
+    frustum.planes[4] = row2;        // 0 <= z
+    frustum.planes[5] = row3 - row2; // z <= w
+    return frustum;
+}
+
+bool Frustum::Intersects(const AABB& bounds) const
+{
+    const glm::vec3 center = bounds.GetCenter();
+    const glm::vec3 extents = bounds.GetExtents();
+
+    for (const glm::vec4& plane : planes)
+    {
+        // Distance of the corner furthest along the normal, no need to normalize for a sign test
+        const glm::vec3 normal{plane};
+        const float distance = glm::dot(normal, center) + plane.w + glm::dot(extents, glm::abs(normal));
+        if (distance < 0.0f)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+} // namespace velecs
@@ -0,0 +1,388 @@
+/// @file    BindlessTable.cpp
+/// @author  Matthew Green
+/// @date    2024-01-06 15:20:51
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Rendering/BindlessTable.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+
+namespace velecs {
+
+// Public Fields
+
+// Constructors and Destructors
+
+// Public Methods
+
+void BindlessTable::Init(VkDevice device, VmaAllocator allocator, const DeviceCapabilities& capabilities)
+{
+    this->device = device;
+    this->allocator = allocator;
+    updateAfterBind = capabilities.descriptorIndexing;
+
+    usedTextureSlots.assign(MAX_TEXTURES, false);
+    materialKeys.assign(MAX_MATERIALS, MaterialKey{});
+    materialReferences.assign(MAX_MATERIALS, 0);
+
+    // SAMPLER
+
+    VkSamplerCreateInfo samplerInfo = {};
+    samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+    samplerInfo.magFilter = VK_FILTER_LINEAR;
+    samplerInfo.minFilter = VK_FILTER_LINEAR;
+    samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+    samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+    samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+    samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+    samplerInfo.minLod = 0.0f;
+    samplerInfo.maxLod = VK_LOD_CLAMP_NONE;
+
+    if (vkCreateSampler(device, &samplerInfo, nullptr, &sampler) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create the bindless table sampler.");
+    }
+
+    // LAYOUT
+
+    VkDescriptorSetLayoutBinding bindings[3] = {};
+
+    bindings[0].binding = TEXTURES_BINDING;
+    bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+    bindings[0].descriptorCount = MAX_TEXTURES;
+    bindings[0].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+
+    bindings[1].binding = SAMPLER_BINDING;
+    bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER;
+    bindings[1].descriptorCount = 1;
+    bindings[1].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+    bindings[1].pImmutableSamplers = &sampler;
+
+    bindings[2].binding = MATERIALS_BINDING;
+    bindings[2].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    bindings[2].descriptorCount = 1;
+    bindings[2].stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+
+    VkDescriptorBindingFlagsEXT bindingFlags[3] =
+    {
+        VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT,
+        0,
+        0
+    };
+
+    VkDescriptorSetLayoutBindingFlagsCreateInfoEXT bindingFlagsInfo = {};
+    bindingFlagsInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT;
+    bindingFlagsInfo.bindingCount = 3;
+    bindingFlagsInfo.pBindingFlags = bindingFlags;
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo = {};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.pNext = updateAfterBind ? &bindingFlagsInfo : nullptr;
+    layoutInfo.flags = updateAfterBind ? VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT : 0;
+    layoutInfo.bindingCount = 3;
+    layoutInfo.pBindings = bindings;
+
+    if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &layout) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create the bindless table descriptor set layout.");
+    }
+
+    // POOL & SET
+
+    VkDescriptorPoolSize poolSizes[] =
+    {
+        { VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, MAX_TEXTURES },
+        { VK_DESCRIPTOR_TYPE_SAMPLER, 1 },
+        { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1 }
+    };
+
+    VkDescriptorPoolCreateInfo poolInfo = {};
+    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.flags = updateAfterBind ? VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT : 0;
+    poolInfo.maxSets = 1;
+    poolInfo.poolSizeCount = (uint32_t)std::size(poolSizes);
+    poolInfo.pPoolSizes = poolSizes;
+
+    if (vkCreateDescriptorPool(device, &poolInfo, nullptr, &pool) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create the bindless table descriptor pool.");
+    }
+
+    VkDescriptorSetAllocateInfo allocInfo = {};
+    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool = pool;
+    allocInfo.descriptorSetCount = 1;
+    allocInfo.pSetLayouts = &layout;
+
+    if (vkAllocateDescriptorSets(device, &allocInfo, &set) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to allocate the bindless table descriptor set.");
+    }
+
+    // MATERIAL BUFFER
+
+    const VkDeviceSize materialBufferSize = sizeof(MaterialParams) * MAX_MATERIALS;
+
+    VkBufferCreateInfo bufferInfo = {};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = materialBufferSize;
+    bufferInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+
+    //host visible and persistently mapped, material records are small and rewritten in place
+    VmaAllocationCreateInfo vmaallocInfo = {};
+    vmaallocInfo.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
+    vmaallocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+    vmaallocInfo.requiredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
+    VmaAllocationInfo allocationInfo = {};
+    if (vmaCreateBuffer(allocator, &bufferInfo, &vmaallocInfo, &materialBuffer._buffer, &materialBuffer._allocation, &allocationInfo) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create the bindless material buffer.");
+    }
+
+    mappedMaterials = static_cast<MaterialParams*>(allocationInfo.pMappedData);
+    std::fill(mappedMaterials, mappedMaterials + MAX_MATERIALS, MaterialParams{});
+
+    VkDescriptorBufferInfo materialBufferInfo = {};
+    materialBufferInfo.buffer = materialBuffer._buffer;
+    materialBufferInfo.offset = 0;
+    materialBufferInfo.range = materialBufferSize;
+
+    VkWriteDescriptorSet write = {};
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet = set;
+    write.dstBinding = MATERIALS_BINDING;
+    write.dstArrayElement = 0;
+    write.descriptorCount = 1;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    write.pBufferInfo = &materialBufferInfo;
+
+    vkUpdateDescriptorSets(device, 1, &write, 0, nullptr);
+}
+
+void BindlessTable::Cleanup()
+{
+    if (materialBuffer.IsInitialized())
+    {
+        vmaDestroyBuffer(allocator, materialBuffer._buffer, materialBuffer._allocation);
+        materialBuffer = AllocatedBuffer{};
+        mappedMaterials = nullptr;
+    }
+
+    if (pool != VK_NULL_HANDLE)
+    {
+        vkDestroyDescriptorPool(device, pool, nullptr);
+        pool = VK_NULL_HANDLE;
+        set = VK_NULL_HANDLE;
+    }
+
+    if (layout != VK_NULL_HANDLE)
+    {
+        vkDestroyDescriptorSetLayout(device, layout, nullptr);
+        layout = VK_NULL_HANDLE;
+    }
+
+    if (sampler != VK_NULL_HANDLE)
+    {
+        vkDestroySampler(device, sampler, nullptr);
+        sampler = VK_NULL_HANDLE;
+    }
+}
+
+void BindlessTable::SetFallbackTexture(VkImageView imageView)
+{
+    fallbackTexture = imageView;
+
+    // Without partially bound arrays every element the shader could reach has to be valid.
+    for (uint32_t i = 0; i < MAX_TEXTURES; ++i)
+    {
+        if (!usedTextureSlots[i])
+        {
+            WriteTexture(i, fallbackTexture);
+        }
+    }
+}
+
+uint32_t BindlessTable::RegisterTexture(VkImageView imageView)
+{
+    const auto freeSlot = std::find(usedTextureSlots.begin(), usedTextureSlots.end(), false);
+    if (freeSlot == usedTextureSlots.end())
+    {
+        std::ostringstream oss;
+        oss << "Bindless texture array is full (" << MAX_TEXTURES << " textures).";
+        throw std::runtime_error(oss.str());
+    }
+
+    const uint32_t index = (uint32_t)std::distance(usedTextureSlots.begin(), freeSlot);
+    usedTextureSlots[index] = true;
+    WriteTexture(index, imageView);
+    return index;
+}
+
+void BindlessTable::ReleaseTexture(const uint32_t index)
+{
+    if (index == INVALID_INDEX || index >= MAX_TEXTURES || !usedTextureSlots[index])
+    {
+        return;
+    }
+
+    usedTextureSlots[index] = false;
+    if (fallbackTexture != VK_NULL_HANDLE)
+    {
+        WriteTexture(index, fallbackTexture);
+    }
+}
+
+uint32_t BindlessTable::AcquireMaterial(const uint32_t current, VkPipeline pipeline, const MaterialParams& params)
+{
+    const MaterialKey key{pipeline, params.color, params.textureIndex};
+    if (current != INVALID_INDEX && current != DEFAULT_MATERIAL_INDEX && current < nextMaterialSlot && materialKeys[current] == key)
+    {
+        return current;
+    }
+
+    uint32_t index = INVALID_INDEX;
+    const auto found = materialSlots.find(key);
+    if (found != materialSlots.end())
+    {
+        index = found->second;
+        ++materialReferences[index];
+    }
+    else
+    {
+        if (!freeMaterialSlots.empty())
+        {
+            index = freeMaterialSlots.back();
+            freeMaterialSlots.pop_back();
+        }
+        else if (nextMaterialSlot < MAX_MATERIALS)
+        {
+            index = nextMaterialSlot++;
+        }
+        else
+        {
+            // called from the draw systems, so running out must not take the frame down
+            if (!warnedMaterialsFull)
+            {
+                std::cout << "[WARNING] [BindlessTable] Material buffer is full (" << MAX_MATERIALS
+                    << " materials), further materials draw with the default material." << std::endl;
+                warnedMaterialsFull = true;
+            }
+            ReleaseMaterial(current);
+            return DEFAULT_MATERIAL_INDEX;
+        }
+
+        materialKeys[index] = key;
+        materialReferences[index] = 1;
+        materialSlots.emplace(key, index);
+    }
+
+    ReleaseMaterial(current);
+    return index;
+}
+
+void BindlessTable::ReleaseMaterial(const uint32_t index)
+{
+    if (index == INVALID_INDEX || index == DEFAULT_MATERIAL_INDEX || index >= nextMaterialSlot || materialReferences[index] == 0)
+    {
+        return;
+    }
+
+    if (--materialReferences[index] == 0)
+    {
+        materialSlots.erase(materialKeys[index]);
+        materialKeys[index] = MaterialKey{};
+        freeMaterialSlots.push_back(index);
+    }
+}
+
+void BindlessTable::SetMaterial(const uint32_t index, const MaterialParams& params)
+{
+    if (index == DEFAULT_MATERIAL_INDEX || index >= MAX_MATERIALS || mappedMaterials == nullptr)
+    {
+        return;
+    }
+
+    std::memcpy(&mappedMaterials[index], &params, sizeof(MaterialParams));
+}
+
+void BindlessTable::Bind
+(
+    VkCommandBuffer cmd,
+    VkPipelineLayout pipelineLayout,
+    const VkPipelineBindPoint bindPoint /*= VK_PIPELINE_BIND_POINT_GRAPHICS*/,
+    const uint32_t setIndex /*= 0*/
+) const
+{
+    vkCmdBindDescriptorSets(cmd, bindPoint, pipelineLayout, setIndex, 1, &set, 0, nullptr);
+}
+
+VkDescriptorSetLayout BindlessTable::GetLayout() const
+{
+    return layout;
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+bool BindlessTable::MaterialKey::operator==(const MaterialKey& other) const
+{
+    return pipeline == other.pipeline && color == other.color && textureIndex == other.textureIndex;
+}
+
+size_t BindlessTable::MaterialKeyHash::operator()(const MaterialKey& key) const
+{
+    uint64_t hash = 14695981039346656037ull;
+    const auto mix = [&hash](const uint64_t word)
+    {
+        hash = (hash ^ word) * 1099511628211ull;
+    };
+
+    mix(reinterpret_cast<uint64_t>(key.pipeline));
+    for (int i = 0; i < 4; ++i)
+    {
+        // adding zero turns -0 into +0, which compare equal
+        const float channel = key.color[i] + 0.0f;
+        uint32_t bits = 0;
+        std::memcpy(&bits, &channel, sizeof(bits));
+        mix(bits);
+    }
+    mix(key.textureIndex);
+    return static_cast<size_t>(hash);
+}
+
+void BindlessTable::WriteTexture(const uint32_t index, VkImageView imageView)
+{
+    VkDescriptorImageInfo imageInfo = {};
+    imageInfo.imageView = imageView;
+    imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    imageInfo.sampler = VK_NULL_HANDLE;
+
+    VkWriteDescriptorSet write = {};
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet = set;
+    write.dstBinding = TEXTURES_BINDING;
+    write.dstArrayElement = index;
+    write.descriptorCount = 1;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+    write.pImageInfo = &imageInfo;
+
+    vkUpdateDescriptorSets(device, 1, &write, 0, nullptr);
+}
+
+} // namespace velecs
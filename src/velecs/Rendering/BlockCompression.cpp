@@ -0,0 +1,286 @@
+/// @file    BlockCompression.cpp
+/// @author  Matthew Green
+/// @date    2024-01-19 10:05:17
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Rendering/BlockCompression.h"
+
+#define STB_DXT_IMPLEMENTATION
+#include <stb_dxt.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace velecs {
+
+namespace {
+
+/// @brief Weights of the 16 interpolated colors of a 4-bit BC7 index, out of 64.
+constexpr int BC7_WEIGHTS[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+/// @brief One candidate encoding of a block in BC7 mode 6.
+struct Mode6Fit {
+    int quantized[2][4]{}; /// @brief 7-bit endpoints.
+    int pBits[2]{}; /// @brief Low bit shared by each endpoint's channels.
+    int indices[16]{}; /// @brief Nearest interpolated color of each pixel.
+    int error{0}; /// @brief Summed squared error of the decoded block.
+};
+
+/// @brief Quantizes an endpoint pair and picks the nearest interpolated color of every pixel.
+/// @param[in] pixels 16 RGBA8 pixels in row order.
+/// @param[in] first The endpoint the weights start at.
+/// @param[in] last The endpoint the weights end at.
+/// @return The fit and its error.
+Mode6Fit FitMode6(const uint8_t* pixels, const int* first, const int* last)
+{
+    Mode6Fit fit;
+
+    // Mode 6 stores 7 bits per channel plus one p-bit shared by the endpoint's channels,
+    // keep the p-bit that reconstructs the endpoint closest.
+    const int* targets[2] = {first, last};
+    for (int e = 0; e < 2; ++e)
+    {
+        int bestError = -1;
+        for (int p = 0; p < 2; ++p)
+        {
+            int candidate[4];
+            int error = 0;
+            for (int c = 0; c < 4; ++c)
+            {
+                candidate[c] = std::clamp((targets[e][c] - p + 1) >> 1, 0, 127);
+                const int difference = ((candidate[c] << 1) | p) - targets[e][c];
+                error += difference * difference;
+            }
+            if (bestError < 0 || error < bestError)
+            {
+                bestError = error;
+                fit.pBits[e] = p;
+                std::copy(candidate, candidate + 4, fit.quantized[e]);
+            }
+        }
+    }
+
+    int palette[16][4];
+    for (int i = 0; i < 16; ++i)
+    {
+        for (int c = 0; c < 4; ++c)
+        {
+            const int e0 = (fit.quantized[0][c] << 1) | fit.pBits[0];
+            const int e1 = (fit.quantized[1][c] << 1) | fit.pBits[1];
+            palette[i][c] = ((64 - BC7_WEIGHTS[i]) * e0 + BC7_WEIGHTS[i] * e1 + 32) >> 6;
+        }
+    }
+
+    for (int i = 0; i < 16; ++i)
+    {
+        int bestError = -1;
+        for (int j = 0; j < 16; ++j)
+        {
+            int error = 0;
+            for (int c = 0; c < 4; ++c)
+            {
+                const int difference = palette[j][c] - pixels[i * 4 + c];
+                error += difference * difference;
+            }
+            if (bestError < 0 || error < bestError)
+            {
+                bestError = error;
+                fit.indices[i] = j;
+            }
+        }
+        fit.error += bestError;
+    }
+
+    return fit;
+}
+
+} // namespace
+
+// Public Fields
+
+// Constructors and Destructors
+
+// Public Methods
+
+bool BlockCompression::IsBlockCompressed(const VkFormat format)
+{
+    return GetBlockSize(format) != 0;
+}
+
+size_t BlockCompression::GetBlockSize(const VkFormat format)
+{
+    switch (format)
+    {
+        case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+        case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+            return 8;
+        case VK_FORMAT_BC3_UNORM_BLOCK:
+        case VK_FORMAT_BC7_UNORM_BLOCK:
+            return 16;
+        default:
+            return 0;
+    }
+}
+
+size_t BlockCompression::GetImageSize(const VkFormat format, const uint32_t width, const uint32_t height)
+{
+    const size_t blocksX = (width + BLOCK_DIM - 1) / BLOCK_DIM;
+    const size_t blocksY = (height + BLOCK_DIM - 1) / BLOCK_DIM;
+    return blocksX * blocksY * GetBlockSize(format);
+}
+
+VkFormat BlockCompression::ChooseFormat(const uint8_t* rgba, const uint32_t width, const uint32_t height)
+{
+    const size_t pixelCount = static_cast<size_t>(width) * height;
+    for (size_t i = 0; i < pixelCount; ++i)
+    {
+        if (rgba[i * 4 + 3] != 255)
+        {
+            return VK_FORMAT_BC7_UNORM_BLOCK;
+        }
+    }
+    return VK_FORMAT_BC1_RGB_UNORM_BLOCK;
+}
+
+std::vector<uint8_t> BlockCompression::Compress(const uint8_t* rgba, const uint32_t width, const uint32_t height, const VkFormat format)
+{
+    const size_t blockSize = GetBlockSize(format);
+    if (blockSize == 0 || format == VK_FORMAT_BC1_RGBA_UNORM_BLOCK)
+    {
+        throw std::invalid_argument("BlockCompression only encodes BC1 RGB, BC3 and BC7.");
+    }
+
+    std::vector<uint8_t> encoded(GetImageSize(format, width, height));
+    uint8_t* out = encoded.data();
+
+    uint8_t pixels[BLOCK_DIM * BLOCK_DIM * 4];
+    for (uint32_t blockY = 0; blockY < height; blockY += BLOCK_DIM)
+    {
+        for (uint32_t blockX = 0; blockX < width; blockX += BLOCK_DIM)
+        {
+            // gather the block, clamping to the edge of images that are not a multiple of 4
+            for (uint32_t y = 0; y < BLOCK_DIM; ++y)
+            {
+                const uint32_t sourceY = std::min(blockY + y, height - 1);
+                for (uint32_t x = 0; x < BLOCK_DIM; ++x)
+                {
+                    const uint32_t sourceX = std::min(blockX + x, width - 1);
+                    std::memcpy(&pixels[(y * BLOCK_DIM + x) * 4], &rgba[(static_cast<size_t>(sourceY) * width + sourceX) * 4], 4);
+                }
+            }
+
+            switch (format)
+            {
+                case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+                    stb_compress_dxt_block(out, pixels, 0, STB_DXT_HIGHQUAL);
+                    break;
+                case VK_FORMAT_BC3_UNORM_BLOCK:
+                    stb_compress_dxt_block(out, pixels, 1, STB_DXT_HIGHQUAL);
+                    break;
+                default:
+                    EncodeBC7Block(pixels, out);
+                    break;
+            }
+            out += blockSize;
+        }
+    }
+
+    return encoded;
+}
+
+void BlockCompression::EncodeBC7Block(const uint8_t* pixels, uint8_t* block)
+{
+    // ENDPOINTS: opposite corners of the block's RGBA bounding box
+
+    int low[4] = {255, 255, 255, 255};
+    int high[4] = {0, 0, 0, 0};
+    for (int i = 0; i < 16; ++i)
+    {
+        for (int c = 0; c < 4; ++c)
+        {
+            low[c] = std::min(low[c], static_cast<int>(pixels[i * 4 + c]));
+            high[c] = std::max(high[c], static_cast<int>(pixels[i * 4 + c]));
+        }
+    }
+
+    // The box has 8 diagonals, one per choice of which channels fall while the first rises.
+    // Channels moving apart, like a red to green edge or alpha fading as color brightens,
+    // only line up with one of them, so every diagonal is fitted and the closest one kept.
+    Mode6Fit best;
+    for (int flips = 0; flips < 8; ++flips)
+    {
+        int first[4];
+        int last[4];
+        for (int c = 0; c < 4; ++c)
+        {
+            const bool falling = c > 0 && (flips & (1 << (c - 1))) != 0;
+            first[c] = falling ? high[c] : low[c];
+            last[c] = falling ? low[c] : high[c];
+        }
+
+        const Mode6Fit fit = FitMode6(pixels, first, last);
+        if (flips == 0 || fit.error < best.error)
+        {
+            best = fit;
+        }
+    }
+
+    int (&quantized)[2][4] = best.quantized;
+    int (&pBits)[2] = best.pBits;
+    int (&indices)[16] = best.indices;
+
+    // the first index is stored with 3 bits, so its top bit must be clear.
+    // Swapping the endpoints mirrors the weights, which flips every index.
+    if (indices[0] & 8)
+    {
+        std::swap(quantized[0], quantized[1]);
+        std::swap(pBits[0], pBits[1]);
+        for (int& index : indices)
+        {
+            index = 15 - index;
+        }
+    }
+
+    // PACKING, least significant bit first
+
+    std::memset(block, 0, 16);
+    uint32_t bitPosition = 0;
+    const auto write = [block, &bitPosition](const uint32_t value, const uint32_t bitCount)
+    {
+        for (uint32_t bit = 0; bit < bitCount; ++bit, ++bitPosition)
+        {
+            block[bitPosition >> 3] |= static_cast<uint8_t>(((value >> bit) & 1u) << (bitPosition & 7));
+        }
+    };
+
+    write(1u << 6, 7); // mode 6 is six zero bits followed by a one
+    for (int c = 0; c < 4; ++c)
+    {
+        write(static_cast<uint32_t>(quantized[0][c]), 7);
+        write(static_cast<uint32_t>(quantized[1][c]), 7);
+    }
+    write(static_cast<uint32_t>(pBits[0]), 1);
+    write(static_cast<uint32_t>(pBits[1]), 1);
+    write(static_cast<uint32_t>(indices[0]), 3);
+    for (int i = 1; i < 16; ++i)
+    {
+        write(static_cast<uint32_t>(indices[i]), 4);
+    }
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+} // namespace velecs
@@ -0,0 +1,202 @@
+/// @file    DebugDraw.cpp
+/// @author  Matthew Green
+/// @date    2024-01-28 13:47:06
+///
+/// @section LICENSE
+///
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Rendering/DebugDraw.h"
+
+#include <glm/geometric.hpp>
+#include <glm/vec4.hpp>
+#include <glm/gtc/constants.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <mutex>
+
+namespace velecs {
+
+namespace {
+
+/// @brief Lines one thread added since the last Collect.
+struct ThreadBuffer {
+    std::mutex mutex; /// @brief Only contended while Collect drains the buffer.
+    std::vector<DebugVertex> vertices;
+};
+
+std::mutex registryMutex; /// @brief Guards registry.
+std::vector<std::shared_ptr<ThreadBuffer>> registry; /// @brief Buffer of every thread that has drawn, kept past the thread's exit until drained.
+
+/// @brief Gets the calling thread's buffer, registering it on first use.
+ThreadBuffer& GetThreadBuffer()
+{
+    thread_local const std::shared_ptr<ThreadBuffer> buffer = []()
+    {
+        std::shared_ptr<ThreadBuffer> created = std::make_shared<ThreadBuffer>();
+        std::lock_guard<std::mutex> lock(registryMutex);
+        registry.push_back(created);
+        return created;
+    }();
+    return *buffer;
+}
+
+/// @brief Appends the 12 edges of a box given by its corners, bit i of a corner's index picks max on axis i.
+void AppendBoxEdges(const glm::vec3 (&corners)[8], const Color32 color)
+{
+    ThreadBuffer& buffer = GetThreadBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+
+    for (uint32_t corner = 0; corner < 8; ++corner)
+    {
+        for (uint32_t axis = 0; axis < 3; ++axis)
+        {
+            // each edge is added once, from the corner on its min side
+            const uint32_t bit = 1u << axis;
+            if ((corner & bit) == 0)
+            {
+                buffer.vertices.emplace_back(corners[corner], color);
+                buffer.vertices.emplace_back(corners[corner | bit], color);
+            }
+        }
+    }
+}
+
+} // namespace
+
+// Public Fields
+
+// Constructors and Destructors
+
+// Public Methods
+
+void DebugDraw::Line(const glm::vec3& from, const glm::vec3& to, const Color32 color /*= Color32::WHITE*/)
+{
+    ThreadBuffer& buffer = GetThreadBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+
+    buffer.vertices.emplace_back(from, color);
+    buffer.vertices.emplace_back(to, color);
+}
+
+void DebugDraw::Box(const AABB& bounds, const Color32 color /*= Color32::WHITE*/)
+{
+    Box(glm::mat4{1.0f}, bounds, color);
+}
+
+void DebugDraw::Box(const glm::mat4& world, const AABB& bounds, const Color32 color /*= Color32::WHITE*/)
+{
+    if (!bounds.IsValid())
+    {
+        return;
+    }
+
+    glm::vec3 corners[8];
+    for (uint32_t corner = 0; corner < 8; ++corner)
+    {
+        const glm::vec3 local
+        {
+            (corner & 1u) != 0 ? bounds.max.x : bounds.min.x,
+            (corner & 2u) != 0 ? bounds.max.y : bounds.min.y,
+            (corner & 4u) != 0 ? bounds.max.z : bounds.min.z
+        };
+        corners[corner] = glm::vec3{world * glm::vec4{local, 1.0f}};
+    }
+
+    AppendBoxEdges(corners, color);
+}
+
+void DebugDraw::Sphere(const glm::vec3& center, const float radius, const Color32 color /*= Color32::WHITE*/, const uint32_t segments /*= DEFAULT_SPHERE_SEGMENTS*/)
+{
+    const uint32_t segmentCount = std::max(segments, 3u);
+    const float step = glm::two_pi<float>() / static_cast<float>(segmentCount);
+
+    ThreadBuffer& buffer = GetThreadBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+
+    buffer.vertices.reserve(buffer.vertices.size() + segmentCount * 6);
+    for (uint32_t i = 0; i < segmentCount; ++i)
+    {
+        const float a0 = step * static_cast<float>(i);
+        const float a1 = step * static_cast<float>(i + 1);
+        const float c0 = std::cos(a0) * radius;
+        const float s0 = std::sin(a0) * radius;
+        const float c1 = std::cos(a1) * radius;
+        const float s1 = std::sin(a1) * radius;
+
+        // around Z, Y and X
+        buffer.vertices.emplace_back(center + glm::vec3{c0, s0, 0.0f}, color);
+        buffer.vertices.emplace_back(center + glm::vec3{c1, s1, 0.0f}, color);
+        buffer.vertices.emplace_back(center + glm::vec3{c0, 0.0f, s0}, color);
+        buffer.vertices.emplace_back(center + glm::vec3{c1, 0.0f, s1}, color);
+        buffer.vertices.emplace_back(center + glm::vec3{0.0f, c0, s0}, color);
+        buffer.vertices.emplace_back(center + glm::vec3{0.0f, c1, s1}, color);
+    }
+}
+
+void DebugDraw::Arrow(const glm::vec3& from, const glm::vec3& to, const Color32 color /*= Color32::WHITE*/, const float headSize /*= DEFAULT_ARROW_HEAD*/)
+{
+    const glm::vec3 shaft = to - from;
+    const float length = glm::length(shaft);
+    if (length <= 0.0f)
+    {
+        return;
+    }
+
+    const glm::vec3 direction = shaft / length;
+
+    // any axis not parallel to the shaft gives the two sides of the head
+    const glm::vec3 reference = std::abs(direction.y) < 0.99f ? glm::vec3{0.0f, 1.0f, 0.0f} : glm::vec3{1.0f, 0.0f, 0.0f};
+    const glm::vec3 side = glm::normalize(glm::cross(direction, reference));
+    const glm::vec3 up = glm::cross(side, direction);
+
+    const float headLength = length * headSize;
+    const glm::vec3 headBase = to - direction * headLength;
+    const float headWidth = headLength * 0.5f;
+
+    ThreadBuffer& buffer = GetThreadBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+
+    buffer.vertices.emplace_back(from, color);
+    buffer.vertices.emplace_back(to, color);
+
+    const glm::vec3 spokes[4] = {side, -side, up, -up};
+    for (const glm::vec3& spoke : spokes)
+    {
+        buffer.vertices.emplace_back(to, color);
+        buffer.vertices.emplace_back(headBase + spoke * headWidth, color);
+    }
+}
+
+void DebugDraw::Collect(std::vector<DebugVertex>& vertices)
+{
+    std::lock_guard<std::mutex> registryLock(registryMutex);
+
+    for (const std::shared_ptr<ThreadBuffer>& buffer : registry)
+    {
+        std::lock_guard<std::mutex> lock(buffer->mutex);
+        vertices.insert(vertices.end(), buffer->vertices.begin(), buffer->vertices.end());
+        buffer->vertices.clear();
+    }
+
+    // the registry holds the last reference of threads that have exited, they are drained now
+    registry.erase
+    (
+        std::remove_if(registry.begin(), registry.end(), [](const std::shared_ptr<ThreadBuffer>& buffer) { return buffer.use_count() == 1; }),
+        registry.end()
+    );
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+} // namespace velecs
@@ -0,0 +1,65 @@
+/// @file    DebugVertex.cpp
+/// @author  Matthew Green
+/// @date    2024-01-28 13:09:44
+///
+/// @section LICENSE
+///
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Rendering/DebugVertex.h"
+
+#include <cstddef>
+
+namespace velecs {
+
+// Public Fields
+
+// Constructors and Destructors
+
+DebugVertex::DebugVertex(const glm::vec3& position, const Color32 color)
+    : position(position), color{color.r, color.g, color.b, color.a} {}
+
+// Public Methods
+
+VertexInputAttributeDescriptor DebugVertex::GetVertexDescription()
+{
+    VertexInputAttributeDescriptor description;
+
+    //we will have just 1 vertex buffer binding, with a per-vertex rate
+    VkVertexInputBindingDescription mainBinding = {};
+    mainBinding.binding = 0;
+    mainBinding.stride = sizeof(DebugVertex);
+    mainBinding.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+
+    description.bindings.push_back(mainBinding);
+
+    //Position will be stored at Location 0
+    VkVertexInputAttributeDescription positionAttribute = {};
+    positionAttribute.binding = 0;
+    positionAttribute.location = 0;
+    positionAttribute.format = VK_FORMAT_R32G32B32_SFLOAT;
+    positionAttribute.offset = offsetof(DebugVertex, position);
+
+    //Color will be stored at Location 1, normalized to [0, 1]
+    VkVertexInputAttributeDescription colorAttribute = {};
+    colorAttribute.binding = 0;
+    colorAttribute.location = 1;
+    colorAttribute.format = VK_FORMAT_R8G8B8A8_UNORM;
+    colorAttribute.offset = offsetof(DebugVertex, color);
+
+    description.attributes.push_back(positionAttribute);
+    description.attributes.push_back(colorAttribute);
+    return description;
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+} // namespace velecs
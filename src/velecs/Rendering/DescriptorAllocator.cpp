@@ -0,0 +1,166 @@
+/// @file    DescriptorAllocator.cpp
+/// @author  Matthew Green
+/// @date    2024-01-17 11:48:06
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Rendering/DescriptorAllocator.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace velecs {
+
+// Public Fields
+
+// Constructors and Destructors
+
+// Public Methods
+
+void DescriptorAllocator::Init
+(
+    VkDevice device,
+    const std::vector<PoolSizeRatio>& poolRatios /*= GetDefaultPoolRatios()*/,
+    const uint32_t setsPerPool /*= DEFAULT_SETS_PER_POOL*/
+)
+{
+    this->device = device;
+    ratios = poolRatios;
+    nextSetsPerPool = std::min(std::max(setsPerPool, 1u), MAX_SETS_PER_POOL);
+}
+
+void DescriptorAllocator::Cleanup()
+{
+    Reset();
+
+    for (VkDescriptorPool pool : freePools)
+    {
+        vkDestroyDescriptorPool(device, pool, nullptr);
+    }
+    freePools.clear();
+}
+
+VkDescriptorSet DescriptorAllocator::Allocate(VkDescriptorSetLayout layout, const void* pNext /*= nullptr*/)
+{
+    if (currentPool == VK_NULL_HANDLE)
+    {
+        currentPool = GrabPool();
+    }
+
+    VkDescriptorSetAllocateInfo allocInfo = {};
+    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.pNext = pNext;
+    allocInfo.descriptorPool = currentPool;
+    allocInfo.descriptorSetCount = 1;
+    allocInfo.pSetLayouts = &layout;
+
+    VkDescriptorSet set = VK_NULL_HANDLE;
+    VkResult result = vkAllocateDescriptorSets(device, &allocInfo, &set);
+
+    // the pool ran out of sets or of one descriptor type, retire it and retry once on an empty pool
+    if (result == VK_ERROR_OUT_OF_POOL_MEMORY || result == VK_ERROR_FRAGMENTED_POOL)
+    {
+        fullPools.push_back(currentPool);
+        currentPool = GrabPool();
+        allocInfo.descriptorPool = currentPool;
+
+        result = vkAllocateDescriptorSets(device, &allocInfo, &set);
+    }
+
+    if (result != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to allocate a descriptor set.");
+    }
+
+    return set;
+}
+
+void DescriptorAllocator::Reset()
+{
+    if (currentPool != VK_NULL_HANDLE)
+    {
+        fullPools.push_back(currentPool);
+        currentPool = VK_NULL_HANDLE;
+    }
+
+    for (VkDescriptorPool pool : fullPools)
+    {
+        vkResetDescriptorPool(device, pool, 0);
+        freePools.push_back(pool);
+    }
+    fullPools.clear();
+}
+
+uint32_t DescriptorAllocator::GetPoolCount() const
+{
+    return (uint32_t)(fullPools.size() + freePools.size()) + (currentPool != VK_NULL_HANDLE ? 1 : 0);
+}
+
+const std::vector<DescriptorAllocator::PoolSizeRatio>& DescriptorAllocator::GetDefaultPoolRatios()
+{
+    static const std::vector<PoolSizeRatio> defaultRatios =
+    {
+        { VK_DESCRIPTOR_TYPE_SAMPLER, 0.5f },
+        { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 4.0f },
+        { VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, 4.0f },
+        { VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1.0f },
+        { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 2.0f },
+        { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 2.0f },
+        { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1.0f },
+        { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, 1.0f }
+    };
+    return defaultRatios;
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+VkDescriptorPool DescriptorAllocator::GrabPool()
+{
+    if (!freePools.empty())
+    {
+        VkDescriptorPool pool = freePools.back();
+        freePools.pop_back();
+        return pool;
+    }
+
+    return CreatePool();
+}
+
+VkDescriptorPool DescriptorAllocator::CreatePool()
+{
+    std::vector<VkDescriptorPoolSize> poolSizes;
+    poolSizes.reserve(ratios.size());
+    for (const PoolSizeRatio& ratio : ratios)
+    {
+        const uint32_t count = std::max(1u, static_cast<uint32_t>(ratio.ratio * nextSetsPerPool));
+        poolSizes.push_back({ ratio.type, count });
+    }
+
+    VkDescriptorPoolCreateInfo poolInfo = {};
+    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.flags = 0; // sets are only ever released by resetting the whole pool
+    poolInfo.maxSets = nextSetsPerPool;
+    poolInfo.poolSizeCount = (uint32_t)poolSizes.size();
+    poolInfo.pPoolSizes = poolSizes.data();
+
+    VkDescriptorPool pool = VK_NULL_HANDLE;
+    if (vkCreateDescriptorPool(device, &poolInfo, nullptr, &pool) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create a descriptor pool.");
+    }
+
+    nextSetsPerPool = std::min(nextSetsPerPool * 2, MAX_SETS_PER_POOL);
+    return pool;
+}
+
+} // namespace velecs
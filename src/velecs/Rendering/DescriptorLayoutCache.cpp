@@ -0,0 +1,166 @@
+/// @file    DescriptorLayoutCache.cpp
+/// @author  Matthew Green
+/// @date    2024-01-17 10:31:52
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Rendering/DescriptorLayoutCache.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+
+namespace velecs {
+
+// Public Fields
+
+// Constructors and Destructors
+
+// Public Methods
+
+void DescriptorLayoutCache::Init(VkDevice device)
+{
+    this->device = device;
+}
+
+void DescriptorLayoutCache::Cleanup()
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+
+    for (const auto& entry : layouts)
+    {
+        vkDestroyDescriptorSetLayout(device, entry.second, nullptr);
+    }
+    layouts.clear();
+}
+
+VkDescriptorSetLayout DescriptorLayoutCache::CreateLayout(const VkDescriptorSetLayoutCreateInfo& info)
+{
+    LayoutKey key = MakeKey(info);
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+
+    const auto cached = layouts.find(key);
+    if (cached != layouts.end())
+    {
+        return cached->second;
+    }
+
+    VkDescriptorSetLayout layout = VK_NULL_HANDLE;
+    if (vkCreateDescriptorSetLayout(device, &info, nullptr, &layout) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create a cached descriptor set layout.");
+    }
+
+    layouts.emplace(std::move(key), layout);
+    return layout;
+}
+
+size_t DescriptorLayoutCache::GetLayoutCount() const
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    return layouts.size();
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+bool DescriptorLayoutCache::BindingKey::operator==(const BindingKey& other) const
+{
+    return binding.binding == other.binding.binding &&
+        binding.descriptorType == other.binding.descriptorType &&
+        binding.descriptorCount == other.binding.descriptorCount &&
+        binding.stageFlags == other.binding.stageFlags &&
+        flags == other.flags &&
+        immutableSamplers == other.immutableSamplers;
+}
+
+bool DescriptorLayoutCache::LayoutKey::operator==(const LayoutKey& other) const
+{
+    return flags == other.flags && bindings == other.bindings;
+}
+
+size_t DescriptorLayoutCache::LayoutKeyHash::operator()(const LayoutKey& key) const
+{
+    uint64_t hash = 14695981039346656037ull;
+    const auto mix = [&hash](const uint64_t word)
+    {
+        hash = (hash ^ word) * 1099511628211ull;
+    };
+
+    mix(key.flags);
+    for (const BindingKey& binding : key.bindings)
+    {
+        mix(binding.binding.binding);
+        mix(static_cast<uint64_t>(binding.binding.descriptorType));
+        mix(binding.binding.descriptorCount);
+        mix(binding.binding.stageFlags);
+        mix(binding.flags);
+        for (const VkSampler sampler : binding.immutableSamplers)
+        {
+            mix(reinterpret_cast<uint64_t>(sampler));
+        }
+    }
+    return static_cast<size_t>(hash);
+}
+
+DescriptorLayoutCache::LayoutKey DescriptorLayoutCache::MakeKey(const VkDescriptorSetLayoutCreateInfo& info)
+{
+    const VkDescriptorSetLayoutBindingFlagsCreateInfoEXT* bindingFlags = nullptr;
+    for (auto next = static_cast<const VkBaseInStructure*>(info.pNext); next != nullptr; next = next->pNext)
+    {
+        if (next->sType != VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT)
+        {
+            throw std::runtime_error("DescriptorLayoutCache only understands chained binding flags.");
+        }
+        bindingFlags = reinterpret_cast<const VkDescriptorSetLayoutBindingFlagsCreateInfoEXT*>(next);
+    }
+
+    LayoutKey key;
+    key.flags = info.flags;
+    key.bindings.resize(info.bindingCount);
+    for (uint32_t i = 0; i < info.bindingCount; ++i)
+    {
+        BindingKey& binding = key.bindings[i];
+        binding.binding = info.pBindings[i];
+        binding.binding.pImmutableSamplers = nullptr;
+
+        if (bindingFlags != nullptr && i < bindingFlags->bindingCount)
+        {
+            binding.flags = bindingFlags->pBindingFlags[i];
+        }
+
+        if (info.pBindings[i].pImmutableSamplers != nullptr)
+        {
+            binding.immutableSamplers.assign
+            (
+                info.pBindings[i].pImmutableSamplers,
+                info.pBindings[i].pImmutableSamplers + info.pBindings[i].descriptorCount
+            );
+        }
+    }
+
+    // the same layout may list its bindings in any order
+    std::sort
+    (
+        key.bindings.begin(),
+        key.bindings.end(),
+        [](const BindingKey& a, const BindingKey& b)
+        {
+            return a.binding.binding < b.binding.binding;
+        }
+    );
+
+    return key;
+}
+
+} // namespace velecs
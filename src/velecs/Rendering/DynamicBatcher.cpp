@@ -0,0 +1,348 @@
+/// @file    DynamicBatcher.cpp
+/// @author  Matthew Green
+/// @date    2024-01-28 10:38:15
+///
+/// @section LICENSE
+///
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Rendering/DynamicBatcher.h"
+
+#include "velecs/Math/SIMD.h"
+
+#include <glm/mat3x3.hpp>
+#include <glm/vec4.hpp>
+#include <glm/matrix.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace velecs {
+
+namespace {
+
+/// @brief Writes @p world times every position of @p source to @p destination.
+void TransformPositions(const glm::mat4& world, const SimpleVertex* const source, const size_t count, SimpleVertex* const destination)
+{
+#ifdef VELECS_SIMD_SSE2
+    // a transformed position is the matrix columns weighted by its coordinates
+    const __m128 column0 = _mm_loadu_ps(&world[0][0]);
+    const __m128 column1 = _mm_loadu_ps(&world[1][0]);
+    const __m128 column2 = _mm_loadu_ps(&world[2][0]);
+    const __m128 column3 = _mm_loadu_ps(&world[3][0]);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const glm::vec3& position = source[i].position;
+        __m128 result = _mm_add_ps(column3, _mm_mul_ps(column0, _mm_set1_ps(position.x)));
+        result = _mm_add_ps(result, _mm_mul_ps(column1, _mm_set1_ps(position.y)));
+        result = _mm_add_ps(result, _mm_mul_ps(column2, _mm_set1_ps(position.z)));
+
+        // positions are packed, a four lane store would spill into the next vertex
+        float* const out = &destination[i].position.x;
+        _mm_storel_pi(reinterpret_cast<__m64*>(out), result);
+        _mm_store_ss(out + 2, _mm_shuffle_ps(result, result, _MM_SHUFFLE(2, 2, 2, 2)));
+    }
+#else
+    for (size_t i = 0; i < count; ++i)
+    {
+        destination[i].position = glm::vec3(world * glm::vec4(source[i].position, 1.0f));
+    }
+#endif
+}
+
+/// @brief Rounds a vertex count up to a multiple of 3.
+///
+/// The VERTEX_COLOR variants color a vertex by gl_VertexIndex % 3, so every source and batch
+/// starts on a multiple of 3 to keep its colors independent of what was batched before it.
+size_t AlignToTriangle(const size_t vertexCount)
+{
+    return (vertexCount + 2) / 3 * 3;
+}
+
+} // namespace
+
+// Public Fields
+
+// Constructors and Destructors
+
+DynamicBatcher::DynamicBatcher(const uint32_t vertexThreshold /*= DEFAULT_VERTEX_THRESHOLD*/)
+    : vertexThreshold(vertexThreshold) {}
+
+// Public Methods
+
+void DynamicBatcher::SetVertexThreshold(const uint32_t vertexThreshold)
+{
+    this->vertexThreshold = vertexThreshold;
+}
+
+bool DynamicBatcher::IsBatchable(const SimpleMesh& mesh) const
+{
+    return !mesh._vertices.empty() && mesh._indices.size() >= 3 && mesh._vertices.size() <= vertexThreshold;
+}
+
+uint32_t DynamicBatcher::Find(const DrawPacket& packet)
+{
+    uint32_t batch = 0;
+    while (batch < batches.size())
+    {
+        const DrawPacket& other = batches[batch].packet;
+        if (other.pipeline == packet.pipeline && other.pipelineLayout == packet.pipelineLayout &&
+            other.material.color == packet.material.color && other.material.textureIndex == packet.material.textureIndex)
+        {
+            return batch;
+        }
+        ++batch;
+    }
+
+    batches.emplace_back();
+    batches.back().packet = packet;
+    return batch;
+}
+
+void DynamicBatcher::Append(ThreadPool& threadPool, const std::vector<Source>& sources)
+{
+    /// @brief Where a source lands in its batch.
+    struct Placement {
+        uint32_t firstVertex;
+        uint32_t firstIndex;
+    };
+    std::vector<Placement> placements(sources.size());
+
+    // offsets are handed out serially, so every source writes its own slice on the workers
+    for (size_t i = 0; i < sources.size(); ++i)
+    {
+        const Source& source = sources[i];
+        Batch& batch = batches[source.batch];
+
+        Geometry& geometry = batch.geometry;
+
+        const size_t firstVertex = AlignToTriangle(geometry.vertices.size());
+        placements[i].firstVertex = static_cast<uint32_t>(firstVertex);
+        placements[i].firstIndex = static_cast<uint32_t>(geometry.indices.size());
+        geometry.vertices.resize(firstVertex + source.mesh->_vertices.size());
+        geometry.indices.resize(geometry.indices.size() + source.mesh->_indices.size() / 3 * 3);
+        batch.viewMask |= source.viewMask;
+        ++batch.sourceCount;
+    }
+
+    threadPool.ParallelFor
+    (
+        sources.size(),
+        [&](size_t index)
+        {
+            const Source& source = sources[index];
+            const SimpleMesh& mesh = *source.mesh;
+            Geometry& geometry = batches[source.batch].geometry;
+            const Placement& placement = placements[index];
+
+            TransformPositions(source.world, mesh._vertices.data(), mesh._vertices.size(), geometry.vertices.data() + placement.firstVertex);
+
+            // A mirroring transform turns triangles inside out, swap two corners to keep the winding
+            const bool mirrored = glm::determinant(glm::mat3(source.world)) < 0.0f;
+
+            uint32_t* const indices = geometry.indices.data() + placement.firstIndex;
+            for (size_t i = 0; i + 2 < mesh._indices.size(); i += 3)
+            {
+                indices[i + 0] = placement.firstVertex + mesh._indices[i];
+                indices[i + 1] = placement.firstVertex + mesh._indices[mirrored ? i + 2 : i + 1];
+                indices[i + 2] = placement.firstVertex + mesh._indices[mirrored ? i + 1 : i + 2];
+            }
+        }
+    );
+}
+
+uint32_t DynamicBatcher::Flatten(std::vector<Geometry>& geometry, std::vector<DrawPacket>& drawPackets)
+{
+    uint32_t sourceCount = 0;
+    size_t slot = 0;
+    size_t vertexCount = 0;
+    size_t indexCount = 0;
+    for (Batch& batch : batches)
+    {
+        if (batch.sourceCount == 0)
+        {
+            continue;
+        }
+
+        // Upload places the batches with the same rule, padding each to a whole triangle
+        vertexCount = AlignToTriangle(vertexCount);
+
+        DrawPacket packet = batch.packet;
+        packet.dynamicBatch = true;
+        packet.indexType = VK_INDEX_TYPE_UINT32;
+        packet.firstIndex = static_cast<uint32_t>(indexCount);
+        packet.indexCount = static_cast<uint32_t>(batch.geometry.indices.size());
+        packet.vertexOffset = static_cast<int32_t>(vertexCount);
+
+        uint32_t mask = batch.viewMask;
+        for (uint32_t view = 0; mask != 0; ++view, mask >>= 1)
+        {
+            if ((mask & 1u) != 0)
+            {
+                packet.viewIndex = view;
+                drawPackets.push_back(packet);
+            }
+        }
+
+        vertexCount += batch.geometry.vertices.size();
+        indexCount += batch.geometry.indices.size();
+
+        // the batch takes over the empty vectors of the slot, so neither side reallocates
+        if (slot == geometry.size())
+        {
+            geometry.emplace_back();
+        }
+        std::swap(geometry[slot], batch.geometry);
+        ++slot;
+
+        sourceCount += batch.sourceCount;
+    }
+
+    // materials no longer drawn drop out, the others keep their capacity for the next frame
+    batches.erase
+    (
+        std::remove_if(batches.begin(), batches.end(), [](const Batch& batch) { return batch.sourceCount == 0; }),
+        batches.end()
+    );
+    for (Batch& batch : batches)
+    {
+        batch.viewMask = 0;
+        batch.geometry.vertices.clear();
+        batch.geometry.indices.clear();
+        batch.sourceCount = 0;
+    }
+
+    return sourceCount;
+}
+
+void DynamicBatcher::Init(VmaAllocator allocator)
+{
+    this->allocator = allocator;
+}
+
+void DynamicBatcher::Cleanup()
+{
+    if (vertexBuffer.IsInitialized())
+    {
+        vmaDestroyBuffer(allocator, vertexBuffer._buffer, vertexBuffer._allocation);
+        vertexBuffer = AllocatedBuffer{};
+    }
+    mappedVertices = nullptr;
+    vertexCapacity = 0;
+
+    if (indexBuffer.IsInitialized())
+    {
+        vmaDestroyBuffer(allocator, indexBuffer._buffer, indexBuffer._allocation);
+        indexBuffer = AllocatedBuffer{};
+    }
+    mappedIndices = nullptr;
+    indexCapacity = 0;
+}
+
+void DynamicBatcher::Upload(const std::vector<Geometry>& geometry)
+{
+    // same layout Flatten gave the packets, every batch padded to a whole triangle
+    size_t vertexCount = 0;
+    size_t indexCount = 0;
+    for (const Geometry& batch : geometry)
+    {
+        if (!batch.indices.empty())
+        {
+            vertexCount = AlignToTriangle(vertexCount) + batch.vertices.size();
+            indexCount += batch.indices.size();
+        }
+    }
+
+    if (vertexCount == 0 || indexCount == 0)
+    {
+        return;
+    }
+
+    Reserve(vertexBuffer, mappedVertices, vertexCapacity, sizeof(SimpleVertex) * vertexCount, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
+    Reserve(indexBuffer, mappedIndices, indexCapacity, sizeof(uint32_t) * indexCount, VK_BUFFER_USAGE_INDEX_BUFFER_BIT);
+
+    SimpleVertex* const vertices = static_cast<SimpleVertex*>(mappedVertices);
+    uint32_t* const indices = static_cast<uint32_t*>(mappedIndices);
+    size_t firstVertex = 0;
+    size_t firstIndex = 0;
+    for (const Geometry& batch : geometry)
+    {
+        if (batch.indices.empty())
+        {
+            continue;
+        }
+
+        firstVertex = AlignToTriangle(firstVertex);
+        std::memcpy(vertices + firstVertex, batch.vertices.data(), sizeof(SimpleVertex) * batch.vertices.size());
+        std::memcpy(indices + firstIndex, batch.indices.data(), sizeof(uint32_t) * batch.indices.size());
+        firstVertex += batch.vertices.size();
+        firstIndex += batch.indices.size();
+    }
+}
+
+VkBuffer DynamicBatcher::GetVertexBuffer() const
+{
+    return vertexBuffer._buffer;
+}
+
+VkBuffer DynamicBatcher::GetIndexBuffer() const
+{
+    return indexBuffer._buffer;
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+void DynamicBatcher::Reserve(AllocatedBuffer& buffer, void*& mapped, VkDeviceSize& capacity, const VkDeviceSize bytes, const VkBufferUsageFlags usage)
+{
+    if (bytes <= capacity)
+    {
+        return;
+    }
+
+    if (buffer.IsInitialized())
+    {
+        vmaDestroyBuffer(allocator, buffer._buffer, buffer._allocation);
+        buffer = AllocatedBuffer{};
+        mapped = nullptr;
+        capacity = 0;
+    }
+
+    // doubles, so a growing scene only reallocates a handful of times
+    VkDeviceSize newCapacity = 64 * 1024;
+    while (newCapacity < bytes)
+    {
+        newCapacity *= 2;
+    }
+
+    // written by the CPU every frame and read once by the GPU, so it is never staged
+    VkBufferCreateInfo bufferInfo = {};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = newCapacity;
+    bufferInfo.usage = usage;
+
+    VmaAllocationCreateInfo allocInfo = {};
+    allocInfo.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
+    allocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+    allocInfo.requiredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
+    VmaAllocationInfo allocationInfo = {};
+    if (vmaCreateBuffer(allocator, &bufferInfo, &allocInfo, &buffer._buffer, &buffer._allocation, &allocationInfo) != VK_SUCCESS)
+    {
+        buffer = AllocatedBuffer{};
+        throw std::runtime_error("Failed to create a dynamic batch buffer.");
+    }
+    mapped = allocationInfo.pMappedData;
+    capacity = newCapacity;
+}
+
+} // namespace velecs
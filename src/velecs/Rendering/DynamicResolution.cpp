@@ -0,0 +1,80 @@
+/// @file    DynamicResolution.cpp
+/// @author  Matthew Green
+/// @date    2024-01-10 09:18:33
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Rendering/DynamicResolution.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace velecs {
+
+// Public Fields
+
+// Constructors and Destructors
+
+// Public Methods
+
+void DynamicResolution::Update(const float gpuFrameTimeMs)
+{
+    if (gpuFrameTimeMs <= 0.0f || targetFrameTimeMs <= 0.0f)
+    {
+        return;
+    }
+
+    smoothedFrameTimeMs = smoothedFrameTimeMs > 0.0f ?
+        smoothedFrameTimeMs + (gpuFrameTimeMs - smoothedFrameTimeMs) * SMOOTHING :
+        gpuFrameTimeMs;
+
+    const float ratio = targetFrameTimeMs / smoothedFrameTimeMs;
+    if (std::abs(ratio - 1.0f) < DEAD_BAND)
+    {
+        return;
+    }
+
+    const float desiredScale = scale * std::sqrt(ratio);
+    const float step = std::clamp(desiredScale - scale, -MAX_STEP, MAX_STEP);
+    scale = std::clamp(scale + step, minScale, maxScale);
+}
+
+void DynamicResolution::Reset()
+{
+    scale = maxScale;
+    smoothedFrameTimeMs = 0.0f;
+}
+
+float DynamicResolution::GetScale() const
+{
+    return enabled ? scale : 1.0f;
+}
+
+float DynamicResolution::GetSmoothedFrameTimeMs() const
+{
+    return smoothedFrameTimeMs;
+}
+
+VkExtent2D DynamicResolution::GetRenderExtent(const VkExtent2D fullExtent) const
+{
+    const float currentScale = GetScale();
+    return VkExtent2D
+    {
+        std::max(1u, static_cast<uint32_t>(static_cast<float>(fullExtent.width) * currentScale)),
+        std::max(1u, static_cast<uint32_t>(static_cast<float>(fullExtent.height) * currentScale))
+    };
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+} // namespace velecs
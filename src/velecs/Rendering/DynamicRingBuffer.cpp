@@ -0,0 +1,206 @@
+/// @file    DynamicRingBuffer.cpp
+/// @author  Matthew Green
+/// @date    2024-01-18 10:27:33
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Rendering/DynamicRingBuffer.h"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+namespace velecs {
+
+// Public Fields
+
+// Constructors and Destructors
+
+// Public Methods
+
+void DynamicRingBuffer::Init
+(
+    VkDevice device,
+    VkPhysicalDevice physicalDevice,
+    VmaAllocator allocator,
+    DescriptorLayoutCache& layoutCache,
+    DescriptorAllocator& descriptorAllocator,
+    const VkDeviceSize capacity /*= DEFAULT_CAPACITY*/
+)
+{
+    this->allocator = allocator;
+    // every offset stays below capacity - range, so each descriptor range stays inside the buffer
+    this->capacity = std::max(capacity, STORAGE_RANGE);
+
+    VkPhysicalDeviceProperties properties = {};
+    vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+    uniformAlignment = std::max<VkDeviceSize>(properties.limits.minUniformBufferOffsetAlignment, 1);
+    storageAlignment = std::max<VkDeviceSize>(properties.limits.minStorageBufferOffsetAlignment, 1);
+
+    // BUFFER
+
+    VkBufferCreateInfo bufferInfo = {};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = this->capacity;
+    bufferInfo.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+
+    //written every frame and read once, so it stays in host memory the GPU reads directly
+    VmaAllocationCreateInfo vmaallocInfo = {};
+    vmaallocInfo.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
+    vmaallocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+    vmaallocInfo.requiredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
+    VmaAllocationInfo allocationInfo = {};
+    if (vmaCreateBuffer(allocator, &bufferInfo, &vmaallocInfo, &buffer._buffer, &buffer._allocation, &allocationInfo) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create the dynamic ring buffer.");
+    }
+    mapped = static_cast<uint8_t*>(allocationInfo.pMappedData);
+
+    // LAYOUT
+
+    VkDescriptorSetLayoutBinding bindings[2] = {};
+
+    bindings[0].binding = UNIFORM_BINDING;
+    bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    bindings[0].descriptorCount = 1;
+    bindings[0].stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT | VK_SHADER_STAGE_COMPUTE_BIT;
+
+    bindings[1].binding = STORAGE_BINDING;
+    bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+    bindings[1].descriptorCount = 1;
+    bindings[1].stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT | VK_SHADER_STAGE_COMPUTE_BIT;
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo = {};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.bindingCount = 2;
+    layoutInfo.pBindings = bindings;
+
+    layout = layoutCache.CreateLayout(layoutInfo);
+
+    // SET
+
+    // written once, the dynamic offsets do the rest
+    set = descriptorAllocator.Allocate(layout);
+
+    VkDescriptorBufferInfo uniformInfo = {};
+    uniformInfo.buffer = buffer._buffer;
+    uniformInfo.offset = 0;
+    uniformInfo.range = UNIFORM_RANGE;
+
+    VkDescriptorBufferInfo storageInfo = {};
+    storageInfo.buffer = buffer._buffer;
+    storageInfo.offset = 0;
+    storageInfo.range = STORAGE_RANGE;
+
+    VkWriteDescriptorSet writes[2] = {};
+    writes[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    writes[0].dstSet = set;
+    writes[0].dstBinding = UNIFORM_BINDING;
+    writes[0].descriptorCount = 1;
+    writes[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    writes[0].pBufferInfo = &uniformInfo;
+
+    writes[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    writes[1].dstSet = set;
+    writes[1].dstBinding = STORAGE_BINDING;
+    writes[1].descriptorCount = 1;
+    writes[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+    writes[1].pBufferInfo = &storageInfo;
+
+    vkUpdateDescriptorSets(device, 2, writes, 0, nullptr);
+}
+
+void DynamicRingBuffer::Cleanup()
+{
+    if (buffer.IsInitialized())
+    {
+        vmaDestroyBuffer(allocator, buffer._buffer, buffer._allocation);
+        buffer = AllocatedBuffer{};
+        mapped = nullptr;
+    }
+
+    layout = VK_NULL_HANDLE;
+    set = VK_NULL_HANDLE;
+}
+
+void DynamicRingBuffer::Reset()
+{
+    head = 0;
+}
+
+DynamicRingBuffer::Allocation DynamicRingBuffer::Allocate(const VkDeviceSize size, const Usage usage /*= Usage::Uniform*/)
+{
+    const VkDeviceSize range = usage == Usage::Uniform ? UNIFORM_RANGE : STORAGE_RANGE;
+    const VkDeviceSize alignment = usage == Usage::Uniform ? uniformAlignment : storageAlignment;
+
+    if (size > range)
+    {
+        std::ostringstream oss;
+        oss << "Dynamic ring allocation of " << size << " bytes exceeds the " << range << " byte binding range.";
+        throw std::runtime_error(oss.str());
+    }
+
+    const VkDeviceSize offset = (head + alignment - 1) / alignment * alignment;
+    if (offset + range > capacity)
+    {
+        std::ostringstream oss;
+        oss << "Dynamic ring buffer is full (" << capacity << " bytes per frame).";
+        throw std::runtime_error(oss.str());
+    }
+
+    head = offset + size;
+
+    Allocation allocation;
+    allocation.data = mapped + offset;
+    allocation.offset = static_cast<uint32_t>(offset);
+    return allocation;
+}
+
+bool DynamicRingBuffer::HasRoom(const Usage usage /*= Usage::Uniform*/) const
+{
+    const VkDeviceSize range = usage == Usage::Uniform ? UNIFORM_RANGE : STORAGE_RANGE;
+    const VkDeviceSize alignment = usage == Usage::Uniform ? uniformAlignment : storageAlignment;
+
+    const VkDeviceSize offset = (head + alignment - 1) / alignment * alignment;
+    return offset + range <= capacity;
+}
+
+void DynamicRingBuffer::Bind
+(
+    VkCommandBuffer cmd,
+    VkPipelineLayout pipelineLayout,
+    const uint32_t uniformOffset,
+    const uint32_t storageOffset /*= 0*/,
+    const uint32_t setIndex /*= 2*/,
+    const VkPipelineBindPoint bindPoint /*= VK_PIPELINE_BIND_POINT_GRAPHICS*/
+) const
+{
+    // dynamic offsets are consumed in binding order
+    const uint32_t offsets[] = {uniformOffset, storageOffset};
+    vkCmdBindDescriptorSets(cmd, bindPoint, pipelineLayout, setIndex, 1, &set, 2, offsets);
+}
+
+VkDescriptorSetLayout DynamicRingBuffer::GetLayout() const
+{
+    return layout;
+}
+
+VkDeviceSize DynamicRingBuffer::GetUsedBytes() const
+{
+    return head;
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+} // namespace velecs
@@ -0,0 +1,390 @@
+/// @file    FrameCapture.cpp
+/// @author  Matthew Green
+/// @date    2024-01-15 09:52:14
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Rendering/FrameCapture.h"
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stb_image_write.h>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace velecs {
+
+// Public Fields
+
+// Constructors and Destructors
+
+// Public Methods
+
+void FrameCapture::Init(VmaAllocator allocator)
+{
+    this->allocator = allocator;
+    stopping = false;
+    worker = std::thread(&FrameCapture::WorkerLoop, this);
+}
+
+void FrameCapture::Cleanup()
+{
+    if (!worker.joinable())
+    {
+        return;
+    }
+
+    // The GPU is idle, so every recorded copy has landed
+    OnFrameRetired();
+
+    {
+        std::lock_guard<std::mutex> lock(workMutex);
+        stopping = true;
+    }
+    workCondition.notify_one();
+    worker.join();
+
+    for (Slot& slot : slots)
+    {
+        if (slot.buffer.IsInitialized())
+        {
+            vmaDestroyBuffer(allocator, slot.buffer._buffer, slot.buffer._allocation);
+            slot.buffer = AllocatedBuffer{};
+        }
+        slot.mapped = nullptr;
+        slot.size = 0;
+        slot.state = SlotState::Free;
+    }
+}
+
+void FrameCapture::Capture(const std::string& path, const Format format /*= Format::PNG*/, const Source source /*= Source::Swapchain*/)
+{
+    std::lock_guard<std::mutex> lock(requestMutex);
+    requests.push_back(Request{path, format, source});
+}
+
+void FrameCapture::StartRecording(const std::string& directory, const Format format /*= Format::Raw*/, const Source source /*= Source::Swapchain*/)
+{
+    std::lock_guard<std::mutex> lock(requestMutex);
+    recording = true;
+    recordingDirectory = directory;
+    recordingFormat = format;
+    recordingSource = source;
+    recordingFrame = 0;
+    droppedFrames = 0;
+}
+
+void FrameCapture::StopRecording()
+{
+    std::lock_guard<std::mutex> lock(requestMutex);
+    recording = false;
+}
+
+bool FrameCapture::IsRecording() const
+{
+    std::lock_guard<std::mutex> lock(requestMutex);
+    return recording;
+}
+
+uint32_t FrameCapture::GetDroppedFrameCount() const
+{
+    return droppedFrames;
+}
+
+void FrameCapture::RecordCopy
+(
+    VkCommandBuffer cmd,
+    const Source source,
+    VkImage image,
+    const VkImageLayout layout,
+    const VkFormat format,
+    const VkExtent2D extent,
+    const bool servesScene /*= false*/
+)
+{
+    const auto matches = [&](const Source requested)
+    {
+        return requested == source || (servesScene && requested == Source::Scene);
+    };
+
+    Slot* slot = nullptr;
+    for (Slot& candidate : slots)
+    {
+        if (candidate.state == SlotState::Free)
+        {
+            slot = &candidate;
+            break;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(requestMutex);
+
+        const auto request = std::find_if(requests.begin(), requests.end(), [&](const Request& r) { return matches(r.source); });
+        const bool recordFrame = recording && matches(recordingSource);
+        if (request == requests.end() && !recordFrame)
+        {
+            return;
+        }
+
+        if (slot == nullptr)
+        {
+            if (request == requests.end())
+            {
+                ++droppedFrames; // Screenshots wait for a free buffer, recordings cannot
+            }
+            return;
+        }
+
+        if (request != requests.end())
+        {
+            slot->path = request->path;
+            slot->format = request->format;
+            slot->announce = true;
+            requests.erase(request);
+        }
+        else
+        {
+            std::ostringstream name;
+            name << "Frame_" << std::setw(6) << std::setfill('0') << recordingFrame++ << (recordingFormat == Format::PNG ? ".png" : ".raw");
+            slot->path = (std::filesystem::path(recordingDirectory) / name.str()).string();
+            slot->format = recordingFormat;
+            slot->announce = false;
+        }
+    }
+
+    const bool bgra = format == VK_FORMAT_B8G8R8A8_UNORM || format == VK_FORMAT_B8G8R8A8_SRGB;
+    const bool rgba = format == VK_FORMAT_R8G8B8A8_UNORM || format == VK_FORMAT_R8G8B8A8_SRGB;
+    if ((!bgra && !rgba) || extent.width == 0 || extent.height == 0)
+    {
+        std::cerr << "[WARNING] [FrameCapture] Cannot capture '" << slot->path << "', the image format " << format << " is not 8-bit RGBA or BGRA." << std::endl;
+        return;
+    }
+
+    Reserve(*slot, static_cast<VkDeviceSize>(extent.width) * extent.height * 4);
+    slot->extent = extent;
+    slot->swizzle = bgra;
+
+    VkImageMemoryBarrier toTransfer = {};
+    toTransfer.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    toTransfer.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+    toTransfer.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    toTransfer.oldLayout = layout;
+    toTransfer.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    toTransfer.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toTransfer.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toTransfer.image = image;
+    toTransfer.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+
+    vkCmdPipelineBarrier
+    (
+        cmd,
+        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        0,
+        0, nullptr,
+        0, nullptr,
+        1, &toTransfer
+    );
+
+    VkBufferImageCopy region = {};
+    region.bufferOffset = 0;
+    region.bufferRowLength = 0;
+    region.bufferImageHeight = 0;
+    region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+    region.imageOffset = {0, 0, 0};
+    region.imageExtent = {extent.width, extent.height, 1};
+
+    vkCmdCopyImageToBuffer(cmd, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, slot->buffer._buffer, 1, &region);
+
+    VkImageMemoryBarrier toOriginal = toTransfer;
+    toOriginal.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    toOriginal.dstAccessMask = 0;
+    toOriginal.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    toOriginal.newLayout = layout;
+
+    VkBufferMemoryBarrier toHost = {};
+    toHost.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    toHost.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    toHost.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    toHost.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toHost.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toHost.buffer = slot->buffer._buffer;
+    toHost.offset = 0;
+    toHost.size = VK_WHOLE_SIZE;
+
+    vkCmdPipelineBarrier
+    (
+        cmd,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT | VK_PIPELINE_STAGE_HOST_BIT,
+        0,
+        0, nullptr,
+        1, &toHost,
+        1, &toOriginal
+    );
+
+    slot->state = SlotState::Recorded;
+}
+
+void FrameCapture::OnFrameRetired()
+{
+    bool handedOff = false;
+    {
+        std::lock_guard<std::mutex> lock(workMutex);
+        for (uint32_t i = 0; i < RING_SIZE; ++i)
+        {
+            if (slots[i].state == SlotState::Recorded)
+            {
+                slots[i].state = SlotState::Encoding;
+                encodeQueue.push_back(i);
+                handedOff = true;
+            }
+        }
+    }
+
+    if (handedOff)
+    {
+        workCondition.notify_one();
+    }
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+void FrameCapture::WorkerLoop()
+{
+    while (true)
+    {
+        uint32_t slotIndex;
+        {
+            std::unique_lock<std::mutex> lock(workMutex);
+            workCondition.wait(lock, [this]() { return stopping || !encodeQueue.empty(); });
+            if (encodeQueue.empty())
+            {
+                return; // Stopping with nothing left to write
+            }
+            slotIndex = encodeQueue.front();
+            encodeQueue.pop_front();
+        }
+
+        try
+        {
+            Encode(slotIndex);
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "[ERROR] [FrameCapture] " << e.what() << std::endl;
+            slots[slotIndex].state = SlotState::Free;
+        }
+    }
+}
+
+void FrameCapture::Encode(const uint32_t slotIndex)
+{
+    Slot& slot = slots[slotIndex];
+
+    const uint32_t width = slot.extent.width;
+    const uint32_t height = slot.extent.height;
+    const size_t byteCount = static_cast<size_t>(width) * height * 4;
+
+    vmaInvalidateAllocation(allocator, slot.buffer._allocation, 0, VK_WHOLE_SIZE);
+
+    std::vector<uint8_t> pixels(byteCount);
+    std::memcpy(pixels.data(), slot.mapped, byteCount);
+
+    const std::string path = slot.path;
+    const Format format = slot.format;
+    const bool swizzle = slot.swizzle;
+    const bool announce = slot.announce;
+
+    // The pixels are ours now, the render thread can reuse the buffer while we encode
+    slot.state = SlotState::Free;
+
+    if (swizzle)
+    {
+        for (size_t i = 0; i < byteCount; i += 4)
+        {
+            std::swap(pixels[i], pixels[i + 2]);
+        }
+    }
+
+    const std::filesystem::path directory = std::filesystem::path(path).parent_path();
+    if (!directory.empty())
+    {
+        std::filesystem::create_directories(directory);
+    }
+
+    if (format == Format::PNG)
+    {
+        if (stbi_write_png(path.c_str(), static_cast<int>(width), static_cast<int>(height), 4, pixels.data(), static_cast<int>(width * 4)) == 0)
+        {
+            throw std::runtime_error("Failed to write '" + path + "'.");
+        }
+    }
+    else
+    {
+        std::ofstream file(path, std::ios::binary);
+        if (!file)
+        {
+            throw std::runtime_error("Failed to open '" + path + "'.");
+        }
+        file.write(reinterpret_cast<const char*>(pixels.data()), static_cast<std::streamsize>(byteCount));
+    }
+
+    if (announce)
+    {
+        std::cout << "[INFO] [FrameCapture] Saved " << width << 'x' << height << " capture to '" << path << "'." << std::endl;
+    }
+}
+
+void FrameCapture::Reserve(Slot& slot, const VkDeviceSize size)
+{
+    if (slot.size >= size)
+    {
+        return;
+    }
+
+    if (slot.buffer.IsInitialized())
+    {
+        vmaDestroyBuffer(allocator, slot.buffer._buffer, slot.buffer._allocation);
+        slot.buffer = AllocatedBuffer{};
+        slot.mapped = nullptr;
+        slot.size = 0;
+    }
+
+    VkBufferCreateInfo bufferInfo = {};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = size;
+    bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+
+    VmaAllocationCreateInfo allocInfo = {};
+    allocInfo.usage = VMA_MEMORY_USAGE_GPU_TO_CPU;
+    allocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+    VmaAllocationInfo allocationInfo = {};
+    if (vmaCreateBuffer(allocator, &bufferInfo, &allocInfo, &slot.buffer._buffer, &slot.buffer._allocation, &allocationInfo) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create a frame capture readback buffer.");
+    }
+
+    slot.mapped = allocationInfo.pMappedData;
+    slot.size = size;
+}
+
+} // namespace velecs
@@ -0,0 +1,243 @@
+/// @file    GlyphAtlas.cpp
+/// @author  Matthew Green
+/// @date    2024-01-22 10:52:08
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#define STB_TRUETYPE_IMPLEMENTATION
+#include "velecs/Rendering/GlyphAtlas.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+
+namespace velecs {
+
+// Public Fields
+
+// Constructors and Destructors
+
+GlyphAtlas::GlyphAtlas(std::vector<unsigned char> fontData, const uint32_t size /*= DEFAULT_SIZE*/)
+    : fontData(std::move(fontData)), size(size), pixels(static_cast<size_t>(size) * size, 0)
+{
+    if (this->fontData.empty() || stbtt_InitFont(&fontInfo, this->fontData.data(), stbtt_GetFontOffsetForIndex(this->fontData.data(), 0)) == 0)
+    {
+        throw std::runtime_error("Failed to parse the font.");
+    }
+
+    pixelScale = stbtt_ScaleForMappingEmToPixels(&fontInfo, GLYPH_PIXELS_PER_EM);
+    emScale = stbtt_ScaleForMappingEmToPixels(&fontInfo, 1.0f);
+
+    int fontAscent = 0;
+    int fontDescent = 0;
+    int fontLineGap = 0;
+    stbtt_GetFontVMetrics(&fontInfo, &fontAscent, &fontDescent, &fontLineGap);
+    ascent = fontAscent * emScale;
+    lineHeight = (fontAscent - fontDescent + fontLineGap) * emScale;
+}
+
+// Public Methods
+
+std::unique_ptr<GlyphAtlas> GlyphAtlas::Load(const std::string& filePath, const uint32_t size /*= DEFAULT_SIZE*/)
+{
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file.is_open())
+    {
+        throw std::runtime_error("Failed to open font file: " + filePath);
+    }
+
+    std::vector<unsigned char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    try
+    {
+        return std::make_unique<GlyphAtlas>(std::move(data), size);
+    }
+    catch (const std::runtime_error&)
+    {
+        throw std::runtime_error("Failed to parse font file: " + filePath);
+    }
+}
+
+const GlyphAtlas::Glyph& GlyphAtlas::GetGlyph(const uint32_t codepoint)
+{
+    const auto found = glyphs.find(codepoint);
+    if (found != glyphs.end())
+    {
+        return found->second;
+    }
+
+    const Glyph glyph = Rasterize(codepoint);
+    return glyphs.emplace(codepoint, glyph).first->second;
+}
+
+float GlyphAtlas::GetKerning(const uint32_t left, const uint32_t right) const
+{
+    return stbtt_GetCodepointKernAdvance(&fontInfo, static_cast<int>(left), static_cast<int>(right)) * emScale;
+}
+
+float GlyphAtlas::GetAscent() const
+{
+    return ascent;
+}
+
+float GlyphAtlas::GetLineHeight() const
+{
+    return lineHeight;
+}
+
+uint32_t GlyphAtlas::GetGeneration() const
+{
+    return generation;
+}
+
+uint32_t GlyphAtlas::GetSize() const
+{
+    return size;
+}
+
+const std::vector<unsigned char>& GlyphAtlas::GetPixels() const
+{
+    return pixels;
+}
+
+bool GlyphAtlas::TakeDirtyRows(uint32_t& firstRow, uint32_t& rowCount)
+{
+    if (dirtyBegin >= dirtyEnd)
+    {
+        return false;
+    }
+
+    firstRow = dirtyBegin;
+    rowCount = dirtyEnd - dirtyBegin;
+    dirtyBegin = UINT32_MAX;
+    dirtyEnd = 0;
+    return true;
+}
+
+size_t GlyphAtlas::GetGlyphCount() const
+{
+    return glyphs.size();
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+GlyphAtlas::Glyph GlyphAtlas::Rasterize(const uint32_t codepoint)
+{
+    Glyph glyph;
+
+    int advance = 0;
+    int leftSideBearing = 0;
+    stbtt_GetCodepointHMetrics(&fontInfo, static_cast<int>(codepoint), &advance, &leftSideBearing);
+    glyph.advance = advance * emScale;
+
+    // the distance falls from ON_EDGE_VALUE to 0 across SDF_PADDING texels outside the outline
+    const float pixelDistanceScale = static_cast<float>(ON_EDGE_VALUE) / static_cast<float>(SDF_PADDING);
+
+    int width = 0;
+    int height = 0;
+    int offsetX = 0;
+    int offsetY = 0;
+    unsigned char* bitmap = stbtt_GetCodepointSDF(&fontInfo, pixelScale, static_cast<int>(codepoint),
+        SDF_PADDING, ON_EDGE_VALUE, pixelDistanceScale, &width, &height, &offsetX, &offsetY);
+    if (bitmap == nullptr)
+    {
+        return glyph; // Whitespace, or a codepoint the font has no outline for
+    }
+
+    uint32_t x = 0;
+    uint32_t y = 0;
+    if (!Allocate(static_cast<uint32_t>(width), static_cast<uint32_t>(height), x, y))
+    {
+        // the glyphs of every layout are about to be stale anyway, start over with room for this one
+        Clear();
+        if (!Allocate(static_cast<uint32_t>(width), static_cast<uint32_t>(height), x, y))
+        {
+            stbtt_FreeSDF(bitmap, nullptr);
+            std::cout << "[WARNING] [Rendering] Glyph " << codepoint << " is larger than its " << size << "x" << size << " atlas" << std::endl;
+            return glyph;
+        }
+    }
+
+    for (int row = 0; row < height; ++row)
+    {
+        std::memcpy(&pixels[(static_cast<size_t>(y) + row) * size + x], bitmap + static_cast<size_t>(row) * width, static_cast<size_t>(width));
+    }
+    stbtt_FreeSDF(bitmap, nullptr);
+
+    // the gutter row below is uploaded too, it may still hold a glyph of an earlier generation on the GPU
+    dirtyBegin = std::min(dirtyBegin, y);
+    dirtyEnd = std::max(dirtyEnd, std::min(y + static_cast<uint32_t>(height) + GUTTER, size));
+
+    // stb_truetype places the bitmap from the pen position with y down, the quads are y up
+    const float texelsToEms = 1.0f / GLYPH_PIXELS_PER_EM;
+    glyph.rect = glm::vec4
+    {
+        offsetX * texelsToEms,
+        -(offsetY + height) * texelsToEms,
+        (offsetX + width) * texelsToEms,
+        -offsetY * texelsToEms
+    };
+
+    const float texelsToUV = 1.0f / static_cast<float>(size);
+    glyph.uvRect = glm::vec4
+    {
+        x * texelsToUV,
+        y * texelsToUV,
+        (x + width) * texelsToUV,
+        (y + height) * texelsToUV
+    };
+    glyph.visible = true;
+
+    return glyph;
+}
+
+bool GlyphAtlas::Allocate(const uint32_t width, const uint32_t height, uint32_t& x, uint32_t& y)
+{
+    const uint32_t paddedWidth = width + GUTTER;
+    const uint32_t paddedHeight = height + GUTTER;
+
+    if (shelfX + paddedWidth > size)
+    {
+        // next shelf
+        shelfY += shelfHeight;
+        shelfX = 0;
+        shelfHeight = 0;
+    }
+
+    if (paddedWidth > size || shelfY + paddedHeight > size)
+    {
+        return false;
+    }
+
+    x = shelfX;
+    y = shelfY;
+    shelfX += paddedWidth;
+    shelfHeight = std::max(shelfHeight, paddedHeight);
+    return true;
+}
+
+void GlyphAtlas::Clear()
+{
+    glyphs.clear();
+    std::fill(pixels.begin(), pixels.end(), static_cast<unsigned char>(0));
+    shelfX = 0;
+    shelfY = 0;
+    shelfHeight = 0;
+    ++generation;
+
+    std::cout << "[INFO] [Rendering] Glyph atlas is full, emptied it for generation " << generation << std::endl;
+}
+
+} // namespace velecs
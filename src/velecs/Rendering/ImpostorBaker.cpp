@@ -0,0 +1,204 @@
+/// @file    ImpostorBaker.cpp
+/// @author  Matthew Green
+/// @date    2024-01-27 09:48:03
+///
+/// @section LICENSE
+///
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Rendering/ImpostorBaker.h"
+
+#include <glm/geometric.hpp>
+#include <glm/gtc/constants.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace velecs {
+
+// Public Fields
+
+// Constructors and Destructors
+
+// Public Methods
+
+ImpostorBaker::Result ImpostorBaker::Bake
+(
+    const std::vector<SimpleVertex>& vertices,
+    const std::vector<uint32_t>& indices,
+    const uint32_t frameCount /*= DEFAULT_FRAME_COUNT*/,
+    const uint32_t frameSize /*= DEFAULT_FRAME_SIZE*/
+)
+{
+    if (indices.size() < 3 || indices.size() % 3 != 0)
+    {
+        throw std::runtime_error("Impostor bake needs a triangle list.");
+    }
+    if (frameCount == 0 || frameSize == 0)
+    {
+        throw std::runtime_error("Impostor bake needs at least one frame of at least one texel.");
+    }
+
+    glm::vec3 min{std::numeric_limits<float>::max()};
+    glm::vec3 max{std::numeric_limits<float>::lowest()};
+    for (const uint32_t index : indices)
+    {
+        if (index >= vertices.size())
+        {
+            throw std::runtime_error("Impostor bake index " + std::to_string(index) + " is out of range.");
+        }
+        min = glm::min(min, vertices[index].position);
+        max = glm::max(max, vertices[index].position);
+    }
+
+    Result result;
+    ImpostorAtlas& atlas = result.atlas;
+    atlas.frameCount = frameCount;
+    atlas.columns = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<float>(frameCount))));
+    atlas.rows = (frameCount + atlas.columns - 1) / atlas.columns;
+    atlas.center = (min + max) * 0.5f;
+    atlas.radius = std::max(glm::length(max - min) * 0.5f, 1e-4f); // a sphere, so every yaw fits the same square
+
+    const uint32_t width = atlas.columns * frameSize;
+    const uint32_t height = atlas.rows * frameSize;
+    const size_t texelCount = static_cast<size_t>(width) * height;
+
+    // empty texels stay white so filtering does not darken the silhouette
+    std::vector<uint8_t> color(texelCount * 4, 255);
+    std::vector<uint8_t> normalDepth(texelCount * 4);
+    for (size_t texel = 0; texel < texelCount; ++texel)
+    {
+        color[texel * 4 + 3] = 0;
+        normalDepth[texel * 4 + 0] = 128;
+        normalDepth[texel * 4 + 1] = 128;
+        normalDepth[texel * 4 + 2] = 255;
+        normalDepth[texel * 4 + 3] = 255;
+    }
+
+    std::vector<float> depth(static_cast<size_t>(frameSize) * frameSize);
+    std::vector<glm::vec3> projected(vertices.size());
+
+    const float halfSize = static_cast<float>(frameSize) * 0.5f;
+    const float invRadius = 1.0f / atlas.radius;
+
+    for (uint32_t frame = 0; frame < frameCount; ++frame)
+    {
+        // the camera sits on direction, looking back at the center with Y up
+        const float yaw = glm::two_pi<float>() * static_cast<float>(frame) / static_cast<float>(frameCount);
+        const glm::vec3 direction{std::sin(yaw), 0.0f, std::cos(yaw)};
+        const glm::vec3 right{direction.z, 0.0f, -direction.x};
+        const glm::vec3 up{0.0f, 1.0f, 0.0f};
+
+        const uint32_t originX = (frame % atlas.columns) * frameSize;
+        const uint32_t originY = (frame / atlas.columns) * frameSize;
+
+        // x and y in texels with row 0 at the top, z in [0, 1] with 0 at the front
+        for (size_t vertex = 0; vertex < vertices.size(); ++vertex)
+        {
+            const glm::vec3 local = (vertices[vertex].position - atlas.center) * invRadius;
+            projected[vertex] = glm::vec3
+            {
+                (glm::dot(local, right) + 1.0f) * halfSize,
+                (1.0f - glm::dot(local, up)) * halfSize,
+                0.5f - 0.5f * glm::dot(local, direction)
+            };
+        }
+
+        std::fill(depth.begin(), depth.end(), 1.0f);
+
+        for (size_t triangle = 0; triangle < indices.size(); triangle += 3)
+        {
+            const uint32_t i0 = indices[triangle + 0];
+            const uint32_t i1 = indices[triangle + 1];
+            const uint32_t i2 = indices[triangle + 2];
+
+            const glm::vec3& a = projected[i0];
+            const glm::vec3& b = projected[i1];
+            const glm::vec3& c = projected[i2];
+
+            const float area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+            if (std::abs(area) < 1e-12f)
+            {
+                continue; // Edge on
+            }
+
+            // two sided, the normal is turned to face the camera
+            glm::vec3 normal = glm::cross(vertices[i1].position - vertices[i0].position, vertices[i2].position - vertices[i0].position);
+            const float normalLength = glm::length(normal);
+            normal = normalLength > 0.0f ? normal / normalLength : direction;
+            if (glm::dot(normal, direction) < 0.0f)
+            {
+                normal = -normal;
+            }
+            const uint8_t encoded[3] =
+            {
+                static_cast<uint8_t>(std::lround((glm::dot(normal, right) * 0.5f + 0.5f) * 255.0f)),
+                static_cast<uint8_t>(std::lround((glm::dot(normal, up) * 0.5f + 0.5f) * 255.0f)),
+                static_cast<uint8_t>(std::lround((glm::dot(normal, direction) * 0.5f + 0.5f) * 255.0f)),
+            };
+
+            const uint32_t firstX = static_cast<uint32_t>(std::max(0.0f, std::floor(std::min({a.x, b.x, c.x}))));
+            const uint32_t firstY = static_cast<uint32_t>(std::max(0.0f, std::floor(std::min({a.y, b.y, c.y}))));
+            const float lastX = std::min(static_cast<float>(frameSize - 1), std::floor(std::max({a.x, b.x, c.x})));
+            const float lastY = std::min(static_cast<float>(frameSize - 1), std::floor(std::max({a.y, b.y, c.y})));
+            if (lastX < 0.0f || lastY < 0.0f)
+            {
+                continue;
+            }
+
+            const float invArea = 1.0f / area;
+            for (uint32_t y = firstY; y <= static_cast<uint32_t>(lastY); ++y)
+            {
+                for (uint32_t x = firstX; x <= static_cast<uint32_t>(lastX); ++x)
+                {
+                    const float px = static_cast<float>(x) + 0.5f;
+                    const float py = static_cast<float>(y) + 0.5f;
+
+                    // barycentrics share the sign of area inside the triangle, either winding
+                    const float w0 = ((b.x - px) * (c.y - py) - (b.y - py) * (c.x - px)) * invArea;
+                    const float w1 = ((c.x - px) * (a.y - py) - (c.y - py) * (a.x - px)) * invArea;
+                    const float w2 = 1.0f - w0 - w1;
+                    if (w0 < 0.0f || w1 < 0.0f || w2 < 0.0f)
+                    {
+                        continue;
+                    }
+
+                    const float z = w0 * a.z + w1 * b.z + w2 * c.z;
+                    float& stored = depth[static_cast<size_t>(y) * frameSize + x];
+                    if (z >= stored)
+                    {
+                        continue;
+                    }
+                    stored = z;
+
+                    const size_t texel = ((static_cast<size_t>(originY) + y) * width + originX + x) * 4;
+                    color[texel + 3] = 255;
+                    normalDepth[texel + 0] = encoded[0];
+                    normalDepth[texel + 1] = encoded[1];
+                    normalDepth[texel + 2] = encoded[2];
+                    normalDepth[texel + 3] = static_cast<uint8_t>(std::lround(std::clamp(z, 0.0f, 1.0f) * 255.0f));
+                }
+            }
+        }
+    }
+
+    result.color = TextureData::FromRGBA8(color.data(), width, height);
+    result.normalDepth = TextureData::FromRGBA8(normalDepth.data(), width, height);
+
+    return result;
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+} // namespace velecs
@@ -0,0 +1,601 @@
+/// @file    MeshOptimizer.cpp
+/// @author  Matthew Green
+/// @date    2024-01-09 10:06:51
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Rendering/MeshOptimizer.h"
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+
+namespace velecs {
+
+namespace {
+
+/// @brief Size of the cache modelled by the Forsyth scores, larger than the hardware so reuse is planned ahead.
+constexpr uint32_t FORSYTH_CACHE_SIZE = 32;
+
+/// @brief Bitwise copy of a position, -0 and 0 are folded together.
+struct PositionKey {
+    uint32_t bits[3];
+
+    bool operator==(const PositionKey& other) const
+    {
+        return bits[0] == other.bits[0] && bits[1] == other.bits[1] && bits[2] == other.bits[2];
+    }
+};
+
+struct PositionKeyHash {
+    size_t operator()(const PositionKey& key) const
+    {
+        // FNV-1a over the three words
+        uint64_t hash = 14695981039346656037ull;
+        for (const uint32_t word : key.bits)
+        {
+            hash = (hash ^ word) * 1099511628211ull;
+        }
+        return static_cast<size_t>(hash);
+    }
+};
+
+PositionKey MakePositionKey(const glm::vec3 position)
+{
+    const glm::vec3 folded = position + glm::vec3{0.0f};
+    PositionKey key;
+    std::memcpy(key.bits, &folded.x, sizeof(float));
+    std::memcpy(key.bits + 1, &folded.y, sizeof(float));
+    std::memcpy(key.bits + 2, &folded.z, sizeof(float));
+    return key;
+}
+
+/// @brief Forsyth's vertex score, high for vertices near the front of the cache and with few triangles left.
+float ScoreVertex(const int32_t cachePosition, const uint32_t liveTriangles)
+{
+    if (liveTriangles == 0)
+    {
+        return -1.0f; // No triangle left to draw with it
+    }
+
+    float score = 0.0f;
+    if (cachePosition >= 0)
+    {
+        if (cachePosition < 3)
+        {
+            score = 0.75f; // Used by the last triangle, fixed so strips and fans are not favoured
+        }
+        else
+        {
+            const float scale = 1.0f / static_cast<float>(FORSYTH_CACHE_SIZE - 3);
+            score = std::pow(1.0f - static_cast<float>(cachePosition - 3) * scale, 1.5f);
+        }
+    }
+
+    // Boost vertices with few triangles left so they are finished off instead of stranded
+    score += 2.0f / std::sqrt(static_cast<float>(liveTriangles));
+    return score;
+}
+
+/// @brief Fills the bounding sphere and normal cone of a meshlet whose index range is set.
+void ComputeMeshletBounds(Meshlet& meshlet, const std::vector<SimpleVertex>& vertices, const std::vector<uint32_t>& indices)
+{
+    const uint32_t lastIndex = meshlet.firstIndex + meshlet.indexCount;
+
+    glm::vec3 min{std::numeric_limits<float>::max()};
+    glm::vec3 max{std::numeric_limits<float>::lowest()};
+    for (uint32_t i = meshlet.firstIndex; i < lastIndex; ++i)
+    {
+        min = glm::min(min, vertices[indices[i]].position);
+        max = glm::max(max, vertices[indices[i]].position);
+    }
+
+    const glm::vec3 center = (min + max) * 0.5f;
+    float radius = 0.0f;
+    for (uint32_t i = meshlet.firstIndex; i < lastIndex; ++i)
+    {
+        radius = std::max(radius, glm::length(vertices[indices[i]].position - center));
+    }
+    meshlet.sphere = glm::vec4{center, radius};
+
+    const auto faceNormal = [&](const uint32_t first)
+    {
+        const glm::vec3& a = vertices[indices[first + 0]].position;
+        const glm::vec3& b = vertices[indices[first + 1]].position;
+        const glm::vec3& c = vertices[indices[first + 2]].position;
+        const glm::vec3 normal = glm::cross(b - a, c - a);
+        const float length = glm::length(normal);
+        return length > 0.0f ? normal / length : glm::vec3{0.0f};
+    };
+
+    glm::vec3 normalSum{0.0f};
+    for (uint32_t i = meshlet.firstIndex; i < lastIndex; i += 3)
+    {
+        normalSum += faceNormal(i);
+    }
+
+    const float axisLength = glm::length(normalSum);
+    if (axisLength < 1e-6f)
+    {
+        meshlet.cone = glm::vec4{0.0f, 0.0f, 0.0f, 1.0f}; // Faces every way, never culled
+        return;
+    }
+    const glm::vec3 axis = normalSum / axisLength;
+
+    float minDot = 1.0f;
+    for (uint32_t i = meshlet.firstIndex; i < lastIndex; i += 3)
+    {
+        const glm::vec3 normal = faceNormal(i);
+        if (normal != glm::vec3{0.0f})
+        {
+            minDot = std::min(minDot, glm::dot(normal, axis));
+        }
+    }
+
+    // The normals lie within acos(minDot) of the axis. Widened by 90 degrees on both sides this
+    // becomes the cone of view directions that see every triangle from behind, whose cosine
+    // is -sin, so the test compares against sin = sqrt(1 - minDot^2)
+    const float cutoff = minDot <= 0.0f ? 1.0f : std::sqrt(1.0f - minDot * minDot);
+    meshlet.cone = glm::vec4{axis, cutoff};
+}
+
+} // namespace
+
+// Public Fields
+
+// Constructors and Destructors
+
+// Public Methods
+
+MeshOptimizer::Report MeshOptimizer::Optimize(std::vector<SimpleVertex>& vertices, std::vector<uint32_t>& indices)
+{
+    Report report;
+    report.verticesBefore = vertices.size();
+    report.trianglesBefore = indices.size() / 3;
+    report.before = AnalyzeVertexCache(indices, vertices.size());
+
+    WeldVertices(vertices, indices);
+    OptimizeVertexCache(indices, vertices.size());
+    OptimizeOverdraw(indices, vertices);
+    OptimizeVertexFetch(vertices, indices);
+
+    report.verticesAfter = vertices.size();
+    report.trianglesAfter = indices.size() / 3;
+    report.after = AnalyzeVertexCache(indices, vertices.size());
+    return report;
+}
+
+void MeshOptimizer::WeldVertices(std::vector<SimpleVertex>& vertices, std::vector<uint32_t>& indices)
+{
+    std::unordered_map<PositionKey, uint32_t, PositionKeyHash> uniqueVertices;
+    uniqueVertices.reserve(vertices.size());
+
+    std::vector<uint32_t> remap(vertices.size());
+    std::vector<SimpleVertex> weldedVertices;
+    weldedVertices.reserve(vertices.size());
+
+    for (size_t i = 0; i < vertices.size(); ++i)
+    {
+        const auto inserted = uniqueVertices.emplace(MakePositionKey(vertices[i].position), static_cast<uint32_t>(weldedVertices.size()));
+        if (inserted.second)
+        {
+            weldedVertices.push_back(vertices[i]);
+        }
+        remap[i] = inserted.first->second;
+    }
+
+    std::vector<uint32_t> weldedIndices;
+    weldedIndices.reserve(indices.size());
+    for (size_t i = 0; i + 2 < indices.size(); i += 3)
+    {
+        const uint32_t a = remap[indices[i]];
+        const uint32_t b = remap[indices[i + 1]];
+        const uint32_t c = remap[indices[i + 2]];
+        if (a == b || b == c || c == a)
+        {
+            continue; // Collapsed to a line or a point
+        }
+
+        weldedIndices.push_back(a);
+        weldedIndices.push_back(b);
+        weldedIndices.push_back(c);
+    }
+
+    vertices.swap(weldedVertices);
+    indices.swap(weldedIndices);
+}
+
+void MeshOptimizer::OptimizeVertexCache(std::vector<uint32_t>& indices, const size_t vertexCount)
+{
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount < 2)
+    {
+        return;
+    }
+
+    // Triangles using each vertex, packed per vertex; the first liveTriangles[v] entries are not drawn yet
+    std::vector<uint32_t> liveTriangles(vertexCount, 0);
+    for (size_t i = 0; i < triangleCount * 3; ++i)
+    {
+        ++liveTriangles[indices[i]];
+    }
+
+    std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; ++v)
+    {
+        adjacencyOffsets[v + 1] = adjacencyOffsets[v] + liveTriangles[v];
+    }
+
+    std::vector<uint32_t> adjacency(triangleCount * 3);
+    std::vector<uint32_t> fillOffsets(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+    for (uint32_t t = 0; t < static_cast<uint32_t>(triangleCount); ++t)
+    {
+        for (int k = 0; k < 3; ++k)
+        {
+            adjacency[fillOffsets[indices[t * 3 + k]]++] = t;
+        }
+    }
+
+    std::vector<int32_t> cachePositions(vertexCount, -1);
+    std::vector<float> vertexScores(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v)
+    {
+        vertexScores[v] = ScoreVertex(-1, liveTriangles[v]);
+    }
+
+    std::vector<float> triangleScores(triangleCount);
+    std::vector<bool> emitted(triangleCount, false);
+    int64_t bestTriangle = -1;
+    float bestScore = -std::numeric_limits<float>::max();
+    for (size_t t = 0; t < triangleCount; ++t)
+    {
+        triangleScores[t] = vertexScores[indices[t * 3]] + vertexScores[indices[t * 3 + 1]] + vertexScores[indices[t * 3 + 2]];
+        if (triangleScores[t] > bestScore)
+        {
+            bestScore = triangleScores[t];
+            bestTriangle = static_cast<int64_t>(t);
+        }
+    }
+
+    std::vector<uint32_t> output;
+    output.reserve(triangleCount * 3);
+    std::vector<uint32_t> cache;
+    std::vector<uint32_t> nextCache;
+    cache.reserve(FORSYTH_CACHE_SIZE + 3);
+    nextCache.reserve(FORSYTH_CACHE_SIZE + 3);
+    size_t inputCursor = 0;
+
+    while (output.size() < triangleCount * 3)
+    {
+        if (bestTriangle < 0)
+        {
+            // Nothing in the cache touches a remaining triangle, restart from the next one in input order
+            while (emitted[inputCursor])
+            {
+                ++inputCursor;
+            }
+            bestTriangle = static_cast<int64_t>(inputCursor);
+        }
+
+        const uint32_t triangle = static_cast<uint32_t>(bestTriangle);
+        const uint32_t* const triangleIndices = indices.data() + static_cast<size_t>(triangle) * 3;
+        emitted[triangle] = true;
+
+        nextCache.clear();
+        for (int k = 0; k < 3; ++k)
+        {
+            const uint32_t vertex = triangleIndices[k];
+            output.push_back(vertex);
+            nextCache.push_back(vertex);
+
+            uint32_t* const live = adjacency.data() + adjacencyOffsets[vertex];
+            uint32_t* const liveEnd = live + liveTriangles[vertex];
+            uint32_t* const found = std::find(live, liveEnd, triangle);
+            if (found != liveEnd)
+            {
+                *found = *(liveEnd - 1);
+                --liveTriangles[vertex];
+            }
+        }
+
+        for (const uint32_t vertex : cache)
+        {
+            if (vertex != triangleIndices[0] && vertex != triangleIndices[1] && vertex != triangleIndices[2])
+            {
+                nextCache.push_back(vertex);
+            }
+        }
+
+        for (size_t i = 0; i < nextCache.size(); ++i)
+        {
+            const uint32_t vertex = nextCache[i];
+            cachePositions[vertex] = i < FORSYTH_CACHE_SIZE ? static_cast<int32_t>(i) : -1;
+            vertexScores[vertex] = ScoreVertex(cachePositions[vertex], liveTriangles[vertex]);
+        }
+
+        // Only triangles touching the cache changed score, the best one among them is drawn next
+        bestTriangle = -1;
+        bestScore = -std::numeric_limits<float>::max();
+        for (const uint32_t vertex : nextCache)
+        {
+            const uint32_t* const live = adjacency.data() + adjacencyOffsets[vertex];
+            for (uint32_t i = 0; i < liveTriangles[vertex]; ++i)
+            {
+                const uint32_t candidate = live[i];
+                const uint32_t* const candidateIndices = indices.data() + static_cast<size_t>(candidate) * 3;
+                const float score = vertexScores[candidateIndices[0]] + vertexScores[candidateIndices[1]] + vertexScores[candidateIndices[2]];
+                triangleScores[candidate] = score;
+
+                if (cachePositions[vertex] >= 0 && score > bestScore)
+                {
+                    bestScore = score;
+                    bestTriangle = static_cast<int64_t>(candidate);
+                }
+            }
+        }
+
+        if (nextCache.size() > FORSYTH_CACHE_SIZE)
+        {
+            nextCache.resize(FORSYTH_CACHE_SIZE);
+        }
+        cache.swap(nextCache);
+    }
+
+    indices.swap(output);
+}
+
+void MeshOptimizer::OptimizeOverdraw
+(
+    std::vector<uint32_t>& indices,
+    const std::vector<SimpleVertex>& vertices,
+    const float threshold /*= DEFAULT_OVERDRAW_THRESHOLD*/
+)
+{
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount < 2)
+    {
+        return;
+    }
+
+    // Split where the cache order already starts over: triangles whose three vertices all miss
+    std::vector<size_t> clusterStarts;
+    {
+        std::vector<uint32_t> timestamps(vertices.size(), 0);
+        uint32_t time = DEFAULT_CACHE_SIZE + 1;
+        for (size_t t = 0; t < triangleCount; ++t)
+        {
+            uint32_t misses = 0;
+            for (int k = 0; k < 3; ++k)
+            {
+                const uint32_t vertex = indices[t * 3 + k];
+                if (time - timestamps[vertex] > DEFAULT_CACHE_SIZE)
+                {
+                    timestamps[vertex] = time++;
+                    ++misses;
+                }
+            }
+
+            if (t == 0 || misses == 3)
+            {
+                clusterStarts.push_back(t);
+            }
+        }
+    }
+
+    if (clusterStarts.size() < 2)
+    {
+        return;
+    }
+    clusterStarts.push_back(triangleCount);
+
+    // Area weighted centroid and normal of the whole mesh and of every cluster
+    const size_t clusterCount = clusterStarts.size() - 1;
+    std::vector<glm::vec3> clusterCentroids(clusterCount, glm::vec3{0.0f});
+    std::vector<glm::vec3> clusterNormals(clusterCount, glm::vec3{0.0f});
+    std::vector<float> clusterAreas(clusterCount, 0.0f);
+    glm::vec3 meshCentroid{0.0f};
+    float meshArea = 0.0f;
+
+    for (size_t c = 0; c < clusterCount; ++c)
+    {
+        for (size_t t = clusterStarts[c]; t < clusterStarts[c + 1]; ++t)
+        {
+            const glm::vec3 vertexA = vertices[indices[t * 3]].position;
+            const glm::vec3 vertexB = vertices[indices[t * 3 + 1]].position;
+            const glm::vec3 vertexC = vertices[indices[t * 3 + 2]].position;
+
+            const glm::vec3 normal = glm::cross(vertexB - vertexA, vertexC - vertexA);
+            const float area = glm::length(normal);
+            const glm::vec3 centroid = (vertexA + vertexB + vertexC) / 3.0f;
+
+            clusterCentroids[c] += centroid * area;
+            clusterNormals[c] += normal;
+            clusterAreas[c] += area;
+        }
+
+        meshCentroid += clusterCentroids[c];
+        meshArea += clusterAreas[c];
+    }
+
+    if (meshArea <= 0.0f)
+    {
+        return;
+    }
+    meshCentroid /= meshArea;
+
+    // Clusters far out along their own normal are likely to cover the rest, draw them first
+    std::vector<float> sortKeys(clusterCount, 0.0f);
+    for (size_t c = 0; c < clusterCount; ++c)
+    {
+        const float normalLength = glm::length(clusterNormals[c]);
+        if (clusterAreas[c] > 0.0f && normalLength > 0.0f)
+        {
+            const glm::vec3 centroid = clusterCentroids[c] / clusterAreas[c];
+            sortKeys[c] = glm::dot(centroid - meshCentroid, clusterNormals[c] / normalLength);
+        }
+    }
+
+    std::vector<size_t> clusterOrder(clusterCount);
+    for (size_t c = 0; c < clusterCount; ++c)
+    {
+        clusterOrder[c] = c;
+    }
+    std::stable_sort
+    (
+        clusterOrder.begin(),
+        clusterOrder.end(),
+        [&](const size_t lhs, const size_t rhs) { return sortKeys[lhs] > sortKeys[rhs]; }
+    );
+
+    std::vector<uint32_t> reordered;
+    reordered.reserve(indices.size());
+    for (const size_t c : clusterOrder)
+    {
+        reordered.insert(reordered.end(), indices.begin() + clusterStarts[c] * 3, indices.begin() + clusterStarts[c + 1] * 3);
+    }
+
+    // Keep the new order only if it does not give back too much of the cache optimization
+    const float baseline = AnalyzeVertexCache(indices, vertices.size()).acmr;
+    if (AnalyzeVertexCache(reordered, vertices.size()).acmr <= baseline * threshold)
+    {
+        indices.swap(reordered);
+    }
+}
+
+void MeshOptimizer::OptimizeVertexFetch(std::vector<SimpleVertex>& vertices, std::vector<uint32_t>& indices)
+{
+    constexpr uint32_t UNUSED = std::numeric_limits<uint32_t>::max();
+
+    std::vector<uint32_t> remap(vertices.size(), UNUSED);
+    std::vector<SimpleVertex> reordered;
+    reordered.reserve(vertices.size());
+
+    for (uint32_t& index : indices)
+    {
+        if (remap[index] == UNUSED)
+        {
+            remap[index] = static_cast<uint32_t>(reordered.size());
+            reordered.push_back(vertices[index]);
+        }
+        index = remap[index];
+    }
+
+    vertices.swap(reordered);
+}
+
+std::vector<Meshlet> MeshOptimizer::BuildMeshlets
+(
+    const std::vector<SimpleVertex>& vertices,
+    const std::vector<uint32_t>& indices,
+    const uint32_t maxVertices /*= DEFAULT_MESHLET_VERTICES*/,
+    const uint32_t maxTriangles /*= DEFAULT_MESHLET_TRIANGLES*/
+)
+{
+    std::vector<Meshlet> meshlets;
+    if (indices.size() < 3 || maxVertices < 3 || maxTriangles == 0)
+    {
+        return meshlets;
+    }
+
+    // owner[v] is the meshlet that last counted vertex v
+    constexpr uint32_t UNOWNED = std::numeric_limits<uint32_t>::max();
+    std::vector<uint32_t> owner(vertices.size(), UNOWNED);
+    uint32_t meshletId = 0;
+
+    Meshlet current;
+    for (uint32_t first = 0; first + 2 < static_cast<uint32_t>(indices.size()); first += 3)
+    {
+        uint32_t newVertices = 0;
+        for (uint32_t corner = 0; corner < 3; ++corner)
+        {
+            newVertices += owner[indices[first + corner]] != meshletId ? 1 : 0;
+        }
+
+        if (current.indexCount / 3 >= maxTriangles || current.vertexCount + newVertices > maxVertices)
+        {
+            ComputeMeshletBounds(current, vertices, indices);
+            meshlets.push_back(current);
+
+            current = Meshlet{};
+            current.firstIndex = first;
+            ++meshletId;
+        }
+
+        for (uint32_t corner = 0; corner < 3; ++corner)
+        {
+            uint32_t& vertexOwner = owner[indices[first + corner]];
+            if (vertexOwner != meshletId)
+            {
+                vertexOwner = meshletId;
+                ++current.vertexCount;
+            }
+        }
+        current.indexCount += 3;
+    }
+
+    if (current.indexCount > 0)
+    {
+        ComputeMeshletBounds(current, vertices, indices);
+        meshlets.push_back(current);
+    }
+
+    return meshlets;
+}
+
+MeshOptimizer::VertexCacheStatistics MeshOptimizer::AnalyzeVertexCache
+(
+    const std::vector<uint32_t>& indices,
+    const size_t vertexCount,
+    const uint32_t cacheSize /*= DEFAULT_CACHE_SIZE*/
+)
+{
+    VertexCacheStatistics statistics;
+    if (indices.empty())
+    {
+        return statistics;
+    }
+
+    // A vertex is in the FIFO if fewer than cacheSize misses happened since it was loaded
+    std::vector<uint32_t> timestamps(vertexCount, 0);
+    std::vector<bool> used(vertexCount, false);
+    uint32_t time = cacheSize + 1;
+    size_t usedVertices = 0;
+
+    for (const uint32_t index : indices)
+    {
+        if (time - timestamps[index] > cacheSize)
+        {
+            timestamps[index] = time++;
+            ++statistics.vertexTransforms;
+        }
+
+        if (!used[index])
+        {
+            used[index] = true;
+            ++usedVertices;
+        }
+    }
+
+    statistics.acmr = static_cast<float>(statistics.vertexTransforms) / static_cast<float>(indices.size() / 3);
+    statistics.atvr = static_cast<float>(statistics.vertexTransforms) / static_cast<float>(usedVertices);
+    return statistics;
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+} // namespace velecs
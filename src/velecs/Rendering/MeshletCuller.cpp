@@ -0,0 +1,314 @@
+/// @file    MeshletCuller.cpp
+/// @author  Matthew Green
+/// @date    2024-01-27 14:58:13
+///
+/// @section LICENSE
+///
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Rendering/MeshletCuller.h"
+
+#include "velecs/Rendering/ShaderModule.h"
+
+#include <glm/geometric.hpp>
+#include <glm/matrix.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+namespace velecs {
+
+namespace {
+
+/// @brief Points one storage buffer binding of @p set at a range of a buffer.
+VkWriteDescriptorSet WriteStorageBuffer(VkDescriptorSet set, const uint32_t binding, const VkDescriptorBufferInfo* bufferInfo)
+{
+    VkWriteDescriptorSet write = {};
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet = set;
+    write.dstBinding = binding;
+    write.descriptorCount = 1;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    write.pBufferInfo = bufferInfo;
+    return write;
+}
+
+} // namespace
+
+// Public Fields
+
+// Constructors and Destructors
+
+// Public Methods
+
+MeshletCullPushConstants MeshletCuller::MakeCullConstants
+(
+    const glm::mat4& world,
+    const Frustum& frustum,
+    const glm::vec3& cameraPosition,
+    const bool perspective,
+    const bool coneCulling
+)
+{
+    MeshletCullPushConstants constants;
+
+    // a plane p keeps the points x with dot(p, world * x) >= 0, which is dot(transpose(world) * p, x) >= 0.
+    // Normalized first, so a local point still gives its world space distance to the plane
+    const glm::mat4 toLocal = glm::transpose(world);
+    for (size_t i = 0; i < frustum.planes.size(); ++i)
+    {
+        glm::vec4 plane = frustum.planes[i];
+        const float length = glm::length(glm::vec3{plane});
+        if (length > 0.0f)
+        {
+            plane /= length;
+        }
+        constants.planes[i] = toLocal * plane;
+    }
+
+    const float scaleX = glm::length(glm::vec3{world[0]});
+    const float scaleY = glm::length(glm::vec3{world[1]});
+    const float scaleZ = glm::length(glm::vec3{world[2]});
+    const float maxScale = std::max({scaleX, scaleY, scaleZ});
+    const float minScale = std::min({scaleX, scaleY, scaleZ});
+
+    constants.camera = glm::vec4{glm::vec3{glm::inverse(world) * glm::vec4{cameraPosition, 1.0f}}, maxScale};
+    constants.coneCulling = coneCulling && perspective && minScale > 0.0f && maxScale - minScale <= maxScale * 1e-3f ? 1 : 0;
+
+    return constants;
+}
+
+bool MeshletCuller::IsVisible(const Meshlet& meshlet, const MeshletCullPushConstants& constants)
+{
+    const glm::vec3 center{meshlet.sphere};
+    const float radius = meshlet.sphere.w;
+
+    const float worldRadius = radius * constants.camera.w;
+    for (const glm::vec4& plane : constants.planes)
+    {
+        if (glm::dot(glm::vec3{plane}, center) + plane.w < -worldRadius)
+        {
+            return false;
+        }
+    }
+
+    // every triangle faces away when the camera sits inside the cone opening behind them,
+    // grown by the radius so the whole sphere is covered, see Meshlet::cone
+    if (constants.coneCulling != 0 && meshlet.cone.w < 1.0f)
+    {
+        const glm::vec3 toCenter = center - glm::vec3{constants.camera};
+        if (glm::dot(toCenter, glm::vec3{meshlet.cone}) >= meshlet.cone.w * glm::length(toCenter) + radius)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+uint32_t MeshletCuller::Cull(const std::vector<Meshlet>& meshlets, const MeshletCullPushConstants& constants, std::vector<IndexRange>& ranges)
+{
+    uint32_t culled = 0;
+    for (const Meshlet& meshlet : meshlets)
+    {
+        if (!IsVisible(meshlet, constants))
+        {
+            ++culled;
+            continue;
+        }
+
+        if (!ranges.empty() && ranges.back().firstIndex + ranges.back().indexCount == meshlet.firstIndex)
+        {
+            ranges.back().indexCount += meshlet.indexCount;
+        }
+        else
+        {
+            ranges.push_back({meshlet.firstIndex, meshlet.indexCount});
+        }
+    }
+    return culled;
+}
+
+void MeshletCuller::Init(VkDevice device, VmaAllocator allocator, DescriptorLayoutCache& layoutCache)
+{
+    this->device = device;
+    this->allocator = allocator;
+
+    // LAYOUT
+
+    const uint32_t bindingIndices[] = {MESHLETS_BINDING, COMMANDS_BINDING};
+    VkDescriptorSetLayoutBinding bindings[2] = {};
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+        bindings[i].binding = bindingIndices[i];
+        bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        bindings[i].descriptorCount = 1;
+        bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    }
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo = {};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.bindingCount = (uint32_t)std::size(bindings);
+    layoutInfo.pBindings = bindings;
+
+    layout = layoutCache.CreateLayout(layoutInfo);
+
+    // PIPELINE
+
+    VkPushConstantRange pushConstant = {};
+    pushConstant.offset = 0;
+    pushConstant.size = sizeof(MeshletCullPushConstants);
+    pushConstant.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+
+    VkPipelineLayoutCreateInfo pipelineLayoutInfo = {};
+    pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipelineLayoutInfo.setLayoutCount = 1;
+    pipelineLayoutInfo.pSetLayouts = &layout;
+    pipelineLayoutInfo.pushConstantRangeCount = 1;
+    pipelineLayoutInfo.pPushConstantRanges = &pushConstant;
+
+    if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create the meshlet culling pipeline layout.");
+    }
+
+    const ShaderModule cullShader = ShaderModule::CreateCompShader(device, "Meshlets/Cull.comp.spv");
+
+    VkComputePipelineCreateInfo pipelineInfo = {};
+    pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipelineInfo.stage = cullShader.pipelineShaderStageCreateInfo;
+    pipelineInfo.layout = pipelineLayout;
+
+    if (vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create the meshlet culling pipeline.");
+    }
+}
+
+void MeshletCuller::Cleanup()
+{
+    if (pipeline != VK_NULL_HANDLE)
+    {
+        vkDestroyPipeline(device, pipeline, nullptr);
+        pipeline = VK_NULL_HANDLE;
+    }
+    if (pipelineLayout != VK_NULL_HANDLE)
+    {
+        vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
+        pipelineLayout = VK_NULL_HANDLE;
+    }
+
+    if (commandBuffer.IsInitialized())
+    {
+        vmaDestroyBuffer(allocator, commandBuffer._buffer, commandBuffer._allocation);
+        commandBuffer = AllocatedBuffer{};
+    }
+    commandCapacity = 0;
+
+    // the layout belongs to the layout cache
+    layout = VK_NULL_HANDLE;
+}
+
+void MeshletCuller::RecordCulling
+(
+    VkCommandBuffer cmd,
+    DescriptorAllocator& frameDescriptorAllocator,
+    const std::vector<Dispatch>& dispatches,
+    const uint32_t commandCount
+)
+{
+    if (dispatches.empty() || commandCount == 0)
+    {
+        return;
+    }
+
+    // COMMANDS
+
+    const VkDeviceSize commandBytes = sizeof(VkDrawIndexedIndirectCommand) * static_cast<VkDeviceSize>(commandCount);
+    if (commandBytes > commandCapacity)
+    {
+        if (commandBuffer.IsInitialized())
+        {
+            vmaDestroyBuffer(allocator, commandBuffer._buffer, commandBuffer._allocation);
+            commandBuffer = AllocatedBuffer{};
+            commandCapacity = 0;
+        }
+
+        // doubles, so streaming in more clustered meshes only reallocates a handful of times
+        VkDeviceSize newCapacity = 64 * 1024;
+        while (newCapacity < commandBytes)
+        {
+            newCapacity *= 2;
+        }
+
+        // written by the compute pass and read by the draws, the CPU never touches it
+        VkBufferCreateInfo bufferInfo = {};
+        bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferInfo.size = newCapacity;
+        bufferInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
+
+        VmaAllocationCreateInfo allocInfo = {};
+        allocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+
+        if (vmaCreateBuffer(allocator, &bufferInfo, &allocInfo, &commandBuffer._buffer, &commandBuffer._allocation, nullptr) != VK_SUCCESS)
+        {
+            commandBuffer = AllocatedBuffer{};
+            throw std::runtime_error("Failed to create the meshlet draw command buffer.");
+        }
+        commandCapacity = newCapacity;
+    }
+
+    // DISPATCHES
+
+    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
+
+    const VkDescriptorBufferInfo commandsInfo = {commandBuffer._buffer, 0, commandBytes};
+    for (const Dispatch& dispatch : dispatches)
+    {
+        const VkDescriptorSet set = frameDescriptorAllocator.Allocate(layout);
+
+        const VkDescriptorBufferInfo meshletsInfo = {dispatch.meshlets, 0, VK_WHOLE_SIZE};
+
+        const VkWriteDescriptorSet writes[] =
+        {
+            WriteStorageBuffer(set, MESHLETS_BINDING, &meshletsInfo),
+            WriteStorageBuffer(set, COMMANDS_BINDING, &commandsInfo)
+        };
+        vkUpdateDescriptorSets(device, (uint32_t)std::size(writes), writes, 0, nullptr);
+
+        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, 0, 1, &set, 0, nullptr);
+
+        vkCmdPushConstants(cmd, pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(MeshletCullPushConstants), &dispatch.constants);
+
+        vkCmdDispatch(cmd, (dispatch.constants.meshletCount + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE, 1, 1);
+    }
+
+    //the draws read the commands as indirect arguments
+    VkMemoryBarrier toDraw = {};
+    toDraw.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    toDraw.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    toDraw.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+
+    vkCmdPipelineBarrier(cmd,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+        0, 1, &toDraw, 0, nullptr, 0, nullptr);
+}
+
+VkBuffer MeshletCuller::GetCommandBuffer() const
+{
+    return commandBuffer._buffer;
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+} // namespace velecs
@@ -0,0 +1,357 @@
+/// @file    OcclusionBuffer.cpp
+/// @author  Matthew Green
+/// @date    2024-01-07 13:37:52
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Rendering/OcclusionBuffer.h"
+
+#include "velecs/Core/ThreadPool.h"
+#include "velecs/Math/SIMD.h"
+
+#include <glm/vec4.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace velecs {
+
+// Public Fields
+
+// Constructors and Destructors
+
+OcclusionBuffer::OcclusionBuffer(const uint32_t width /*= DEFAULT_WIDTH*/, const uint32_t height /*= DEFAULT_HEIGHT*/)
+{
+    Resize(width, height);
+}
+
+// Public Methods
+
+void OcclusionBuffer::Resize(const uint32_t width, const uint32_t height)
+{
+    tilesX = std::max(1u, (width + TILE_WIDTH - 1) / TILE_WIDTH);
+    tilesY = std::max(1u, (height + TILE_HEIGHT - 1) / TILE_HEIGHT);
+    this->width = tilesX * TILE_WIDTH;
+    this->height = tilesY * TILE_HEIGHT;
+
+    depthBuffer.resize(static_cast<size_t>(this->width) * this->height);
+    tileBins.resize(static_cast<size_t>(tilesX) * tilesY);
+
+    Clear();
+}
+
+void OcclusionBuffer::Clear()
+{
+    std::fill(depthBuffer.begin(), depthBuffer.end(), 1.0f);
+    triangles.clear();
+    for (std::vector<uint32_t>& bin : tileBins)
+    {
+        bin.clear();
+    }
+}
+
+void OcclusionBuffer::AddOccluder
+(
+    const glm::mat4& renderMatrix,
+    const std::vector<SimpleVertex>& vertices,
+    const std::vector<uint32_t>& indices
+)
+{
+    // Project each vertex once, vertices behind the camera are flagged with a negative depth
+    projectedVertices.resize(vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i)
+    {
+        const glm::vec4 clip = renderMatrix * glm::vec4(vertices[i].position, 1.0f);
+        if (clip.w < MIN_CLIP_W)
+        {
+            projectedVertices[i] = glm::vec3{0.0f, 0.0f, -1.0f};
+            continue;
+        }
+
+        const float invW = 1.0f / clip.w;
+        projectedVertices[i] = glm::vec3
+        {
+            (clip.x * invW * 0.5f + 0.5f) * static_cast<float>(width),
+            (clip.y * invW * 0.5f + 0.5f) * static_cast<float>(height),
+            clip.z * invW
+        };
+    }
+
+    for (size_t i = 0; i + 2 < indices.size(); i += 3)
+    {
+        if (indices[i] >= vertices.size() || indices[i + 1] >= vertices.size() || indices[i + 2] >= vertices.size())
+        {
+            throw std::runtime_error("Occluder triangle " + std::to_string(i / 3) + " references a vertex out of range.");
+        }
+
+        AddTriangle(projectedVertices[indices[i]], projectedVertices[indices[i + 1]], projectedVertices[indices[i + 2]]);
+    }
+}
+
+void OcclusionBuffer::Rasterize(ThreadPool& threadPool)
+{
+    for (std::vector<uint32_t>& bin : tileBins)
+    {
+        bin.clear();
+    }
+
+    // Binning in submission order keeps the per tile work identical between runs
+    for (uint32_t i = 0; i < static_cast<uint32_t>(triangles.size()); ++i)
+    {
+        const Triangle& triangle = triangles[i];
+        const uint32_t firstTileX = static_cast<uint32_t>(triangle.minX) / TILE_WIDTH;
+        const uint32_t lastTileX = static_cast<uint32_t>(triangle.maxX) / TILE_WIDTH;
+        const uint32_t firstTileY = static_cast<uint32_t>(triangle.minY) / TILE_HEIGHT;
+        const uint32_t lastTileY = static_cast<uint32_t>(triangle.maxY) / TILE_HEIGHT;
+
+        for (uint32_t tileY = firstTileY; tileY <= lastTileY; ++tileY)
+        {
+            for (uint32_t tileX = firstTileX; tileX <= lastTileX; ++tileX)
+            {
+                tileBins[tileY * tilesX + tileX].push_back(i);
+            }
+        }
+    }
+
+    threadPool.ParallelFor
+    (
+        tileBins.size(),
+        [this](size_t tileIndex)
+        {
+            RasterizeTile(static_cast<uint32_t>(tileIndex));
+        }
+    );
+}
+
+bool OcclusionBuffer::IsVisible(const glm::mat4& renderMatrix, const AABB& bounds) const
+{
+    if (!bounds.IsValid())
+    {
+        return true; // Nothing to test against, let the object through
+    }
+
+    float minX = FLOAT_POS_INFINITY;
+    float minY = FLOAT_POS_INFINITY;
+    float maxX = FLOAT_NEG_INFINITY;
+    float maxY = FLOAT_NEG_INFINITY;
+    float minDepth = FLOAT_POS_INFINITY;
+
+    for (const glm::vec3& corner : bounds.GetCorners())
+    {
+        const glm::vec4 clip = renderMatrix * glm::vec4(corner, 1.0f);
+        if (clip.w < MIN_CLIP_W)
+        {
+            return true; // Crosses the near plane, the object surrounds the camera
+        }
+
+        const float invW = 1.0f / clip.w;
+        const float x = (clip.x * invW * 0.5f + 0.5f) * static_cast<float>(width);
+        const float y = (clip.y * invW * 0.5f + 0.5f) * static_cast<float>(height);
+        minX = std::min(minX, x);
+        minY = std::min(minY, y);
+        maxX = std::max(maxX, x);
+        maxY = std::max(maxY, y);
+        minDepth = std::min(minDepth, clip.z * invW);
+    }
+
+    if (maxX < 0.0f || maxY < 0.0f || minX >= static_cast<float>(width) || minY >= static_cast<float>(height))
+    {
+        return false;
+    }
+
+    if (minDepth <= 0.0f)
+    {
+        return true;
+    }
+
+    const uint32_t firstX = static_cast<uint32_t>(std::max(0.0f, std::floor(minX))) & ~3u;
+    const uint32_t lastX = static_cast<uint32_t>(std::min(static_cast<float>(width - 1), std::floor(maxX)));
+    const uint32_t firstY = static_cast<uint32_t>(std::max(0.0f, std::floor(minY)));
+    const uint32_t lastY = static_cast<uint32_t>(std::min(static_cast<float>(height - 1), std::floor(maxY)));
+
+#ifdef VELECS_SIMD_SSE2
+    const __m128 boxDepth = _mm_set1_ps(minDepth);
+#endif
+
+    for (uint32_t y = firstY; y <= lastY; ++y)
+    {
+        const float* const row = depthBuffer.data() + static_cast<size_t>(y) * width;
+        for (uint32_t x = firstX; x <= lastX; x += 4)
+        {
+#ifdef VELECS_SIMD_SSE2
+            if (_mm_movemask_ps(_mm_cmplt_ps(boxDepth, _mm_loadu_ps(row + x))) != 0)
+            {
+                return true;
+            }
+#else
+            for (uint32_t lane = 0; lane < 4; ++lane)
+            {
+                if (minDepth < row[x + lane])
+                {
+                    return true;
+                }
+            }
+#endif
+        }
+    }
+
+    return false;
+}
+
+uint32_t OcclusionBuffer::GetWidth() const
+{
+    return width;
+}
+
+uint32_t OcclusionBuffer::GetHeight() const
+{
+    return height;
+}
+
+float OcclusionBuffer::GetDepth(const uint32_t x, const uint32_t y) const
+{
+    return depthBuffer[static_cast<size_t>(y) * width + x];
+}
+
+size_t OcclusionBuffer::GetTriangleCount() const
+{
+    return triangles.size();
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+void OcclusionBuffer::AddTriangle(const glm::vec3 a, const glm::vec3 b, const glm::vec3 c)
+{
+    const float nearestDepth = std::min({a.z, b.z, c.z});
+    const float farthestDepth = std::max({a.z, b.z, c.z});
+    if (nearestDepth < 0.0f || farthestDepth >= 1.0f)
+    {
+        return; // Behind the camera, clipped by the near plane or reaching past the far plane
+    }
+
+    const float area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+    if (std::abs(area) < 1e-6f)
+    {
+        return; // Degenerate
+    }
+
+    Triangle triangle;
+    triangle.minX = static_cast<int32_t>(std::floor(std::min({a.x, b.x, c.x})));
+    triangle.minY = static_cast<int32_t>(std::floor(std::min({a.y, b.y, c.y})));
+    triangle.maxX = static_cast<int32_t>(std::ceil(std::max({a.x, b.x, c.x})));
+    triangle.maxY = static_cast<int32_t>(std::ceil(std::max({a.y, b.y, c.y})));
+
+    triangle.minX = std::max(triangle.minX, 0);
+    triangle.minY = std::max(triangle.minY, 0);
+    triangle.maxX = std::min(triangle.maxX, static_cast<int32_t>(width) - 1);
+    triangle.maxY = std::min(triangle.maxY, static_cast<int32_t>(height) - 1);
+
+    if (triangle.minX > triangle.maxX || triangle.minY > triangle.maxY)
+    {
+        return; // Off screen
+    }
+
+    // Edge function E(p) = A * p.x + B * p.y + C is positive inside for both windings once flipped by the area sign.
+    // Pixels centered on an edge count as covered, so triangles sharing an edge leave no crack between them.
+    const glm::vec3 vertices[3] = {a, b, c};
+    const float sign = area > 0.0f ? 1.0f : -1.0f;
+    for (int i = 0; i < 3; ++i)
+    {
+        const glm::vec3& from = vertices[i];
+        const glm::vec3& to = vertices[(i + 1) % 3];
+        triangle.edgeA[i] = sign * (from.y - to.y);
+        triangle.edgeB[i] = sign * (to.x - from.x);
+        triangle.edgeC[i] = sign * (from.x * to.y - from.y * to.x);
+    }
+    triangle.depth = farthestDepth;
+
+    triangles.push_back(triangle);
+}
+
+void OcclusionBuffer::RasterizeTile(const uint32_t tileIndex)
+{
+    const int32_t tileMinX = static_cast<int32_t>((tileIndex % tilesX) * TILE_WIDTH);
+    const int32_t tileMinY = static_cast<int32_t>((tileIndex / tilesX) * TILE_HEIGHT);
+    const int32_t tileMaxX = tileMinX + static_cast<int32_t>(TILE_WIDTH) - 1;
+    const int32_t tileMaxY = tileMinY + static_cast<int32_t>(TILE_HEIGHT) - 1;
+
+    for (int32_t y = tileMinY; y <= tileMaxY; ++y)
+    {
+        float* const row = depthBuffer.data() + static_cast<size_t>(y) * width;
+        std::fill(row + tileMinX, row + tileMaxX + 1, 1.0f);
+    }
+
+    for (const uint32_t triangleIndex : tileBins[tileIndex])
+    {
+        const Triangle& triangle = triangles[triangleIndex];
+
+        // Start on a multiple of 4 so every group of 4 pixels stays inside this tile
+        const int32_t firstX = std::max(tileMinX, triangle.minX) & ~3;
+        const int32_t lastX = std::min(tileMaxX, triangle.maxX);
+        const int32_t firstY = std::max(tileMinY, triangle.minY);
+        const int32_t lastY = std::min(tileMaxY, triangle.maxY);
+
+#ifdef VELECS_SIMD_SSE2
+        const __m128 laneOffsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+        const __m128 triangleDepth = _mm_set1_ps(triangle.depth);
+        const __m128 zero = _mm_setzero_ps();
+        __m128 edgeA[3];
+        for (int i = 0; i < 3; ++i)
+        {
+            edgeA[i] = _mm_set1_ps(triangle.edgeA[i]);
+        }
+#endif
+
+        for (int32_t y = firstY; y <= lastY; ++y)
+        {
+            float* const row = depthBuffer.data() + static_cast<size_t>(y) * width;
+            const float pixelY = static_cast<float>(y) + 0.5f;
+
+            float rowTerms[3];
+            for (int i = 0; i < 3; ++i)
+            {
+                rowTerms[i] = triangle.edgeB[i] * pixelY + triangle.edgeC[i];
+            }
+
+            for (int32_t x = firstX; x <= lastX; x += 4)
+            {
+#ifdef VELECS_SIMD_SSE2
+                const __m128 pixelX = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), laneOffsets);
+
+                __m128 covered = _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(edgeA[0], pixelX), _mm_set1_ps(rowTerms[0])), zero);
+                covered = _mm_and_ps(covered, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(edgeA[1], pixelX), _mm_set1_ps(rowTerms[1])), zero));
+                covered = _mm_and_ps(covered, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(edgeA[2], pixelX), _mm_set1_ps(rowTerms[2])), zero));
+
+                const __m128 current = _mm_loadu_ps(row + x);
+                const __m128 nearer = _mm_min_ps(current, triangleDepth);
+                _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(covered, nearer), _mm_andnot_ps(covered, current)));
+#else
+                for (int32_t lane = 0; lane < 4; ++lane)
+                {
+                    const float pixelX = static_cast<float>(x + lane) + 0.5f;
+                    if (triangle.edgeA[0] * pixelX + rowTerms[0] >= 0.0f &&
+                        triangle.edgeA[1] * pixelX + rowTerms[1] >= 0.0f &&
+                        triangle.edgeA[2] * pixelX + rowTerms[2] >= 0.0f)
+                    {
+                        row[x + lane] = std::min(row[x + lane], triangle.depth);
+                    }
+                }
+#endif
+            }
+        }
+    }
+}
+
+} // namespace velecs
@@ -0,0 +1,126 @@
+/// @file    ParticleSimulation.cpp
+/// @author  Matthew Green
+/// @date    2024-01-29 14:20:36
+///
+/// @section LICENSE
+///
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Rendering/ParticleSystem.h"
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+// ParticleSystem::Simulate, the CPU copy of Particles/Simulate.comp. It is kept out of
+// ParticleSystem.cpp so the CPU tests build it without linking Vulkan.
+
+namespace velecs {
+
+namespace {
+
+/// @brief PCG hash, written the same way in Particles/Simulate.comp.
+uint32_t Hash(uint32_t value)
+{
+    const uint32_t state = value * 747796405u + 2891336453u;
+    const uint32_t word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+    return (word >> 22u) ^ word;
+}
+
+/// @brief Advances @p state and maps it to [0, 1) with 24 bits, exact on both sides.
+float Random(uint32_t& state)
+{
+    state = Hash(state);
+    return static_cast<float>(state >> 8u) * (1.0f / 16777216.0f);
+}
+
+/// @brief Uniformly distributed direction.
+glm::vec3 RandomDirection(uint32_t& state)
+{
+    const float z = Random(state) * 2.0f - 1.0f;
+    const float angle = Random(state) * 6.28318530718f;
+    const float radius = std::sqrt(std::max(1.0f - z * z, 0.0f));
+    return glm::vec3{radius * std::cos(angle), radius * std::sin(angle), z};
+}
+
+/// @brief Advances a live particle by one step.
+/// @return false once it has outlived its lifetime.
+bool Integrate(Particle& particle, const float deltaTime)
+{
+    particle.positionAge.w += deltaTime;
+    if (particle.positionAge.w >= particle.velocityLifetime.w)
+    {
+        return false;
+    }
+
+    glm::vec3 velocity = glm::vec3{particle.velocityLifetime} + glm::vec3{particle.accelerationDrag} * deltaTime;
+    velocity *= std::max(1.0f - particle.accelerationDrag.w * deltaTime, 0.0f);
+
+    particle.velocityLifetime = glm::vec4{velocity, particle.velocityLifetime.w};
+    particle.positionAge = glm::vec4{glm::vec3{particle.positionAge} + velocity * deltaTime, particle.positionAge.w};
+    return true;
+}
+
+/// @brief Creates the spawnIndex-th particle of the frame.
+Particle Spawn(const ParticleEmitterParams* emitters, const ParticleSimulationParams& params, const uint32_t spawnIndex)
+{
+    // emitters are few, a linear search over their ranges is cheaper than anything smarter
+    uint32_t emitterIndex = 0;
+    while (emitterIndex + 1 < params.emitterCount && spawnIndex >= emitters[emitterIndex].spawnOffset + emitters[emitterIndex].spawnCount)
+    {
+        ++emitterIndex;
+    }
+    const ParticleEmitterParams& emitter = emitters[emitterIndex];
+
+    uint32_t state = Hash(emitter.seed ^ Hash(params.frameSeed ^ Hash(spawnIndex)));
+
+    Particle particle;
+    particle.positionAge = glm::vec4{glm::vec3{emitter.position}, 0.0f};
+    const glm::vec3 velocity = glm::vec3{emitter.velocitySpread} + RandomDirection(state) * (emitter.velocitySpread.w * Random(state));
+    particle.velocityLifetime = glm::vec4{velocity, emitter.lifetime * (1.0f - 0.25f * Random(state))};
+    particle.accelerationDrag = emitter.accelerationDrag;
+    particle.startColor = emitter.startColor;
+    particle.endColor = emitter.endColor;
+    particle.startSize = emitter.startSize;
+    particle.endSize = emitter.endSize;
+    return particle;
+}
+
+} // namespace
+
+// Public Methods
+
+uint32_t ParticleSystem::Simulate
+(
+    const Particle* source,
+    const uint32_t sourceCount,
+    Particle* destination,
+    const ParticleEmitterParams* emitters,
+    const ParticleSimulationParams& params
+)
+{
+    uint32_t count = 0;
+
+    const uint32_t aliveCount = std::min(sourceCount, params.capacity);
+    for (uint32_t i = 0; i < aliveCount && count < params.capacity; ++i)
+    {
+        Particle particle = source[i];
+        if (Integrate(particle, params.deltaTime))
+        {
+            destination[count++] = particle;
+        }
+    }
+
+    const uint32_t spawnCount = params.emitterCount > 0 ? params.spawnCount : 0;
+    for (uint32_t i = 0; i < spawnCount && count < params.capacity; ++i)
+    {
+        destination[count++] = Spawn(emitters, params, i);
+    }
+
+    return count;
+}
+
+} // namespace velecs
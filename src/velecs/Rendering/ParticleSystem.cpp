@@ -0,0 +1,403 @@
+/// @file    ParticleSystem.cpp
+/// @author  Matthew Green
+/// @date    2024-01-20 11:47:19
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Rendering/ParticleSystem.h"
+
+#include "velecs/Rendering/ShaderModule.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+
+namespace velecs {
+
+namespace {
+
+/// @brief Creates a host-invisible buffer or throws.
+AllocatedBuffer CreateDeviceBuffer(VmaAllocator allocator, const VkDeviceSize size, const VkBufferUsageFlags usage)
+{
+    VkBufferCreateInfo bufferInfo = {};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = size;
+    bufferInfo.usage = usage;
+
+    VmaAllocationCreateInfo allocInfo = {};
+    allocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+
+    AllocatedBuffer buffer;
+    if (vmaCreateBuffer(allocator, &bufferInfo, &allocInfo, &buffer._buffer, &buffer._allocation, nullptr) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create a particle buffer.");
+    }
+    return buffer;
+}
+
+/// @brief Points one storage buffer binding of @p set at a whole buffer.
+VkWriteDescriptorSet WriteStorageBuffer(VkDescriptorSet set, const uint32_t binding, const VkDescriptorBufferInfo* bufferInfo)
+{
+    VkWriteDescriptorSet write = {};
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet = set;
+    write.dstBinding = binding;
+    write.descriptorCount = 1;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    write.pBufferInfo = bufferInfo;
+    return write;
+}
+
+} // namespace
+
+// Public Fields
+
+// Constructors and Destructors
+
+// Public Methods
+
+void ParticleSystem::Init
+(
+    VkDevice device,
+    VmaAllocator allocator,
+    DescriptorLayoutCache& layoutCache,
+    DescriptorAllocator& descriptorAllocator,
+    VkDescriptorSetLayout frameLayout,
+    const bool useCpuSimulation,
+    const uint32_t capacity /*= DEFAULT_CAPACITY*/
+)
+{
+    this->device = device;
+    this->allocator = allocator;
+    this->capacity = std::max(capacity, 1u);
+    cpuSimulation = useCpuSimulation;
+
+    const VkDeviceSize particleBufferSize = sizeof(Particle) * static_cast<VkDeviceSize>(this->capacity);
+
+    // BUFFERS
+
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+        particleBuffers[i] = CreateDeviceBuffer(allocator, particleBufferSize,
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT);
+        counterBuffers[i] = CreateDeviceBuffer(allocator, sizeof(VkDrawIndirectCommand),
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT);
+    }
+
+    if (cpuSimulation)
+    {
+        VkBufferCreateInfo stagingInfo = {};
+        stagingInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        stagingInfo.size = particleBufferSize;
+        stagingInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+
+        VmaAllocationCreateInfo stagingAllocInfo = {};
+        stagingAllocInfo.usage = VMA_MEMORY_USAGE_CPU_ONLY;
+        stagingAllocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+        VmaAllocationInfo allocationInfo = {};
+        if (vmaCreateBuffer(allocator, &stagingInfo, &stagingAllocInfo, &stagingBuffer._buffer, &stagingBuffer._allocation, &allocationInfo) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to create the particle staging buffer.");
+        }
+        mappedStaging = static_cast<Particle*>(allocationInfo.pMappedData);
+
+        cpuParticles[0].resize(this->capacity);
+        cpuParticles[1].resize(this->capacity);
+    }
+
+    // LAYOUTS
+
+    VkDescriptorSetLayoutBinding renderBinding = {};
+    renderBinding.binding = PARTICLES_BINDING;
+    renderBinding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    renderBinding.descriptorCount = 1;
+    renderBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+
+    VkDescriptorSetLayoutCreateInfo renderLayoutInfo = {};
+    renderLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    renderLayoutInfo.bindingCount = 1;
+    renderLayoutInfo.pBindings = &renderBinding;
+
+    renderLayout = layoutCache.CreateLayout(renderLayoutInfo);
+
+    // SETS
+
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+        renderSets[i] = descriptorAllocator.Allocate(renderLayout);
+
+        const VkDescriptorBufferInfo particlesInfo = {particleBuffers[i]._buffer, 0, VK_WHOLE_SIZE};
+        const VkWriteDescriptorSet write = WriteStorageBuffer(renderSets[i], PARTICLES_BINDING, &particlesInfo);
+        vkUpdateDescriptorSets(device, 1, &write, 0, nullptr);
+    }
+
+    if (cpuSimulation)
+    {
+        return; // nothing below is used without the compute shader
+    }
+
+    const uint32_t simulationBindingIndices[] = {SOURCE_BINDING, DESTINATION_BINDING, SOURCE_COUNTER_BINDING, DESTINATION_COUNTER_BINDING};
+    VkDescriptorSetLayoutBinding simulationBindings[4] = {};
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        simulationBindings[i].binding = simulationBindingIndices[i];
+        simulationBindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        simulationBindings[i].descriptorCount = 1;
+        simulationBindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    }
+
+    VkDescriptorSetLayoutCreateInfo simulationLayoutInfo = {};
+    simulationLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    simulationLayoutInfo.bindingCount = 4;
+    simulationLayoutInfo.pBindings = simulationBindings;
+
+    simulationLayout = layoutCache.CreateLayout(simulationLayoutInfo);
+
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+        simulationSets[i] = descriptorAllocator.Allocate(simulationLayout);
+
+        const uint32_t other = 1 - i;
+        const VkDescriptorBufferInfo sourceInfo = {particleBuffers[i]._buffer, 0, VK_WHOLE_SIZE};
+        const VkDescriptorBufferInfo destinationInfo = {particleBuffers[other]._buffer, 0, VK_WHOLE_SIZE};
+        const VkDescriptorBufferInfo sourceCounterInfo = {counterBuffers[i]._buffer, 0, VK_WHOLE_SIZE};
+        const VkDescriptorBufferInfo destinationCounterInfo = {counterBuffers[other]._buffer, 0, VK_WHOLE_SIZE};
+
+        const VkWriteDescriptorSet writes[] =
+        {
+            WriteStorageBuffer(simulationSets[i], SOURCE_BINDING, &sourceInfo),
+            WriteStorageBuffer(simulationSets[i], DESTINATION_BINDING, &destinationInfo),
+            WriteStorageBuffer(simulationSets[i], SOURCE_COUNTER_BINDING, &sourceCounterInfo),
+            WriteStorageBuffer(simulationSets[i], DESTINATION_COUNTER_BINDING, &destinationCounterInfo)
+        };
+        vkUpdateDescriptorSets(device, (uint32_t)std::size(writes), writes, 0, nullptr);
+    }
+
+    // PIPELINE
+
+    VkPushConstantRange pushConstant = {};
+    pushConstant.offset = 0;
+    pushConstant.size = sizeof(ParticleSimulationParams);
+    pushConstant.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+
+    //the emitters of the frame are read from the frame ring's storage binding at set 1
+    const VkDescriptorSetLayout setLayouts[] = {simulationLayout, frameLayout};
+
+    VkPipelineLayoutCreateInfo pipelineLayoutInfo = {};
+    pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipelineLayoutInfo.setLayoutCount = (uint32_t)std::size(setLayouts);
+    pipelineLayoutInfo.pSetLayouts = setLayouts;
+    pipelineLayoutInfo.pushConstantRangeCount = 1;
+    pipelineLayoutInfo.pPushConstantRanges = &pushConstant;
+
+    if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &simulationPipelineLayout) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create the particle simulation pipeline layout.");
+    }
+
+    const ShaderModule simulateShader = ShaderModule::CreateCompShader(device, "Particles/Simulate.comp.spv");
+
+    VkComputePipelineCreateInfo pipelineInfo = {};
+    pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipelineInfo.stage = simulateShader.pipelineShaderStageCreateInfo;
+    pipelineInfo.layout = simulationPipelineLayout;
+
+    if (vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &simulationPipeline) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create the particle simulation pipeline.");
+    }
+}
+
+void ParticleSystem::Cleanup()
+{
+    if (simulationPipeline != VK_NULL_HANDLE)
+    {
+        vkDestroyPipeline(device, simulationPipeline, nullptr);
+        simulationPipeline = VK_NULL_HANDLE;
+    }
+    if (simulationPipelineLayout != VK_NULL_HANDLE)
+    {
+        vkDestroyPipelineLayout(device, simulationPipelineLayout, nullptr);
+        simulationPipelineLayout = VK_NULL_HANDLE;
+    }
+
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+        if (particleBuffers[i].IsInitialized())
+        {
+            vmaDestroyBuffer(allocator, particleBuffers[i]._buffer, particleBuffers[i]._allocation);
+            particleBuffers[i] = AllocatedBuffer{};
+        }
+        if (counterBuffers[i].IsInitialized())
+        {
+            vmaDestroyBuffer(allocator, counterBuffers[i]._buffer, counterBuffers[i]._allocation);
+            counterBuffers[i] = AllocatedBuffer{};
+        }
+        cpuParticles[i].clear();
+        cpuCounts[i] = 0;
+    }
+
+    if (stagingBuffer.IsInitialized())
+    {
+        vmaDestroyBuffer(allocator, stagingBuffer._buffer, stagingBuffer._allocation);
+        stagingBuffer = AllocatedBuffer{};
+        mappedStaging = nullptr;
+    }
+
+    // layouts belong to the layout cache, sets to the descriptor allocator
+    simulationLayout = VK_NULL_HANDLE;
+    renderLayout = VK_NULL_HANDLE;
+}
+
+void ParticleSystem::RecordSimulation
+(
+    VkCommandBuffer cmd,
+    DynamicRingBuffer& frameRing,
+    const std::vector<ParticleEmitterParams>& emitters,
+    const float deltaTime
+)
+{
+    ParticleSimulationParams params;
+    params.deltaTime = deltaTime;
+    params.emitterCount = static_cast<uint32_t>(std::min<size_t>(emitters.size(), MAX_EMITTERS));
+    params.capacity = capacity;
+    params.frameSeed = frameSeed++;
+    if (params.emitterCount > 0)
+    {
+        const ParticleEmitterParams& last = emitters[params.emitterCount - 1];
+        params.spawnCount = std::min(last.spawnOffset + last.spawnCount, capacity);
+    }
+
+    if (cpuSimulation)
+    {
+        RecordCpuSimulation(cmd, emitters, params);
+    }
+    else
+    {
+        RecordGpuSimulation(cmd, frameRing, emitters, params);
+    }
+
+    current = 1 - current;
+
+    //the draw reads the particles in the vertex shader and the count as its indirect command
+    VkMemoryBarrier toDraw = {};
+    toDraw.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    toDraw.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+    toDraw.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+
+    vkCmdPipelineBarrier(cmd,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
+        0, 1, &toDraw, 0, nullptr, 0, nullptr);
+}
+
+void ParticleSystem::RecordDraw(VkCommandBuffer cmd, VkPipelineLayout pipelineLayout, const uint32_t setIndex /*= 1*/) const
+{
+    vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, setIndex, 1, &renderSets[current], 0, nullptr);
+    vkCmdDrawIndirect(cmd, counterBuffers[current]._buffer, 0, 1, sizeof(VkDrawIndirectCommand));
+}
+
+VkDescriptorSetLayout ParticleSystem::GetRenderLayout() const
+{
+    return renderLayout;
+}
+
+uint32_t ParticleSystem::GetCapacity() const
+{
+    return capacity;
+}
+
+bool ParticleSystem::IsCpuSimulated() const
+{
+    return cpuSimulation;
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+void ParticleSystem::RecordGpuSimulation
+(
+    VkCommandBuffer cmd,
+    DynamicRingBuffer& frameRing,
+    const std::vector<ParticleEmitterParams>& emitters,
+    const ParticleSimulationParams& params
+)
+{
+    const uint32_t destination = 1 - current;
+
+    uint32_t emitterOffset = 0;
+    if (params.emitterCount > 0)
+    {
+        const DynamicRingBuffer::Allocation allocation = frameRing.Allocate(sizeof(ParticleEmitterParams) * params.emitterCount, DynamicRingBuffer::Usage::Storage);
+        std::memcpy(allocation.data, emitters.data(), sizeof(ParticleEmitterParams) * params.emitterCount);
+        emitterOffset = allocation.offset;
+    }
+
+    const VkDrawIndirectCommand empty = {VERTICES_PER_PARTICLE, 0, 0, 0};
+    vkCmdUpdateBuffer(cmd, counterBuffers[destination]._buffer, 0, sizeof(empty), &empty);
+    if (!sourceCounterCleared)
+    {
+        // the very first step reads a count nothing has written yet
+        vkCmdUpdateBuffer(cmd, counterBuffers[current]._buffer, 0, sizeof(empty), &empty);
+        sourceCounterCleared = true;
+    }
+
+    //the cleared counter, and the particles the last step wrote, are read and appended to by the shader
+    VkMemoryBarrier toCompute = {};
+    toCompute.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    toCompute.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    toCompute.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+
+    vkCmdPipelineBarrier(cmd,
+        VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        0, 1, &toCompute, 0, nullptr, 0, nullptr);
+
+    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, simulationPipeline);
+    vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, simulationPipelineLayout, 0, 1, &simulationSets[current], 0, nullptr);
+    frameRing.Bind(cmd, simulationPipelineLayout, 0, emitterOffset, 1, VK_PIPELINE_BIND_POINT_COMPUTE);
+    vkCmdPushConstants(cmd, simulationPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(ParticleSimulationParams), &params);
+
+    //one thread per particle that may be alive, then one per spawn. The live count is only known on the GPU
+    const uint32_t threadCount = capacity + params.spawnCount;
+    vkCmdDispatch(cmd, (threadCount + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE, 1, 1);
+}
+
+void ParticleSystem::RecordCpuSimulation
+(
+    VkCommandBuffer cmd,
+    const std::vector<ParticleEmitterParams>& emitters,
+    const ParticleSimulationParams& params
+)
+{
+    const uint32_t destination = 1 - current;
+
+    cpuCounts[destination] = Simulate(cpuParticles[current].data(), cpuCounts[current], cpuParticles[destination].data(), emitters.data(), params);
+
+    //the fence of the previous frame was waited on, so the staging buffer is free
+    const uint32_t count = cpuCounts[destination];
+    if (count > 0)
+    {
+        std::memcpy(mappedStaging, cpuParticles[destination].data(), sizeof(Particle) * count);
+
+        VkBufferCopy copyRegion = {};
+        copyRegion.size = sizeof(Particle) * count;
+        vkCmdCopyBuffer(cmd, stagingBuffer._buffer, particleBuffers[destination]._buffer, 1, &copyRegion);
+    }
+
+    const VkDrawIndirectCommand command = {VERTICES_PER_PARTICLE, count, 0, 0};
+    vkCmdUpdateBuffer(cmd, counterBuffers[destination]._buffer, 0, sizeof(command), &command);
+}
+
+} // namespace velecs
@@ -0,0 +1,61 @@
+/// @file    QuantizedSimpleVertex.cpp
+/// @author  Matthew Green
+/// @date    2024-01-08 11:14:40
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Rendering/QuantizedSimpleVertex.h"
+#include "velecs/Rendering/VertexQuantization.h"
+
+namespace velecs {
+
+// Public Fields
+
+// Constructors and Destructors
+
+QuantizedSimpleVertex::QuantizedSimpleVertex(const glm::vec3 position, const AABB& bounds)
+{
+    const std::array<uint16_t, 3> encoded = VertexQuantization::QuantizePosition(position, bounds);
+    this->position[0] = encoded[0];
+    this->position[1] = encoded[1];
+    this->position[2] = encoded[2];
+}
+
+// Public Methods
+
+VertexInputAttributeDescriptor QuantizedSimpleVertex::GetVertexDescription()
+{
+    VertexInputAttributeDescriptor description;
+
+    //we will have just 1 vertex buffer binding, with a per-vertex rate
+    VkVertexInputBindingDescription mainBinding = {};
+    mainBinding.binding = 0;
+    mainBinding.stride = sizeof(QuantizedSimpleVertex);
+    mainBinding.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+
+    description.bindings.push_back(mainBinding);
+
+    //Position will be stored at Location 0, normalized to the mesh bounds
+    VkVertexInputAttributeDescription positionAttribute = {};
+    positionAttribute.binding = 0;
+    positionAttribute.location = 0;
+    positionAttribute.format = VK_FORMAT_R16G16B16A16_UNORM;
+    positionAttribute.offset = offsetof(QuantizedSimpleVertex, position);
+
+    description.attributes.push_back(positionAttribute);
+    return description;
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+} // namespace velecs
@@ -0,0 +1,93 @@
+/// @file    QuantizedVertex.cpp
+/// @author  Matthew Green
+/// @date    2024-01-08 11:32:17
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Rendering/QuantizedVertex.h"
+#include "velecs/Rendering/VertexQuantization.h"
+
+namespace velecs {
+
+// Public Fields
+
+// Constructors and Destructors
+
+QuantizedVertex::QuantizedVertex(const Vertex& vertex, const AABB& bounds)
+    : color(vertex.color)
+{
+    const std::array<uint16_t, 3> encodedPosition = VertexQuantization::QuantizePosition(vertex.position, bounds);
+    position[0] = encodedPosition[0];
+    position[1] = encodedPosition[1];
+    position[2] = encodedPosition[2];
+
+    const std::array<int16_t, 2> encodedNormal = VertexQuantization::EncodeOctahedral(vertex.normal);
+    normal[0] = encodedNormal[0];
+    normal[1] = encodedNormal[1];
+
+    uv[0] = VertexQuantization::FloatToHalf(vertex.uv.x);
+    uv[1] = VertexQuantization::FloatToHalf(vertex.uv.y);
+}
+
+// Public Methods
+
+VertexInputAttributeDescriptor QuantizedVertex::GetVertexDescription()
+{
+    VertexInputAttributeDescriptor description;
+
+    //we will have just 1 vertex buffer binding, with a per-vertex rate
+    VkVertexInputBindingDescription mainBinding = {};
+    mainBinding.binding = 0;
+    mainBinding.stride = sizeof(QuantizedVertex);
+    mainBinding.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+
+    description.bindings.push_back(mainBinding);
+
+    //Position will be stored at Location 0, normalized to the mesh bounds
+    VkVertexInputAttributeDescription positionAttribute = {};
+    positionAttribute.binding = 0;
+    positionAttribute.location = 0;
+    positionAttribute.format = VK_FORMAT_R16G16B16A16_UNORM;
+    positionAttribute.offset = offsetof(QuantizedVertex, position);
+
+    //Normal will be stored at Location 1, octahedral encoded
+    VkVertexInputAttributeDescription normalAttribute = {};
+    normalAttribute.binding = 0;
+    normalAttribute.location = 1;
+    normalAttribute.format = VK_FORMAT_R16G16_SNORM;
+    normalAttribute.offset = offsetof(QuantizedVertex, normal);
+
+    //Color will be stored at Location 2
+    VkVertexInputAttributeDescription colorAttribute = {};
+    colorAttribute.binding = 0;
+    colorAttribute.location = 2;
+    colorAttribute.format = VK_FORMAT_R8G8B8A8_UNORM;
+    colorAttribute.offset = offsetof(QuantizedVertex, color);
+
+    //UV will be stored at Location 3
+    VkVertexInputAttributeDescription uvAttribute = {};
+    uvAttribute.binding = 0;
+    uvAttribute.location = 3;
+    uvAttribute.format = VK_FORMAT_R16G16_SFLOAT;
+    uvAttribute.offset = offsetof(QuantizedVertex, uv);
+
+    description.attributes.push_back(positionAttribute);
+    description.attributes.push_back(normalAttribute);
+    description.attributes.push_back(colorAttribute);
+    description.attributes.push_back(uvAttribute);
+    return description;
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+} // namespace velecs
@@ -0,0 +1,99 @@
+/// @file    RenderSnapshot.cpp
+/// @author  Matthew Green
+/// @date    2024-01-11 10:17:20
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Rendering/RenderSnapshot.h"
+
+namespace velecs {
+
+// Public Fields
+
+// Constructors and Destructors
+
+RenderSnapshot::~RenderSnapshot()
+{
+    ClearUI();
+}
+
+// Public Methods
+
+void RenderSnapshot::Clear()
+{
+    views.clear();
+    drawPackets.clear();
+    transformUploads.clear();
+    transformUploadData.clear();
+    ownershipAcquires.clear();
+    transferWaitValue = 0;
+    particleEmitters.clear();
+    particleDeltaTime = 0.0f;
+    textViewProjection = glm::mat4{1.0f};
+    textLabels.clear();
+    glyphInstances.clear();
+    textBatches.clear();
+    atlasUploads.clear();
+    atlasUploadPixels.clear();
+    skinDispatches.clear();
+    skinMatrices.clear();
+    impostorInstances.clear();
+    impostorBatches.clear();
+    meshletDispatches.clear();
+    meshletCommandCount = 0;
+    // the vectors are swapped back into the batcher, keeping their capacity saves it reallocating
+    for (DynamicBatcher::Geometry& geometry : batchGeometry)
+    {
+        geometry.vertices.clear();
+        geometry.indices.clear();
+    }
+    batchedCount = 0;
+    debugVertices.clear();
+    retiredBuffers.clear();
+    ClearUI();
+}
+
+void RenderSnapshot::CaptureUI(const ImDrawData* const drawData)
+{
+    ClearUI();
+
+    if (drawData == nullptr || !drawData->Valid)
+    {
+        return;
+    }
+
+    // Copies the header fields, the list pointers are replaced with owned clones below
+    uiDrawData = *drawData;
+    for (int i = 0; i < drawData->CmdListsCount; ++i)
+    {
+        uiDrawData.CmdLists[i] = drawData->CmdLists[i]->CloneOutput();
+    }
+}
+
+ImDrawData* RenderSnapshot::GetUIDrawData()
+{
+    return &uiDrawData;
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+void RenderSnapshot::ClearUI()
+{
+    for (int i = 0; i < uiDrawData.CmdLists.Size; ++i)
+    {
+        IM_DELETE(uiDrawData.CmdLists[i]);
+    }
+    uiDrawData.Clear();
+}
+
+} // namespace velecs
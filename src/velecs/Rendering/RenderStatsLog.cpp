@@ -0,0 +1,120 @@
+/// @file    RenderStatsLog.cpp
+/// @author  Matthew Green
+/// @date    2024-01-25 11:19:30
+///
+/// @section LICENSE
+///
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Rendering/RenderStatsLog.h"
+
+#include <filesystem>
+#include <iostream>
+
+namespace velecs {
+
+// Public Fields
+
+// Constructors and Destructors
+
+// Public Methods
+
+bool RenderStatsLog::Start(const std::string& path)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (file.is_open())
+    {
+        file.close();
+    }
+
+    const std::filesystem::path directory = std::filesystem::path(path).parent_path();
+    std::error_code error;
+    if (!directory.empty())
+    {
+        std::filesystem::create_directories(directory, error);
+    }
+
+    file.open(path, std::ios::out | std::ios::trunc);
+    if (!file.is_open())
+    {
+        std::cerr << "[ERROR] [RenderStatsLog] Failed to open '" << path << "'" << std::endl;
+        return false;
+    }
+
+    file << "frame,render_scale,render_width,render_height,gpu_ms,"
+        "draws,instances,triangles,pipeline_binds,buffer_binds,push_constant_bytes,"
+        "transform_uploads,glyphs,skinned,impostors,batched,"
+        "vertex_invocations,clipping_invocations,fragment_invocations\n";
+
+    return true;
+}
+
+void RenderStatsLog::Stop()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (file.is_open())
+    {
+        file.close();
+    }
+}
+
+bool RenderStatsLog::IsLogging() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    return file.is_open();
+}
+
+void RenderStatsLog::Append(const int frameNumber, const RenderStats& stats)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (!file.is_open())
+    {
+        return;
+    }
+
+    file << frameNumber << ','
+        << stats.renderScale << ','
+        << stats.renderExtent.width << ','
+        << stats.renderExtent.height << ','
+        << stats.gpuFrameTimeMs << ','
+        << stats.drawCount << ','
+        << stats.instanceCount << ','
+        << stats.triangleCount << ','
+        << stats.pipelineBindCount << ','
+        << stats.bufferBindCount << ','
+        << stats.pushConstantBytes << ','
+        << stats.transformUploadCount << ','
+        << stats.glyphCount << ','
+        << stats.skinnedCount << ','
+        << stats.impostorCount << ','
+        << stats.batchedCount << ',';
+
+    if (stats.pipelineStatisticsValid)
+    {
+        file << stats.vertexInvocations << ','
+            << stats.clippingInvocations << ','
+            << stats.fragmentInvocations;
+    }
+    else
+    {
+        file << ",,";
+    }
+
+    file << '\n';
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+} // namespace velecs
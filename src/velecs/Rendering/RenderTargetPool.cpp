@@ -0,0 +1,180 @@
+/// @file    RenderTargetPool.cpp
+/// @author  Matthew Green
+/// @date    2024-01-26 10:31:52
+///
+/// @section LICENSE
+///
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Rendering/RenderTargetPool.h"
+
+#include "velecs/Rendering/BindlessTable.h"
+#include "velecs/Engine/vk_initializers.h"
+
+#include <stdexcept>
+
+namespace velecs {
+
+// Public Fields
+
+// Constructors and Destructors
+
+// Public Methods
+
+void RenderTargetPool::Init
+(
+    VkDevice device,
+    VmaAllocator allocator,
+    BindlessTable* const bindlessTable,
+    const VkFormat colorFormat,
+    const VkFormat depthFormat,
+    VkRenderPass renderPass
+)
+{
+    this->device = device;
+    this->allocator = allocator;
+    this->bindlessTable = bindlessTable;
+    this->colorFormat = colorFormat;
+    this->depthFormat = depthFormat;
+    this->renderPass = renderPass;
+}
+
+void RenderTargetPool::Cleanup()
+{
+    for (RenderTarget& target : targets)
+    {
+        bindlessTable->ReleaseTexture(target.textureIndex);
+
+        if (target.framebuffer != VK_NULL_HANDLE)
+        {
+            vkDestroyFramebuffer(device, target.framebuffer, nullptr);
+        }
+        vkDestroyImageView(device, target.colorView, nullptr);
+        vkDestroyImageView(device, target.depthView, nullptr);
+        vmaDestroyImage(allocator, target.colorImage._image, target.colorImage._allocation);
+        vmaDestroyImage(allocator, target.depthImage._image, target.depthImage._allocation);
+    }
+    targets.clear();
+    freeIndices.clear();
+}
+
+uint32_t RenderTargetPool::Acquire(const VkExtent2D extent, bool& outCreated)
+{
+    for (size_t i = 0; i < freeIndices.size(); ++i)
+    {
+        const uint32_t index = freeIndices[i];
+        if (targets[index].extent.width == extent.width && targets[index].extent.height == extent.height)
+        {
+            freeIndices[i] = freeIndices.back();
+            freeIndices.pop_back();
+            outCreated = false;
+            return index;
+        }
+    }
+
+    targets.push_back(Create(extent));
+    outCreated = true;
+    return static_cast<uint32_t>(targets.size() - 1);
+}
+
+void RenderTargetPool::Release(const uint32_t index)
+{
+    if (index == INVALID_INDEX || index >= targets.size())
+    {
+        return;
+    }
+
+    freeIndices.push_back(index);
+}
+
+const RenderTarget& RenderTargetPool::Get(const uint32_t index) const
+{
+    return targets[index];
+}
+
+void RenderTargetPool::RecordInitialLayout(VkCommandBuffer cmd, const RenderTarget& target)
+{
+    VkImageMemoryBarrier toReadable = {};
+    toReadable.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    toReadable.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    toReadable.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    toReadable.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toReadable.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toReadable.image = target.colorImage._image;
+    toReadable.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+    toReadable.srcAccessMask = 0;
+    toReadable.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &toReadable);
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+RenderTarget RenderTargetPool::Create(const VkExtent2D extent) const
+{
+    RenderTarget target;
+    target.extent = extent;
+
+    const VkExtent3D imageExtent = {extent.width, extent.height, 1};
+
+    VmaAllocationCreateInfo imageAllocInfo = {};
+    imageAllocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+    imageAllocInfo.requiredFlags = VkMemoryPropertyFlags(VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+    const VkImageCreateInfo colorInfo = vkinit::image_create_info(colorFormat, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, imageExtent);
+    if (vmaCreateImage(allocator, &colorInfo, &imageAllocInfo, &target.colorImage._image, &target.colorImage._allocation, nullptr) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create a render target color image.");
+    }
+
+    const VkImageViewCreateInfo colorViewInfo = vkinit::imageview_create_info(colorFormat, target.colorImage._image, VK_IMAGE_ASPECT_COLOR_BIT);
+    if (vkCreateImageView(device, &colorViewInfo, nullptr, &target.colorView) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create a render target color view.");
+    }
+
+    const VkImageCreateInfo depthInfo = vkinit::image_create_info(depthFormat, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, imageExtent);
+    if (vmaCreateImage(allocator, &depthInfo, &imageAllocInfo, &target.depthImage._image, &target.depthImage._allocation, nullptr) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create a render target depth image.");
+    }
+
+    const VkImageViewCreateInfo depthViewInfo = vkinit::imageview_create_info(depthFormat, target.depthImage._image, VK_IMAGE_ASPECT_DEPTH_BIT);
+    if (vkCreateImageView(device, &depthViewInfo, nullptr, &target.depthView) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create a render target depth view.");
+    }
+
+    if (renderPass != VK_NULL_HANDLE)
+    {
+        const VkImageView attachments[2] = {target.colorView, target.depthView};
+
+        VkFramebufferCreateInfo framebufferInfo = {};
+        framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+        framebufferInfo.renderPass = renderPass;
+        framebufferInfo.attachmentCount = 2;
+        framebufferInfo.pAttachments = attachments;
+        framebufferInfo.width = extent.width;
+        framebufferInfo.height = extent.height;
+        framebufferInfo.layers = 1;
+
+        if (vkCreateFramebuffer(device, &framebufferInfo, nullptr, &target.framebuffer) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to create a render target framebuffer.");
+        }
+    }
+
+    target.textureIndex = bindlessTable->RegisterTexture(target.colorView);
+
+    return target;
+}
+
+} // namespace velecs
@@ -0,0 +1,153 @@
+/// @file    RenderThread.cpp
+/// @author  Matthew Green
+/// @date    2024-01-11 10:36:08
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Rendering/RenderThread.h"
+
+namespace velecs {
+
+// Public Fields
+
+// Constructors and Destructors
+
+RenderThread::~RenderThread()
+{
+    Stop();
+}
+
+// Public Methods
+
+void RenderThread::Start(RenderFunction renderFunction, const bool threaded /*= true*/)
+{
+    Stop();
+
+    this->renderFunction = std::move(renderFunction);
+    this->threaded = threaded;
+    stopping = false;
+
+    if (threaded)
+    {
+        thread = std::thread([this]() { RenderLoop(); });
+    }
+}
+
+void RenderThread::Stop()
+{
+    if (!thread.joinable())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    snapshotReady.notify_one();
+
+    thread.join();
+}
+
+RenderSnapshot& RenderThread::GetWriteSnapshot()
+{
+    return snapshots[writeIndex];
+}
+
+void RenderThread::Publish()
+{
+    if (!threaded)
+    {
+        renderFunction(snapshots[writeIndex]);
+        snapshots[writeIndex].Clear();
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        WaitIdleLocked(lock);
+
+        readIndex = writeIndex;
+        writeIndex = 1 - writeIndex;
+        hasPendingSnapshot = true;
+    }
+    snapshotReady.notify_one();
+
+    // The render thread finished with this one before it picked up the snapshot just published
+    snapshots[writeIndex].Clear();
+}
+
+void RenderThread::WaitIdle()
+{
+    if (!threaded)
+    {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    WaitIdleLocked(lock);
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+void RenderThread::RenderLoop()
+{
+    while (true)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        snapshotReady.wait(lock, [this]() { return hasPendingSnapshot || stopping; });
+
+        if (!hasPendingSnapshot)
+        {
+            return; // Stopping, and every published snapshot was rendered
+        }
+
+        hasPendingSnapshot = false;
+        rendering = true;
+        RenderSnapshot& snapshot = snapshots[readIndex];
+        lock.unlock();
+
+        std::exception_ptr error;
+        try
+        {
+            renderFunction(snapshot);
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+
+        lock.lock();
+        rendering = false;
+        if (error && !renderError)
+        {
+            renderError = error;
+        }
+        lock.unlock();
+        renderDone.notify_all();
+    }
+}
+
+void RenderThread::WaitIdleLocked(std::unique_lock<std::mutex>& lock)
+{
+    renderDone.wait(lock, [this]() { return !hasPendingSnapshot && !rendering; });
+
+    if (renderError)
+    {
+        std::exception_ptr error = renderError;
+        renderError = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+} // namespace velecs
@@ -53,6 +53,14 @@ ShaderModule ShaderModule::CreateFragShader(const VkDevice device, const std::st
     return ShaderModule{ device, shaderModule, info };
 }
 
+ShaderModule ShaderModule::CreateCompShader(const VkDevice device, const std::string& filePath)
+{
+    VkShaderModule shaderModule = LoadShader(device, filePath);
+    VkPipelineShaderStageCreateInfo info = vkinit::pipeline_shader_stage_create_info(VK_SHADER_STAGE_COMPUTE_BIT, shaderModule);
+
+    return ShaderModule{ device, shaderModule, info };
+}
+
 // Protected Fields
 
 // Protected Methods
@@ -0,0 +1,167 @@
+/// @file    ShaderVariantCache.cpp
+/// @author  Matthew Green
+/// @date    2024-01-24 10:07:55
+///
+/// @section LICENSE
+///
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Rendering/ShaderVariantCache.h"
+
+#include "velecs/Rendering/ShaderModule.h"
+
+#include <array>
+#include <iostream>
+#include <stdexcept>
+
+namespace velecs {
+
+// Public Fields
+
+// Constructors and Destructors
+
+// Public Methods
+
+void ShaderVariantCache::Init
+(
+    VkDevice device,
+    VkRenderPass renderPass,
+    const PipelineBuilder& builder,
+    const std::string& vertShaderPath,
+    const std::string& fragShaderPath
+)
+{
+    this->device = device;
+    this->renderPass = renderPass;
+    this->builder = builder;
+    this->vertShaderPath = vertShaderPath;
+    this->fragShaderPath = fragShaderPath;
+
+    this->builder._shaderStages.clear();
+
+    if (builder._renderingInfo != nullptr)
+    {
+        renderingInfo = *builder._renderingInfo;
+        if (renderingInfo.colorAttachmentCount > 0)
+        {
+            colorFormat = renderingInfo.pColorAttachmentFormats[0];
+            renderingInfo.colorAttachmentCount = 1;
+            renderingInfo.pColorAttachmentFormats = &colorFormat;
+        }
+        renderingInfo.pNext = nullptr;
+        this->builder._renderingInfo = &renderingInfo;
+    }
+}
+
+void ShaderVariantCache::SetVertexInput(const VertexFormat format, const VertexInputAttributeDescriptor& description)
+{
+    vertexInputs[static_cast<uint8_t>(format)] = description;
+}
+
+VkPipeline* ShaderVariantCache::Get(const uint32_t features, const VertexFormat format /*= VertexFormat::Float32*/)
+{
+    const uint64_t key = MakeKey(features, format);
+
+    const auto variant = variants.find(key);
+    if (variant != variants.end())
+    {
+        return &variant->second;
+    }
+
+    return &variants.emplace(key, Build(features, format)).first->second;
+}
+
+void ShaderVariantCache::Cleanup()
+{
+    for (auto& variant : variants)
+    {
+        if (variant.second != VK_NULL_HANDLE)
+        {
+            vkDestroyPipeline(device, variant.second, nullptr);
+            variant.second = VK_NULL_HANDLE;
+        }
+    }
+    variants.clear();
+}
+
+uint32_t ShaderVariantCache::GetVariantCount() const
+{
+    return static_cast<uint32_t>(variants.size());
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+uint64_t ShaderVariantCache::MakeKey(const uint32_t features, const VertexFormat format)
+{
+    return (static_cast<uint64_t>(features) << 8) | static_cast<uint64_t>(format);
+}
+
+VkPipeline ShaderVariantCache::Build(const uint32_t features, const VertexFormat format)
+{
+    if (features >> MAX_FEATURES != 0)
+    {
+        throw std::runtime_error("Shader variant of '" + vertShaderPath + "' sets feature bits above the first " + std::to_string(MAX_FEATURES) + ".");
+    }
+
+    const auto vertexInput = vertexInputs.find(static_cast<uint8_t>(format));
+    if (vertexInput == vertexInputs.end())
+    {
+        throw std::runtime_error("Shader variant of '" + vertShaderPath + "' requested for a vertex format it has no vertex input for.");
+    }
+
+    // Every constant is given to both stages, a stage ignores the IDs it does not declare
+    std::array<uint32_t, 1 + MAX_FEATURES> values{};
+    std::array<VkSpecializationMapEntry, 1 + MAX_FEATURES> entries{};
+
+    values[0] = static_cast<uint32_t>(format);
+    entries[0] = {VERTEX_FORMAT_CONSTANT_ID, 0, sizeof(uint32_t)};
+    for (uint32_t bit = 0; bit < MAX_FEATURES; ++bit)
+    {
+        values[1 + bit] = (features >> bit) & 1u ? VK_TRUE : VK_FALSE; // bool constants are read as VkBool32
+        entries[1 + bit] = {FIRST_FEATURE_CONSTANT_ID + bit, (1 + bit) * sizeof(uint32_t), sizeof(VkBool32)};
+    }
+
+    VkSpecializationInfo specialization = {};
+    specialization.mapEntryCount = (uint32_t)entries.size();
+    specialization.pMapEntries = entries.data();
+    specialization.dataSize = sizeof(values);
+    specialization.pData = values.data();
+
+    const ShaderModule vertShader = ShaderModule::CreateVertShader(device, vertShaderPath);
+    const ShaderModule fragShader = ShaderModule::CreateFragShader(device, fragShaderPath);
+
+    PipelineBuilder variantBuilder = builder;
+    variantBuilder._shaderStages.push_back(vertShader.pipelineShaderStageCreateInfo);
+    variantBuilder._shaderStages.push_back(fragShader.pipelineShaderStageCreateInfo);
+    for (VkPipelineShaderStageCreateInfo& stage : variantBuilder._shaderStages)
+    {
+        stage.pSpecializationInfo = &specialization;
+    }
+
+    const VertexInputAttributeDescriptor& description = vertexInput->second;
+    variantBuilder._vertexInputInfo.pVertexAttributeDescriptions = description.attributes.data();
+    variantBuilder._vertexInputInfo.vertexAttributeDescriptionCount = (uint32_t)description.attributes.size();
+    variantBuilder._vertexInputInfo.pVertexBindingDescriptions = description.bindings.data();
+    variantBuilder._vertexInputInfo.vertexBindingDescriptionCount = (uint32_t)description.bindings.size();
+
+    const VkPipeline pipeline = variantBuilder.BuildPipeline(device, renderPass);
+    if (pipeline == VK_NULL_HANDLE)
+    {
+        throw std::runtime_error("Failed to build a shader variant of '" + vertShaderPath + "'.");
+    }
+
+    std::cout << "[INFO] [ShaderVariantCache] Built '" << vertShaderPath << "' variant with features 0x"
+        << std::hex << features << std::dec << ", " << (format == VertexFormat::Quantized16 ? "quantized" : "float") << " vertices." << std::endl;
+
+    return pipeline;
+}
+
+} // namespace velecs
@@ -0,0 +1,329 @@
+/// @file    SkinningSystem.cpp
+/// @author  Matthew Green
+/// @date    2024-01-23 14:51:16
+///
+/// @section LICENSE
+///
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Rendering/SkinningSystem.h"
+
+#include "velecs/Rendering/ShaderModule.h"
+#include "velecs/Rendering/SimpleVertex.h"
+#include "velecs/Rendering/SkinningPushConstants.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+
+namespace velecs {
+
+namespace {
+
+/// @brief Points one storage buffer binding of @p set at a range of a buffer.
+VkWriteDescriptorSet WriteStorageBuffer(VkDescriptorSet set, const uint32_t binding, const VkDescriptorBufferInfo* bufferInfo)
+{
+    VkWriteDescriptorSet write = {};
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet = set;
+    write.dstBinding = binding;
+    write.descriptorCount = 1;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    write.pBufferInfo = bufferInfo;
+    return write;
+}
+
+} // namespace
+
+// Public Fields
+
+// Constructors and Destructors
+
+// Public Methods
+
+void SkinningSystem::Init(VkDevice device, VmaAllocator allocator, DescriptorLayoutCache& layoutCache)
+{
+    this->device = device;
+    this->allocator = allocator;
+
+    // LAYOUT
+
+    const uint32_t bindingIndices[] = {BIND_POSE_BINDING, BONES_BINDING, OUTPUT_BINDING};
+    VkDescriptorSetLayoutBinding bindings[3] = {};
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        bindings[i].binding = bindingIndices[i];
+        bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        bindings[i].descriptorCount = 1;
+        bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    }
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo = {};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.bindingCount = (uint32_t)std::size(bindings);
+    layoutInfo.pBindings = bindings;
+
+    layout = layoutCache.CreateLayout(layoutInfo);
+
+    // PIPELINE
+
+    VkPushConstantRange pushConstant = {};
+    pushConstant.offset = 0;
+    pushConstant.size = sizeof(SkinningPushConstants);
+    pushConstant.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+
+    VkPipelineLayoutCreateInfo pipelineLayoutInfo = {};
+    pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipelineLayoutInfo.setLayoutCount = 1;
+    pipelineLayoutInfo.pSetLayouts = &layout;
+    pipelineLayoutInfo.pushConstantRangeCount = 1;
+    pipelineLayoutInfo.pPushConstantRanges = &pushConstant;
+
+    if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create the skinning pipeline layout.");
+    }
+
+    const ShaderModule skinShader = ShaderModule::CreateCompShader(device, "Skinning/Skin.comp.spv");
+
+    VkComputePipelineCreateInfo pipelineInfo = {};
+    pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipelineInfo.stage = skinShader.pipelineShaderStageCreateInfo;
+    pipelineInfo.layout = pipelineLayout;
+
+    if (vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create the skinning pipeline.");
+    }
+}
+
+void SkinningSystem::Cleanup()
+{
+    if (pipeline != VK_NULL_HANDLE)
+    {
+        vkDestroyPipeline(device, pipeline, nullptr);
+        pipeline = VK_NULL_HANDLE;
+    }
+    if (pipelineLayout != VK_NULL_HANDLE)
+    {
+        vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
+        pipelineLayout = VK_NULL_HANDLE;
+    }
+
+    for (AllocatedBuffer& buffer : outputBuffers)
+    {
+        if (buffer.IsInitialized())
+        {
+            vmaDestroyBuffer(allocator, buffer._buffer, buffer._allocation);
+        }
+    }
+    for (const AllocatedBuffer& buffer : releasedBuffers)
+    {
+        vmaDestroyBuffer(allocator, buffer._buffer, buffer._allocation);
+    }
+    outputBuffers.clear();
+    outputCapacities.clear();
+    freeIndices.clear();
+    releasedBuffers.clear();
+    liveCount = 0;
+
+    if (boneBuffer.IsInitialized())
+    {
+        vmaDestroyBuffer(allocator, boneBuffer._buffer, boneBuffer._allocation);
+        boneBuffer = AllocatedBuffer{};
+    }
+    mappedBones = nullptr;
+    boneCapacity = 0;
+
+    // the layout belongs to the layout cache
+    layout = VK_NULL_HANDLE;
+}
+
+uint32_t SkinningSystem::Allocate()
+{
+    ++liveCount;
+
+    if (!freeIndices.empty())
+    {
+        const uint32_t index = freeIndices.back();
+        freeIndices.pop_back();
+        return index;
+    }
+
+    outputBuffers.emplace_back();
+    outputCapacities.push_back(0);
+    return static_cast<uint32_t>(outputBuffers.size() - 1);
+}
+
+void SkinningSystem::Release(const uint32_t index)
+{
+    if (index == INVALID_INDEX || index >= outputBuffers.size())
+    {
+        return;
+    }
+
+    if (outputBuffers[index].IsInitialized())
+    {
+        releasedBuffers.push_back(outputBuffers[index]);
+        outputBuffers[index] = AllocatedBuffer{};
+    }
+    outputCapacities[index] = 0;
+
+    freeIndices.push_back(index);
+    --liveCount;
+}
+
+VkBuffer SkinningSystem::Reserve(const uint32_t index, const uint32_t vertexCount, std::vector<AllocatedBuffer>& retiredBuffers)
+{
+    AllocatedBuffer& buffer = outputBuffers[index];
+    if (buffer.IsInitialized() && outputCapacities[index] >= vertexCount)
+    {
+        return buffer._buffer;
+    }
+
+    if (buffer.IsInitialized())
+    {
+        retiredBuffers.push_back(buffer);
+        buffer = AllocatedBuffer{};
+        outputCapacities[index] = 0;
+    }
+
+    // written by the compute pass, read as a SimpleVertex stream by the draw
+    VkBufferCreateInfo bufferInfo = {};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = sizeof(SimpleVertex) * static_cast<VkDeviceSize>(std::max(vertexCount, 1u));
+    bufferInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+
+    VmaAllocationCreateInfo allocInfo = {};
+    allocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+
+    if (vmaCreateBuffer(allocator, &bufferInfo, &allocInfo, &buffer._buffer, &buffer._allocation, nullptr) != VK_SUCCESS)
+    {
+        buffer = AllocatedBuffer{};
+        throw std::runtime_error("Failed to create a skinned vertex buffer.");
+    }
+    outputCapacities[index] = vertexCount;
+
+    return buffer._buffer;
+}
+
+void SkinningSystem::EndFrame(std::vector<AllocatedBuffer>& retiredBuffers)
+{
+    retiredBuffers.insert(retiredBuffers.end(), releasedBuffers.begin(), releasedBuffers.end());
+    releasedBuffers.clear();
+}
+
+void SkinningSystem::RecordSkinning
+(
+    VkCommandBuffer cmd,
+    DescriptorAllocator& frameDescriptorAllocator,
+    const std::vector<Dispatch>& dispatches,
+    const std::vector<glm::mat4>& boneMatrices
+)
+{
+    if (dispatches.empty() || boneMatrices.empty())
+    {
+        return;
+    }
+
+    // BONES
+
+    const VkDeviceSize boneBytes = sizeof(glm::mat4) * boneMatrices.size();
+    if (boneBytes > boneCapacity)
+    {
+        if (boneBuffer.IsInitialized())
+        {
+            vmaDestroyBuffer(allocator, boneBuffer._buffer, boneBuffer._allocation);
+            boneBuffer = AllocatedBuffer{};
+            mappedBones = nullptr;
+            boneCapacity = 0;
+        }
+
+        // doubles, so a growing crowd only reallocates a handful of times
+        VkDeviceSize newCapacity = 64 * 1024;
+        while (newCapacity < boneBytes)
+        {
+            newCapacity *= 2;
+        }
+
+        VkBufferCreateInfo bufferInfo = {};
+        bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferInfo.size = newCapacity;
+        bufferInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+
+        VmaAllocationCreateInfo allocInfo = {};
+        allocInfo.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
+        allocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+        allocInfo.requiredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
+        VmaAllocationInfo allocationInfo = {};
+        if (vmaCreateBuffer(allocator, &bufferInfo, &allocInfo, &boneBuffer._buffer, &boneBuffer._allocation, &allocationInfo) != VK_SUCCESS)
+        {
+            boneBuffer = AllocatedBuffer{};
+            throw std::runtime_error("Failed to create the skin matrix buffer.");
+        }
+        mappedBones = allocationInfo.pMappedData;
+        boneCapacity = newCapacity;
+    }
+    std::memcpy(mappedBones, boneMatrices.data(), static_cast<size_t>(boneBytes));
+
+    // DISPATCHES
+
+    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
+
+    const VkDescriptorBufferInfo bonesInfo = {boneBuffer._buffer, 0, boneBytes};
+    for (const Dispatch& dispatch : dispatches)
+    {
+        // the output buffers change as instances come and go, so the sets are written anew each frame
+        const VkDescriptorSet set = frameDescriptorAllocator.Allocate(layout);
+
+        const VkDescriptorBufferInfo bindPoseInfo = {dispatch.bindPose, 0, VK_WHOLE_SIZE};
+        const VkDescriptorBufferInfo outputInfo = {dispatch.output, 0, VK_WHOLE_SIZE};
+
+        const VkWriteDescriptorSet writes[] =
+        {
+            WriteStorageBuffer(set, BIND_POSE_BINDING, &bindPoseInfo),
+            WriteStorageBuffer(set, BONES_BINDING, &bonesInfo),
+            WriteStorageBuffer(set, OUTPUT_BINDING, &outputInfo)
+        };
+        vkUpdateDescriptorSets(device, (uint32_t)std::size(writes), writes, 0, nullptr);
+
+        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, 0, 1, &set, 0, nullptr);
+
+        SkinningPushConstants constants;
+        constants.vertexCount = dispatch.vertexCount;
+        constants.firstBone = dispatch.firstBone;
+        vkCmdPushConstants(cmd, pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(SkinningPushConstants), &constants);
+
+        vkCmdDispatch(cmd, (dispatch.vertexCount + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE, 1, 1);
+    }
+
+    //the draws read the posed positions as vertex attributes
+    VkMemoryBarrier toDraw = {};
+    toDraw.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    toDraw.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    toDraw.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
+
+    vkCmdPipelineBarrier(cmd,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+        0, 1, &toDraw, 0, nullptr, 0, nullptr);
+}
+
+uint32_t SkinningSystem::GetInstanceCount() const
+{
+    return liveCount;
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+} // namespace velecs
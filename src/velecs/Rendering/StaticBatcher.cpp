@@ -0,0 +1,94 @@
+/// @file    StaticBatcher.cpp
+/// @author  Matthew Green
+/// @date    2024-01-13 10:31:52
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Rendering/StaticBatcher.h"
+
+#include "velecs/Rendering/VertexQuantization.h"
+
+#include <glm/mat3x3.hpp>
+#include <glm/vec4.hpp>
+#include <glm/matrix.hpp>
+
+#include <cmath>
+#include <utility>
+
+namespace velecs {
+
+// Public Fields
+
+// Constructors and Destructors
+
+StaticBatcher::StaticBatcher(const float chunkSize /*= DEFAULT_CHUNK_SIZE*/)
+    : chunkSize(chunkSize) {}
+
+// Public Methods
+
+void StaticBatcher::Add(const uint32_t group, const glm::mat4& worldMatrix, const SimpleMesh& mesh)
+{
+    const glm::vec3 localCenter = (mesh._bounds.min + mesh._bounds.max) * 0.5f;
+    const glm::vec3 center = glm::vec3(worldMatrix * glm::vec4(localCenter, 1.0f));
+
+    const BatchKey key
+    {
+        group,
+        static_cast<int32_t>(std::floor(center.x / chunkSize)),
+        static_cast<int32_t>(std::floor(center.y / chunkSize)),
+        static_cast<int32_t>(std::floor(center.z / chunkSize))
+    };
+
+    Batch& batch = batches[key];
+    batch.group = group;
+    batch.chunk = {std::get<1>(key), std::get<2>(key), std::get<3>(key)};
+    ++batch.sourceCount;
+
+    const uint32_t baseVertex = static_cast<uint32_t>(batch.mesh._vertices.size());
+    batch.mesh._vertices.reserve(batch.mesh._vertices.size() + mesh._vertices.size());
+    for (const SimpleVertex& vertex : mesh._vertices)
+    {
+        batch.mesh._vertices.emplace_back(glm::vec3(worldMatrix * glm::vec4(vertex.position, 1.0f)));
+    }
+
+    // A mirroring transform turns triangles inside out, swap two corners to keep the winding
+    const bool mirrored = glm::determinant(glm::mat3(worldMatrix)) < 0.0f;
+
+    batch.mesh._indices.reserve(batch.mesh._indices.size() + mesh._indices.size());
+    for (size_t i = 0; i + 2 < mesh._indices.size(); i += 3)
+    {
+        batch.mesh._indices.push_back(baseVertex + mesh._indices[i]);
+        batch.mesh._indices.push_back(baseVertex + mesh._indices[mirrored ? i + 2 : i + 1]);
+        batch.mesh._indices.push_back(baseVertex + mesh._indices[mirrored ? i + 1 : i + 2]);
+    }
+}
+
+std::vector<StaticBatcher::Batch> StaticBatcher::Build()
+{
+    std::vector<Batch> result;
+    result.reserve(batches.size());
+
+    for (auto& [key, batch] : batches)
+    {
+        batch.mesh.RecalculateBounds();
+        batch.mesh._vertexFormat = VertexQuantization::ChooseFormat(batch.mesh._bounds);
+        result.push_back(std::move(batch));
+    }
+
+    batches.clear();
+    return result;
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+} // namespace velecs
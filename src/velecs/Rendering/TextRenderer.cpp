@@ -0,0 +1,481 @@
+/// @file    TextRenderer.cpp
+/// @author  Matthew Green
+/// @date    2024-01-22 13:41:56
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Rendering/TextRenderer.h"
+
+#include "velecs/Math/AABB.h"
+#include "velecs/Math/Frustum.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+
+namespace velecs {
+
+namespace {
+
+/// @brief Decodes the UTF-8 sequence at @p index and moves past it.
+/// @return The codepoint, U+FFFD for a malformed sequence.
+uint32_t NextCodepoint(const std::string& text, size_t& index)
+{
+    const uint32_t lead = static_cast<unsigned char>(text[index++]);
+    if (lead < 0x80)
+    {
+        return lead;
+    }
+
+    uint32_t codepoint = 0;
+    size_t continuationCount = 0;
+    if ((lead & 0xE0) == 0xC0)
+    {
+        codepoint = lead & 0x1F;
+        continuationCount = 1;
+    }
+    else if ((lead & 0xF0) == 0xE0)
+    {
+        codepoint = lead & 0x0F;
+        continuationCount = 2;
+    }
+    else if ((lead & 0xF8) == 0xF0)
+    {
+        codepoint = lead & 0x07;
+        continuationCount = 3;
+    }
+    else
+    {
+        return 0xFFFD; // Stray continuation byte
+    }
+
+    for (size_t i = 0; i < continuationCount; ++i)
+    {
+        if (index >= text.size() || (static_cast<unsigned char>(text[index]) & 0xC0) != 0x80)
+        {
+            return 0xFFFD; // Truncated sequence, the next byte starts over
+        }
+        codepoint = (codepoint << 6) | (static_cast<unsigned char>(text[index++]) & 0x3F);
+    }
+    return codepoint;
+}
+
+/// @brief Packs a color the way unpackUnorm4x8 reads it, red in the lowest byte.
+uint32_t PackColor(const Color32 color)
+{
+    return uint32_t(color.r) | (uint32_t(color.g) << 8) | (uint32_t(color.b) << 16) | (uint32_t(color.a) << 24);
+}
+
+} // namespace
+
+// Public Fields
+
+// Constructors and Destructors
+
+// Public Methods
+
+void TextRenderer::Init(VkDevice device, VmaAllocator allocator, DescriptorLayoutCache& layoutCache)
+{
+    this->device = device;
+    this->allocator = allocator;
+
+    VkDescriptorSetLayoutBinding bindings[2] = {};
+
+    bindings[0].binding = LABELS_BINDING;
+    bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    bindings[0].descriptorCount = 1;
+    bindings[0].stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+
+    bindings[1].binding = GLYPHS_BINDING;
+    bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    bindings[1].descriptorCount = 1;
+    bindings[1].stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo = {};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.bindingCount = (uint32_t)std::size(bindings);
+    layoutInfo.pBindings = bindings;
+
+    layout = layoutCache.CreateLayout(layoutInfo);
+}
+
+void TextRenderer::Cleanup()
+{
+    for (Font& font : fonts)
+    {
+        vkDestroyImageView(device, font.imageView, nullptr);
+        vmaDestroyImage(allocator, font.image._image, font.image._allocation);
+    }
+    fonts.clear();
+
+    AllocatedBuffer* const buffers[] = {&stagingBuffer, &labelBuffer, &glyphBuffer};
+    for (AllocatedBuffer* const buffer : buffers)
+    {
+        if (buffer->IsInitialized())
+        {
+            vmaDestroyBuffer(allocator, buffer->_buffer, buffer->_allocation);
+            *buffer = AllocatedBuffer{};
+        }
+    }
+    mappedStaging = nullptr;
+    mappedLabels = nullptr;
+    mappedGlyphs = nullptr;
+    stagingCapacity = 0;
+    labelCapacity = 0;
+    glyphCapacity = 0;
+}
+
+uint32_t TextRenderer::AddFont(std::unique_ptr<GlyphAtlas> atlas, const AllocatedImage& image, VkImageView imageView, const uint32_t textureIndex)
+{
+    Font font;
+    font.atlas = std::move(atlas);
+    font.image = image;
+    font.imageView = imageView;
+    font.textureIndex = textureIndex;
+    fonts.push_back(std::move(font));
+    return static_cast<uint32_t>(fonts.size() - 1);
+}
+
+uint32_t TextRenderer::GetFontCount() const
+{
+    return static_cast<uint32_t>(fonts.size());
+}
+
+bool TextRenderer::Extract(TextLabel& label, const glm::mat4& worldMatrix, const glm::mat4& viewProjection, std::vector<TextLabelParams>& labels)
+{
+    if (label.font >= fonts.size())
+    {
+        return false; // Font not loaded
+    }
+    Font& font = fonts[label.font];
+
+    TextLabel::Layout& layout = label.layout;
+    if (layout.revision != label.GetRevision() || layout.font != label.font || layout.generation != font.atlas->GetGeneration())
+    {
+        Layout(*font.atlas, label);
+        ++layoutCount;
+    }
+
+    if (layout.glyphs.empty())
+    {
+        return false; // Nothing but whitespace
+    }
+
+    TextLabelParams params;
+    params.transform = worldMatrix;
+    params.offset = glm::vec2{-label.pivot.x * layout.width, (1.0f - label.pivot.y) * layout.height};
+    params.size = label.size;
+    params.color = PackColor(label.color);
+    params.billboard = label.billboard ? 1 : 0;
+
+    // the block in the label's local space, a billboard may turn any way around its origin
+    const glm::vec2 blockMin = (params.offset - glm::vec2{0.0f, layout.height}) * label.size;
+    const glm::vec2 blockMax = (params.offset + glm::vec2{layout.width, 0.0f}) * label.size;
+    glm::mat4 renderMatrix = viewProjection * worldMatrix;
+    AABB bounds{glm::vec3{blockMin, 0.0f}, glm::vec3{blockMax, 0.0f}};
+    if (label.billboard)
+    {
+        glm::mat4 originMatrix{1.0f};
+        originMatrix[3] = worldMatrix[3];
+        renderMatrix = viewProjection * originMatrix;
+
+        const float radius = std::max({std::abs(blockMin.x), std::abs(blockMin.y), std::abs(blockMax.x), std::abs(blockMax.y)});
+        bounds = AABB{glm::vec3{-radius}, glm::vec3{radius}};
+    }
+
+    // planes taken from the full matrix are in the label's space, so the local box is tested as is
+    if (!Frustum::FromViewProjection(renderMatrix).Intersects(bounds))
+    {
+        return false;
+    }
+
+    const uint32_t labelIndex = static_cast<uint32_t>(labels.size());
+    labels.push_back(params);
+
+    for (const GlyphInstance& glyph : layout.glyphs)
+    {
+        font.glyphs.push_back(glyph);
+        font.glyphs.back().labelIndex = labelIndex;
+    }
+    return true;
+}
+
+void TextRenderer::EndFrame
+(
+    std::vector<GlyphInstance>& glyphs,
+    std::vector<Batch>& batches,
+    std::vector<AtlasUpload>& uploads,
+    std::vector<unsigned char>& uploadPixels
+)
+{
+    for (Font& font : fonts)
+    {
+        if (!font.glyphs.empty())
+        {
+            Batch batch;
+            batch.textureIndex = font.textureIndex;
+            batch.firstGlyph = static_cast<uint32_t>(glyphs.size());
+            batch.glyphCount = static_cast<uint32_t>(font.glyphs.size());
+            batches.push_back(batch);
+
+            glyphs.insert(glyphs.end(), font.glyphs.begin(), font.glyphs.end());
+            font.glyphs.clear();
+        }
+
+        AtlasUpload upload;
+        if (font.atlas->TakeDirtyRows(upload.firstRow, upload.rowCount))
+        {
+            upload.image = font.image._image;
+            upload.width = font.atlas->GetSize();
+            upload.pixelOffset = uploadPixels.size();
+            uploads.push_back(upload);
+
+            const auto rows = font.atlas->GetPixels().begin() + static_cast<ptrdiff_t>(upload.firstRow) * upload.width;
+            uploadPixels.insert(uploadPixels.end(), rows, rows + static_cast<ptrdiff_t>(upload.rowCount) * upload.width);
+        }
+    }
+}
+
+void TextRenderer::RecordUploads(VkCommandBuffer cmd, const std::vector<AtlasUpload>& uploads, const std::vector<unsigned char>& uploadPixels)
+{
+    if (uploads.empty())
+    {
+        return;
+    }
+
+    Reserve(stagingBuffer, mappedStaging, stagingCapacity, uploadPixels.size(), VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
+    std::memcpy(mappedStaging, uploadPixels.data(), uploadPixels.size());
+
+    for (const AtlasUpload& upload : uploads)
+    {
+        VkImageMemoryBarrier toTransfer = {};
+        toTransfer.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        toTransfer.oldLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        toTransfer.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        toTransfer.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        toTransfer.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        toTransfer.image = upload.image;
+        toTransfer.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        toTransfer.subresourceRange.baseMipLevel = 0;
+        toTransfer.subresourceRange.levelCount = 1;
+        toTransfer.subresourceRange.baseArrayLayer = 0;
+        toTransfer.subresourceRange.layerCount = 1;
+        toTransfer.srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        toTransfer.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &toTransfer);
+
+        VkBufferImageCopy copyRegion = {};
+        copyRegion.bufferOffset = upload.pixelOffset;
+        copyRegion.bufferRowLength = 0;
+        copyRegion.bufferImageHeight = 0;
+        copyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        copyRegion.imageSubresource.mipLevel = 0;
+        copyRegion.imageSubresource.baseArrayLayer = 0;
+        copyRegion.imageSubresource.layerCount = 1;
+        copyRegion.imageOffset = {0, static_cast<int32_t>(upload.firstRow), 0};
+        copyRegion.imageExtent = {upload.width, upload.rowCount, 1};
+
+        vkCmdCopyBufferToImage(cmd, stagingBuffer._buffer, upload.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &copyRegion);
+
+        VkImageMemoryBarrier toReadable = toTransfer;
+        toReadable.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        toReadable.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        toReadable.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        toReadable.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &toReadable);
+    }
+}
+
+void TextRenderer::RecordDraw
+(
+    VkCommandBuffer cmd,
+    VkPipelineLayout pipelineLayout,
+    DescriptorAllocator& frameDescriptorAllocator,
+    const std::vector<TextLabelParams>& labels,
+    const std::vector<GlyphInstance>& glyphs,
+    const std::vector<Batch>& batches,
+    TextPushConstants constants,
+    const uint32_t setIndex /*= 1*/
+)
+{
+    if (batches.empty())
+    {
+        return;
+    }
+
+    const VkDeviceSize labelBytes = sizeof(TextLabelParams) * labels.size();
+    const VkDeviceSize glyphBytes = sizeof(GlyphInstance) * glyphs.size();
+    Reserve(labelBuffer, mappedLabels, labelCapacity, labelBytes, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+    Reserve(glyphBuffer, mappedGlyphs, glyphCapacity, glyphBytes, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+    std::memcpy(mappedLabels, labels.data(), static_cast<size_t>(labelBytes));
+    std::memcpy(mappedGlyphs, glyphs.data(), static_cast<size_t>(glyphBytes));
+
+    // the buffers may have been replaced since the last frame, so the set is written anew each frame
+    const VkDescriptorSet set = frameDescriptorAllocator.Allocate(layout);
+
+    VkDescriptorBufferInfo bufferInfos[2] = {};
+    bufferInfos[0].buffer = labelBuffer._buffer;
+    bufferInfos[0].offset = 0;
+    bufferInfos[0].range = labelBytes;
+    bufferInfos[1].buffer = glyphBuffer._buffer;
+    bufferInfos[1].offset = 0;
+    bufferInfos[1].range = glyphBytes;
+
+    VkWriteDescriptorSet writes[2] = {};
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+        writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[i].dstSet = set;
+        writes[i].dstBinding = i == 0 ? LABELS_BINDING : GLYPHS_BINDING;
+        writes[i].descriptorCount = 1;
+        writes[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        writes[i].pBufferInfo = &bufferInfos[i];
+    }
+    vkUpdateDescriptorSets(device, (uint32_t)std::size(writes), writes, 0, nullptr);
+
+    vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, setIndex, 1, &set, 0, nullptr);
+
+    for (const Batch& batch : batches)
+    {
+        constants.textureIndex = batch.textureIndex;
+        vkCmdPushConstants(cmd, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(TextPushConstants), &constants);
+        vkCmdDraw(cmd, VERTICES_PER_GLYPH, batch.glyphCount, 0, batch.firstGlyph);
+    }
+}
+
+void TextRenderer::Layout(GlyphAtlas& atlas, TextLabel& label)
+{
+    TextLabel::Layout& layout = label.layout;
+    const std::string& text = label.GetText();
+
+    // a second pass only happens when the first one emptied the atlas
+    for (uint32_t attempt = 0; attempt < 2; ++attempt)
+    {
+        const uint32_t generation = atlas.GetGeneration();
+
+        layout.glyphs.clear();
+        float penX = 0.0f;
+        float baseline = -atlas.GetAscent();
+        float width = 0.0f;
+        uint32_t lineCount = 1;
+        uint32_t previous = 0;
+
+        size_t index = 0;
+        while (index < text.size())
+        {
+            const uint32_t codepoint = NextCodepoint(text, index);
+            if (codepoint == '\n')
+            {
+                width = std::max(width, penX);
+                penX = 0.0f;
+                baseline -= atlas.GetLineHeight();
+                ++lineCount;
+                previous = 0;
+                continue;
+            }
+            if (codepoint == '\r')
+            {
+                continue;
+            }
+
+            if (previous != 0)
+            {
+                penX += atlas.GetKerning(previous, codepoint);
+            }
+
+            const GlyphAtlas::Glyph& glyph = atlas.GetGlyph(codepoint);
+            if (glyph.visible)
+            {
+                GlyphInstance instance;
+                instance.rect = glyph.rect + glm::vec4{penX, baseline, penX, baseline};
+                instance.uvRect = glyph.uvRect;
+                layout.glyphs.push_back(instance);
+            }
+
+            penX += glyph.advance;
+            previous = codepoint;
+        }
+
+        layout.width = std::max(width, penX);
+        layout.height = lineCount * atlas.GetLineHeight();
+
+        if (atlas.GetGeneration() == generation)
+        {
+            break;
+        }
+    }
+
+    layout.revision = label.GetRevision();
+    layout.font = label.font;
+    layout.generation = atlas.GetGeneration();
+}
+
+VkDescriptorSetLayout TextRenderer::GetLayout() const
+{
+    return layout;
+}
+
+uint64_t TextRenderer::GetLayoutCount() const
+{
+    return layoutCount;
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+void TextRenderer::Reserve(AllocatedBuffer& buffer, void*& mapped, VkDeviceSize& capacity, const VkDeviceSize size, const VkBufferUsageFlags usage)
+{
+    if (size <= capacity)
+    {
+        return;
+    }
+
+    if (buffer.IsInitialized())
+    {
+        vmaDestroyBuffer(allocator, buffer._buffer, buffer._allocation);
+        buffer = AllocatedBuffer{};
+    }
+
+    // doubles, so a growing scene only reallocates a handful of times
+    VkDeviceSize newCapacity = std::max<VkDeviceSize>(capacity * 2, 64 * 1024);
+    while (newCapacity < size)
+    {
+        newCapacity *= 2;
+    }
+
+    VkBufferCreateInfo bufferInfo = {};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = newCapacity;
+    bufferInfo.usage = usage;
+
+    VmaAllocationCreateInfo allocInfo = {};
+    allocInfo.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
+    allocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+    allocInfo.requiredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
+    VmaAllocationInfo allocationInfo = {};
+    if (vmaCreateBuffer(allocator, &bufferInfo, &allocInfo, &buffer._buffer, &buffer._allocation, &allocationInfo) != VK_SUCCESS)
+    {
+        mapped = nullptr;
+        capacity = 0;
+        throw std::runtime_error("Failed to create a text buffer.");
+    }
+
+    mapped = allocationInfo.pMappedData;
+    capacity = newCapacity;
+}
+
+} // namespace velecs
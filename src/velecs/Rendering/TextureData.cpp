@@ -0,0 +1,266 @@
+/// @file    TextureData.cpp
+/// @author  Matthew Green
+/// @date    2024-01-19 11:52:36
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Rendering/TextureData.h"
+
+#include "velecs/Rendering/BlockCompression.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace velecs {
+
+// Public Fields
+
+// Constructors and Destructors
+
+// Public Methods
+
+TextureData TextureData::FromRGBA8(const uint8_t* rgba, const uint32_t width, const uint32_t height)
+{
+    TextureData texture;
+    texture.format = VK_FORMAT_R8G8B8A8_UNORM;
+    texture.width = width;
+    texture.height = height;
+    texture.mips.emplace_back(rgba, rgba + static_cast<size_t>(width) * height * 4);
+    return texture;
+}
+
+TextureData TextureData::FromSprite(const Sprite& sprite)
+{
+    if (!sprite.isValid())
+    {
+        throw std::runtime_error("Cannot make a texture from an invalid sprite.");
+    }
+
+    return FromRGBA8(sprite.data(), static_cast<uint32_t>(sprite.width()), static_cast<uint32_t>(sprite.height()));
+}
+
+TextureData TextureData::LoadBaked(const std::string& filePath)
+{
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file.is_open())
+    {
+        throw std::runtime_error("Failed to open baked texture: " + filePath);
+    }
+
+    uint32_t header[6] = {};
+    file.read(reinterpret_cast<char*>(header), sizeof(header));
+    if (!file || header[0] != BAKED_MAGIC || header[1] != BAKED_VERSION)
+    {
+        std::ostringstream oss;
+        oss << "Baked texture " << filePath << " is not a version " << BAKED_VERSION << " .vtex file.";
+        throw std::runtime_error(oss.str());
+    }
+
+    TextureData texture;
+    texture.format = static_cast<VkFormat>(header[2]);
+    texture.width = header[3];
+    texture.height = header[4];
+
+    // every count and size below comes from the file, so nothing is allocated before it is checked
+    const bool isCompressed = BlockCompression::IsBlockCompressed(texture.format);
+    if ((texture.format != VK_FORMAT_R8G8B8A8_UNORM && !isCompressed) ||
+        texture.width == 0 || texture.height == 0 ||
+        texture.width > MAX_BAKED_DIMENSION || texture.height > MAX_BAKED_DIMENSION ||
+        header[5] == 0 || header[5] > GetFullMipCount(texture.width, texture.height))
+    {
+        std::ostringstream oss;
+        oss << "Baked texture " << filePath << " has an invalid header (format " << header[2] << ", "
+            << texture.width << "x" << texture.height << ", " << header[5] << " mips).";
+        throw std::runtime_error(oss.str());
+    }
+
+    texture.mips.resize(header[5]);
+    for (uint32_t level = 0; level < header[5]; ++level)
+    {
+        const uint32_t mipWidth = texture.GetMipWidth(level);
+        const uint32_t mipHeight = texture.GetMipHeight(level);
+        const size_t expectedSize = isCompressed
+            ? BlockCompression::GetImageSize(texture.format, mipWidth, mipHeight)
+            : static_cast<size_t>(mipWidth) * mipHeight * 4;
+
+        uint64_t size = 0;
+        file.read(reinterpret_cast<char*>(&size), sizeof(size));
+        if (!file)
+        {
+            break;
+        }
+
+        if (size != expectedSize)
+        {
+            std::ostringstream oss;
+            oss << "Baked texture " << filePath << " has " << size << " bytes in mip " << level << ", expected " << expectedSize << ".";
+            throw std::runtime_error(oss.str());
+        }
+
+        std::vector<uint8_t>& mip = texture.mips[level];
+        mip.resize(expectedSize);
+        file.read(reinterpret_cast<char*>(mip.data()), static_cast<std::streamsize>(expectedSize));
+    }
+
+    if (!file)
+    {
+        throw std::runtime_error("Baked texture is truncated: " + filePath);
+    }
+
+    return texture;
+}
+
+void TextureData::Bake(const std::string& sourcePath, const std::string& bakedPath, const VkFormat compressedFormat /*= VK_FORMAT_UNDEFINED*/)
+{
+    const Sprite sprite = Sprite::Load(sourcePath);
+    if (!sprite.isValid())
+    {
+        throw std::runtime_error("Failed to decode texture source: " + sourcePath);
+    }
+
+    TextureData texture = FromSprite(sprite);
+    texture.GenerateMips();
+
+    VkFormat targetFormat = compressedFormat;
+    if (targetFormat == VK_FORMAT_UNDEFINED)
+    {
+        targetFormat = BlockCompression::ChooseFormat(texture.mips[0].data(), texture.width, texture.height);
+    }
+
+    if (targetFormat != VK_FORMAT_R8G8B8A8_UNORM)
+    {
+        texture = texture.Compress(targetFormat);
+    }
+
+    texture.Save(bakedPath);
+}
+
+void TextureData::Save(const std::string& filePath) const
+{
+    std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+        throw std::runtime_error("Failed to write baked texture: " + filePath);
+    }
+
+    const uint32_t header[6] = {BAKED_MAGIC, BAKED_VERSION, static_cast<uint32_t>(format), width, height, static_cast<uint32_t>(mips.size())};
+    file.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+    for (const std::vector<uint8_t>& mip : mips)
+    {
+        const uint64_t size = mip.size();
+        file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+        file.write(reinterpret_cast<const char*>(mip.data()), static_cast<std::streamsize>(size));
+    }
+}
+
+void TextureData::GenerateMips()
+{
+    if (format != VK_FORMAT_R8G8B8A8_UNORM || mips.empty())
+    {
+        throw std::runtime_error("Mips can only be generated for RGBA8 textures.");
+    }
+
+    const uint32_t mipCount = GetFullMipCount(width, height);
+    mips.resize(1);
+    mips.reserve(mipCount);
+
+    for (uint32_t level = 1; level < mipCount; ++level)
+    {
+        const uint32_t sourceWidth = GetMipWidth(level - 1);
+        const uint32_t sourceHeight = GetMipHeight(level - 1);
+        const uint32_t mipWidth = GetMipWidth(level);
+        const uint32_t mipHeight = GetMipHeight(level);
+
+        std::vector<uint8_t> mip(static_cast<size_t>(mipWidth) * mipHeight * 4);
+        const std::vector<uint8_t>& source = mips[level - 1];
+
+        // 2x2 box filter, the last row or column of odd sizes is reused
+        for (uint32_t y = 0; y < mipHeight; ++y)
+        {
+            const uint32_t y0 = std::min(y * 2, sourceHeight - 1);
+            const uint32_t y1 = std::min(y * 2 + 1, sourceHeight - 1);
+            for (uint32_t x = 0; x < mipWidth; ++x)
+            {
+                const uint32_t x0 = std::min(x * 2, sourceWidth - 1);
+                const uint32_t x1 = std::min(x * 2 + 1, sourceWidth - 1);
+                for (uint32_t c = 0; c < 4; ++c)
+                {
+                    const uint32_t sum =
+                        source[(static_cast<size_t>(y0) * sourceWidth + x0) * 4 + c] +
+                        source[(static_cast<size_t>(y0) * sourceWidth + x1) * 4 + c] +
+                        source[(static_cast<size_t>(y1) * sourceWidth + x0) * 4 + c] +
+                        source[(static_cast<size_t>(y1) * sourceWidth + x1) * 4 + c];
+                    mip[(static_cast<size_t>(y) * mipWidth + x) * 4 + c] = static_cast<uint8_t>((sum + 2) / 4);
+                }
+            }
+        }
+
+        mips.push_back(std::move(mip));
+    }
+}
+
+TextureData TextureData::Compress(const VkFormat compressedFormat) const
+{
+    if (format != VK_FORMAT_R8G8B8A8_UNORM)
+    {
+        throw std::runtime_error("Only RGBA8 textures can be block compressed.");
+    }
+
+    TextureData compressed;
+    compressed.format = compressedFormat;
+    compressed.width = width;
+    compressed.height = height;
+    compressed.mips.reserve(mips.size());
+    for (uint32_t level = 0; level < mips.size(); ++level)
+    {
+        compressed.mips.push_back(BlockCompression::Compress(mips[level].data(), GetMipWidth(level), GetMipHeight(level), compressedFormat));
+    }
+    return compressed;
+}
+
+uint32_t TextureData::GetFullMipCount(const uint32_t width, const uint32_t height)
+{
+    uint32_t count = 1;
+    for (uint32_t size = std::max(width, height); size > 1; size >>= 1)
+    {
+        ++count;
+    }
+    return count;
+}
+
+uint32_t TextureData::GetMipWidth(const uint32_t level) const
+{
+    return std::max(width >> level, 1u);
+}
+
+uint32_t TextureData::GetMipHeight(const uint32_t level) const
+{
+    return std::max(height >> level, 1u);
+}
+
+size_t TextureData::GetTotalSize() const
+{
+    size_t size = 0;
+    for (const std::vector<uint8_t>& mip : mips)
+    {
+        size += mip.size();
+    }
+    return size;
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+} // namespace velecs
@@ -0,0 +1,77 @@
+/// @file    TileVertex.cpp
+/// @author  Matthew Green
+/// @date    2024-01-21 10:15:37
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Rendering/TileVertex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace velecs {
+
+namespace {
+
+/// @brief Maps [0, 1] to the full range of a 16-bit UNORM.
+uint16_t ToUnorm16(const float value)
+{
+    return static_cast<uint16_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 65535.0f));
+}
+
+} // namespace
+
+// Public Fields
+
+// Constructors and Destructors
+
+TileVertex::TileVertex(const uint16_t x, const uint16_t y, const float u, const float v)
+    : corner{x, y}, uv{ToUnorm16(u), ToUnorm16(v)} {}
+
+// Public Methods
+
+VertexInputAttributeDescriptor TileVertex::GetVertexDescription()
+{
+    VertexInputAttributeDescriptor description;
+
+    //we will have just 1 vertex buffer binding, with a per-vertex rate
+    VkVertexInputBindingDescription mainBinding = {};
+    mainBinding.binding = 0;
+    mainBinding.stride = sizeof(TileVertex);
+    mainBinding.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+
+    description.bindings.push_back(mainBinding);
+
+    //Corner will be stored at Location 0, as whole tiles
+    VkVertexInputAttributeDescription cornerAttribute = {};
+    cornerAttribute.binding = 0;
+    cornerAttribute.location = 0;
+    cornerAttribute.format = VK_FORMAT_R16G16_UINT;
+    cornerAttribute.offset = offsetof(TileVertex, corner);
+
+    //UV will be stored at Location 1
+    VkVertexInputAttributeDescription uvAttribute = {};
+    uvAttribute.binding = 0;
+    uvAttribute.location = 1;
+    uvAttribute.format = VK_FORMAT_R16G16_UNORM;
+    uvAttribute.offset = offsetof(TileVertex, uv);
+
+    description.attributes.push_back(cornerAttribute);
+    description.attributes.push_back(uvAttribute);
+    return description;
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+} // namespace velecs
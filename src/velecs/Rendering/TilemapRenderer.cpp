@@ -0,0 +1,366 @@
+/// @file    TilemapRenderer.cpp
+/// @author  Matthew Green
+/// @date    2024-01-21 11:40:03
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Rendering/TilemapRenderer.h"
+
+#include "velecs/Math/Frustum.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace velecs {
+
+namespace {
+
+/// @brief Copies @p size bytes into a new device local buffer through a staging buffer on @p uploadQueue.
+/// @return The TransferQueue value signaled once @p destination holds the data.
+uint64_t StreamToBuffer
+(
+    VmaAllocator allocator,
+    TransferQueue& uploadQueue,
+    const void* data,
+    const VkDeviceSize size,
+    const VkBufferUsageFlags usage,
+    AllocatedBuffer& destination
+)
+{
+    VkBufferCreateInfo stagingInfo = {};
+    stagingInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    stagingInfo.size = size;
+    stagingInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+
+    VmaAllocationCreateInfo stagingAllocInfo = {};
+    stagingAllocInfo.usage = VMA_MEMORY_USAGE_CPU_ONLY;
+
+    AllocatedBuffer staging;
+    if (vmaCreateBuffer(allocator, &stagingInfo, &stagingAllocInfo, &staging._buffer, &staging._allocation, nullptr) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create a tilemap staging buffer.");
+    }
+
+    void* mapped;
+    vmaMapMemory(allocator, staging._allocation, &mapped);
+    std::memcpy(mapped, data, static_cast<size_t>(size));
+    vmaUnmapMemory(allocator, staging._allocation);
+
+    VkBufferCreateInfo bufferInfo = {};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = size;
+    bufferInfo.usage = usage | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+
+    VmaAllocationCreateInfo allocInfo = {};
+    allocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+
+    if (vmaCreateBuffer(allocator, &bufferInfo, &allocInfo, &destination._buffer, &destination._allocation, nullptr) != VK_SUCCESS)
+    {
+        vmaDestroyBuffer(allocator, staging._buffer, staging._allocation);
+        throw std::runtime_error("Failed to create a tilemap buffer.");
+    }
+
+    const VkBuffer destinationBuffer = destination._buffer;
+    return uploadQueue.Submit
+    (
+        [=](VkCommandBuffer cmd)
+        {
+            VkBufferCopy copy = {};
+            copy.size = size;
+            vkCmdCopyBuffer(cmd, staging._buffer, destinationBuffer, 1, &copy);
+        },
+        {destinationBuffer},
+        [=]()
+        {
+            vmaDestroyBuffer(allocator, staging._buffer, staging._allocation);
+        }
+    );
+}
+
+} // namespace
+
+// Public Fields
+
+// Constructors and Destructors
+
+// Public Methods
+
+void TilemapRenderer::Init(VmaAllocator allocator, TransferQueue& uploadQueue, const uint32_t rebuildBudget /*= DEFAULT_REBUILD_BUDGET*/)
+{
+    this->allocator = allocator;
+    this->uploadQueue = &uploadQueue;
+    this->rebuildBudget = rebuildBudget;
+
+    //every chunk lists its quads the same way, so one index buffer covers the fullest chunk
+    static_assert(MAX_QUADS_PER_CHUNK * 4 <= UINT16_MAX, "Chunk vertices must be addressable with 16-bit indices.");
+    std::vector<uint16_t> indices;
+    indices.reserve(MAX_QUADS_PER_CHUNK * 6);
+    for (uint32_t quad = 0; quad < MAX_QUADS_PER_CHUNK; ++quad)
+    {
+        const uint16_t first = static_cast<uint16_t>(quad * 4);
+        indices.insert(indices.end(), {first, uint16_t(first + 1), uint16_t(first + 2), uint16_t(first + 2), uint16_t(first + 3), first});
+    }
+
+    indexUploadValue = StreamToBuffer(allocator, uploadQueue, indices.data(), sizeof(uint16_t) * indices.size(),
+        VK_BUFFER_USAGE_INDEX_BUFFER_BIT, indexBuffer);
+
+    scratchVertices.reserve(MAX_QUADS_PER_CHUNK * 4);
+}
+
+void TilemapRenderer::Cleanup()
+{
+    std::vector<AllocatedBuffer> buffers;
+    for (auto& entry : tilemaps)
+    {
+        for (ChunkMesh& mesh : entry.second.chunks)
+        {
+            Retire(mesh, buffers);
+        }
+    }
+    for (TilemapMeshes& meshes : orphans)
+    {
+        for (ChunkMesh& mesh : meshes.chunks)
+        {
+            Retire(mesh, buffers);
+        }
+    }
+    if (indexBuffer.IsInitialized())
+    {
+        buffers.push_back(indexBuffer);
+        indexBuffer = AllocatedBuffer{};
+    }
+
+    for (const AllocatedBuffer& buffer : buffers)
+    {
+        vmaDestroyBuffer(allocator, buffer._buffer, buffer._allocation);
+    }
+
+    tilemaps.clear();
+    orphans.clear();
+}
+
+void TilemapRenderer::Extract
+(
+    const uint64_t id,
+    const Tilemap& tilemap,
+    const glm::mat4& renderMatrix,
+    const DrawPacket& packet,
+    const OcclusionBuffer* const occlusionBuffer,
+    std::vector<DrawPacket>& packets,
+    std::vector<AllocatedBuffer>& retiredBuffers
+)
+{
+    if (!uploadQueue->IsComplete(indexUploadValue))
+    {
+        return; // Still streaming in
+    }
+
+    TilemapMeshes& meshes = tilemaps[id];
+    meshes.lastFrame = frame;
+
+    if (meshes.chunkColumns != tilemap.GetChunkColumns() || meshes.chunkRows != tilemap.GetChunkRows())
+    {
+        // The component was replaced by a map of another size, start over
+        if (!meshes.chunks.empty())
+        {
+            orphans.push_back(std::move(meshes));
+        }
+        meshes = TilemapMeshes{};
+        meshes.chunkColumns = tilemap.GetChunkColumns();
+        meshes.chunkRows = tilemap.GetChunkRows();
+        meshes.chunks.resize(static_cast<size_t>(meshes.chunkColumns) * meshes.chunkRows);
+        meshes.lastFrame = frame;
+    }
+
+    const float chunkExtent = static_cast<float>(Tilemap::CHUNK_SIZE) * tilemap.tileSize;
+
+    // planes in the tilemap's local space, where the chunk bounds are
+    const Frustum frustum = Frustum::FromViewProjection(renderMatrix);
+
+    for (uint32_t chunkY = 0; chunkY < meshes.chunkRows; ++chunkY)
+    {
+        for (uint32_t chunkX = 0; chunkX < meshes.chunkColumns; ++chunkX)
+        {
+            const Tilemap::Chunk& chunk = tilemap.GetChunk(chunkX, chunkY);
+            ChunkMesh& mesh = meshes.chunks[static_cast<size_t>(chunkY) * meshes.chunkColumns + chunkX];
+
+            // A rebuilt mesh replaces the drawn one as soon as it has landed
+            if (mesh.pendingUploadValue != 0 && uploadQueue->IsComplete(mesh.pendingUploadValue))
+            {
+                if (mesh.vertexBuffer.IsInitialized())
+                {
+                    retiredBuffers.push_back(mesh.vertexBuffer);
+                }
+                mesh.vertexBuffer = mesh.pendingBuffer;
+                mesh.quadCount = mesh.pendingQuadCount;
+                mesh.pendingBuffer = AllocatedBuffer{};
+                mesh.pendingQuadCount = 0;
+                mesh.pendingUploadValue = 0;
+            }
+
+            const bool stale = chunk.revision != mesh.builtRevision;
+            if (!stale && mesh.quadCount == 0)
+            {
+                continue; // Empty, no need to test its bounds
+            }
+
+            const glm::vec3 origin{static_cast<float>(chunkX) * chunkExtent, static_cast<float>(chunkY) * chunkExtent, 0.0f};
+            const AABB bounds{origin, origin + glm::vec3{chunkExtent, chunkExtent, 0.0f}};
+            if (!frustum.Intersects(bounds) || (occlusionBuffer != nullptr && !occlusionBuffer->IsVisible(renderMatrix, bounds)))
+            {
+                continue; // Off screen chunks keep their old mesh until they are seen again
+            }
+
+            if (stale && mesh.pendingUploadValue == 0 && rebuildCount < rebuildBudget)
+            {
+                ++rebuildCount;
+                mesh.builtRevision = chunk.revision;
+
+                if (chunk.tileCount == 0)
+                {
+                    // Nothing left to draw, this frame already stops reading the old mesh
+                    if (mesh.vertexBuffer.IsInitialized())
+                    {
+                        retiredBuffers.push_back(mesh.vertexBuffer);
+                        mesh.vertexBuffer = AllocatedBuffer{};
+                    }
+                    mesh.quadCount = 0;
+                }
+                else
+                {
+                    BuildChunkVertices(tilemap, chunkX, chunkY, scratchVertices);
+                    Upload(mesh, scratchVertices);
+                }
+            }
+
+            if (mesh.quadCount == 0)
+            {
+                continue; // First build still streaming in
+            }
+
+            DrawPacket chunkPacket = packet;
+            chunkPacket.positionOffset = glm::vec4{origin, 0.0f};
+            chunkPacket.positionScale = glm::vec4{tilemap.tileSize, tilemap.tileSize, 1.0f, 1.0f};
+            chunkPacket.vertexBuffer = mesh.vertexBuffer._buffer;
+            chunkPacket.indexBuffer = indexBuffer._buffer;
+            chunkPacket.indexType = VK_INDEX_TYPE_UINT16;
+            chunkPacket.indexCount = mesh.quadCount * 6;
+            packets.push_back(chunkPacket);
+        }
+    }
+}
+
+void TilemapRenderer::EndFrame(std::vector<AllocatedBuffer>& retiredBuffers)
+{
+    for (auto it = tilemaps.begin(); it != tilemaps.end();)
+    {
+        if (it->second.lastFrame != frame)
+        {
+            orphans.push_back(std::move(it->second));
+            it = tilemaps.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    // A buffer still being copied into cannot be freed after a frame, wait for its copy first
+    for (auto it = orphans.begin(); it != orphans.end();)
+    {
+        const bool streaming = std::any_of(it->chunks.begin(), it->chunks.end(), [this](const ChunkMesh& mesh)
+        {
+            return mesh.pendingUploadValue != 0 && !uploadQueue->IsComplete(mesh.pendingUploadValue);
+        });
+        if (streaming)
+        {
+            ++it;
+            continue;
+        }
+
+        for (ChunkMesh& mesh : it->chunks)
+        {
+            Retire(mesh, retiredBuffers);
+        }
+        it = orphans.erase(it);
+    }
+
+    lastRebuildCount = rebuildCount;
+    rebuildCount = 0;
+    ++frame;
+}
+
+void TilemapRenderer::BuildChunkVertices(const Tilemap& tilemap, const uint32_t chunkX, const uint32_t chunkY, std::vector<TileVertex>& vertices)
+{
+    vertices.clear();
+
+    const Tilemap::Chunk& chunk = tilemap.GetChunk(chunkX, chunkY);
+    const uint32_t atlasColumns = std::max(tilemap.atlasColumns, 1u);
+    const uint32_t atlasRows = std::max(tilemap.atlasRows, 1u);
+    const float cellWidth = 1.0f / static_cast<float>(atlasColumns);
+    const float cellHeight = 1.0f / static_cast<float>(atlasRows);
+
+    for (uint16_t y = 0; y < Tilemap::CHUNK_SIZE; ++y)
+    {
+        for (uint16_t x = 0; x < Tilemap::CHUNK_SIZE; ++x)
+        {
+            const uint16_t tile = chunk.tiles[y * Tilemap::CHUNK_SIZE + x];
+            if (tile == Tilemap::EMPTY_TILE)
+            {
+                continue;
+            }
+
+            const uint32_t cell = static_cast<uint32_t>(tile - 1);
+            const float u0 = static_cast<float>(cell % atlasColumns) * cellWidth;
+            const float v0 = static_cast<float>((cell / atlasColumns) % atlasRows) * cellHeight;
+            const float u1 = u0 + cellWidth;
+            const float v1 = v0 + cellHeight;
+
+            // Images start at the top row, so the top corners take the top of the cell
+            vertices.emplace_back(x, y, u0, v1);
+            vertices.emplace_back(uint16_t(x + 1), y, u1, v1);
+            vertices.emplace_back(uint16_t(x + 1), uint16_t(y + 1), u1, v0);
+            vertices.emplace_back(x, uint16_t(y + 1), u0, v0);
+        }
+    }
+}
+
+uint32_t TilemapRenderer::GetRebuildCount() const
+{
+    return lastRebuildCount;
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+void TilemapRenderer::Upload(ChunkMesh& mesh, const std::vector<TileVertex>& vertices)
+{
+    mesh.pendingQuadCount = static_cast<uint32_t>(vertices.size() / 4);
+    mesh.pendingUploadValue = StreamToBuffer(allocator, *uploadQueue, vertices.data(), sizeof(TileVertex) * vertices.size(),
+        VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, mesh.pendingBuffer);
+}
+
+void TilemapRenderer::Retire(ChunkMesh& mesh, std::vector<AllocatedBuffer>& retiredBuffers)
+{
+    if (mesh.vertexBuffer.IsInitialized())
+    {
+        retiredBuffers.push_back(mesh.vertexBuffer);
+    }
+    if (mesh.pendingBuffer.IsInitialized())
+    {
+        retiredBuffers.push_back(mesh.pendingBuffer);
+    }
+    mesh = ChunkMesh{};
+}
+
+} // namespace velecs
@@ -0,0 +1,363 @@
+/// @file    TransferQueue.cpp
+/// @author  Matthew Green
+/// @date    2024-01-14 11:06:37
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Rendering/TransferQueue.h"
+
+#include <stdexcept>
+
+namespace velecs {
+
+// Public Fields
+
+// Constructors and Destructors
+
+// Public Methods
+
+void TransferQueue::Init
+(
+    VkDevice device,
+    VkQueue queue,
+    const uint32_t queueFamily,
+    const uint32_t graphicsQueueFamily,
+    const bool useTimeline,
+    std::mutex* const sharedQueueMutex /*= nullptr*/
+)
+{
+    this->device = device;
+    this->queue = queue;
+    this->queueFamily = queueFamily;
+    this->graphicsQueueFamily = graphicsQueueFamily;
+    this->sharedQueueMutex = sharedQueueMutex;
+
+    VkCommandPoolCreateInfo poolInfo = {};
+    poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT | VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+    poolInfo.queueFamilyIndex = queueFamily;
+
+    if (vkCreateCommandPool(device, &poolInfo, nullptr, &commandPool) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create the transfer command pool.");
+    }
+
+    if (!useTimeline)
+    {
+        return;
+    }
+
+    getSemaphoreCounterValue = reinterpret_cast<PFN_vkGetSemaphoreCounterValueKHR>(vkGetDeviceProcAddr(device, "vkGetSemaphoreCounterValueKHR"));
+    if (getSemaphoreCounterValue == nullptr)
+    {
+        return; // Fall back to fences
+    }
+
+    VkSemaphoreTypeCreateInfoKHR typeInfo = {};
+    typeInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO_KHR;
+    typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE_KHR;
+    typeInfo.initialValue = 0;
+
+    VkSemaphoreCreateInfo semaphoreInfo = {};
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    semaphoreInfo.pNext = &typeInfo;
+
+    if (vkCreateSemaphore(device, &semaphoreInfo, nullptr, &timelineSemaphore) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create the transfer timeline semaphore.");
+    }
+}
+
+void TransferQueue::Cleanup()
+{
+    if (queue != VK_NULL_HANDLE)
+    {
+        if (sharedQueueMutex != nullptr)
+        {
+            std::lock_guard<std::mutex> queueLock(*sharedQueueMutex);
+            vkQueueWaitIdle(queue);
+        }
+        else
+        {
+            vkQueueWaitIdle(queue);
+        }
+        Collect();
+    }
+
+    for (VkFence fence : freeFences)
+    {
+        vkDestroyFence(device, fence, nullptr);
+    }
+    freeFences.clear();
+
+    if (timelineSemaphore != VK_NULL_HANDLE)
+    {
+        vkDestroySemaphore(device, timelineSemaphore, nullptr);
+        timelineSemaphore = VK_NULL_HANDLE;
+    }
+
+    if (commandPool != VK_NULL_HANDLE)
+    {
+        vkDestroyCommandPool(device, commandPool, nullptr);
+        commandPool = VK_NULL_HANDLE;
+    }
+
+    freeCommandBuffers.clear();
+    pendingAcquires.clear();
+    queue = VK_NULL_HANDLE;
+}
+
+uint64_t TransferQueue::Submit
+(
+    std::function<void(VkCommandBuffer cmd)>&& record,
+    const std::vector<VkBuffer>& buffers,
+    std::function<void()>&& onComplete
+)
+{
+    Submission submission;
+    submission.value = nextValue++;
+    submission.onComplete = std::move(onComplete);
+
+    if (!freeCommandBuffers.empty())
+    {
+        submission.cmd = freeCommandBuffers.back();
+        freeCommandBuffers.pop_back();
+    }
+    else
+    {
+        VkCommandBufferAllocateInfo allocInfo = {};
+        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocInfo.commandPool = commandPool;
+        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        allocInfo.commandBufferCount = 1;
+
+        if (vkAllocateCommandBuffers(device, &allocInfo, &submission.cmd) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to allocate a transfer command buffer.");
+        }
+    }
+
+    VkCommandBufferBeginInfo beginInfo = {};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+    if (vkBeginCommandBuffer(submission.cmd, &beginInfo) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to begin a transfer command buffer.");
+    }
+
+    record(submission.cmd);
+
+    // Release half of the ownership transfer, the graphics queue records the acquire once this has finished
+    if (queueFamily != graphicsQueueFamily && !buffers.empty())
+    {
+        std::vector<VkBufferMemoryBarrier> releases;
+        releases.reserve(buffers.size());
+        for (VkBuffer buffer : buffers)
+        {
+            VkBufferMemoryBarrier release = {};
+            release.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+            release.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            release.dstAccessMask = 0;
+            release.srcQueueFamilyIndex = queueFamily;
+            release.dstQueueFamilyIndex = graphicsQueueFamily;
+            release.buffer = buffer;
+            release.offset = 0;
+            release.size = VK_WHOLE_SIZE;
+            releases.push_back(release);
+        }
+
+        vkCmdPipelineBarrier
+        (
+            submission.cmd,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+            0,
+            0, nullptr,
+            static_cast<uint32_t>(releases.size()), releases.data(),
+            0, nullptr
+        );
+
+        submission.releasedBuffers = buffers;
+    }
+
+    if (vkEndCommandBuffer(submission.cmd) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to end a transfer command buffer.");
+    }
+
+    VkSubmitInfo submit = {};
+    submit.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submit.commandBufferCount = 1;
+    submit.pCommandBuffers = &submission.cmd;
+
+    if (timelineSemaphore != VK_NULL_HANDLE)
+    {
+        VkTimelineSemaphoreSubmitInfoKHR timelineInfo = {};
+        timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR;
+        timelineInfo.signalSemaphoreValueCount = 1;
+        timelineInfo.pSignalSemaphoreValues = &submission.value;
+
+        submit.pNext = &timelineInfo;
+        submit.signalSemaphoreCount = 1;
+        submit.pSignalSemaphores = &timelineSemaphore;
+
+        SubmitToQueue(submit, VK_NULL_HANDLE);
+    }
+    else
+    {
+        if (!freeFences.empty())
+        {
+            submission.fence = freeFences.back();
+            freeFences.pop_back();
+        }
+        else
+        {
+            VkFenceCreateInfo fenceInfo = {};
+            fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+
+            if (vkCreateFence(device, &fenceInfo, nullptr, &submission.fence) != VK_SUCCESS)
+            {
+                throw std::runtime_error("Failed to create a transfer fence.");
+            }
+        }
+
+        SubmitToQueue(submit, submission.fence);
+    }
+
+    const uint64_t value = submission.value;
+    inFlight.push_back(std::move(submission));
+    return value;
+}
+
+void TransferQueue::Collect()
+{
+    uint64_t signaledValue = 0;
+    if (timelineSemaphore != VK_NULL_HANDLE)
+    {
+        if (getSemaphoreCounterValue(device, timelineSemaphore, &signaledValue) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to read the transfer timeline semaphore.");
+        }
+    }
+
+    while (!inFlight.empty())
+    {
+        Submission& submission = inFlight.front();
+
+        if (timelineSemaphore != VK_NULL_HANDLE)
+        {
+            if (submission.value > signaledValue)
+            {
+                break;
+            }
+        }
+        else
+        {
+            if (vkGetFenceStatus(device, submission.fence) != VK_SUCCESS)
+            {
+                break;
+            }
+            vkResetFences(device, 1, &submission.fence);
+            freeFences.push_back(submission.fence);
+        }
+
+        vkResetCommandBuffer(submission.cmd, 0);
+        freeCommandBuffers.push_back(submission.cmd);
+
+        for (VkBuffer buffer : submission.releasedBuffers)
+        {
+            VkBufferMemoryBarrier acquire = {};
+            acquire.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+            acquire.srcAccessMask = 0;
+            acquire.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+            acquire.srcQueueFamilyIndex = queueFamily;
+            acquire.dstQueueFamilyIndex = graphicsQueueFamily;
+            acquire.buffer = buffer;
+            acquire.offset = 0;
+            acquire.size = VK_WHOLE_SIZE;
+            pendingAcquires.push_back(acquire);
+        }
+
+        if (submission.onComplete)
+        {
+            submission.onComplete();
+        }
+
+        completedValue = submission.value;
+        inFlight.pop_front();
+    }
+}
+
+bool TransferQueue::IsComplete(const uint64_t value) const
+{
+    return value <= completedValue;
+}
+
+uint64_t TransferQueue::GetCompletedValue() const
+{
+    return completedValue;
+}
+
+void TransferQueue::TakeAcquires(std::vector<VkBufferMemoryBarrier>& barriers)
+{
+    barriers.insert(barriers.end(), pendingAcquires.begin(), pendingAcquires.end());
+    pendingAcquires.clear();
+}
+
+VkSemaphore TransferQueue::GetTimelineSemaphore() const
+{
+    return timelineSemaphore;
+}
+
+void TransferQueue::RecordAcquires(VkCommandBuffer cmd, const std::vector<VkBufferMemoryBarrier>& barriers)
+{
+    if (barriers.empty())
+    {
+        return;
+    }
+
+    vkCmdPipelineBarrier
+    (
+        cmd,
+        VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+        VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        0,
+        0, nullptr,
+        static_cast<uint32_t>(barriers.size()), barriers.data(),
+        0, nullptr
+    );
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+void TransferQueue::SubmitToQueue(const VkSubmitInfo& submit, VkFence fence)
+{
+    VkResult result;
+    if (sharedQueueMutex != nullptr)
+    {
+        std::lock_guard<std::mutex> queueLock(*sharedQueueMutex);
+        result = vkQueueSubmit(queue, 1, &submit, fence);
+    }
+    else
+    {
+        result = vkQueueSubmit(queue, 1, &submit, fence);
+    }
+
+    if (result != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to submit to the transfer queue.");
+    }
+}
+
+} // namespace velecs
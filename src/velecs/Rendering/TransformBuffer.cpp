@@ -0,0 +1,303 @@
+/// @file    TransformBuffer.cpp
+/// @author  Matthew Green
+/// @date    2024-01-12 09:18:02
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Rendering/TransformBuffer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+
+namespace velecs {
+
+// Public Fields
+
+// Constructors and Destructors
+
+// Public Methods
+
+void TransformBuffer::Init(VkDevice device, VmaAllocator allocator)
+{
+    this->device = device;
+    this->allocator = allocator;
+
+    const VkDeviceSize bufferSize = sizeof(glm::mat4) * MAX_TRANSFORMS;
+
+    // BUFFERS
+
+    VkBufferCreateInfo bufferInfo = {};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = bufferSize;
+    bufferInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+
+    VmaAllocationCreateInfo gpuAllocInfo = {};
+    gpuAllocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+
+    if (vmaCreateBuffer(allocator, &bufferInfo, &gpuAllocInfo, &gpuBuffer._buffer, &gpuBuffer._allocation, nullptr) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create the transform buffer.");
+    }
+
+    //sized for every slot changing at once, which happens on the first frame of a level
+    bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+
+    VmaAllocationCreateInfo stagingAllocInfo = {};
+    stagingAllocInfo.usage = VMA_MEMORY_USAGE_CPU_ONLY;
+    stagingAllocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+    VmaAllocationInfo allocationInfo = {};
+    if (vmaCreateBuffer(allocator, &bufferInfo, &stagingAllocInfo, &stagingBuffer._buffer, &stagingBuffer._allocation, &allocationInfo) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create the transform staging buffer.");
+    }
+
+    mappedStaging = static_cast<glm::mat4*>(allocationInfo.pMappedData);
+
+    // LAYOUT
+
+    VkDescriptorSetLayoutBinding binding = {};
+    binding.binding = TRANSFORMS_BINDING;
+    binding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    binding.descriptorCount = 1;
+    binding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo = {};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.bindingCount = 1;
+    layoutInfo.pBindings = &binding;
+
+    if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &layout) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create the transform buffer descriptor set layout.");
+    }
+
+    // POOL & SET
+
+    VkDescriptorPoolSize poolSize = { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1 };
+
+    VkDescriptorPoolCreateInfo poolInfo = {};
+    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.maxSets = 1;
+    poolInfo.poolSizeCount = 1;
+    poolInfo.pPoolSizes = &poolSize;
+
+    if (vkCreateDescriptorPool(device, &poolInfo, nullptr, &pool) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create the transform buffer descriptor pool.");
+    }
+
+    VkDescriptorSetAllocateInfo allocInfo = {};
+    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool = pool;
+    allocInfo.descriptorSetCount = 1;
+    allocInfo.pSetLayouts = &layout;
+
+    if (vkAllocateDescriptorSets(device, &allocInfo, &set) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to allocate the transform buffer descriptor set.");
+    }
+
+    VkDescriptorBufferInfo descriptorBufferInfo = {};
+    descriptorBufferInfo.buffer = gpuBuffer._buffer;
+    descriptorBufferInfo.offset = 0;
+    descriptorBufferInfo.range = bufferSize;
+
+    VkWriteDescriptorSet write = {};
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet = set;
+    write.dstBinding = TRANSFORMS_BINDING;
+    write.dstArrayElement = 0;
+    write.descriptorCount = 1;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    write.pBufferInfo = &descriptorBufferInfo;
+
+    vkUpdateDescriptorSets(device, 1, &write, 0, nullptr);
+}
+
+void TransformBuffer::Cleanup()
+{
+    if (gpuBuffer.IsInitialized())
+    {
+        vmaDestroyBuffer(allocator, gpuBuffer._buffer, gpuBuffer._allocation);
+        gpuBuffer = AllocatedBuffer{};
+    }
+
+    if (stagingBuffer.IsInitialized())
+    {
+        vmaDestroyBuffer(allocator, stagingBuffer._buffer, stagingBuffer._allocation);
+        stagingBuffer = AllocatedBuffer{};
+        mappedStaging = nullptr;
+    }
+
+    if (pool != VK_NULL_HANDLE)
+    {
+        vkDestroyDescriptorPool(device, pool, nullptr);
+        pool = VK_NULL_HANDLE;
+        set = VK_NULL_HANDLE;
+    }
+
+    if (layout != VK_NULL_HANDLE)
+    {
+        vkDestroyDescriptorSetLayout(device, layout, nullptr);
+        layout = VK_NULL_HANDLE;
+    }
+}
+
+uint32_t TransformBuffer::Allocate()
+{
+    uint32_t index;
+    if (!freeSlots.empty())
+    {
+        index = freeSlots.back();
+        freeSlots.pop_back();
+    }
+    else if (nextSlot < MAX_TRANSFORMS)
+    {
+        index = nextSlot++;
+        matrices.emplace_back(0.0f); // differs from any real matrix, so the first Write always uploads
+        dirtyFlags.push_back(false);
+    }
+    else
+    {
+        std::ostringstream oss;
+        oss << "Transform buffer is full (" << MAX_TRANSFORMS << " transforms).";
+        throw std::runtime_error(oss.str());
+    }
+
+    Write(index, glm::mat4{1.0f});
+    return index;
+}
+
+void TransformBuffer::Release(const uint32_t index)
+{
+    if (index == INVALID_INDEX || index >= nextSlot)
+    {
+        return;
+    }
+
+    freeSlots.push_back(index);
+}
+
+void TransformBuffer::Write(const uint32_t index, const glm::mat4& matrix)
+{
+    if (index >= nextSlot || matrices[index] == matrix)
+    {
+        return;
+    }
+
+    matrices[index] = matrix;
+    if (!dirtyFlags[index])
+    {
+        dirtyFlags[index] = true;
+        dirtyIndices.push_back(index);
+    }
+}
+
+const glm::mat4& TransformBuffer::GetMatrix(const uint32_t index) const
+{
+    return matrices[index];
+}
+
+void TransformBuffer::ExtractUploads(std::vector<UploadRange>& ranges, std::vector<glm::mat4>& data)
+{
+    ranges.clear();
+    data.clear();
+
+    if (dirtyIndices.empty())
+    {
+        return;
+    }
+
+    std::sort(dirtyIndices.begin(), dirtyIndices.end());
+
+    UploadRange range{dirtyIndices[0], 1, 0};
+    for (auto it = std::next(dirtyIndices.begin()); it != dirtyIndices.end(); ++it)
+    {
+        const uint32_t index = *it;
+        if (index - (range.firstIndex + range.count) <= MERGE_GAP)
+        {
+            range.count = index - range.firstIndex + 1; // the clean slots in between are copied from the CPU copy
+        }
+        else
+        {
+            ranges.push_back(range);
+            range = UploadRange{index, 1, 0};
+        }
+    }
+    ranges.push_back(range);
+
+    for (UploadRange& uploadRange : ranges)
+    {
+        uploadRange.dataOffset = static_cast<uint32_t>(data.size());
+        data.insert(data.end(), matrices.begin() + uploadRange.firstIndex, matrices.begin() + uploadRange.firstIndex + uploadRange.count);
+    }
+
+    for (const uint32_t index : dirtyIndices)
+    {
+        dirtyFlags[index] = false;
+    }
+    dirtyIndices.clear();
+}
+
+void TransformBuffer::RecordUploads(VkCommandBuffer cmd, const std::vector<UploadRange>& ranges, const std::vector<glm::mat4>& data)
+{
+    if (ranges.empty() || mappedStaging == nullptr)
+    {
+        return;
+    }
+
+    std::memcpy(mappedStaging, data.data(), data.size() * sizeof(glm::mat4));
+
+    std::vector<VkBufferCopy> regions;
+    regions.reserve(ranges.size());
+    for (const UploadRange& range : ranges)
+    {
+        VkBufferCopy region = {};
+        region.srcOffset = static_cast<VkDeviceSize>(range.dataOffset) * sizeof(glm::mat4);
+        region.dstOffset = static_cast<VkDeviceSize>(range.firstIndex) * sizeof(glm::mat4);
+        region.size = static_cast<VkDeviceSize>(range.count) * sizeof(glm::mat4);
+        regions.push_back(region);
+    }
+
+    vkCmdCopyBuffer(cmd, stagingBuffer._buffer, gpuBuffer._buffer, static_cast<uint32_t>(regions.size()), regions.data());
+
+    VkBufferMemoryBarrier barrier = {};
+    barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.buffer = gpuBuffer._buffer;
+    barrier.offset = 0;
+    barrier.size = VK_WHOLE_SIZE;
+
+    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, 0, 0, nullptr, 1, &barrier, 0, nullptr);
+}
+
+void TransformBuffer::Bind(VkCommandBuffer cmd, VkPipelineLayout pipelineLayout, const uint32_t setIndex /*= 1*/) const
+{
+    vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, setIndex, 1, &set, 0, nullptr);
+}
+
+VkDescriptorSetLayout TransformBuffer::GetLayout() const
+{
+    return layout;
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+} // namespace velecs
@@ -52,9 +52,17 @@ VertexInputAttributeDescriptor Vertex::GetVertexDescription()
     colorAttribute.format = VK_FORMAT_R8G8B8A8_UNORM;
     colorAttribute.offset = offsetof(Vertex, color);
 
+    //UV will be stored at Location 3
+    VkVertexInputAttributeDescription uvAttribute = {};
+    uvAttribute.binding = 0;
+    uvAttribute.location = 3;
+    uvAttribute.format = VK_FORMAT_R32G32_SFLOAT;
+    uvAttribute.offset = offsetof(Vertex, uv);
+
     description.attributes.push_back(positionAttribute);
     description.attributes.push_back(normalAttribute);
     description.attributes.push_back(colorAttribute);
+    description.attributes.push_back(uvAttribute);
     return description;
 }
 
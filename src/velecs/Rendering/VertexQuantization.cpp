@@ -0,0 +1,180 @@
+/// @file    VertexQuantization.cpp
+/// @author  Matthew Green
+/// @date    2024-01-08 09:55:03
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Rendering/VertexQuantization.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/geometric.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace velecs {
+
+// Public Fields
+
+// Constructors and Destructors
+
+// Public Methods
+
+VertexFormat VertexQuantization::ChooseFormat(const AABB& bounds)
+{
+    if (!bounds.IsValid())
+    {
+        return VertexFormat::Float32;
+    }
+
+    const glm::vec3 size = bounds.max - bounds.min;
+    const float largestSide = std::max({size.x, size.y, size.z});
+    return largestSide / 65535.0f <= MAX_POSITION_ERROR ? VertexFormat::Quantized16 : VertexFormat::Float32;
+}
+
+std::array<uint16_t, 3> VertexQuantization::QuantizePosition(const glm::vec3 position, const AABB& bounds)
+{
+    std::array<uint16_t, 3> encoded;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        const float size = bounds.max[axis] - bounds.min[axis];
+        const float normalized = size > 0.0f ? (position[axis] - bounds.min[axis]) / size : 0.0f;
+        encoded[axis] = static_cast<uint16_t>(std::clamp(normalized, 0.0f, 1.0f) * 65535.0f + 0.5f);
+    }
+    return encoded;
+}
+
+glm::mat4 VertexQuantization::GetDequantizeMatrix(const AABB& bounds)
+{
+    const glm::mat4 translation = glm::translate(glm::mat4{1.0f}, bounds.min);
+    return glm::scale(translation, bounds.max - bounds.min);
+}
+
+std::array<int16_t, 2> VertexQuantization::EncodeOctahedral(const glm::vec3 normal)
+{
+    const float length = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+    if (length <= 0.0f)
+    {
+        return {0, 0};
+    }
+
+    // Project onto the octahedron, then fold the lower hemisphere over the diagonals
+    glm::vec2 octahedral = glm::vec2{normal.x, normal.y} / length;
+    if (normal.z < 0.0f)
+    {
+        const glm::vec2 folded
+        {
+            (1.0f - std::abs(octahedral.y)) * (octahedral.x >= 0.0f ? 1.0f : -1.0f),
+            (1.0f - std::abs(octahedral.x)) * (octahedral.y >= 0.0f ? 1.0f : -1.0f)
+        };
+        octahedral = folded;
+    }
+
+    return
+    {
+        static_cast<int16_t>(std::round(std::clamp(octahedral.x, -1.0f, 1.0f) * 32767.0f)),
+        static_cast<int16_t>(std::round(std::clamp(octahedral.y, -1.0f, 1.0f) * 32767.0f))
+    };
+}
+
+glm::vec3 VertexQuantization::DecodeOctahedral(const std::array<int16_t, 2> encoded)
+{
+    const float x = std::max(encoded[0] / 32767.0f, -1.0f);
+    const float y = std::max(encoded[1] / 32767.0f, -1.0f);
+
+    glm::vec3 normal{x, y, 1.0f - std::abs(x) - std::abs(y)};
+    const float fold = std::max(-normal.z, 0.0f);
+    normal.x += normal.x >= 0.0f ? -fold : fold;
+    normal.y += normal.y >= 0.0f ? -fold : fold;
+    return glm::normalize(normal);
+}
+
+uint16_t VertexQuantization::FloatToHalf(const float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    const uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000u);
+    const uint32_t floatExponent = (bits >> 23) & 0xFFu;
+    uint32_t mantissa = bits & 0x7FFFFFu;
+
+    if (floatExponent == 0xFFu)
+    {
+        return static_cast<uint16_t>(sign | 0x7C00u | (mantissa != 0 ? 0x200u : 0u)); // Infinity or NaN
+    }
+
+    const int32_t exponent = static_cast<int32_t>(floatExponent) - 127 + 15;
+    if (exponent >= 31)
+    {
+        return static_cast<uint16_t>(sign | 0x7C00u); // Too large, becomes infinity
+    }
+
+    if (exponent <= 0)
+    {
+        if (exponent < -10)
+        {
+            return sign; // Too small even for a subnormal
+        }
+
+        mantissa |= 0x800000u;
+        const uint32_t shift = static_cast<uint32_t>(14 - exponent);
+        uint32_t half = mantissa >> shift;
+        const uint32_t remainder = mantissa & ((1u << shift) - 1u);
+        const uint32_t halfway = 1u << (shift - 1u);
+        if (remainder > halfway || (remainder == halfway && (half & 1u)))
+        {
+            ++half;
+        }
+        return static_cast<uint16_t>(sign | half);
+    }
+
+    // A carry out of the mantissa correctly bumps the exponent, up to infinity
+    uint32_t half = (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+    const uint32_t remainder = mantissa & 0x1FFFu;
+    if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u)))
+    {
+        ++half;
+    }
+    return static_cast<uint16_t>(sign | half);
+}
+
+float VertexQuantization::HalfToFloat(const uint16_t half)
+{
+    const uint32_t sign = static_cast<uint32_t>(half & 0x8000u) << 16;
+    const uint32_t exponent = (half >> 10) & 0x1Fu;
+    const uint32_t mantissa = half & 0x3FFu;
+
+    uint32_t bits;
+    if (exponent == 0)
+    {
+        const float subnormal = std::ldexp(static_cast<float>(mantissa), -24);
+        return sign != 0 ? -subnormal : subnormal;
+    }
+    else if (exponent == 31)
+    {
+        bits = sign | 0x7F800000u | (mantissa << 13);
+    }
+    else
+    {
+        bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+    }
+
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+} // namespace velecs
@@ -0,0 +1,131 @@
+/// @file    OcclusionBufferTests.cpp
+/// @author  Matthew Green
+/// @date    2024-01-29 09:31:57
+///
+/// @section LICENSE
+///
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "TestHarness.h"
+
+#include "velecs/Rendering/OcclusionBuffer.h"
+#include "velecs/Core/ThreadPool.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <random>
+
+using namespace velecs;
+
+namespace {
+
+/// @brief Camera at the origin looking down -z, twice as wide as it is tall like the buffer.
+glm::mat4 GetProjection()
+{
+    return glm::perspective(glm::radians(90.0f), 2.0f, 0.1f, 100.0f);
+}
+
+/// @brief Adds a square facing the camera at depth @p z, covering [-halfSize, halfSize] on x and y.
+void AddSquare(OcclusionBuffer& buffer, const glm::mat4& renderMatrix, const float z, const float halfSize)
+{
+    const std::vector<SimpleVertex> vertices
+    {
+        SimpleVertex{-halfSize, -halfSize, z},
+        SimpleVertex{halfSize, -halfSize, z},
+        SimpleVertex{halfSize, halfSize, z},
+        SimpleVertex{-halfSize, halfSize, z}
+    };
+    const std::vector<uint32_t> indices{0, 1, 2, 0, 2, 3};
+    buffer.AddOccluder(renderMatrix, vertices, indices);
+}
+
+/// @brief Rasterizes a square 10 units in front of the camera, 10 units wide.
+void RasterizeSquare(OcclusionBuffer& buffer, ThreadPool& threadPool)
+{
+    AddSquare(buffer, GetProjection(), -10.0f, 5.0f);
+    buffer.Rasterize(threadPool);
+}
+
+} // namespace
+
+VELECS_TEST(OcclusionBufferCullsBoxBehindOccluder)
+{
+    OcclusionBuffer buffer;
+    ThreadPool threadPool{1};
+    RasterizeSquare(buffer, threadPool);
+
+    VELECS_CHECK(!buffer.IsVisible(GetProjection(), AABB{glm::vec3{-1.0f, -1.0f, -20.0f}, glm::vec3{1.0f, 1.0f, -15.0f}}));
+}
+
+VELECS_TEST(OcclusionBufferKeepsBoxInFrontOfOccluder)
+{
+    OcclusionBuffer buffer;
+    ThreadPool threadPool{1};
+    RasterizeSquare(buffer, threadPool);
+
+    VELECS_CHECK(buffer.IsVisible(GetProjection(), AABB{glm::vec3{-1.0f, -1.0f, -8.0f}, glm::vec3{1.0f, 1.0f, -6.0f}}));
+}
+
+VELECS_TEST(OcclusionBufferKeepsBoxStraddlingOccluderEdge)
+{
+    OcclusionBuffer buffer;
+    ThreadPool threadPool{1};
+    RasterizeSquare(buffer, threadPool);
+
+    // behind the square, but reaching past its right edge on screen
+    VELECS_CHECK(buffer.IsVisible(GetProjection(), AABB{glm::vec3{4.0f, -1.0f, -20.0f}, glm::vec3{10.0f, 1.0f, -15.0f}}));
+}
+
+VELECS_TEST(OcclusionBufferKeepsBoxCrossingNearPlane)
+{
+    OcclusionBuffer buffer;
+    ThreadPool threadPool{1};
+    RasterizeSquare(buffer, threadPool);
+
+    // mostly behind the square, but reaching behind the camera
+    VELECS_CHECK(buffer.IsVisible(GetProjection(), AABB{glm::vec3{-1.0f, -1.0f, -20.0f}, glm::vec3{1.0f, 1.0f, 0.5f}}));
+    // reaching in front of the near plane without passing the camera
+    VELECS_CHECK(buffer.IsVisible(GetProjection(), AABB{glm::vec3{-0.01f, -0.01f, -20.0f}, glm::vec3{0.01f, 0.01f, -0.05f}}));
+}
+
+VELECS_TEST(OcclusionBufferIsIdenticalForAnyThreadCount)
+{
+    // overlapping triangles of every size, so tiles see different amounts of work
+    std::mt19937 random{1234u};
+    std::uniform_real_distribution<float> spreadX{-40.0f, 40.0f};
+    std::uniform_real_distribution<float> spreadY{-20.0f, 20.0f};
+    std::uniform_real_distribution<float> spreadZ{-60.0f, -2.0f};
+
+    std::vector<SimpleVertex> vertices;
+    std::vector<uint32_t> indices;
+    for (uint32_t i = 0; i < 3 * 500; ++i)
+    {
+        vertices.emplace_back(spreadX(random), spreadY(random), spreadZ(random));
+        indices.push_back(i);
+    }
+
+    OcclusionBuffer reference;
+    ThreadPool serialPool{0};
+    reference.AddOccluder(GetProjection(), vertices, indices);
+    reference.Rasterize(serialPool);
+
+    for (const size_t workerCount : {1u, 3u, 7u})
+    {
+        OcclusionBuffer buffer;
+        ThreadPool threadPool{workerCount};
+        buffer.AddOccluder(GetProjection(), vertices, indices);
+        buffer.Rasterize(threadPool);
+
+        bool identical = true;
+        for (uint32_t y = 0; y < buffer.GetHeight(); ++y)
+        {
+            for (uint32_t x = 0; x < buffer.GetWidth(); ++x)
+            {
+                identical = identical && buffer.GetDepth(x, y) == reference.GetDepth(x, y);
+            }
+        }
+        VELECS_CHECK(identical);
+    }
+}
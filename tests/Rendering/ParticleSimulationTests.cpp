@@ -0,0 +1,140 @@
+/// @file    ParticleSimulationTests.cpp
+/// @author  Matthew Green
+/// @date    2024-01-29 14:52:08
+///
+/// @section LICENSE
+///
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "TestHarness.h"
+
+#include "velecs/Rendering/ParticleSystem.h"
+
+#include <cstring>
+#include <vector>
+
+using namespace velecs;
+
+namespace {
+
+/// @brief Emitter at @p x on the x axis, spawning @p spawnCount particles after @p spawnOffset others.
+ParticleEmitterParams MakeEmitter(const float x, const uint32_t spawnOffset, const uint32_t spawnCount)
+{
+    ParticleEmitterParams emitter;
+    emitter.position = glm::vec4{x, 0.0f, 0.0f, 0.0f};
+    emitter.velocitySpread = glm::vec4{0.0f, 1.0f, 0.0f, 2.0f};
+    emitter.lifetime = 2.0f;
+    emitter.spawnOffset = spawnOffset;
+    emitter.spawnCount = spawnCount;
+    emitter.seed = spawnOffset + 1;
+    return emitter;
+}
+
+/// @brief Particle at the origin that has lived @p age of its @p lifetime seconds.
+Particle MakeParticle(const float age, const float lifetime)
+{
+    Particle particle;
+    particle.positionAge = glm::vec4{0.0f, 0.0f, 0.0f, age};
+    particle.velocityLifetime = glm::vec4{1.0f, 0.0f, 0.0f, lifetime};
+    return particle;
+}
+
+} // namespace
+
+VELECS_TEST(ParticleSimulationSpawnsEachEmittersCount)
+{
+    const std::vector<ParticleEmitterParams> emitters{MakeEmitter(-5.0f, 0, 3), MakeEmitter(5.0f, 3, 5)};
+
+    ParticleSimulationParams params;
+    params.deltaTime = 0.1f;
+    params.emitterCount = 2;
+    params.spawnCount = 8;
+    params.capacity = 64;
+
+    std::vector<Particle> destination(params.capacity);
+    const uint32_t count = ParticleSystem::Simulate(nullptr, 0, destination.data(), emitters.data(), params);
+
+    VELECS_CHECK(count == 8);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const float expectedX = i < 3 ? -5.0f : 5.0f;
+        VELECS_CHECK(destination[i].positionAge.x == expectedX);
+        VELECS_CHECK(destination[i].positionAge.w == 0.0f);
+
+        // each particle loses up to a quarter of its emitter's lifetime
+        VELECS_CHECK(destination[i].velocityLifetime.w > 1.5f && destination[i].velocityLifetime.w <= 2.0f);
+    }
+}
+
+VELECS_TEST(ParticleSimulationDropsParticlesPastTheirLifetime)
+{
+    const std::vector<Particle> source{MakeParticle(0.5f, 1.0f), MakeParticle(0.95f, 1.0f), MakeParticle(0.2f, 1.0f)};
+
+    ParticleSimulationParams params;
+    params.deltaTime = 0.1f;
+    params.capacity = 64;
+
+    std::vector<Particle> destination(params.capacity);
+    const uint32_t count = ParticleSystem::Simulate(source.data(), static_cast<uint32_t>(source.size()), destination.data(), nullptr, params);
+
+    // the survivors keep their order and age by one step
+    VELECS_CHECK(count == 2);
+    VELECS_CHECK(destination[0].positionAge.w == 0.5f + 0.1f);
+    VELECS_CHECK(destination[1].positionAge.w == 0.2f + 0.1f);
+    VELECS_CHECK(destination[0].positionAge.x > 0.0f);
+}
+
+VELECS_TEST(ParticleSimulationStopsAtCapacity)
+{
+    const std::vector<Particle> source(6, MakeParticle(0.0f, 10.0f));
+    const std::vector<ParticleEmitterParams> emitters{MakeEmitter(0.0f, 0, 4)};
+
+    ParticleSimulationParams params;
+    params.deltaTime = 0.1f;
+    params.emitterCount = 1;
+    params.spawnCount = 4;
+    params.capacity = 8;
+
+    // one slot past capacity, which must stay untouched
+    std::vector<Particle> destination(params.capacity + 1, MakeParticle(-1.0f, -1.0f));
+
+    // 6 survivors and 4 spawned particles
+    const uint32_t count = ParticleSystem::Simulate(source.data(), 6, destination.data(), emitters.data(), params);
+    VELECS_CHECK(count == params.capacity);
+    VELECS_CHECK(destination[params.capacity].positionAge.w == -1.0f);
+
+    // more live particles than the buffer holds are cut at capacity as well
+    params.emitterCount = 0;
+    params.capacity = 4;
+    const uint32_t clamped = ParticleSystem::Simulate(source.data(), 6, destination.data(), emitters.data(), params);
+    VELECS_CHECK(clamped == params.capacity);
+}
+
+VELECS_TEST(ParticleSimulationIsDeterministicForAFrameSeed)
+{
+    const std::vector<Particle> source{MakeParticle(0.3f, 1.0f), MakeParticle(0.6f, 1.0f)};
+    const std::vector<ParticleEmitterParams> emitters{MakeEmitter(0.0f, 0, 16), MakeEmitter(1.0f, 16, 16)};
+
+    ParticleSimulationParams params;
+    params.deltaTime = 1.0f / 60.0f;
+    params.emitterCount = 2;
+    params.spawnCount = 32;
+    params.capacity = 64;
+    params.frameSeed = 42;
+
+    std::vector<Particle> first(params.capacity);
+    std::vector<Particle> second(params.capacity);
+    const uint32_t firstCount = ParticleSystem::Simulate(source.data(), 2, first.data(), emitters.data(), params);
+    const uint32_t secondCount = ParticleSystem::Simulate(source.data(), 2, second.data(), emitters.data(), params);
+
+    VELECS_CHECK(firstCount == secondCount);
+    VELECS_CHECK(std::memcmp(first.data(), second.data(), sizeof(Particle) * firstCount) == 0);
+
+    // another frame draws other random numbers
+    params.frameSeed = 43;
+    std::vector<Particle> other(params.capacity);
+    ParticleSystem::Simulate(source.data(), 2, other.data(), emitters.data(), params);
+    VELECS_CHECK(std::memcmp(first.data() + 2, other.data() + 2, sizeof(Particle) * (firstCount - 2)) != 0);
+}
@@ -0,0 +1,53 @@
+/// @file    TestHarness.h
+/// @author  Matthew Green
+/// @date    2024-01-29 09:12:40
+///
+/// @section LICENSE
+///
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include <vector>
+
+namespace velecs {
+
+/// @struct TestCase
+/// @brief One test function registered with VELECS_TEST.
+struct TestCase {
+    const char* name; /// @brief Name printed with the result.
+    void (*function)(); /// @brief Body of the test, reports failures through VELECS_CHECK.
+};
+
+/// @brief Gets every test registered so far, in registration order.
+/// @return The registered tests.
+std::vector<TestCase>& GetTestCases();
+
+/// @brief Records the outcome of one check, printing it when it failed.
+/// @param[in] passed Whether the checked condition held.
+/// @param[in] expression The condition as written.
+/// @param[in] file File of the check.
+/// @param[in] line Line of the check.
+void ReportCheck(const bool passed, const char* expression, const char* file, const int line);
+
+/// @struct TestRegistrar
+/// @brief Adds a test to GetTestCases while static objects are constructed.
+struct TestRegistrar {
+    /// @brief Constructor.
+    /// @param[in] name Name printed with the result.
+    /// @param[in] function Body of the test.
+    TestRegistrar(const char* name, void (*function)());
+};
+
+} // namespace velecs
+
+/// @brief Defines a test function and registers it to run from main.
+#define VELECS_TEST(name) \
+    static void name(); \
+    static const velecs::TestRegistrar name##Registrar{#name, &name}; \
+    static void name()
+
+/// @brief Fails the running test when @p condition is false, the test keeps running.
+#define VELECS_CHECK(condition) velecs::ReportCheck(static_cast<bool>(condition), #condition, __FILE__, __LINE__)
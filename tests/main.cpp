@@ -0,0 +1,69 @@
+/// @file    main.cpp
+/// @author  Matthew Green
+/// @date    2024-01-29 09:14:03
+///
+/// @section LICENSE
+///
+/// Copyright (c) 2024 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "TestHarness.h"
+
+#include <exception>
+#include <iostream>
+
+namespace velecs {
+
+namespace {
+
+size_t failedChecks = 0; /// @brief Checks failed by the running test.
+
+} // namespace
+
+std::vector<TestCase>& GetTestCases()
+{
+    static std::vector<TestCase> testCases;
+    return testCases;
+}
+
+void ReportCheck(const bool passed, const char* expression, const char* file, const int line)
+{
+    if (!passed)
+    {
+        std::cerr << file << "(" << line << "): check failed: " << expression << std::endl;
+        ++failedChecks;
+    }
+}
+
+TestRegistrar::TestRegistrar(const char* name, void (*function)())
+{
+    GetTestCases().push_back(TestCase{name, function});
+}
+
+} // namespace velecs
+
+int main()
+{
+    size_t failedTests = 0;
+    for (const velecs::TestCase& testCase : velecs::GetTestCases())
+    {
+        velecs::failedChecks = 0;
+        try
+        {
+            testCase.function();
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << testCase.name << " threw: " << e.what() << std::endl;
+            ++velecs::failedChecks;
+        }
+
+        const bool passed = velecs::failedChecks == 0;
+        std::cout << (passed ? "[PASS] " : "[FAIL] ") << testCase.name << std::endl;
+        failedTests += passed ? 0 : 1;
+    }
+
+    std::cout << velecs::GetTestCases().size() - failedTests << " of " << velecs::GetTestCases().size() << " tests passed" << std::endl;
+    return failedTests == 0 ? 0 : 1;
+}